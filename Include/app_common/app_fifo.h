@@ -26,6 +26,26 @@
 #include <stdlib.h>
 #include "nrf_error.h"
 
+/**@brief Enables the single-producer/single-consumer variant of the FIFO.
+ *
+ * @details When set, the read and write positions are C11 atomics, published with release
+ *          ordering and observed with acquire ordering. One producer (app_fifo_put(),
+ *          app_fifo_write()) and one consumer (all other operations) can then run concurrently
+ *          on different threads or cores. The structure layout and the API are unchanged.
+ *          When not set, the FIFO relies on the single core interrupt model of the nRF51.
+ */
+#ifndef APP_FIFO_SPSC
+#define APP_FIFO_SPSC 0
+#endif
+
+#if APP_FIFO_SPSC
+#include <stdatomic.h>
+
+typedef _Atomic uint32_t app_fifo_pos_t;    /**< FIFO read/write position. */
+#else
+typedef volatile uint32_t app_fifo_pos_t;   /**< FIFO read/write position. */
+#endif
+
 /**@brief A FIFO instance structure. Keeps track of which bytes to read and write next.
  *        Also it keeps the information about which memory is allocated for the buffer
  *        and its size. This needs to be initialized by app_fifo_init() before use.
@@ -34,8 +54,8 @@ typedef struct
 {
     uint8_t *          p_buf;           /**< Pointer to FIFO buffer memory.                      */
     uint16_t           buf_size_mask;   /**< Read/write index mask. Also used for size checking. */
-    volatile uint32_t  read_pos;        /**< Next read position in the FIFO buffer.              */
-    volatile uint32_t  write_pos;       /**< Next write position in the FIFO buffer.             */
+    app_fifo_pos_t     read_pos;        /**< Next read position in the FIFO buffer.              */
+    app_fifo_pos_t     write_pos;       /**< Next write position in the FIFO buffer.             */
 } app_fifo_t;
 
 /**@brief Function for initializing the FIFO.
@@ -70,6 +90,62 @@ uint32_t app_fifo_put(app_fifo_t * p_fifo, uint8_t byte);
  */
 uint32_t app_fifo_get(app_fifo_t * p_fifo, uint8_t * p_byte);
 
+/**@brief Function for adding a block of data to the FIFO.
+ *
+ * @details As much of the data as there is room for is copied, in at most two blocks.
+ *
+ * @param[in]     p_fifo   Pointer to the FIFO.
+ * @param[in]     p_data   Data to add to the FIFO. If NULL, nothing is added and p_size returns
+ *                         the number of free bytes in the FIFO.
+ * @param[in,out] p_size   Number of bytes to add. Returns the number of bytes added.
+ *
+ * @retval     NRF_SUCCESS              If data has been added to the FIFO (or p_data is NULL).
+ * @retval     NRF_ERROR_NULL           If p_size is NULL.
+ * @retval     NRF_ERROR_NO_MEM         If the FIFO is full.
+ */
+uint32_t app_fifo_write(app_fifo_t * p_fifo, const uint8_t * p_data, uint32_t * p_size);
+
+/**@brief Function for getting a block of data from the FIFO.
+ *
+ * @details As much of the requested data as the FIFO holds is copied, in at most two blocks.
+ *
+ * @param[in]     p_fifo   Pointer to the FIFO.
+ * @param[out]    p_data   Buffer for the data read. If NULL, nothing is read and p_size returns
+ *                         the number of bytes in the FIFO.
+ * @param[in,out] p_size   Number of bytes to read. Returns the number of bytes read.
+ *
+ * @retval     NRF_SUCCESS              If data was returned (or p_data is NULL).
+ * @retval     NRF_ERROR_NULL           If p_size is NULL.
+ * @retval     NRF_ERROR_NOT_FOUND      If the FIFO is empty.
+ */
+uint32_t app_fifo_read(app_fifo_t * p_fifo, uint8_t * p_data, uint32_t * p_size);
+
+/**@brief Function for getting the next contiguous block of data in the FIFO without removing it.
+ *
+ * @details The data can be processed in place, and is removed from the FIFO by calling
+ *          app_fifo_commit(). When the data wraps around the end of the FIFO buffer, only the part
+ *          up to the end of the buffer is returned, and the rest is returned by the next call.
+ *
+ * @param[in]  p_fifo   Pointer to the FIFO.
+ * @param[out] pp_data  Pointer to the first byte of the block.
+ * @param[out] p_size   Number of bytes in the block.
+ *
+ * @retval     NRF_SUCCESS              If a block was returned.
+ * @retval     NRF_ERROR_NOT_FOUND      If the FIFO is empty.
+ */
+uint32_t app_fifo_peek_span(app_fifo_t * p_fifo, uint8_t ** pp_data, uint32_t * p_size);
+
+/**@brief Function for removing data processed in place from the FIFO.
+ *
+ * @param[in]  p_fifo   Pointer to the FIFO.
+ * @param[in]  size     Number of bytes to remove, at most the size returned by
+ *                      app_fifo_peek_span().
+ *
+ * @retval     NRF_SUCCESS              If the data was removed.
+ * @retval     NRF_ERROR_INVALID_LENGTH If the FIFO holds less than size bytes.
+ */
+uint32_t app_fifo_commit(app_fifo_t * p_fifo, uint32_t size);
+
 /**@brief Function for flushing the FIFO.
  *
  * @param[in]  p_fifo   Pointer to the FIFO.
@@ -43,6 +43,25 @@
  * @ref ble_sdk_app_hids_mouse and @ref ble_sdk_app_hids_keyboard.
  *
  * @image html scheduler_working.jpg The high level design of the scheduler
+ *
+ * @section app_scheduler_prio Priority levels:
+ *
+ * When APP_SCHED_PRIORITY_LEVELS is set to 2 to 4 in the build environment, the single event
+ * queue is replaced by one queue per event priority and interrupt level. Each queue has a
+ * single producer (the interrupt level) and a single consumer (app_sched_execute()). This means
+ * app_sched_event_put() does not disable interrupts. app_sched_execute() runs the highest
+ * priority events first. Events put from the same interrupt level with the same priority are
+ * executed in order. Each queue holds QUEUE_SIZE events, so the scheduler buffer is
+ * APP_SCHED_PRIORITY_LEVELS * APP_SCHED_INT_LEVELS times the size of the single queue.
+ *
+ * @section app_scheduler_ring Byte ring storage:
+ *
+ * When APP_SCHED_BYTE_RING is set to 1 in the build environment, the single event queue stores
+ * each event as a header followed by its actual data, rounded up to a word, instead of using a
+ * slot of the maximum event size. A record that does not fit before the end of the buffer is
+ * placed at the start, and the rest of the buffer is skipped. The buffer still holds QUEUE_SIZE
+ * events of EVENT_SIZE, and proportionally more smaller events. QUEUE_SIZE can therefore be set
+ * from the expected amount of pending event data rather than the number of events.
  */
 
 #ifndef APP_SCHEDULER_H__
@@ -51,7 +70,40 @@
 #include <stdint.h>
 #include "app_error.h"
 
+#ifndef APP_SCHED_PROFILE
+#define APP_SCHED_PROFILE           0       /**< Set to 1 to record queue depth, put failures and per-handler latency and run time, see app_sched_profile_get(). */
+#endif
+
+#if (APP_SCHED_PROFILE)
+#define APP_SCHED_EVENT_HEADER_SIZE 12      /**< Size of app_scheduler.event_header_t (only for use inside APP_SCHED_BUF_SIZE()). */
+#else
 #define APP_SCHED_EVENT_HEADER_SIZE 8       /**< Size of app_scheduler.event_header_t (only for use inside APP_SCHED_BUF_SIZE()). */
+#endif
+
+#ifndef APP_SCHED_PRIORITY_LEVELS
+#define APP_SCHED_PRIORITY_LEVELS   1       /**< Number of event priority levels (1 to 4). 1 gives a single event queue shared by all interrupt levels. */
+#endif
+
+#ifndef APP_SCHED_BYTE_RING
+#define APP_SCHED_BYTE_RING         0       /**< Set to 1 to store events in a byte ring sized by their actual data size (single event queue only). */
+#endif
+
+#if (APP_SCHED_BYTE_RING && (APP_SCHED_PRIORITY_LEVELS > 1))
+#error "APP_SCHED_BYTE_RING requires APP_SCHED_PRIORITY_LEVELS to be 1."
+#endif
+
+#ifndef APP_SCHED_STARVATION_LIMIT
+#define APP_SCHED_STARVATION_LIMIT  0       /**< Number of consecutive higher priority events after which a waiting lowest priority event is executed. 0 disables the bound. */
+#endif
+
+#define APP_SCHED_PRIORITY_HIGHEST  0                                   /**< Highest event priority. */
+#define APP_SCHED_PRIORITY_LOWEST   (APP_SCHED_PRIORITY_LEVELS - 1)     /**< Lowest event priority, used by app_sched_event_put(). */
+
+#if (APP_SCHED_PRIORITY_LEVELS > 1)
+#define APP_SCHED_INT_LEVELS        3       /**< Number of interrupt levels from where events may be put (only for use inside APP_SCHED_BUF_SIZE()). */
+#else
+#define APP_SCHED_INT_LEVELS        1       /**< Number of interrupt levels from where events may be put (only for use inside APP_SCHED_BUF_SIZE()). */
+#endif
 
 /**@brief Compute number of bytes required to hold the scheduler buffer.
  *
@@ -61,8 +113,14 @@
  *
  * @return    Required scheduler buffer size (in bytes).
  */
+#if (APP_SCHED_BYTE_RING)
 #define APP_SCHED_BUF_SIZE(EVENT_SIZE, QUEUE_SIZE)                                                 \
-            (((EVENT_SIZE) + APP_SCHED_EVENT_HEADER_SIZE) * ((QUEUE_SIZE) + 1))
+            (((((EVENT_SIZE) + 3) & ~3) + APP_SCHED_EVENT_HEADER_SIZE) * ((QUEUE_SIZE) + 1))
+#else
+#define APP_SCHED_BUF_SIZE(EVENT_SIZE, QUEUE_SIZE)                                                 \
+            (((EVENT_SIZE) + APP_SCHED_EVENT_HEADER_SIZE) * ((QUEUE_SIZE) + 1) *                   \
+             APP_SCHED_PRIORITY_LEVELS * APP_SCHED_INT_LEVELS)
+#endif
             
 /**@brief Scheduler event handler type. */
 typedef void (*app_sched_event_handler_t)(void * p_event_data, uint16_t event_size);
@@ -129,6 +187,78 @@ uint32_t app_sched_event_put(void *                    p_event_data,
                              uint16_t                  event_size,
                              app_sched_event_handler_t handler);
 
+#if (APP_SCHED_PROFILE)
+/**@brief Clock used for time stamping events.
+ *
+ * @details The default is the RTC1 counter, which is only valid while the RTC1 runs. app_timer
+ *          stops and clears RTC1 when no timer is running, so either keep an app_timer timer
+ *          running while profiling (e.g. a repeated timer with a long period), or define this
+ *          macro and APP_SCHED_PROFILE_CLOCK_MASK in the build environment to use another clock,
+ *          e.g. the counter of a free running RTC or TIMER instance.
+ */
+#ifndef APP_SCHED_PROFILE_CLOCK
+#define APP_SCHED_PROFILE_CLOCK()         (NRF_RTC1->COUNTER)
+#endif
+
+#ifndef APP_SCHED_PROFILE_CLOCK_MASK
+#define APP_SCHED_PROFILE_CLOCK_MASK      0x00FFFFFF            /**< Mask for differences between two APP_SCHED_PROFILE_CLOCK() values, the width of the clock counter. */
+#endif
+
+#define APP_SCHED_PROFILE_HANDLERS        8                     /**< Number of event handlers profiled separately. */
+#define APP_SCHED_PROFILE_LATENCY_BUCKETS 8                     /**< Number of buckets in the latency histogram of each handler. */
+
+/**@brief Profiling data of one event handler. */
+typedef struct
+{
+    app_sched_event_handler_t handler;                                              /**< Event handler, NULL if the entry is unused. */
+    uint32_t                  event_count;                                          /**< Number of events executed. */
+    uint32_t                  latency_max;                                          /**< Longest time from event put until the handler was called, in clock ticks. */
+    uint32_t                  run_time_max;                                         /**< Longest time spent in the handler, in clock ticks. */
+    uint16_t                  latency_histogram[APP_SCHED_PROFILE_LATENCY_BUCKETS]; /**< Event counts by latency. Bucket 0 is zero ticks, bucket n is 2^(n-1) to 2^n - 1 ticks, and the last bucket holds all longer latencies. Counts saturate. */
+} app_sched_handler_profile_t;
+
+/**@brief Scheduler profiling data. */
+typedef struct
+{
+    uint32_t                    queue_depth_max;                                    /**< Maximum number of pending events in a queue (bytes of pending event records with APP_SCHED_BYTE_RING). */
+    uint32_t                    put_failures;                                       /**< Number of events rejected because the queue was full. */
+    uint32_t                    untracked_events;                                   /**< Number of events executed after all handler entries were in use. */
+    app_sched_handler_profile_t handlers[APP_SCHED_PROFILE_HANDLERS];               /**< Profiling data by event handler, in order of first execution. */
+} app_sched_profile_t;
+
+/**@brief Function for getting the scheduler profiling data.
+ *
+ * @details The data is collected since initialization or the last call to
+ *          app_sched_profile_reset(), and can e.g. be printed to a console when tuning
+ *          QUEUE_SIZE.
+ *
+ * @return      Pointer to the profiling data.
+ */
+const app_sched_profile_t * app_sched_profile_get(void);
+
+/**@brief Function for clearing the scheduler profiling data. */
+void app_sched_profile_reset(void);
+#endif // APP_SCHED_PROFILE
+
+/**@brief Function for scheduling an event with a given priority.
+ *
+ * @details Puts an event into the event queue of the given priority. When
+ *          APP_SCHED_PRIORITY_LEVELS is 1, the priority is ignored and this is the same as
+ *          app_sched_event_put().
+ *
+ * @param[in]   p_event_data   Pointer to event data to be scheduled.
+ * @param[in]   p_event_size   Size of event data to be scheduled.
+ * @param[in]   handler        Event handler to receive the event.
+ * @param[in]   priority       Event priority, from APP_SCHED_PRIORITY_HIGHEST to
+ *                             APP_SCHED_PRIORITY_LOWEST.
+ *
+ * @return      NRF_SUCCESS on success, otherwise an error code.
+ */
+uint32_t app_sched_event_put_prio(void *                    p_event_data,
+                                  uint16_t                  event_size,
+                                  app_sched_event_handler_t handler,
+                                  uint8_t                   priority);
+
 #endif // APP_SCHEDULER_H__
 
 /** @} */
@@ -34,6 +34,12 @@
  * @details Use the USE_SCHEDULER parameter of the APP_TIMER_INIT() macro to select if the
  *          @ref app_scheduler is to be used or not.
  *
+ * @details Running timers are kept either in a sorted list (@ref APP_TIMER_BACKEND_LIST), where
+ *          starting and stopping a timer is O(n) in the number of running timers, or in a
+ *          hierarchical timing wheel (@ref APP_TIMER_BACKEND_WHEEL), where starting and stopping
+ *          is O(1). The backend is selected at compile time with APP_TIMER_BACKEND, and
+ *          APP_TIMER_INIT() dimensions the buffer for the selected backend.
+ *
  * @note    Even if the scheduler is not used, app_timer.h will include app_scheduler.h, so when
  *          compiling, app_scheduler.h must be available in one of the compiler include paths.
  */
@@ -53,8 +59,24 @@
 #define APP_TIMER_CLOCK_FREQ         32768                      /**< Clock frequency of the RTC timer used to implement the app timer module. */
 #define APP_TIMER_MIN_TIMEOUT_TICKS  5                          /**< Minimum value of the timeout_ticks parameter of app_timer_start(). */
 
-#define APP_TIMER_NODE_SIZE          40                         /**< Size of app_timer.timer_node_t (only for use inside APP_TIMER_BUF_SIZE()). */
-#define APP_TIMER_USER_OP_SIZE       24                         /**< Size of app_timer.timer_user_op_t (only for use inside APP_TIMER_BUF_SIZE()). */
+/**@defgroup APP_TIMER_BACKENDS Running timer storage backends
+ * @{ */
+#define APP_TIMER_BACKEND_LIST       0                          /**< Delta-encoded sorted list. Small, but start and stop are O(n). */
+#define APP_TIMER_BACKEND_WHEEL      1                          /**< Hierarchical timing wheel. Start and stop are O(1), at the cost of 8 extra bytes per timer and 288 bytes of static data. */
+/** @} */
+
+#ifndef APP_TIMER_BACKEND
+/** Running timer storage backend, one of @ref APP_TIMER_BACKENDS. Can be overridden from the
+ *  build environment, e.g. with -DAPP_TIMER_BACKEND=APP_TIMER_BACKEND_WHEEL. */
+#define APP_TIMER_BACKEND            APP_TIMER_BACKEND_LIST
+#endif
+
+#if (APP_TIMER_BACKEND == APP_TIMER_BACKEND_WHEEL)
+#define APP_TIMER_NODE_SIZE          52                         /**< Size of app_timer.timer_node_t (only for use inside APP_TIMER_BUF_SIZE()). */
+#else
+#define APP_TIMER_NODE_SIZE          44                         /**< Size of app_timer.timer_node_t (only for use inside APP_TIMER_BUF_SIZE()). */
+#endif
+#define APP_TIMER_USER_OP_SIZE       28                         /**< Size of app_timer.timer_user_op_t (only for use inside APP_TIMER_BUF_SIZE()). */
 #define APP_TIMER_USER_SIZE          8                          /**< Size of app_timer.timer_user_t (only for use inside APP_TIMER_BUF_SIZE()). */
 #define APP_TIMER_INT_LEVELS         3                          /**< Number of interrupt levels from where timer operations may be initiated (only for use inside APP_TIMER_BUF_SIZE()). */
 
@@ -225,6 +247,36 @@ uint32_t app_timer_create(app_timer_id_t *            p_timer_id,
  */
 uint32_t app_timer_start(app_timer_id_t timer_id, uint32_t timeout_ticks, void * p_context);
 
+/**@brief Function for starting a timer whose expiry may be delayed to save RTC interrupts.
+ *
+ * @details The timer expires at some point between timeout_ticks and timeout_ticks + slack_ticks
+ *          after the start. The RTC interrupt is set up for the earliest latest-allowed expiry of
+ *          all running timers, and every timer that has reached its timeout by then expires in the
+ *          same interrupt. Timers whose windows overlap are thereby grouped on one wakeup.
+ *          Repeating timers keep their nominal period, so the slack does not accumulate.
+ *
+ * @param[in]  timer_id        Id of timer to start.
+ * @param[in]  timeout_ticks   Number of ticks (of RTC1, including prescaling) to timeout event
+ *                             (minimum 5 ticks).
+ * @param[in]  slack_ticks     Number of ticks the timeout event may be delayed (less than
+ *                             timeout_ticks). 0 gives the same behavior as app_timer_start().
+ * @param[in]  p_context       General purpose pointer. Will be passed to the timeout handler when
+ *                             the timer expires.
+ *
+ * @retval     NRF_SUCCESS               Timer was successfully started.
+ * @retval     NRF_ERROR_INVALID_PARAM   Invalid parameter.
+ * @retval     NRF_ERROR_INVALID_STATE   Application timer module has not been initialized, or timer
+ *                                       has not been created.
+ * @retval     NRF_ERROR_NO_MEM          Timer operations queue was full.
+ *
+ * @note When calling this method on a timer which is already running, the second start operation
+ *       will be ignored.
+ */
+uint32_t app_timer_start_with_slack(app_timer_id_t timer_id,
+                                    uint32_t       timeout_ticks,
+                                    uint32_t       slack_ticks,
+                                    void *         p_context);
+
 /**@brief Function for stopping the specified timer.
  *
  * @param[in]  timer_id   Id of timer to stop.
@@ -24,6 +24,19 @@
 
 #include <stdint.h>
 
+/**@defgroup CRC16_ENGINES CRC-16 calculation engines
+ * @{ */
+#define CRC16_ENGINE_COMPACT     0  /**< Bitwise calculation, one byte per iteration. No lookup table. */
+#define CRC16_ENGINE_TABLE       1  /**< One byte per iteration using a 256-entry lookup table (512 bytes of flash). */
+#define CRC16_ENGINE_SLICE_BY_4  2  /**< Four bytes per iteration using four 256-entry lookup tables (2 kB of flash). */
+/** @} */
+
+#ifndef CRC16_ENGINE
+/** CRC-16 calculation engine, one of @ref CRC16_ENGINES. Can be overridden from the build
+ *  environment, e.g. with -DCRC16_ENGINE=CRC16_ENGINE_TABLE. All engines give the same result. */
+#define CRC16_ENGINE CRC16_ENGINE_COMPACT
+#endif
+
 /**@brief Function for calculating CRC-16 in blocks.
  *
  * Feed each consecutive data block into this function, along with the current value of p_crc as 
@@ -38,6 +51,30 @@
  */
 uint16_t crc16_compute(const uint8_t * p_data, uint32_t size, const uint16_t * p_crc);
 
+/**@brief Function for getting the initial value of CRC-16 for a streaming calculation.
+ *
+ * @return The initial CRC-16 value.
+ */
+uint16_t crc16_init(void);
+
+/**@brief Function for updating CRC-16 with the next data block of a streaming calculation.
+ *
+ * @param[in] crc    The CRC-16 value returned by @ref crc16_init or a previous call of this function.
+ * @param[in] p_data The input data block for computation.
+ * @param[in] size   The size of the input data block in bytes.
+ *
+ * @return The updated CRC-16 value.
+ */
+uint16_t crc16_update(uint16_t crc, const uint8_t * p_data, uint32_t size);
+
+/**@brief Function for finishing a streaming CRC-16 calculation.
+ *
+ * @param[in] crc    The CRC-16 value returned by the last call of @ref crc16_update.
+ *
+ * @return The final CRC-16 value, equal to the one returned by @ref crc16_compute for the same data.
+ */
+uint16_t crc16_final(uint16_t crc);
+
 #endif // CRC16_H__
  
 /** @} */
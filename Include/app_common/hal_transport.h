@@ -32,7 +32,8 @@
  * \par Implementation specific behaviour
  * - As Link establishment procedure is not supported following static link configuration parameters
  * are used:
- * + TX window size is 1.
+ * + TX window size is TX_BUF_QUEUE_SIZE of the memory pool (1, 2 or 4, default 1). Acknowledgements are
+ * cumulative and a lost packet is retransmitted together with all packets sent after it.
  * + 16 bit CCITT-CRC must be used.
  * + Out of frame software flow control not supported.
  * + Parameters specific for resending reliable packets are compile time configurable (clarifed 
@@ -70,6 +71,9 @@
  * The following compile time configuration option is available to configure module specific 
  * behaviour:
  * - MAX_RETRY_COUNT Max retransmission retry count for applicaton packets.
+ *
+ * The retransmission timeout is initially derived from the options above, and thereafter adapted 
+ * to the measured round trip time of the application packets.
  */
  
 #ifndef HCI_TRANSPORT_H__
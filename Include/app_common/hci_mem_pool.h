@@ -20,6 +20,8 @@
  *
  * Memory pool implementation, based on circular buffer data structure, which supports asynchronous 
  * processing of RX data. The current default implementation supports 1 TX buffer and 4 RX buffers.
+ * TX buffers are allocated and freed in FIFO order, so several TX packets can be in flight at the 
+ * same time when more than 1 TX buffer is configured.
  * The memory managed by the pool is allocated from static storage instead of heap. The internal 
  * design of the circular buffer implementing the RX memory layout is illustrated in the picture 
  * below. 
@@ -38,6 +40,7 @@
  *
  * The following compile time configuration options are available to suit various implementations:
  * - TX_BUF_SIZE TX buffer size in bytes. 
+ * - TX_BUF_QUEUE_SIZE Number of TX buffers, must be 1, 2 or 4.
  * - RX_BUF_SIZE RX buffer size in bytes. 
  * - RX_BUF_QUEUE_SIZE RX buffer element size.
  */
@@ -76,7 +79,7 @@ uint32_t hci_mem_pool_tx_alloc(void ** pp_buffer);
  *       alloc(...) order, which is the reason for omitting exact memory block identifier as an 
  *       input parameter.
  *
- * @retval NRF_SUCCESS          Operation success. Memory was freed.
+ * @retval NRF_SUCCESS          Operation success. Memory was freed, or no memory was allocated.
  */
 uint32_t hci_mem_pool_tx_free(void);
  
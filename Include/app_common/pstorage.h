@@ -66,6 +66,8 @@
  * @param[in] op_code  Identifies the operation for which the event is notified.
  * @param[in] result   Identifies the result of flash access operation.
  *                     NRF_SUCCESS implies, operation succeeded.
+ *                     NRF_ERROR_TIMEOUT implies, flash could not be accessed and the access is
+ *                     retried; the operation is notified again when it is completed.
  * @param[in] p_data   Identifies the application data pointer. In case of store operation, this 
  *                     points to the resident source of application memory that application can now 
  *                     free or reuse. In case of clear, this is NULL as no application pointer is 
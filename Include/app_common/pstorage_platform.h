@@ -40,6 +40,10 @@
 
 #define PSTORAGE_MAX_BLOCK_SIZE     PSTORAGE_FLASH_PAGE_SIZE                                    /**< Maximum size of block that can be registered with the module. Should be configured based on system requirements. And should be greater than or equal to the minimum size. */
 #define PSTORAGE_CMD_QUEUE_SIZE     10                                                          /**< Maximum number of flash access commands that can be maintained by the module for all applications. Configurable. */
+#define PSTORAGE_WRITE_COMBINE_SIZE 128                                                         /**< Size of the buffer in which queued stores to consecutive addresses within a flash page are combined into a single flash write, 0 to disable. Configurable. */
+
+/* Flash backend. Define PSTORAGE_FLASH_WRITE, PSTORAGE_FLASH_PAGE_ERASE and PSTORAGE_FLASH_PTR here
+ * to run the module on top of a flash driver other than the SoftDevice flash API (see pstorage.c). */
 
 
 /** Abstracts persistently memory block identifier. */
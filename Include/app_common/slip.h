@@ -0,0 +1,142 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/** @file
+ *
+ * @defgroup slip SLIP codec
+ * @{
+ * @ingroup app_common
+ *
+ * @brief SLIP encoder and decoder operating on spans of bytes.
+ *
+ * @details The codec is shared by the SLIP layers of the HCI transport (@ref hci_slip) and of the
+ *          serialization PHY. Instead of processing one byte at a time, the encoder and decoder
+ *          search for the next SLIP END or ESC byte a word at a time and copy the bytes in between
+ *          in bulk.
+ *
+ *          The encoder only encodes the content of a frame. Framing the content with
+ *          @ref SLIP_END bytes is left to the user, as a frame can be built from several spans.
+ *
+ *          The decoder discards bytes until it has received a @ref SLIP_END byte, which
+ *          synchronizes it to the start of a frame. Empty frames are ignored. After a frame has
+ *          been decoded it waits for the next @ref SLIP_END byte again.
+ */
+
+#ifndef SLIP_H__
+#define SLIP_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "compiler_abstraction.h"
+
+#define SLIP_END     0xC0                                   /**< SLIP code for identifying the beginning and end of a packet frame. */
+#define SLIP_ESC     0xDB                                   /**< SLIP escape code. This code is used to specify that the following character is specially encoded. */
+#define SLIP_ESC_END 0xDC                                   /**< SLIP special code. When this code follows 0xDB, this character is interpreted as payload data 0xC0. */
+#define SLIP_ESC_ESC 0xDD                                   /**< SLIP special code. When this code follows 0xDB, this character is interpreted as payload data 0xDB. */
+
+/**@brief SLIP encoder instance. */
+typedef struct
+{
+    const uint8_t * p_data;                                 /**< Span of data being encoded. */
+    uint32_t        length;                                 /**< Length of the span in bytes. */
+    uint32_t        index;                                  /**< Index of the next byte of the span to be encoded. */
+    bool            escape;                                 /**< SLIP escape code has been output, the special code for the byte at index is pending. */
+} slip_encoder_t;
+
+/**@brief SLIP decoder instance. */
+typedef struct
+{
+    uint8_t *       p_buffer;                               /**< Buffer for the decoded frame. */
+    uint32_t        buffer_size;                            /**< Size of the buffer in bytes. */
+    uint32_t        length;                                 /**< Number of decoded bytes stored in the buffer. */
+    bool            escape;                                 /**< SLIP escape code has been received. */
+    bool            synchronized;                           /**< SLIP END byte has been received, bytes are decoded. */
+} slip_decoder_t;
+
+/**@brief Results of decoding a span of received bytes. */
+typedef enum
+{
+    SLIP_DECODE_CONTINUE,                                   /**< All bytes were consumed, no complete frame was received. */
+    SLIP_DECODE_FRAME_END,                                  /**< A frame was received, length bytes are stored in the buffer. The bytes following the SLIP END byte were not consumed. */
+    SLIP_DECODE_BUFFER_FULL                                 /**< The buffer is full. The byte which did not fit and the following bytes were not consumed. */
+} slip_decode_result_t;
+
+/**@brief Function for finding the next SLIP END or ESC byte in a span.
+ *
+ * @param[in] p_data  Pointer to the span.
+ * @param[in] length  Length of the span in bytes.
+ *
+ * @return Index of the first SLIP END or ESC byte, or length if the span contains none.
+ */
+uint32_t slip_special_byte_find(const uint8_t * p_data, uint32_t length);
+
+/**@brief Function for starting to encode a span.
+ *
+ * @param[out] p_encoder  Encoder instance.
+ * @param[in]  p_data     Pointer to the span to encode. Must be kept valid until it is encoded.
+ * @param[in]  length     Length of the span in bytes.
+ */
+void slip_encoder_init(slip_encoder_t * p_encoder, const uint8_t * p_data, uint32_t length);
+
+/**@brief Function for encoding the span of an encoder into an output buffer.
+ *
+ * @details Encodes as many bytes as fit into the output buffer. The function can be called again
+ *          with a new output buffer until @ref slip_encoder_is_done returns true.
+ *
+ * @param[in,out] p_encoder  Encoder instance.
+ * @param[out]    p_output   Output buffer.
+ * @param[in]     size       Size of the output buffer in bytes.
+ *
+ * @return Number of bytes written to the output buffer.
+ */
+uint32_t slip_encode(slip_encoder_t * p_encoder, uint8_t * p_output, uint32_t size);
+
+/**@brief Function for checking if the span of an encoder has been completely encoded.
+ *
+ * @param[in] p_encoder  Encoder instance.
+ *
+ * @return true if the complete span has been encoded.
+ */
+static __INLINE bool slip_encoder_is_done(const slip_encoder_t * p_encoder)
+{
+    return (p_encoder->index == p_encoder->length) && !p_encoder->escape;
+}
+
+/**@brief Function for initializing a decoder.
+ *
+ * @details The decoder discards received bytes until it is synchronized by a SLIP END byte.
+ *
+ * @param[out] p_decoder    Decoder instance.
+ * @param[in]  p_buffer     Buffer for the decoded frame, can be NULL if buffer_size is 0.
+ * @param[in]  buffer_size  Size of the buffer in bytes.
+ */
+void slip_decoder_init(slip_decoder_t * p_decoder, uint8_t * p_buffer, uint32_t buffer_size);
+
+/**@brief Function for decoding a span of received bytes.
+ *
+ * @details Decoding stops after the end of a frame, or when a decoded byte does not fit into the
+ *          buffer. In the latter case the user can continue by providing a bigger buffer, after
+ *          copying the decoded bytes to it, or drop the frame with @ref slip_decoder_init.
+ *
+ * @param[in,out] p_decoder  Decoder instance.
+ * @param[in]     p_data     Pointer to the received bytes.
+ * @param[in,out] p_length   In: number of received bytes. Out: number of bytes consumed.
+ *
+ * @return Result of decoding, see @ref slip_decode_result_t.
+ */
+slip_decode_result_t slip_decode(slip_decoder_t * p_decoder,
+                                 const uint8_t  * p_data,
+                                 uint32_t       * p_length);
+
+#endif // SLIP_H__
+
+/** @} */
@@ -0,0 +1,78 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/** @file
+ *
+ * @defgroup ble_sdk_lib_gatts_router GATT Server Event Router
+ * @{
+ * @ingroup ble_sdk_lib
+ * @brief Module for dispatching GATT Server events to the module owning the attribute handle.
+ *
+ * @details Services register the attribute handles they need events for, normally in their
+ *          init function, once the handles are known. The application then passes all BLE
+ *          events to ble_gatts_router_on_ble_evt(). Write, read/write authorize request and handle
+ *          value confirmation events are passed to the handler registered for the attribute
+ *          handle of the event, found with a binary search, instead of every service comparing the
+ *          handle against each of its own attribute handles.
+ */
+
+#ifndef BLE_GATTS_ROUTER_H__
+#define BLE_GATTS_ROUTER_H__
+
+#include <stdint.h>
+#include "ble.h"
+
+/**@brief Maximum number of attribute handles that can be registered. */
+#ifndef BLE_GATTS_ROUTER_ROUTES_MAX
+#define BLE_GATTS_ROUTER_ROUTES_MAX 16
+#endif
+
+/**@brief GATT Server event handler type.
+ *
+ * @param[in]   p_context   Context given when the attribute handle was registered, e.g. the
+ *                          service instance.
+ * @param[in]   p_ble_evt   BLE_GATTS_EVT_WRITE, BLE_GATTS_EVT_RW_AUTHORIZE_REQUEST or
+ *                          BLE_GATTS_EVT_HVC event for the registered attribute handle.
+ */
+typedef void (*ble_gatts_router_handler_t) (void * p_context, ble_evt_t * p_ble_evt);
+
+/**@brief Function for registering a handler for GATT Server events on an attribute handle.
+ *
+ * @details Registering an attribute handle that is already registered replaces its handler and
+ *          context, so a service can be initialized again.
+ *
+ * @param[in]   handle      Attribute handle, e.g. a characteristic value or CCCD handle.
+ * @param[in]   handler     Function to be called for events on the attribute handle.
+ * @param[in]   p_context   Context passed to the handler.
+ *
+ * @retval      NRF_SUCCESS              Successful registration.
+ * @retval      NRF_ERROR_NULL           Null pointer provided as handler.
+ * @retval      NRF_ERROR_INVALID_PARAM  Invalid attribute handle.
+ * @retval      NRF_ERROR_NO_MEM         @ref BLE_GATTS_ROUTER_ROUTES_MAX handles already
+ *                                       registered.
+ */
+uint32_t ble_gatts_router_register(uint16_t                   handle,
+                                   ble_gatts_router_handler_t handler,
+                                   void *                     p_context);
+
+/**@brief Function for handling the Application's BLE Stack events.
+ *
+ * @details Passes GATT Server events on registered attribute handles to their handler. All other
+ *          events are ignored.
+ *
+ * @param[in]   p_ble_evt   Event received from the BLE stack.
+ */
+void ble_gatts_router_on_ble_evt(ble_evt_t * p_ble_evt);
+
+#endif // BLE_GATTS_ROUTER_H__
+
+/** @} */
@@ -62,7 +62,9 @@ uint32_t ble_cis_init(ble_cis_t * p_cis, const ble_cis_init_t * p_cis_init);
 
 /**@brief Function for handling the Application's BLE Stack events.
  *
- * @details Handles all events from the BLE stack of interest to the Identify Service.
+ * @details Handles all events from the BLE stack of interest to the Identify Service. Writes to the
+ *          LED characteristic are received through ble_gatts_router_on_ble_evt(), which the
+ *          application must also call for each BLE event.
  *
  *
  * @param[in]   p_cis      Identify Service structure.
@@ -239,7 +239,9 @@ uint32_t ble_gls_init(ble_gls_t * p_gls, const ble_gls_init_t * p_gls_init);
 
 /**@brief Function for handling the Application's BLE Stack events.
  *
- * @details Handles all events from the BLE stack of interest to the Glucose Service.
+ * @details Handles all events from the BLE stack of interest to the Glucose Service. Events on the
+ *          Glucose Measurement CCCD and the Record Access Control Point are received through
+ *          ble_gatts_router_on_ble_evt(), which the application must also call for each BLE event.
  *
  * @param[in]   p_gls      Glucose Service structure.
  * @param[in]   p_ble_evt  Event received from the BLE stack.
@@ -165,6 +165,7 @@ typedef struct
 {
     ble_gatts_char_handles_t      char_handles;     /**< Handles related to the Report characteristic. */
     uint16_t                      ref_handle;       /**< Handle of the Report Reference descriptor. */
+    ble_hids_t *                  p_hids;           /**< Service the report belongs to, set by ble_hids_init() for routing GATT Server events. */
 } ble_hids_rep_char_t;
 
 /**@brief HID Service init structure. This contains all options and data needed for initialization 
@@ -228,7 +229,11 @@ uint32_t ble_hids_init(ble_hids_t * p_hids, const ble_hids_init_t * p_hids_init)
 
 /**@brief Function for handling the Application's BLE Stack events.
  *
- * @details Handles all events from the BLE stack of interest to the HID Service.
+ * @details Handles all events from the BLE stack of interest to the HID Service. Writes and read
+ *          authorize requests on the service's characteristics are received through
+ *          ble_gatts_router_on_ble_evt(), which the application must also call for each BLE event.
+ *          The service registers up to 6 attribute handles, plus 2 per Input Report and 1 per
+ *          Output or Feature Report, with the router (see @ref BLE_GATTS_ROUTER_ROUTES_MAX).
  *
  * @param[in]   p_hids     HID Service structure.
  * @param[in]   p_ble_evt  Event received from the BLE stack.
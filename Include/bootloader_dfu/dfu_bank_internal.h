@@ -49,6 +49,10 @@ typedef enum
 #define IMAGE_WRITE_IN_PROGRESS()   (m_data_received > 0)                           /**< Macro for determining is image write in progress. */
 #define IS_WORD_SIZED(SIZE)         ((SIZE & (sizeof(uint32_t) - 1)) == 0)          /**< Macro for checking that the provided is word sized. */
 
+#ifndef DFU_POST_WRITE_VERIFY
+#define DFU_POST_WRITE_VERIFY       1                                               /**< Set to 1 to calculate CRC of the flash content as each data packet store completes and check it against the CRC of the received data before activation. */
+#endif
+
 static uint32_t                     m_data_received;                                /**< Amount of received data. */
 
 /**@brief     Type definition of function used for preparing of the bank before receiving of a
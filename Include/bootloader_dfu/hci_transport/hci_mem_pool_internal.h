@@ -25,6 +25,7 @@
 #define TX_BUF_SIZE       32u    /**< TX buffer size in bytes. */
 #define RX_BUF_SIZE       600u   /**< RX buffer size in bytes. */
 
+#define TX_BUF_QUEUE_SIZE 1u     /**< Number of TX buffers, i.e. of application packets which can be in flight (1, 2 or 4). */
 #define RX_BUF_QUEUE_SIZE 2u     /**< RX buffer element size. */
  
 #endif // MEM_POOL_INTERNAL_H__
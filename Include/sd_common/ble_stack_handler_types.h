@@ -34,9 +34,48 @@
 #define BLE_STACK_EVT_MSG_BUF_SIZE       (sizeof(ble_evt_t) + (GATT_MTU_SIZE_DEFAULT))     /**< Size of BLE event message buffer. This will be provided to the SoftDevice while fetching an event. */
 #define BLE_STACK_HANDLER_SCHED_EVT_SIZE 0                                                 /**< The size of the scheduler event used by SoftDevice handler when passing BLE events using the @ref app_scheduler. */
 
+/**@brief Maximum number of BLE events fetched from the SoftDevice before they are dispatched.
+ *
+ * @details When larger than 1, the SoftDevice handler drains up to this many BLE events into
+ *          separate buffers and then dispatches them in one pass, either to the batch handler
+ *          registered with softdevice_ble_evt_batch_handler_set(), or one by one to the handler
+ *          registered with softdevice_ble_evt_handler_set().
+ */
+#ifndef BLE_STACK_EVT_BATCH_SIZE
+#define BLE_STACK_EVT_BATCH_SIZE         1
+#endif
+
+/**@brief Maximum number of handlers in the BLE event registry.
+ *
+ * @details Handlers registered with softdevice_ble_evt_handler_register() only receive the event
+ *          they were registered for. Set to 0 to leave out the registry.
+ */
+#ifndef BLE_STACK_EVT_HANDLERS_MAX
+#define BLE_STACK_EVT_HANDLERS_MAX       0
+#endif
+
+#define BLE_STACK_EVT_BUF_SIZE           (CEIL_DIV(BLE_STACK_EVT_MSG_BUF_SIZE, sizeof(uint32_t)) * \
+                                          sizeof(uint32_t) * BLE_STACK_EVT_BATCH_SIZE)     /**< Size of the buffer holding one batch of BLE events. Each event buffer is word aligned. */
+
 /**@brief Application stack event handler type. */
 typedef void (*ble_evt_handler_t) (ble_evt_t * p_ble_evt);
 
+/**@brief Application stack event batch handler type.
+ *
+ * @param[in] pp_ble_evts  Events in the order they were fetched from the SoftDevice. The events are
+ *                         only valid until the handler returns.
+ * @param[in] evt_count    Number of events in the batch, at least 1 and at most
+ *                         @ref BLE_STACK_EVT_BATCH_SIZE.
+ */
+typedef void (*ble_evt_batch_handler_t) (ble_evt_t * const * pp_ble_evts, uint8_t evt_count);
+
+/**@brief BLE event registry handler type.
+ *
+ * @param[in] p_context  Context given when the handler was registered, e.g. the service instance.
+ * @param[in] p_ble_evt  Event with the event id the handler was registered for.
+ */
+typedef void (*ble_evt_registry_handler_t) (void * p_context, ble_evt_t * p_ble_evt);
+
 /**@brief     Function for registering for BLE events.
  *
  * @details   The application should use this function to register for receiving BLE events from
@@ -53,10 +92,49 @@ typedef void (*ble_evt_handler_t) (ble_evt_t * p_ble_evt);
  */
 uint32_t softdevice_ble_evt_handler_set(ble_evt_handler_t ble_evt_handler);
 
+/**@brief     Function for registering for batches of BLE events.
+ *
+ * @details   Once registered, the batch handler is called instead of the handler registered with
+ *            softdevice_ble_evt_handler_set(), with all events fetched in one pass. This lets the
+ *            application handle related events together, e.g. all BLE_EVT_TX_COMPLETE events in a
+ *            batch with one response. Batches hold at most @ref BLE_STACK_EVT_BATCH_SIZE events.
+ *            After the batch handler returns, each event of the batch is passed to the handlers
+ *            registered for its id with softdevice_ble_evt_handler_register().
+ *
+ * @param[in] ble_evt_batch_handler Function to be called for each batch of received BLE events.
+ *
+ * @retval    NRF_SUCCESS              Successful registration.
+ * @retval    NRF_ERROR_NULL           Null pointer provided as input.
+ * @retval    NRF_ERROR_NOT_SUPPORTED  @ref BLE_STACK_EVT_BATCH_SIZE is 1.
+ */
+uint32_t softdevice_ble_evt_batch_handler_set(ble_evt_batch_handler_t ble_evt_batch_handler);
+
+/**@brief     Function for registering a handler for one BLE event id.
+ *
+ * @details   The registry is kept sorted by event id, so each received event is passed only to the
+ *            handlers registered for its id, found with a binary search. Handlers registered for
+ *            the same id are called in the order they were registered, after the handler
+ *            registered with softdevice_ble_evt_handler_set() or the batch handler registered with
+ *            softdevice_ble_evt_batch_handler_set() (if any). A module interested in
+ *            several events registers once per event id, normally during initialization.
+ *
+ * @param[in] evt_id     BLE event id, e.g. BLE_GAP_EVT_CONNECTED.
+ * @param[in] handler    Function to be called for each received event with the given id.
+ * @param[in] p_context  Context passed to the handler.
+ *
+ * @retval    NRF_SUCCESS              Successful registration.
+ * @retval    NRF_ERROR_NULL           Null pointer provided as handler.
+ * @retval    NRF_ERROR_NO_MEM         @ref BLE_STACK_EVT_HANDLERS_MAX handlers already registered.
+ */
+uint32_t softdevice_ble_evt_handler_register(uint16_t                   evt_id,
+                                             ble_evt_registry_handler_t handler,
+                                             void *                     p_context);
+
 #else
 
 #define BLE_STACK_EVT_MSG_BUF_SIZE        0                                                /**< Since the BLE stack support is not required, this is equated to 0, so that the @ref softdevice_handler.h can compute the internal event buffer size without having to care for BLE events.*/
 #define BLE_STACK_HANDLER_SCHED_EVT_SIZE  0
+#define BLE_STACK_EVT_BUF_SIZE            0                                                /**< Since the BLE stack support is not required, no BLE event batch buffer is needed. */
 
 #endif // BLE_STACK_SUPPORT_REQD
 
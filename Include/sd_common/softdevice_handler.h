@@ -72,7 +72,7 @@ typedef void (*sys_evt_handler_t) (uint32_t evt_id);
     do                                                                                             \
     {                                                                                              \
         static uint32_t EVT_BUFFER[CEIL_DIV(MAX(                                                   \
-                                                MAX(BLE_STACK_EVT_MSG_BUF_SIZE,                    \
+                                                MAX(BLE_STACK_EVT_BUF_SIZE,                        \
                                                     ANT_STACK_EVT_STRUCT_SIZE),                    \
                                                 SYS_EVT_MSG_BUF_SIZE                               \
                                                ),                                                  \
@@ -101,7 +101,9 @@ typedef void (*sys_evt_handler_t) (uint32_t evt_id);
  *                                 buffer must be large enough to hold the biggest stack event the
  *                                 application is supposed to handle. The buffer must be aligned to
  *                                 a 4 byte boundary. This parameter is unused if neither BLE nor
- *                                 ANT stack support is required.
+ *                                 ANT stack support is required. If @ref BLE_STACK_EVT_BATCH_SIZE
+ *                                 is larger than 1, the buffer is split into that many equally
+ *                                 sized, word aligned BLE event buffers.
  * @param[in]  evt_buffer_size     Size of SoftDevice event buffer. This parameter is unused if
  *                                 BLE stack support is not required.
  * @param[in]  evt_schedule_func   Function for passing events to the scheduler. Point to
@@ -156,7 +158,7 @@ static __INLINE void softdevice_evt_get(void * p_event_data, uint16_t event_size
 
 static __INLINE uint32_t softdevice_evt_schedule(void)
 {
-    return app_sched_event_put(NULL, 0, softdevice_evt_get);
+    return app_sched_event_put_prio(NULL, 0, softdevice_evt_get, APP_SCHED_PRIORITY_HIGHEST);
 }
 /**@endcond */
 
@@ -0,0 +1,82 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#ifndef CONN_MW_STATS_APP_H__
+#define CONN_MW_STATS_APP_H__
+
+/**@file
+ *
+ * @defgroup conn_mw_stats_app Connectivity middleware statistics command request encoder and command response decoder
+ * @{
+ * @ingroup  ser_app_common_codecs
+ *
+ * @brief   Connectivity middleware statistics command request encoder and command response decoder.
+ */
+
+#include <stdint.h>
+#include "ble_serialization.h"
+
+/**@brief Encodes @ref SER_CONN_MW_STATS_GET_OP_CODE command request.
+ *
+ * @sa @ref conn_mw_stats_get_rsp_dec for command response decoder.
+ *
+ * @param[in] opcode                Opcode which statistics are requested.
+ * @param[in] p_buf                 Pointer to buffer where encoded data command will be returned.
+ * @param[in,out] p_buf_len         \c in: Size of \p p_buf buffer.
+ *                                  \c out: Length of encoded command packet.
+ *
+ * @retval NRF_SUCCESS                Encoding success.
+ * @retval NRF_ERROR_NULL             Encoding failure. NULL pointer supplied.
+ * @retval NRF_ERROR_INVALID_LENGTH   Encoding failure. Incorrect buffer length.
+ */
+uint32_t conn_mw_stats_get_req_enc(uint8_t          opcode,
+                                   uint8_t * const  p_buf,
+                                   uint32_t * const p_buf_len);
+
+
+/**@brief Decodes response to @ref SER_CONN_MW_STATS_GET_OP_CODE command.
+ *
+ * @sa @ref conn_mw_stats_get_req_enc for command request encoder.
+ *
+ * @param[in] p_buf             Pointer to beginning of command response packet.
+ * @param[in] packet_len        Length (in bytes) of response packet.
+ * @param[out] p_stats          Pointer to statistics of the requested opcode.
+ * @param[out] p_result_code    Command result code.
+ *
+ * @retval NRF_SUCCESS               Decoding success.
+ * @retval NRF_ERROR_NULL            Decoding failure. NULL pointer supplied.
+ * @retval NRF_ERROR_INVALID_LENGTH  Decoding failure. Incorrect buffer length.
+ * @retval NRF_ERROR_INVALID_DATA    Decoding failure. Decoded operation code does not match
+ *                                   expected operation code.
+ */
+uint32_t conn_mw_stats_get_rsp_dec(uint8_t const * const       p_buf,
+                                   uint32_t                    packet_len,
+                                   ser_conn_mw_stats_t * const p_stats,
+                                   uint32_t * const            p_result_code);
+
+
+/**@brief Function for reading connectivity middleware statistics of a given opcode.
+ *
+ * @note Connectivity chip has to be built with SER_CONN_MW_STATS_ENABLED set, otherwise the
+ *       command is not supported.
+ *
+ * @param[in]  opcode     Opcode (SoftDevice SVC number) which statistics are requested.
+ * @param[out] p_stats    Pointer to structure where statistics will be stored.
+ *
+ * @retval NRF_SUCCESS              Statistics read.
+ * @retval NRF_ERROR_NULL           NULL pointer supplied.
+ * @retval NRF_ERROR_NOT_SUPPORTED  Statistics are disabled on the connectivity chip.
+ */
+uint32_t ser_conn_mw_stats_get(uint8_t opcode, ser_conn_mw_stats_t * const p_stats);
+
+/** @} */
+#endif // CONN_MW_STATS_APP_H__
@@ -29,6 +29,11 @@
  *          type field of incoming packets is handled in this layer - responses are handled by
  *          ser_sd_transport (using response decoder handler provided for each SoftDevice call) but
  *          events are forwarded to the user so it is user's responsibility to free RX buffer.
+ *          Optionally, a burst of commands can be sent in pipelined mode in which the caller does
+ *          not wait for each response - responses are matched to commands by sequence number and
+ *          reported through a completion handler. Commands can also be collected in batch mode
+ *          and sent in a single batch packet to which the connectivity chip replies with one
+ *          aggregated response.
  *
  */
 #ifndef SER_SD_TRANSPORT_H_
@@ -44,6 +49,14 @@ typedef void (*ser_sd_transport_rx_notification_handler_t)(void);
 
 typedef uint32_t (*ser_sd_transport_rsp_handler_t)(const uint8_t * p_buffer, uint16_t length);
 
+/**@brief Handler called in serial peripheral interrupt context when response to a command sent in
+ *        pipelined mode has been decoded.
+ *
+ * @param[in] seq       Sequence number of the command (see @ref ser_sd_transport_next_seq_get).
+ * @param[in] result    SoftDevice call return value decoded from the response.
+ */
+typedef void (*ser_sd_transport_cmd_cmpl_handler_t)(uint8_t seq, uint32_t result);
+
 /**@brief Function for opening the module.
  *
  * @note 'Wait for response' and 'Response set' callbacks can be set in RTOS environment.
@@ -98,7 +111,13 @@ uint32_t ser_sd_transport_close(void);
  * @param[out] pp_data       Pointer to data pointer to be set to point to allocated buffer.
  * @param[out] p_len         Pointer to allocated buffer length.
  *
+ * @note In batch mode a part of the batch packet is given and the collected commands can be sent
+ *       (blocking task context) first to make room for the next one.
+ *
  * @retval NRF_SUCCESS          Operation success.
+ * @retval NRF_ERROR_BUSY       Operation failure. Module is waiting for response (in pipelined
+ *                              mode: maximum number of commands is waiting for response).
+ * @retval NRF_ERROR_NO_MEM     Operation failure. No TX buffer available in HAL Transport layer.
  */
 uint32_t ser_sd_transport_tx_alloc(uint8_t * * pp_data, uint16_t * p_len);
 
@@ -106,6 +125,7 @@ uint32_t ser_sd_transport_tx_alloc(uint8_t * * pp_data, uint16_t * p_len);
 /**@brief Function for freeing tx packet.
  *
  * @note Function should be called once command is processed.
+ * @note In batch mode function has no effect as the batch packet is released when it is sent.
  *
  * @param[out] p_data       Pointer to allocated tx buffer.
  *
@@ -132,9 +152,100 @@ uint32_t ser_sd_transport_rx_free(uint8_t * p_data);
  */
 bool ser_sd_transport_is_busy(void);
 
+/**@brief Function for entering pipelined mode.
+ *
+ * @details In pipelined mode @ref ser_sd_transport_cmd_write returns as soon as the command is
+ *          passed to the HAL Transport layer, so up to @ref SER_SD_TRANSPORT_MAX_PENDING_CMDS
+ *          commands (e.g. sd_ble_gap_adv_data_set, sd_ble_gap_adv_start, sd_ble_gap_ppcp_set) can
+ *          be sent back to back and wait for their responses at the same time. SoftDevice call
+ *          wrappers return NRF_SUCCESS in this mode; the actual return values are passed to the
+ *          completion handler and the first failure is returned by
+ *          @ref ser_sd_transport_pipeline_end.
+ *
+ * @note At most one command with output parameters may be waiting for its response per API
+ *       group (ble, ble_gap, ble_gattc, ble_gatts, ble_l2cap, nrf_soc). The output parameters of
+ *       all SoftDevice call wrappers of a group are stored in one static location until the
+ *       response is decoded, so e.g. sd_ble_gap_device_name_get and sd_ble_gap_ppcp_get must not
+ *       be in the same pipeline, while sd_ble_gap_ppcp_get and sd_ble_uuid_vs_add can be.
+ *
+ * @param[in] cmd_cmpl_handler  Handler to be called for every response received in pipelined mode.
+ *                              Can be NULL.
+ *
+ * @retval NRF_SUCCESS              Operation success.
+ * @retval NRF_ERROR_INVALID_STATE  Operation failure. Module already works in pipelined mode or it
+ *                                  is waiting for response.
+ */
+uint32_t ser_sd_transport_pipeline_begin(ser_sd_transport_cmd_cmpl_handler_t cmd_cmpl_handler);
+
+/**@brief Function for leaving pipelined mode.
+ *
+ * @note Function blocks task context until responses to all commands sent in pipelined mode are
+ *       received and processed.
+ *
+ * @retval NRF_SUCCESS              Operation success. All commands returned NRF_SUCCESS.
+ * @retval NRF_ERROR_INVALID_STATE  Operation failure. Module does not work in pipelined mode.
+ * @return First error code returned by SoftDevice for commands sent in pipelined mode.
+ */
+uint32_t ser_sd_transport_pipeline_end(void);
+
+/**@brief Function for getting sequence number which will be given to the next command.
+ *
+ * @details Every command with a response gets the next sequence number, whether it is sent
+ *          normally, in pipelined mode or in batch mode. Sequence number is passed to the
+ *          completion handler so it can be used to identify which command a response belongs to.
+ *
+ * @return Sequence number of the next command.
+ */
+uint8_t ser_sd_transport_next_seq_get(void);
+
+/**@brief Function for entering batch mode.
+ *
+ * @details In batch mode commands are not sent one by one - @ref ser_sd_transport_tx_alloc gives
+ *          space in a shared batch packet and @ref ser_sd_transport_cmd_write only appends the
+ *          encoded command to it. The batch packet is sent when it is full (see
+ *          @ref SER_SD_TRANSPORT_MAX_BATCH_CMDS and @ref SER_SD_TRANSPORT_BATCH_FLUSH_THRESHOLD)
+ *          or when @ref ser_sd_transport_batch_end is called, and the connectivity chip executes
+ *          all its commands before replying with one response packet. It is intended for bursts of
+ *          setup calls without output parameters, e.g. sd_ble_gap_device_name_set,
+ *          sd_ble_gap_appearance_set, sd_ble_gap_ppcp_set, sd_ble_gap_adv_data_set and
+ *          sd_ble_gap_adv_start issued when GAP and advertising are initialized. SoftDevice call
+ *          wrappers return NRF_SUCCESS in this mode; the actual return values are passed to the
+ *          completion handler (with the sequence number, see @ref ser_sd_transport_next_seq_get)
+ *          and the first failure is returned by @ref ser_sd_transport_batch_end.
+ *
+ * @note Output parameters of a SoftDevice call wrapper are stored in a single static location per
+ *       API group until the response is decoded, and they are not available to later commands of
+ *       the same batch. So a batch can contain at most one command with output parameters
+ *       (e.g. sd_ble_gatts_characteristic_add or sd_ble_gap_address_get) and no command may use
+ *       its output - sd_ble_gatts_service_add and the sd_ble_gatts_characteristic_add calls which
+ *       need the service handle can not be batched together. Responses must not be longer than
+ *       @ref SER_BATCH_RSP_MAX_SIZE.
+ *
+ * @param[in] cmd_cmpl_handler  Handler to be called for every command in batch mode. Can be NULL.
+ *
+ * @retval NRF_SUCCESS              Operation success.
+ * @retval NRF_ERROR_INVALID_STATE  Operation failure. Module already works in batch or pipelined
+ *                                  mode or it is waiting for response.
+ */
+uint32_t ser_sd_transport_batch_begin(ser_sd_transport_cmd_cmpl_handler_t cmd_cmpl_handler);
+
+/**@brief Function for sending the collected commands and leaving batch mode.
+ *
+ * @note Function blocks task context until the batch response is received and processed.
+ *
+ * @retval NRF_SUCCESS              Operation success. All commands returned NRF_SUCCESS.
+ * @retval NRF_ERROR_INVALID_STATE  Operation failure. Module does not work in batch mode.
+ * @retval NRF_ERROR_DATA_SIZE      Operation failure. The connectivity chip had no room for a
+ *                                  response to a command and did not execute it.
+ * @return First error code returned by SoftDevice for commands sent in batch mode.
+ */
+uint32_t ser_sd_transport_batch_end(void);
+
 /**@brief Function for handling SoftDevice command.
  *
- * @note Function blocks task context until response is received and processed.
+ * @note Function blocks task context until response is received and processed unless module
+ *       works in pipelined mode (see @ref ser_sd_transport_pipeline_begin) or in batch mode (see
+ *       @ref ser_sd_transport_batch_begin).
  * @note Non-blocking functionality can be achieved using os handlers or 'One Time' handler
  * @warning Function shouldn't be called from interrupt context which would block switching to
  *          serial port interrupt.
@@ -26,6 +26,7 @@ typedef enum
     SER_PKT_TYPE_EVT,         /**< Event packet type. */
     SER_PKT_TYPE_DTM_CMD,     /**< DTM Command packet type. */
     SER_PKT_TYPE_DTM_RESP,    /**< DTM Response packet type. */
+    SER_PKT_TYPE_BATCH,       /**< Batch packet type - several commands or their responses. */
     SER_PKT_TYPE_MAX          /**< Upper bound. */
 } ser_pkt_type_t;
 
@@ -60,6 +61,9 @@ typedef enum
 /** Position of the Command Response code. */
 #define SER_CMD_RSP_STATUS_CODE_POS    (SER_OP_CODE_SIZE)
 
+/** Size of the length field preceding every command or response in a Batch packet. */
+#define SER_BATCH_ITEM_LEN_SIZE        2
+
 /** Size of event ID field. */
 #define SER_EVT_ID_SIZE                2
 /** Position of event ID field. */
@@ -79,6 +83,17 @@ typedef enum
 /** Position of the status field in the DTM command response buffer.*/
 #define SER_DTM_RESP_STATUS_POS        2
 
+/** Op Code of the command reading connectivity middleware statistics. It is placed outside of the
+ *  range of SoftDevice SVC numbers. */
+#define SER_CONN_MW_STATS_GET_OP_CODE  0xFF
+
+/**@brief Connectivity middleware statistics of a single opcode. */
+typedef struct
+{
+    uint32_t call_count; /**< Number of handler calls. */
+    uint32_t ticks;      /**< Total handler execution time in SER_CONN_MW_STATS_TIMESTAMP_GET units. */
+} ser_conn_mw_stats_t;
+
 /** Value to indicate that an optional field is encoded in the serialized packet, e.g. white list.*/
 #define SER_FIELD_PRESENT              0x01
 /** Value to indicate that an optional field is not encoded in the serialized packet. */
@@ -0,0 +1,134 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#ifndef FIELD_DESC_SERIALIZATION_H__
+#define FIELD_DESC_SERIALIZATION_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**@brief Types of fields in a structure descriptor. */
+typedef enum
+{
+    SER_FIELD_TYPE_UINT8 = 0,   /**< 8-bit integer. */
+    SER_FIELD_TYPE_UINT16,      /**< 16-bit integer, encoded little endian. */
+    SER_FIELD_TYPE_UINT32,      /**< 32-bit integer, encoded little endian. */
+    SER_FIELD_TYPE_STRUCT,      /**< Embedded structure, encoded according to its own descriptor. */
+    SER_FIELD_TYPE_COND_STRUCT, /**< Pointer to a structure, encoded as presence flag followed by the structure if the pointer is not NULL. */
+    SER_FIELD_TYPE_LEN16_ARRAY  /**< Byte array at the end of the structure, encoded as its 16-bit length followed by the bytes. */
+} ser_field_type_t;
+
+typedef struct ser_struct_desc_s ser_struct_desc_t;
+
+/**@brief Descriptor of a single structure field. */
+typedef struct
+{
+    uint8_t                   type;         /**< Field type, see @ref ser_field_type_t. */
+    uint8_t                   len_offset;   /**< Offset of the uint16_t length of a @ref SER_FIELD_TYPE_LEN16_ARRAY field, at most 255. */
+    uint16_t                  offset;       /**< Offset of the field in the structure. */
+    ser_struct_desc_t const * p_desc;       /**< Descriptor of an embedded or conditional structure. */
+} ser_field_desc_t;
+
+/**@brief Descriptor of a structure - fields listed in the encoding order.
+ *
+ * @details The fixed length fields at the start of the structure are encoded and decoded with a
+ *          single buffer length check. Integers and embedded structures whose fields all have fixed
+ *          length are fixed length fields.
+ */
+struct ser_struct_desc_s
+{
+    ser_field_desc_t const * p_fields;      /**< Field descriptors. */
+    uint16_t                 field_count;   /**< Number of field descriptors. */
+    uint16_t                 struct_size;   /**< Size of the structure, up to the byte array if there is one. */
+    uint16_t                 fixed_count;   /**< Number of fixed length fields at the start of the structure. */
+    uint16_t                 fixed_len;     /**< Encoded length of the fixed length fields at the start of the structure. */
+};
+
+/**@brief Macros for defining field descriptors of structure type @p type. */
+#define SER_FIELD_UINT8(type, member)   {SER_FIELD_TYPE_UINT8,  0, offsetof(type, member), NULL}
+#define SER_FIELD_UINT16(type, member)  {SER_FIELD_TYPE_UINT16, 0, offsetof(type, member), NULL}
+#define SER_FIELD_UINT32(type, member)  {SER_FIELD_TYPE_UINT32, 0, offsetof(type, member), NULL}
+#define SER_FIELD_STRUCT(type, member, desc)                                                       \
+    {SER_FIELD_TYPE_STRUCT, 0, offsetof(type, member), &(desc)}
+#define SER_FIELD_COND_STRUCT(type, member, desc)                                                  \
+    {SER_FIELD_TYPE_COND_STRUCT, 0, offsetof(type, member), &(desc)}
+
+/**@brief Macro for defining a byte array field descriptor. The offset of len_member must not exceed
+ *        255, check it with STATIC_ASSERT next to the descriptor.
+ */
+#define SER_FIELD_LEN16_ARRAY(type, member, len_member)                                            \
+    {SER_FIELD_TYPE_LEN16_ARRAY, offsetof(type, len_member), offsetof(type, member), NULL}
+
+/**@brief Macro for defining a structure descriptor from an array of field descriptors.
+ *
+ * @param[in] fields       Array of field descriptors.
+ * @param[in] struct_size  Size of the structure, up to the byte array if there is one.
+ * @param[in] fixed_count  Number of fixed length fields at the start of the structure.
+ * @param[in] fixed_len    Encoded length of these fields: 1, 2 or 4 bytes per integer and the
+ *                         encoded length of every embedded structure.
+ */
+#define SER_STRUCT_DESC(fields, struct_size, fixed_count, fixed_len)                               \
+    {(fields), sizeof (fields) / sizeof ((fields)[0]), (struct_size), (fixed_count), (fixed_len)}
+
+/**@brief Descriptor of a single uint16_t, e.g. target of a conditional pointer field. */
+extern ser_struct_desc_t const ser_uint16_desc;
+
+/**@brief Function for encoding a structure according to its descriptor.
+ *
+ * @details The fixed length fields at the start of the structure are encoded with a single buffer
+ *          length check. Byte array is allowed only as the last field of the top level descriptor.
+ *
+ * @param[in]      p_desc           Structure descriptor.
+ * @param[in]      p_struct         Pointer to the structure.
+ * @param[in]      p_buf            Pointer to the beginning of the output buffer.
+ * @param[in]      buf_len          Size of buffer.
+ * @param[in,out]  p_index          \c in: Index to start of the structure in buffer.
+ *                                  \c out: Index in buffer to first byte after the encoded data.
+ *
+ * @return NRF_SUCCESS              Structure encoded successfully.
+ * @retval NRF_ERROR_INVALID_LENGTH Encoding failure. Incorrect buffer length.
+ */
+uint32_t ser_struct_enc(ser_struct_desc_t const * const p_desc,
+                        void const * const              p_struct,
+                        uint8_t * const                 p_buf,
+                        uint32_t                        buf_len,
+                        uint32_t * const                p_index);
+
+/**@brief Function for decoding a structure according to its descriptor.
+ *
+ * @details The fixed length fields at the start of the structure are decoded with a single buffer
+ *          length check. If p_struct is NULL, the structure is skipped and only its size is
+ *          calculated.
+ *
+ * @param[in]      p_desc           Structure descriptor.
+ * @param[in]      p_buf            Pointer to the beginning of the input buffer.
+ * @param[in]      buf_len          Size of buffer.
+ * @param[in,out]  p_index          \c in: Index to start of the structure in buffer.
+ *                                  \c out: Index in buffer to first byte after the decoded data.
+ * @param[in,out]  p_struct_len     \c in: Size of the memory available for the structure.
+ *                                  \c out: Size of the decoded structure including the byte array.
+ *                                  Can be NULL if the structure has no byte array.
+ * @param[out]     p_struct         Pointer to the structure, or NULL.
+ *
+ * @return NRF_SUCCESS              Structure decoded successfully.
+ * @retval NRF_ERROR_INVALID_LENGTH Decoding failure. Incorrect buffer or structure length.
+ * @retval NRF_ERROR_NULL           Decoding failure. Conditional field present but no memory for it.
+ * @retval NRF_ERROR_INVALID_DATA   Decoding failure. Invalid presence flag.
+ */
+uint32_t ser_struct_dec(ser_struct_desc_t const * const p_desc,
+                        uint8_t const * const           p_buf,
+                        uint32_t                        buf_len,
+                        uint32_t * const                p_index,
+                        uint32_t * const                p_struct_len,
+                        void * const                    p_struct);
+
+#endif // FIELD_DESC_SERIALIZATION_H__
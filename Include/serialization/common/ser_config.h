@@ -53,6 +53,58 @@
     #define SER_HAL_TRANSPORT_RX_MAX_PKT_SIZE         SER_HAL_TRANSPORT_CONN_TO_APP_MAX_PKT_SIZE
 #endif /* SER_CONNECTIVITY */
 
+/** Number of TX and RX packet buffers in serialization HAL Transport layer. With more than one TX
+ *  buffer the next packet can be encoded while the previous one is still being transmitted. The
+ *  number of TX buffers must be a power of two. */
+#define SER_HAL_TRANSPORT_TX_PKT_COUNT                2
+#define SER_HAL_TRANSPORT_RX_PKT_COUNT                2
+
+
+/***********************************************************************************************//**
+ * SoftDevice Transport layer configuration.
+ **************************************************************************************************/
+
+/** Max number of commands which can wait for a response at the same time when SoftDevice Transport
+ *  works in pipelined mode (see @ref ser_sd_transport_pipeline_begin). Must be a power of 2. */
+#define SER_SD_TRANSPORT_MAX_PENDING_CMDS    (uint32_t)(4)
+
+/** Max number of commands which can be sent in a single batch packet (see
+ *  @ref ser_sd_transport_batch_begin). */
+#define SER_SD_TRANSPORT_MAX_BATCH_CMDS      16
+
+/** Max length of a response to a command sent in a batch packet. The connectivity chip executes a
+ *  command from a batch only if at least this many bytes are left for its response, and the
+ *  application chip puts in one batch only as many commands as the batch response can hold. */
+#define SER_BATCH_RSP_MAX_SIZE               (uint16_t)(32)
+
+/** Batch packet is sent before the next command is encoded if fewer bytes than this are left in
+ *  it. Commands longer than this value should not be issued in batch mode. */
+#define SER_SD_TRANSPORT_BATCH_FLUSH_THRESHOLD  (uint16_t)(96)
+
+/** Set to 1 to pass received event packets to sd_ble_evt_get without an intermediate copy. The
+ *  event mailbox then holds references to RX buffers of HAL Transport layer and an event is decoded
+ *  directly to the buffer provided to sd_ble_evt_get, which frees the RX buffer. One RX buffer is
+ *  always left for a command response: when the others are held by waiting events, further events
+ *  are decoded to a copy as with this option disabled. Requires @ref SER_HAL_TRANSPORT_RX_PKT_COUNT
+ *  to be at least 2. */
+#define SER_SD_EVT_ZERO_COPY                 0
+
+
+/***********************************************************************************************//**
+ * Connectivity middleware configuration.
+ **************************************************************************************************/
+
+/** Set to 1 to count calls and execution time of every connectivity middleware handler. The
+ *  statistics can be read by the application chip (see ser_conn_mw_stats_get). */
+#define SER_CONN_MW_STATS_ENABLED            0
+
+/** Time source for connectivity middleware statistics - RTC1 ticks by default. Can be replaced by
+ *  a cycle counter on cores which provide one. */
+#define SER_CONN_MW_STATS_TIMESTAMP_GET()    (NRF_RTC1->COUNTER)
+
+/** Mask applied to a difference of two timestamps (RTC counter is 24 bits wide). */
+#define SER_CONN_MW_STATS_TIMESTAMP_MASK     (uint32_t)(0x00FFFFFF)
+
 
 /***********************************************************************************************//**
  * SER_PHY layer configuration.
@@ -68,6 +120,13 @@
 #define SER_PHY_UART_PARITY             true
 #define SER_PHY_UART_BAUDRATE           UART_BAUDRATE_BAUDRATE_Baud1M
 
+/** Number of reliable HCI PHY packets which can be sent before the first of them is acknowledged
+ *  (1 - 7). With more than one, every packet is copied to a buffer of the HCI PHY, so that it can
+ *  be retransmitted after the HAL Transport buffer has been released. */
+#ifndef SER_PHY_HCI_TX_WINDOW_SIZE
+#define SER_PHY_HCI_TX_WINDOW_SIZE      1
+#endif
+
 /** Find UART baudrate value based on chosen register setting. */
 #if (SER_PHY_UART_BAUDRATE == UART_BAUDRATE_BAUDRATE_Baud1200)
     #define SER_PHY_UART_BAUDRATE_VAL 1200uL
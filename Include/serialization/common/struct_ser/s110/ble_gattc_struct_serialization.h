@@ -13,6 +13,10 @@
 #define BLE_GATTC_STRUCT_SERIALIZATION_H
 
 #include "ble_gattc.h"
+#include "field_desc_serialization.h"
+
+/**@brief Descriptor of @ref ble_gattc_evt_t carrying a @ref ble_gattc_evt_hvx_t event. */
+extern ser_struct_desc_t const ble_gattc_evt_hvx_desc;
 
 uint32_t ble_gattc_evt_char_val_by_uuid_read_rsp_t_enc(void const * const p_void_struct,
                                                        uint8_t * const    p_buf,
@@ -11,7 +11,12 @@
  */
 
 #include "ble_types.h"
+#include "field_desc_serialization.h"
 
+#define BLE_UUID_T_ENC_LEN (2 + 1)    /**< Encoded length of @ref ble_uuid_t: uuid and type. */
+
+/**@brief Descriptor of @ref ble_uuid_t. */
+extern ser_struct_desc_t const ble_uuid_t_desc;
 
 uint32_t ble_uuid_t_enc(void const * const p_void_uuid,
                         uint8_t * const    p_buf,
@@ -24,6 +24,10 @@
  *          memory management. In the future it is possible to add more feature to it as: crc,
  *          retransmission etc.
  *
+ *          Packets are stored in pools of @ref SER_HAL_TRANSPORT_TX_PKT_COUNT TX buffers and
+ *          @ref SER_HAL_TRANSPORT_RX_PKT_COUNT RX buffers. TX packets are transmitted in the order
+ *          in which they were allocated, RX packets can be freed in any order.
+ *
  * \n \n
  * \image html ser_hal_transport_rx_state_machine.png "RX state machine"
  * \n \n
@@ -66,6 +70,15 @@ typedef enum
 } ser_hal_transport_phy_error_type_t;
 
 
+/**@brief A struct containing parameters of the event of type @ref SER_HAL_TRANSP_EVT_TX_PKT_SENT.
+ */
+typedef struct
+{
+    uint8_t const * p_buffer; /**< Pointer to a buffer containing the transmitted packet. The buffer
+                                   has already been released. */
+} ser_hal_transport_evt_tx_pkt_sent_params_t;
+
+
 /**@brief A struct containing parameters of the event of type
  *        @ref SER_HAL_TRANSP_EVT_RX_PKT_RECEIVED.
  */
@@ -95,6 +108,7 @@ typedef struct
     ser_hal_transport_evt_type_t evt_type;  /**< Type of event. */
     union  /**< Union alternative identified by evt_type in enclosing struct. */
     {
+        ser_hal_transport_evt_tx_pkt_sent_params_t      tx_pkt_sent;     /**< Parameters of the event of type @ref SER_HAL_TRANSP_EVT_TX_PKT_SENT. */
         ser_hal_transport_evt_rx_pkt_received_params_t  rx_pkt_received; /**< Parameters of the event of type @ref SER_HAL_TRANSP_EVT_RX_PKT_RECEIVED. */
         ser_hal_transport_evt_phy_error_params_t        phy_error;       /**< Parameters of the event of type @ref SER_HAL_TRANSP_EVT_PHY_ERROR. */
     } evt_params;
@@ -169,6 +183,9 @@ uint32_t ser_hal_transport_rx_pkt_free(uint8_t * p_buffer);
  * @param[out] p_num_of_bytes  A pointer to a variable to which size in octets of the allocated
  *                             buffer is written.
  * 
+ * @note Only one TX buffer can be allocated and not yet passed to
+ *       @ref ser_hal_transport_tx_pkt_send at a time.
+ *
  * @retval NRF_SUCCESS              Operation success. Memory was allocated.
  * @retval NRF_ERROR_NULL           Operation failure. NULL pointer supplied.
  * @retval NRF_ERROR_NO_MEM         Operation failure. No memory available.
@@ -0,0 +1,67 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#ifndef CONN_MW_STATS_CONN_H__
+#define CONN_MW_STATS_CONN_H__
+
+/**@file
+ *
+ * @defgroup conn_mw_stats_conn Connectivity middleware statistics command request decoder and command response encoder
+ * @{
+ * @ingroup  ser_conn_common_codecs
+ *
+ * @brief   Connectivity middleware statistics command request decoder and command response encoder.
+ */
+
+#include <stdint.h>
+#include "ble_serialization.h"
+
+/**@brief Decodes @ref SER_CONN_MW_STATS_GET_OP_CODE command request.
+ *
+ * @sa @ref conn_mw_stats_get_rsp_enc for response encoding.
+ *
+ * @param[in] p_buf               Pointer to beginning of command request packet.
+ * @param[in] packet_len          Length (in bytes) of request packet.
+ * @param[out] p_opcode           Pointer to opcode which statistics are requested.
+ *
+ * @retval NRF_SUCCESS                Decoding success.
+ * @retval NRF_ERROR_NULL             Decoding failure. NULL pointer supplied.
+ * @retval NRF_ERROR_INVALID_LENGTH   Decoding failure. Incorrect buffer length.
+ * @retval NRF_ERROR_INVALID_PARAM    Decoding failure. Invalid operation type.
+ */
+uint32_t conn_mw_stats_get_req_dec(uint8_t const * const p_buf,
+                                   uint32_t              packet_len,
+                                   uint8_t * const       p_opcode);
+
+
+/**@brief Encodes @ref SER_CONN_MW_STATS_GET_OP_CODE command response.
+ *
+ * @sa @ref conn_mw_stats_get_req_dec for request decoding.
+ *
+ * @param[in] return_code         Return code indicating if command was successful or not.
+ * @param[out] p_buf              Pointer to buffer where encoded data command response will be
+ *                                returned.
+ * @param[in,out] p_buf_len       \c in: size of \p p_buf buffer.
+ *                                \c out: Length of encoded command response packet.
+ * @param[in] p_stats             Pointer to statistics of the requested opcode.
+ *
+ * @retval NRF_SUCCESS                Encoding success.
+ * @retval NRF_ERROR_NULL             Encoding failure. NULL pointer supplied.
+ * @retval NRF_ERROR_INVALID_LENGTH   Encoding failure. Incorrect buffer length.
+ */
+uint32_t conn_mw_stats_get_rsp_enc(uint32_t                          return_code,
+                                   uint8_t * const                   p_buf,
+                                   uint32_t * const                  p_buf_len,
+                                   ser_conn_mw_stats_t const * const p_stats);
+
+/** @} */
+#endif // CONN_MW_STATS_CONN_H__
@@ -35,4 +35,22 @@ uint32_t conn_mw_handler (uint8_t const * const p_rx_buf,
                           uint32_t              rx_buf_len,
                           uint8_t * const       p_tx_buf,
                           uint32_t      * const p_tx_buf_len);
+
+/**@brief Handles @ref SER_CONN_MW_STATS_GET_OP_CODE command request and prepares response with
+ *        statistics of the requested opcode (available when SER_CONN_MW_STATS_ENABLED is set).
+ *
+ * @param[in]     p_rx_buf            Pointer to input buffer.
+ * @param[in]     rx_buf_len          Size of p_rx_buf.
+ * @param[out]    p_tx_buf            Pointer to output buffer.
+ * @param[in,out] p_tx_buf_len        \c in: size of \p p_tx_buf buffer.
+ *                                    \c out: Length of valid data in \p p_tx_buf.
+ *
+ * @retval NRF_SUCCESS                Handler success.
+ * @retval NRF_ERROR_NULL             Handler failure. NULL pointer supplied.
+ * @retval NRF_ERROR_INVALID_LENGTH   Handler failure. Incorrect buffer length.
+ */
+uint32_t conn_mw_stats_get(uint8_t const * const p_rx_buf,
+                           uint32_t              rx_buf_len,
+                           uint8_t * const       p_tx_buf,
+                           uint32_t * const      p_tx_buf_len);
 #endif //_CONN_MW_H
@@ -48,6 +48,26 @@
  */
 uint32_t ser_conn_command_process(uint8_t * p_command, uint16_t command_len);
 
+/**@brief A function processes a batch of encoded commands and sends one response packet with
+ *        responses to all of them to an Application Chip.
+ *
+ * @details Commands in a batch are preceded by a length field of @ref SER_BATCH_ITEM_LEN_SIZE
+ *          bytes and are executed in order. A response to every executed command (or a common
+ *          response with an error code if the command could not be handled) is placed in the
+ *          response packet, preceded by its length. A command is executed only if there are at
+ *          least @ref SER_BATCH_RSP_MAX_SIZE bytes left for its response; otherwise processing
+ *          stops before the command, so the response packet may hold fewer responses than there
+ *          were commands in the batch and the commands without a response were not executed.
+ *
+ * @param[in]   p_batch        The encoded commands with their length fields.
+ * @param[in]   batch_len      Length of the batch.
+ *
+ * @retval    NRF_SUCCESS           Operation success.
+ * @retval    NRF_ERROR_NULL        Operation failure. NULL pointer supplied.
+ * @retval    NRF_ERROR_INTERNAL    Operation failure. Internal error ocurred.
+ */
+uint32_t ser_conn_batch_process(uint8_t * p_batch, uint16_t batch_len);
+
 #endif /* SER_CONN_CMD_DECODER_H__ */
 
 /** @} */
@@ -50,11 +50,13 @@ uint32_t ser_conn_dtm_command_process(uint8_t * p_command, uint16_t command_len)
 
 /**@brief A function for checking if Connectivity Chip is ready to enter the DTM mode.
  *
- * @details     The function checks if Connectivity Chip is ready to enter into DTM mode.
- *              If it is ready then it disables SoftDevice, closes HAL Transport Layer
- *              and starts DTM mode.
+ * @details     The function checks if Connectivity Chip is ready to enter into DTM mode, that is
+ *              if the transmitted packet is the DTM Command Response. If it is ready then it
+ *              disables SoftDevice, closes HAL Transport Layer and starts DTM mode.
+ *
+ * @param[in]   p_sent_buf     Buffer of the packet which has just been transmitted.
  */
-void ser_conn_is_ready_to_enter_dtm(void);
+void ser_conn_is_ready_to_enter_dtm(uint8_t const * p_sent_buf);
 
 #endif /* SER_CONN_DTM_CMD_DECODER_H__ */
 
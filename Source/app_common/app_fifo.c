@@ -11,9 +11,22 @@
  */
 
 #include "app_fifo.h"
+#include <string.h>
 #include "app_util.h"
+#include "nordic_common.h"
 
-#define FIFO_LENGTH (p_fifo->write_pos - p_fifo->read_pos)  /**< Macro for calculating the FIFO length. */
+// Each position is only written by one side. The owner reads its own position relaxed, reads the
+// other side's position with acquire ordering, and publishes its own position with release
+// ordering, so buffer accesses never cross the position update.
+#if APP_FIFO_SPSC
+#define POS_LOAD_OWN(POS)         atomic_load_explicit(&(POS), memory_order_relaxed)    /**< Read a position owned by the caller. */
+#define POS_LOAD_OTHER(POS)       atomic_load_explicit(&(POS), memory_order_acquire)    /**< Read a position owned by the other side. */
+#define POS_STORE(POS, VAL)       atomic_store_explicit(&(POS), (VAL), memory_order_release) /**< Publish a position owned by the caller. */
+#else
+#define POS_LOAD_OWN(POS)         (POS)                                                  /**< Read a position owned by the caller. */
+#define POS_LOAD_OTHER(POS)       (POS)                                                  /**< Read a position owned by the other side. */
+#define POS_STORE(POS, VAL)       ((POS) = (VAL))                                        /**< Publish a position owned by the caller. */
+#endif
 
 
 uint32_t app_fifo_init(app_fifo_t * p_fifo, uint8_t * p_buf, uint16_t buf_size)
@@ -32,8 +45,8 @@ uint32_t app_fifo_init(app_fifo_t * p_fifo, uint8_t * p_buf, uint16_t buf_size)
 
     p_fifo->p_buf         = p_buf;
     p_fifo->buf_size_mask = buf_size - 1;
-    p_fifo->read_pos      = 0;
-    p_fifo->write_pos     = 0;
+    POS_STORE(p_fifo->read_pos, 0);
+    POS_STORE(p_fifo->write_pos, 0);
 
     return NRF_SUCCESS;
 }
@@ -41,10 +54,12 @@ uint32_t app_fifo_init(app_fifo_t * p_fifo, uint8_t * p_buf, uint16_t buf_size)
 
 uint32_t app_fifo_put(app_fifo_t * p_fifo, uint8_t byte)
 {
-    if (FIFO_LENGTH <= p_fifo->buf_size_mask)
+    uint32_t write_pos = POS_LOAD_OWN(p_fifo->write_pos);
+
+    if ((write_pos - POS_LOAD_OTHER(p_fifo->read_pos)) <= p_fifo->buf_size_mask)
     {
-        p_fifo->p_buf[p_fifo->write_pos & p_fifo->buf_size_mask] = byte;
-        p_fifo->write_pos++;
+        p_fifo->p_buf[write_pos & p_fifo->buf_size_mask] = byte;
+        POS_STORE(p_fifo->write_pos, write_pos + 1);
         return NRF_SUCCESS;
     }
 
@@ -54,10 +69,12 @@ uint32_t app_fifo_put(app_fifo_t * p_fifo, uint8_t byte)
 
 uint32_t app_fifo_get(app_fifo_t * p_fifo, uint8_t * p_byte)
 {
-    if (FIFO_LENGTH != 0)
+    uint32_t read_pos = POS_LOAD_OWN(p_fifo->read_pos);
+
+    if ((POS_LOAD_OTHER(p_fifo->write_pos) - read_pos) != 0)
     {
-        *p_byte = p_fifo->p_buf[p_fifo->read_pos & p_fifo->buf_size_mask];
-        p_fifo->read_pos++;
+        *p_byte = p_fifo->p_buf[read_pos & p_fifo->buf_size_mask];
+        POS_STORE(p_fifo->read_pos, read_pos + 1);
         return NRF_SUCCESS;
     }
 
@@ -65,8 +82,117 @@ uint32_t app_fifo_get(app_fifo_t * p_fifo, uint8_t * p_byte)
 
 }
 
+
+uint32_t app_fifo_write(app_fifo_t * p_fifo, const uint8_t * p_data, uint32_t * p_size)
+{
+    uint32_t write_pos;
+    uint32_t available;
+    uint32_t index;
+    uint32_t size;
+    uint32_t first;
+
+    if (p_size == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    write_pos = POS_LOAD_OWN(p_fifo->write_pos);
+    available = (p_fifo->buf_size_mask + 1) - (write_pos - POS_LOAD_OTHER(p_fifo->read_pos));
+    if (p_data == NULL)
+    {
+        *p_size = available;
+        return NRF_SUCCESS;
+    }
+
+    size    = MIN(*p_size, available);
+    *p_size = size;
+    if (size == 0)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    // Copy up to the end of the buffer, then the rest from the start of the buffer.
+    index = write_pos & p_fifo->buf_size_mask;
+    first = MIN(size, (p_fifo->buf_size_mask + 1) - index);
+    memcpy(&p_fifo->p_buf[index], p_data, first);
+    memcpy(p_fifo->p_buf, &p_data[first], size - first);
+
+    POS_STORE(p_fifo->write_pos, write_pos + size);
+    return NRF_SUCCESS;
+}
+
+
+uint32_t app_fifo_read(app_fifo_t * p_fifo, uint8_t * p_data, uint32_t * p_size)
+{
+    uint32_t read_pos;
+    uint32_t length;
+    uint32_t index;
+    uint32_t size;
+    uint32_t first;
+
+    if (p_size == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    read_pos = POS_LOAD_OWN(p_fifo->read_pos);
+    length   = POS_LOAD_OTHER(p_fifo->write_pos) - read_pos;
+    if (p_data == NULL)
+    {
+        *p_size = length;
+        return NRF_SUCCESS;
+    }
+
+    size    = MIN(*p_size, length);
+    *p_size = size;
+    if (size == 0)
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+
+    // Copy up to the end of the buffer, then the rest from the start of the buffer.
+    index = read_pos & p_fifo->buf_size_mask;
+    first = MIN(size, (p_fifo->buf_size_mask + 1) - index);
+    memcpy(p_data, &p_fifo->p_buf[index], first);
+    memcpy(&p_data[first], p_fifo->p_buf, size - first);
+
+    POS_STORE(p_fifo->read_pos, read_pos + size);
+    return NRF_SUCCESS;
+}
+
+
+uint32_t app_fifo_peek_span(app_fifo_t * p_fifo, uint8_t ** pp_data, uint32_t * p_size)
+{
+    uint32_t read_pos = POS_LOAD_OWN(p_fifo->read_pos);
+    uint32_t length   = POS_LOAD_OTHER(p_fifo->write_pos) - read_pos;
+    uint32_t index    = read_pos & p_fifo->buf_size_mask;
+
+    if (length == 0)
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+
+    *pp_data = &p_fifo->p_buf[index];
+    *p_size  = MIN(length, (p_fifo->buf_size_mask + 1) - index);
+    return NRF_SUCCESS;
+}
+
+
+uint32_t app_fifo_commit(app_fifo_t * p_fifo, uint32_t size)
+{
+    uint32_t read_pos = POS_LOAD_OWN(p_fifo->read_pos);
+
+    if (size > (POS_LOAD_OTHER(p_fifo->write_pos) - read_pos))
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
+    POS_STORE(p_fifo->read_pos, read_pos + size);
+    return NRF_SUCCESS;
+}
+
 uint32_t app_fifo_flush(app_fifo_t * p_fifo)
 {
-    p_fifo->read_pos = p_fifo->write_pos;
+    POS_STORE(p_fifo->read_pos, POS_LOAD_OTHER(p_fifo->write_pos));
     return NRF_SUCCESS;
 }
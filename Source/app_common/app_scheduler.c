@@ -17,30 +17,24 @@
 #include "nrf_soc.h"
 #include "nrf_assert.h"
 #include "app_util.h"
+#include "nordic_common.h"
 #include "app_util_platform.h"
 
 /**@brief Structure for holding a scheduled event header. */
 typedef struct
 {
     app_sched_event_handler_t handler;          /**< Pointer to event handler to receive the event. */
+#if (APP_SCHED_PROFILE)
+    uint32_t                  put_time;         /**< APP_SCHED_PROFILE_CLOCK() value when the event was put. */
+#endif
     uint16_t                  event_data_size;  /**< Size of event data. */
 } event_header_t;
 
 STATIC_ASSERT(sizeof(event_header_t) <= APP_SCHED_EVENT_HEADER_SIZE);
 
-static event_header_t * m_queue_event_headers;  /**< Array for holding the queue event headers. */
-static uint8_t        * m_queue_event_data;     /**< Array for holding the queue event data. */
-static volatile uint8_t m_queue_start_index;    /**< Index of queue entry at the start of the queue. */
-static volatile uint8_t m_queue_end_index;      /**< Index of queue entry at the end of the queue. */
 static uint16_t         m_queue_event_size;     /**< Maximum event size in queue. */
 static uint16_t         m_queue_size;           /**< Number of queue entries. */
 
-/**@brief Macro for checking if a queue is full. */
-#define APP_SCHED_QUEUE_FULL() (next_index(m_queue_end_index) == m_queue_start_index)
-
-/**@brief Macro for checking if a queue is empty. */
-#define APP_SCHED_QUEUE_EMPTY() (m_queue_end_index == m_queue_start_index)
-
 
 /**@brief Function for incrementing a queue index, and handle wrap-around.
  *
@@ -54,6 +48,573 @@ static __INLINE uint8_t next_index(uint8_t index)
 }
 
 
+#if (APP_SCHED_PROFILE)
+static app_sched_profile_t m_profile;           /**< Scheduler profiling data. */
+
+/**@brief Macro for recording the queue depth after a successful put, or a put to a full queue. */
+#define PROFILE_PUT_RECORD(QUEUE_DEPTH, ERR_CODE) profile_put_record((QUEUE_DEPTH), (ERR_CODE))
+
+/**@brief Macro for time stamping an event header when the event is put. */
+#define PROFILE_PUT_TIME_SET(P_HEADER)            ((P_HEADER)->put_time = APP_SCHED_PROFILE_CLOCK())
+
+
+/**@brief Function for recording the outcome of an event put.
+ *
+ * @param[in]   queue_depth   Number of pending events (bytes with APP_SCHED_BYTE_RING) in the
+ *                            queue after the put.
+ * @param[in]   err_code      Result of the put.
+ */
+static void profile_put_record(uint32_t queue_depth, uint32_t err_code)
+{
+    // Events may be put from several interrupt levels.
+    CRITICAL_REGION_ENTER();
+
+    if (err_code != NRF_SUCCESS)
+    {
+        m_profile.put_failures++;
+    }
+    else if (queue_depth > m_profile.queue_depth_max)
+    {
+        m_profile.queue_depth_max = queue_depth;
+    }
+
+    CRITICAL_REGION_EXIT();
+}
+
+
+/**@brief Function for recording the latency and run time of an executed event.
+ *
+ * @param[in]   handler    Event handler that was executed.
+ * @param[in]   latency    Clock ticks from the event put until the handler was called.
+ * @param[in]   run_time   Clock ticks spent in the handler.
+ */
+static void profile_execute_record(app_sched_event_handler_t handler,
+                                   uint32_t                  latency,
+                                   uint32_t                  run_time)
+{
+    app_sched_handler_profile_t * p_entry = NULL;
+    uint32_t                      bucket  = 0;
+    uint32_t                      i;
+
+    for (i = 0; i < APP_SCHED_PROFILE_HANDLERS; i++)
+    {
+        if ((m_profile.handlers[i].handler == handler) || (m_profile.handlers[i].handler == NULL))
+        {
+            p_entry = &m_profile.handlers[i];
+            break;
+        }
+    }
+    if (p_entry == NULL)
+    {
+        m_profile.untracked_events++;
+        return;
+    }
+
+    // Bucket 0 holds zero latency, bucket n latencies from 2^(n-1), the last bucket the rest.
+    while ((latency >> bucket) != 0 && (bucket < APP_SCHED_PROFILE_LATENCY_BUCKETS - 1))
+    {
+        bucket++;
+    }
+
+    p_entry->handler = handler;
+    p_entry->event_count++;
+    if (p_entry->latency_histogram[bucket] != UINT16_MAX)
+    {
+        p_entry->latency_histogram[bucket]++;
+    }
+    p_entry->latency_max  = MAX(p_entry->latency_max, latency);
+    p_entry->run_time_max = MAX(p_entry->run_time_max, run_time);
+}
+
+
+const app_sched_profile_t * app_sched_profile_get(void)
+{
+    return &m_profile;
+}
+
+
+void app_sched_profile_reset(void)
+{
+    CRITICAL_REGION_ENTER();
+    memset(&m_profile, 0, sizeof(m_profile));
+    CRITICAL_REGION_EXIT();
+}
+#else
+#define PROFILE_PUT_RECORD(QUEUE_DEPTH, ERR_CODE)
+#define PROFILE_PUT_TIME_SET(P_HEADER)
+#endif // APP_SCHED_PROFILE
+
+
+/**@brief Function for executing the handler of an event.
+ *
+ * @param[in]   p_header       Header of the event.
+ * @param[in]   p_event_data   Event data.
+ */
+static __INLINE void event_execute(const event_header_t * p_header, void * p_event_data)
+{
+#if (APP_SCHED_PROFILE)
+    app_sched_event_handler_t handler    = p_header->handler;
+    uint32_t                  start_time = APP_SCHED_PROFILE_CLOCK();
+
+    handler(p_event_data, p_header->event_data_size);
+
+    profile_execute_record(handler,
+                           (start_time - p_header->put_time) & APP_SCHED_PROFILE_CLOCK_MASK,
+                           (APP_SCHED_PROFILE_CLOCK() - start_time) & APP_SCHED_PROFILE_CLOCK_MASK);
+#else
+    p_header->handler(p_event_data, p_header->event_data_size);
+#endif
+}
+
+
+#if (APP_SCHED_PRIORITY_LEVELS > 1)
+STATIC_ASSERT(APP_SCHED_PRIORITY_LEVELS <= 4);
+
+#define APP_HIGH_USER_ID        0               /**< Queue index for events put from Application High interrupt level. */
+#define APP_LOW_USER_ID         1               /**< Queue index for events put from Application Low interrupt level. */
+#define THREAD_MODE_USER_ID     2               /**< Queue index for events put from Thread Mode. */
+
+/**@brief Structure for holding a single producer, single consumer event queue.
+ *
+ * @details There is one queue for each event priority and interrupt level. Only the interrupt
+ *          level owning the queue writes the end index, and only app_sched_execute() writes the
+ *          start index, so no critical region is needed.
+ */
+typedef struct
+{
+    event_header_t *  p_event_headers;          /**< Array for holding the queue event headers. */
+    uint8_t *         p_event_data;             /**< Array for holding the queue event data. */
+    volatile uint8_t  start_index;              /**< Index of queue entry at the start of the queue. */
+    volatile uint8_t  end_index;                /**< Index of queue entry at the end of the queue. */
+} event_queue_t;
+
+static event_queue_t m_queues[APP_SCHED_PRIORITY_LEVELS][APP_SCHED_INT_LEVELS];   /**< Event queues, by priority and interrupt level. */
+
+/**@brief Macro for completing the accesses to a queue entry before the index update that passes
+ *        the entry to the other side. With GCC, __DMB() of this CMSIS version does not stop the
+ *        compiler from moving memory accesses across it, hence the extra compiler barrier.
+ */
+#if defined(__GNUC__)
+#define QUEUE_INDEX_BARRIER()                                                                     \
+    do                                                                                            \
+    {                                                                                             \
+        __ASM volatile ("" ::: "memory");                                                         \
+        __DMB();                                                                                  \
+    } while (0)
+#else
+#define QUEUE_INDEX_BARRIER() __DMB()
+#endif
+
+
+/**@brief Function for finding the queue of the current interrupt level.
+ *
+ * @return      Queue index for the current interrupt level.
+ */
+static uint32_t user_id_get(void)
+{
+    STATIC_ASSERT(APP_SCHED_INT_LEVELS == 3);
+
+    switch (current_int_priority_get())
+    {
+        case APP_IRQ_PRIORITY_HIGH:
+            return APP_HIGH_USER_ID;
+
+        case APP_IRQ_PRIORITY_LOW:
+            return APP_LOW_USER_ID;
+
+        default:
+            return THREAD_MODE_USER_ID;
+    }
+}
+
+
+uint32_t app_sched_init(uint16_t event_size, uint16_t queue_size, void * p_event_buffer)
+{
+    event_header_t * p_headers = p_event_buffer;
+    uint8_t *        p_data;
+    uint32_t         priority;
+    uint32_t         user_id;
+
+    // Check that buffer is correctly aligned
+    if (!is_word_aligned(p_event_buffer))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    // The headers of all queues are placed first to keep them aligned, then the event data.
+    p_data = (uint8_t *)&p_headers[APP_SCHED_PRIORITY_LEVELS * APP_SCHED_INT_LEVELS *
+                                   (queue_size + 1)];
+
+    for (priority = 0; priority < APP_SCHED_PRIORITY_LEVELS; priority++)
+    {
+        for (user_id = 0; user_id < APP_SCHED_INT_LEVELS; user_id++)
+        {
+            event_queue_t * p_queue = &m_queues[priority][user_id];
+
+            p_queue->p_event_headers = p_headers;
+            p_queue->p_event_data    = p_data;
+            p_queue->start_index     = 0;
+            p_queue->end_index       = 0;
+
+            p_headers += (queue_size + 1);
+            p_data    += (queue_size + 1) * event_size;
+        }
+    }
+
+    m_queue_event_size = event_size;
+    m_queue_size       = queue_size;
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t app_sched_event_put_prio(void                    * p_event_data,
+                                  uint16_t                  event_data_size,
+                                  app_sched_event_handler_t handler,
+                                  uint8_t                   priority)
+{
+    event_queue_t * p_queue;
+    uint8_t         event_index;
+
+    if (event_data_size > m_queue_event_size)
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+    if (priority >= APP_SCHED_PRIORITY_LEVELS)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    p_queue     = &m_queues[priority][user_id_get()];
+    event_index = p_queue->end_index;
+
+    if (next_index(event_index) == p_queue->start_index)
+    {
+        PROFILE_PUT_RECORD(0, NRF_ERROR_NO_MEM);
+        return NRF_ERROR_NO_MEM;
+    }
+
+    p_queue->p_event_headers[event_index].handler = handler;
+    PROFILE_PUT_TIME_SET(&p_queue->p_event_headers[event_index]);
+    if ((p_event_data != NULL) && (event_data_size > 0))
+    {
+        memcpy(&p_queue->p_event_data[event_index * m_queue_event_size],
+               p_event_data,
+               event_data_size);
+        p_queue->p_event_headers[event_index].event_data_size = event_data_size;
+    }
+    else
+    {
+        p_queue->p_event_headers[event_index].event_data_size = 0;
+    }
+
+    // Publish the event only after it has been written, as the consumer may run at any time.
+    QUEUE_INDEX_BARRIER();
+    p_queue->end_index = next_index(event_index);
+
+    PROFILE_PUT_RECORD((p_queue->end_index + m_queue_size + 1 - p_queue->start_index) %
+                       (m_queue_size + 1),
+                       NRF_SUCCESS);
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t app_sched_event_put(void                    * p_event_data,
+                             uint16_t                  event_data_size,
+                             app_sched_event_handler_t handler)
+{
+    return app_sched_event_put_prio(p_event_data,
+                                    event_data_size,
+                                    handler,
+                                    APP_SCHED_PRIORITY_LOWEST);
+}
+
+
+/**@brief Function for selecting the queue to execute the next event from.
+ *
+ * @details Selects the highest priority non-empty queue. If lower priority events have waited
+ *          for APP_SCHED_STARVATION_LIMIT consecutive higher priority events, the lowest priority
+ *          non-empty queue is selected instead.
+ *
+ * @param[in,out] p_starved_count   Number of consecutive events executed while lower priority
+ *                                  events were waiting.
+ *
+ * @return      Pointer to selected queue, NULL if all queues are empty.
+ */
+static event_queue_t * event_queue_select(uint32_t * p_starved_count)
+{
+    event_queue_t * p_queue_high  = NULL;
+    event_queue_t * p_queue_low   = NULL;
+    uint32_t        priority_high = 0;
+    uint32_t        priority_low  = 0;
+    uint32_t        priority;
+    uint32_t        user_id;
+
+    for (priority = 0; priority < APP_SCHED_PRIORITY_LEVELS; priority++)
+    {
+        for (user_id = 0; user_id < APP_SCHED_INT_LEVELS; user_id++)
+        {
+            event_queue_t * p_queue = &m_queues[priority][user_id];
+
+            if (p_queue->start_index == p_queue->end_index)
+            {
+                continue;
+            }
+            if (p_queue_high == NULL)
+            {
+                p_queue_high  = p_queue;
+                priority_high = priority;
+            }
+            if ((p_queue_low == NULL) || (priority != priority_low))
+            {
+                p_queue_low  = p_queue;
+                priority_low = priority;
+            }
+        }
+    }
+
+    if ((p_queue_high == NULL) || (priority_low == priority_high))
+    {
+        *p_starved_count = 0;
+        return p_queue_high;
+    }
+
+    if ((APP_SCHED_STARVATION_LIMIT != 0) && (++(*p_starved_count) > APP_SCHED_STARVATION_LIMIT))
+    {
+        *p_starved_count = 0;
+        return p_queue_low;
+    }
+
+    return p_queue_high;
+}
+
+
+void app_sched_execute(void)
+{
+    event_queue_t * p_queue;
+    uint32_t        starved_count = 0;
+
+    // Execute events in priority order, until all queues are empty
+    while ((p_queue = event_queue_select(&starved_count)) != NULL)
+    {
+        uint8_t          event_index = p_queue->start_index;
+        event_header_t * p_header    = &p_queue->p_event_headers[event_index];
+
+        event_execute(p_header, &p_queue->p_event_data[event_index * m_queue_event_size]);
+
+        // Free the entry only after the handler is done with the event data.
+        QUEUE_INDEX_BARRIER();
+        p_queue->start_index = next_index(event_index);
+    }
+}
+#elif (APP_SCHED_BYTE_RING)
+#define EVENT_RECORD_SIZE(DATA_SIZE) (sizeof(event_header_t) + (((DATA_SIZE) + 3) & ~3))   /**< Size of an event record in the ring, keeping the next header word aligned. */
+
+static uint8_t *         mp_ring;               /**< Buffer holding the event records. */
+static uint16_t          m_ring_size;           /**< Size of the ring buffer in bytes. */
+static volatile uint16_t m_ring_start;          /**< Offset of the first record in the ring. */
+static volatile uint16_t m_ring_end;            /**< Offset following the last record in the ring. */
+
+/**@brief Macro for checking if the ring is empty. */
+#define APP_SCHED_QUEUE_EMPTY() (m_ring_end == m_ring_start)
+
+
+uint32_t app_sched_init(uint16_t event_size, uint16_t queue_size, void * p_event_buffer)
+{
+    // Check that buffer is correctly aligned
+    if (!is_word_aligned(p_event_buffer))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    // Initialize event scheduler
+    mp_ring            = p_event_buffer;
+    m_ring_size        = (queue_size + 1) * EVENT_RECORD_SIZE(event_size);
+    m_ring_start       = 0;
+    m_ring_end         = 0;
+    m_queue_event_size = event_size;
+    m_queue_size       = queue_size;
+
+    return NRF_SUCCESS;
+}
+
+
+/**@brief Function for reserving space for an event record at the end of the ring.
+ *
+ * @details If the record does not fit before the end of the buffer, the rest of the buffer is
+ *          marked with a padding record (a header with no handler) and the record is placed at
+ *          the start of the buffer. The ring is never filled completely, so that a full ring can
+ *          be told apart from an empty one.
+ *
+ * @note    Must be called from inside a critical region.
+ *
+ * @param[in]   record_size   Size of the event record.
+ *
+ * @return      Offset of the reserved record, or m_ring_size if there is no room.
+ */
+static uint16_t ring_reserve(uint16_t record_size)
+{
+    uint16_t start = m_ring_start;
+    uint16_t end   = m_ring_end;
+
+    if (end >= start)
+    {
+        uint16_t tail = m_ring_size - end;
+
+        if ((record_size < tail) || ((record_size == tail) && (start != 0)))
+        {
+            m_ring_end = (end + record_size == m_ring_size) ? 0 : (end + record_size);
+            return end;
+        }
+        if (record_size < start)
+        {
+            if (tail >= sizeof(event_header_t))
+            {
+                ((event_header_t *)&mp_ring[end])->handler = NULL;
+            }
+            m_ring_end = record_size;
+            return 0;
+        }
+    }
+    else if (record_size < (start - end))
+    {
+        m_ring_end = end + record_size;
+        return end;
+    }
+
+    return m_ring_size;
+}
+
+
+uint32_t app_sched_event_put(void                    * p_event_data,
+                             uint16_t                  event_data_size,
+                             app_sched_event_handler_t handler)
+{
+    uint32_t err_code;
+
+    if (event_data_size <= m_queue_event_size)
+    {
+        uint16_t record_size = EVENT_RECORD_SIZE(((p_event_data != NULL) ? event_data_size : 0));
+        uint16_t offset;
+
+        CRITICAL_REGION_ENTER();
+
+        offset = ring_reserve(record_size);
+
+        CRITICAL_REGION_EXIT();
+
+        if (offset != m_ring_size)
+        {
+            event_header_t * p_header = (event_header_t *)&mp_ring[offset];
+
+            // NOTE: This can be done outside the critical region since the event consumer will
+            //       always be called from the main loop, and will thus never interrupt this code.
+            p_header->handler = handler;
+            PROFILE_PUT_TIME_SET(p_header);
+            if ((p_event_data != NULL) && (event_data_size > 0))
+            {
+                memcpy(&p_header[1], p_event_data, event_data_size);
+                p_header->event_data_size = event_data_size;
+            }
+            else
+            {
+                p_header->event_data_size = 0;
+            }
+
+            err_code = NRF_SUCCESS;
+            PROFILE_PUT_RECORD((m_ring_end + m_ring_size - m_ring_start) % m_ring_size, err_code);
+        }
+        else
+        {
+            err_code = NRF_ERROR_NO_MEM;
+            PROFILE_PUT_RECORD(0, err_code);
+        }
+    }
+    else
+    {
+        err_code = NRF_ERROR_INVALID_LENGTH;
+    }
+
+    return err_code;
+}
+
+
+uint32_t app_sched_event_put_prio(void                    * p_event_data,
+                                  uint16_t                  event_data_size,
+                                  app_sched_event_handler_t handler,
+                                  uint8_t                   priority)
+{
+    UNUSED_PARAMETER(priority);
+
+    return app_sched_event_put(p_event_data, event_data_size, handler);
+}
+
+
+/**@brief Function for finding the first event record in the ring, skipping wrap-around padding.
+ *
+ * @return      Pointer to the header of the first event record, NULL if the ring is empty.
+ */
+static event_header_t * ring_first_get(void)
+{
+    event_header_t * p_header;
+
+    if (APP_SCHED_QUEUE_EMPTY())
+    {
+        return NULL;
+    }
+
+    // NOTE: There is no need for a critical region here, as this function will only be called
+    //       from app_sched_execute() from inside the main loop, so it will never interrupt
+    //       app_sched_event_put(). Also, updating of (i.e. writing to) the start offset will be
+    //       an atomic operation.
+    if ((m_ring_size - m_ring_start) >= sizeof(event_header_t))
+    {
+        p_header = (event_header_t *)&mp_ring[m_ring_start];
+        if (p_header->handler != NULL)
+        {
+            return p_header;
+        }
+    }
+
+    // The rest of the buffer is padding, the next record is at the start of the buffer.
+    m_ring_start = 0;
+
+    return (event_header_t *)mp_ring;
+}
+
+
+void app_sched_execute(void)
+{
+    event_header_t * p_header;
+
+    // Get next event (if any), and execute handler
+    while ((p_header = ring_first_get()) != NULL)
+    {
+        uint16_t record_size = EVENT_RECORD_SIZE(p_header->event_data_size);
+
+        event_execute(p_header, &p_header[1]);
+
+        // Free the record only after the handler is done with the event data.
+        record_size += m_ring_start;
+        m_ring_start = (record_size == m_ring_size) ? 0 : record_size;
+    }
+}
+
+
+#else
+static event_header_t * m_queue_event_headers;  /**< Array for holding the queue event headers. */
+static uint8_t        * m_queue_event_data;     /**< Array for holding the queue event data. */
+static volatile uint8_t m_queue_start_index;    /**< Index of queue entry at the start of the queue. */
+static volatile uint8_t m_queue_end_index;      /**< Index of queue entry at the end of the queue. */
+
+/**@brief Macro for checking if a queue is full. */
+#define APP_SCHED_QUEUE_FULL() (next_index(m_queue_end_index) == m_queue_start_index)
+
+/**@brief Macro for checking if a queue is empty. */
+#define APP_SCHED_QUEUE_EMPTY() (m_queue_end_index == m_queue_start_index)
+
+
 uint32_t app_sched_init(uint16_t event_size, uint16_t queue_size, void * p_event_buffer)
 {
     uint16_t data_start_index = (queue_size + 1) * sizeof(event_header_t);
@@ -101,6 +662,7 @@ uint32_t app_sched_event_put(void                    * p_event_data,
             // NOTE: This can be done outside the critical region since the event consumer will
             //       always be called from the main loop, and will thus never interrupt this code.
             m_queue_event_headers[event_index].handler = handler;
+            PROFILE_PUT_TIME_SET(&m_queue_event_headers[event_index]);
             if ((p_event_data != NULL) && (event_data_size > 0))
             {
                 memcpy(&m_queue_event_data[event_index * m_queue_event_size],
@@ -114,10 +676,14 @@ uint32_t app_sched_event_put(void                    * p_event_data,
             }
 
             err_code = NRF_SUCCESS;
+            PROFILE_PUT_RECORD((m_queue_end_index + m_queue_size + 1 - m_queue_start_index) %
+                               (m_queue_size + 1),
+                               err_code);
         }
         else
         {
             err_code = NRF_ERROR_NO_MEM;
+            PROFILE_PUT_RECORD(0, err_code);
         }
     }
     else
@@ -131,15 +697,12 @@ uint32_t app_sched_event_put(void                    * p_event_data,
 
 /**@brief Function for reading the next event from specified event queue.
  *
- * @param[out]  pp_event_data       Pointer to pointer to event data.
- * @param[out]  p_event_data_size   Pointer to size of event data.
- * @param[out]  p_event_handler     Pointer to event handler function pointer.
+ * @param[out]  pp_event_data    Pointer to pointer to event data.
+ * @param[out]  p_event_header   Pointer to copy of event header.
  *
  * @return      NRF_SUCCESS if new event, NRF_ERROR_NOT_FOUND if event queue is empty.
  */
-static uint32_t app_sched_event_get(void                     ** pp_event_data,
-                                    uint16_t *                  p_event_data_size,
-                                    app_sched_event_handler_t * p_event_handler)
+static uint32_t app_sched_event_get(void ** pp_event_data, event_header_t * p_event_header)
 {
     uint32_t err_code = NRF_ERROR_NOT_FOUND;
 
@@ -154,9 +717,8 @@ static uint32_t app_sched_event_get(void                     ** pp_event_data,
         event_index         = m_queue_start_index;
         m_queue_start_index = next_index(m_queue_start_index);
 
-        *pp_event_data     = &m_queue_event_data[event_index * m_queue_event_size];
-        *p_event_data_size = m_queue_event_headers[event_index].event_data_size;
-        *p_event_handler   = m_queue_event_headers[event_index].handler;
+        *pp_event_data  = &m_queue_event_data[event_index * m_queue_event_size];
+        *p_event_header = m_queue_event_headers[event_index];
 
         err_code = NRF_SUCCESS;
     }
@@ -167,13 +729,24 @@ static uint32_t app_sched_event_get(void                     ** pp_event_data,
 
 void app_sched_execute(void)
 {
-    void                    * p_event_data;
-    uint16_t                  event_data_size;
-    app_sched_event_handler_t event_handler;
+    void *         p_event_data;
+    event_header_t event_header;
 
     // Get next event (if any), and execute handler
-    while ((app_sched_event_get(&p_event_data, &event_data_size, &event_handler) == NRF_SUCCESS))
+    while ((app_sched_event_get(&p_event_data, &event_header) == NRF_SUCCESS))
     {
-        event_handler(p_event_data, event_data_size);
+        event_execute(&event_header, p_event_data);
     }
 }
+
+
+uint32_t app_sched_event_put_prio(void                    * p_event_data,
+                                  uint16_t                  event_data_size,
+                                  app_sched_event_handler_t handler,
+                                  uint8_t                   priority)
+{
+    UNUSED_PARAMETER(priority);
+
+    return app_sched_event_put(p_event_data, event_data_size, handler);
+}
+#endif // APP_SCHED_PRIORITY_LEVELS > 1
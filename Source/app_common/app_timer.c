@@ -12,12 +12,14 @@
 
 #include "app_timer.h"
 #include <stdlib.h>
+#include <string.h>
 #include "nrf51.h"
 #include "nrf51_bitfields.h"
 #include "nrf_soc.h"
 #include "app_error.h"
 #include "nrf_delay.h"
 #include "app_util.h"
+#include "nordic_common.h"
 #include "app_util_platform.h"
 
 #define RTC1_IRQ_PRI            APP_IRQ_PRIORITY_LOW                        /**< Priority of the RTC1 interrupt (used for checking for timeouts and executing timeout handlers). */
@@ -38,6 +40,17 @@ STATIC_ASSERT(RTC1_IRQ_PRI == SWI0_IRQ_PRI);
 
 #define MAX_RTC_TASKS_DELAY     47                                          /**< Maximum delay until an RTC task is executed. */
 
+#define WHEEL_SLOT_BITS         6                                           /**< Number of expiry tick bits resolved by each level of the timing wheel. */
+#define WHEEL_SLOTS             (1 << WHEEL_SLOT_BITS)                      /**< Number of slots in each level of the timing wheel. */
+#define WHEEL_SLOT_MASK         (WHEEL_SLOTS - 1)                           /**< Mask for the slot index of a level of the timing wheel. */
+#define WHEEL_LEVELS            4                                           /**< Number of levels in the timing wheel. */
+#define WHEEL_NULL              0xFF                                        /**< Empty timing wheel slot. */
+
+// The occupied slots of a wheel level are tracked in a 64-bit map, and the levels together must
+// cover the full range of the RTC counter.
+STATIC_ASSERT(WHEEL_SLOTS == 64);
+STATIC_ASSERT(WHEEL_SLOT_BITS * WHEEL_LEVELS >= 24);
+
 /**@brief Timer allocation state type. */
 typedef enum
 {
@@ -50,14 +63,19 @@ typedef struct
 {
     timer_alloc_state_t         state;                                      /**< Timer allocation state. */
     app_timer_mode_t            mode;                                       /**< Timer mode. */
-    uint32_t                    ticks_to_expire;                            /**< Number of ticks from previous timer interrupt to timer expiry. */
+    uint32_t                    ticks_to_expire;                            /**< Number of ticks from previous timer interrupt to timer expiry (wheel backend: wheel time of timer expiry). */
     uint32_t                    ticks_at_start;                             /**< Current RTC counter value when the timer was started. */
     uint32_t                    ticks_first_interval;                       /**< Number of ticks in the first timer interval. */
     uint32_t                    ticks_periodic_interval;                    /**< Timer period (for repeating timers). */
+    uint32_t                    ticks_slack;                                /**< Number of ticks the expiry may be delayed to share an RTC interrupt with other timers. */
     bool                        is_running;                                 /**< True if timer is running, False otherwise. */
     app_timer_timeout_handler_t p_timeout_handler;                          /**< Pointer to function to be executed when the timer expires. */
     void *                      p_context;                                  /**< General purpose pointer. Will be passed to the timeout handler when the timer expires. */
     app_timer_id_t              next;                                       /**< Id of next timer in list of running timers. */
+#if (APP_TIMER_BACKEND == APP_TIMER_BACKEND_WHEEL)
+    app_timer_id_t              prev;                                       /**< Id of previous timer in the same timing wheel slot. */
+    uint32_t                    slot;                                       /**< Timing wheel slot holding the timer (level * WHEEL_SLOTS + index). */
+#endif
 } timer_node_t;
 
 STATIC_ASSERT(sizeof(timer_node_t) <= APP_TIMER_NODE_SIZE);
@@ -78,6 +96,7 @@ typedef struct
     uint32_t ticks_at_start;                                                /**< Current RTC counter value when the timer was started. */
     uint32_t ticks_first_interval;                                          /**< Number of ticks in the first timer interval. */
     uint32_t ticks_periodic_interval;                                       /**< Timer period (for repeating timers). */
+    uint32_t ticks_slack;                                                   /**< Number of ticks the expiry may be delayed. */
     void *   p_context;                                                     /**< General purpose pointer. Will be passed to the timeout handler when the timer expires. */
 } timer_user_op_start_t;
 
@@ -130,11 +149,18 @@ static uint8_t                       m_node_array_size;
 static timer_node_t *                mp_nodes = NULL;                           /**< Array of timer nodes. */
 static uint8_t                       m_user_array_size;                         /**< Size of timer user array. */
 static timer_user_t *                mp_users;                                  /**< Array of timer users. */
-static app_timer_id_t                m_timer_id_head;                           /**< First timer in list of running timers. */
 static uint32_t                      m_ticks_latest;                            /**< Last known RTC counter value. */
+#if (APP_TIMER_BACKEND == APP_TIMER_BACKEND_WHEEL)
+static uint8_t                       m_wheel_head[WHEEL_LEVELS * WHEEL_SLOTS];  /**< First timer in each timing wheel slot. */
+static uint64_t                      m_wheel_map[WHEEL_LEVELS];                 /**< Occupied slots of each timing wheel level. */
+static uint8_t                       m_wheel_min[WHEEL_LEVELS * WHEEL_SLOTS];   /**< Timer with the earliest deadline (expiry plus slack) in each occupied timing wheel slot. */
+static uint32_t                      m_wheel_now;                               /**< Wheel time (extended RTC counter) corresponding to m_ticks_latest. */
+#else
+static app_timer_id_t                m_timer_id_head;                           /**< First timer in list of running timers. */
 static uint32_t                      m_ticks_elapsed[CONTEXT_QUEUE_SIZE_MAX];   /**< Timer internal elapsed ticks queue. */
 static uint8_t                       m_ticks_elapsed_q_read_ind;                /**< Timer internal elapsed ticks queue read index. */
 static uint8_t                       m_ticks_elapsed_q_write_ind;               /**< Timer internal elapsed ticks queue write index. */
+#endif
 static app_timer_evt_schedule_func_t m_evt_schedule_func;                       /**< Pointer to function for propagating timeout events to the scheduler. */
 static bool                          m_rtc1_running;                            /**< Boolean indicating if RTC1 is running. */
 
@@ -218,6 +244,7 @@ static __INLINE void rtc1_compare0_set(uint32_t value)
 }
 
 
+#if (APP_TIMER_BACKEND != APP_TIMER_BACKEND_WHEEL)
 /**@brief Function for inserting a timer in the timer list.
  *
  * @param[in]  timer_id   Id of timer to insert.
@@ -299,16 +326,12 @@ static void timer_list_remove(app_timer_id_t timer_id)
         return;
     }
 
-    // Timer is the first in the list
+    // Timer is the first in the list. When the list becomes empty the RTC is not stopped here, but
+    // by compare_reg_update() after the insertions: stopping it clears the counter, which the start
+    // time of a timer restarted from its own timeout handler was taken from.
     if (previous == current)
     {
         m_timer_id_head = mp_nodes[m_timer_id_head].next;
-
-        // No more timers in the list. Disable RTC1.
-        if (m_timer_id_head == TIMER_NULL)
-        {
-            rtc1_stop();
-        }
     }
 
     // Remaining timeout between next timeout.
@@ -326,6 +349,46 @@ static void timer_list_remove(app_timer_id_t timer_id)
 }
 
 
+/**@brief Function for computing the number of ticks until the next RTC1 interrupt is needed.
+ *
+ * @details This is the earliest expiry plus slack of all running timers. The list is only walked
+ *          until the timers expire after the earliest deadline found so far.
+ *
+ * @param[out] p_ticks_to_expire   Number of ticks from m_ticks_latest.
+ *
+ * @return     TRUE if any timer is running, FALSE otherwise.
+ */
+static bool timer_list_deadline_get(uint32_t * p_ticks_to_expire)
+{
+    app_timer_id_t timer_id;
+    uint32_t       ticks_to_expire;
+
+    if (m_timer_id_head == TIMER_NULL)
+    {
+        return false;
+    }
+
+    ticks_to_expire    = mp_nodes[m_timer_id_head].ticks_to_expire;
+    *p_ticks_to_expire = ticks_to_expire + mp_nodes[m_timer_id_head].ticks_slack;
+    timer_id           = mp_nodes[m_timer_id_head].next;
+
+    while (timer_id != TIMER_NULL)
+    {
+        ticks_to_expire += mp_nodes[timer_id].ticks_to_expire;
+        if (ticks_to_expire >= *p_ticks_to_expire)
+        {
+            break;
+        }
+
+        *p_ticks_to_expire = MIN(*p_ticks_to_expire, ticks_to_expire + mp_nodes[timer_id].ticks_slack);
+        timer_id           = mp_nodes[timer_id].next;
+    }
+
+    return true;
+}
+#endif // APP_TIMER_BACKEND != APP_TIMER_BACKEND_WHEEL
+
+
 /**@brief Function for scheduling a check for timeouts by generating a RTC1 interrupt.
  */
 static void timer_timeouts_check_sched(void)
@@ -361,6 +424,526 @@ static void timeout_handler_exec(timer_node_t * p_timer)
 }
 
 
+/**@brief Function for scheduling the next RTC1 interrupt.
+ *
+ * @param[in]  ticks_to_expire   Number of ticks from m_ticks_latest to the next timer expiry.
+ */
+static void compare_reg_set(uint32_t ticks_to_expire)
+{
+    uint32_t pre_counter_val = rtc1_counter_get();
+    uint32_t cc              = m_ticks_latest;
+    uint32_t ticks_elapsed   = ticks_diff_get(pre_counter_val, cc) + RTC_COMPARE_OFFSET_MIN;
+
+    if (!m_rtc1_running)
+    {
+        // No timers were already running, start RTC
+        rtc1_start();
+    }
+
+    cc += (ticks_elapsed < ticks_to_expire) ? ticks_to_expire : ticks_elapsed;
+    cc &= MAX_RTC_COUNTER_VAL;
+    
+    rtc1_compare0_set(cc);
+
+    uint32_t post_counter_val = rtc1_counter_get();
+
+    if (
+        (ticks_diff_get(post_counter_val, pre_counter_val) + RTC_COMPARE_OFFSET_MIN)
+        >
+        ticks_diff_get(cc, pre_counter_val)
+       )
+    {
+        // When this happens the COMPARE event may not be triggered by the RTC.
+        // The nRF51 Series User Specification states that if the COUNTER value is N
+        // (i.e post_counter_val = N), writing N or N+1 to a CC register may not trigger a
+        // COMPARE event. Hence the RTC interrupt is forcefully pended by calling the following
+        // function.
+        timer_timeouts_check_sched();
+    }
+}
+
+
+/**@brief Function for computing the number of ticks from m_ticks_latest to the first expiry of a
+ *        timer being started.
+ *
+ * @param[in]  p_timer   Timer being started, with ticks_at_start and ticks_first_interval set.
+ *
+ * @return     Number of ticks to the first expiry (0 if the first interval has already elapsed).
+ */
+static uint32_t timer_first_expiry_get(timer_node_t * p_timer)
+{
+    if (
+         ((p_timer->ticks_at_start - m_ticks_latest) & MAX_RTC_COUNTER_VAL)
+         <
+         (MAX_RTC_COUNTER_VAL / 2)
+        )
+    {
+        return ticks_diff_get(p_timer->ticks_at_start, m_ticks_latest) + 
+               p_timer->ticks_first_interval;
+    }
+    else
+    {
+        uint32_t delta_current_start;
+
+        delta_current_start = ticks_diff_get(m_ticks_latest, p_timer->ticks_at_start);
+        if (p_timer->ticks_first_interval > delta_current_start)
+        {
+            return p_timer->ticks_first_interval - delta_current_start;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+}
+
+
+#if (APP_TIMER_BACKEND == APP_TIMER_BACKEND_WHEEL)
+/**@brief Function for getting the deadline of a timer in the timing wheel, its expiry plus slack.
+ *
+ * @param[in]  timer_id   Id of timer.
+ *
+ * @return     Number of ticks from the current wheel time.
+ */
+static uint32_t wheel_deadline_get(app_timer_id_t timer_id)
+{
+    return (mp_nodes[timer_id].ticks_to_expire - m_wheel_now) + mp_nodes[timer_id].ticks_slack;
+}
+
+
+/**@brief Function for finding the timing wheel slot for a given expiry.
+ *
+ * @details The timer is placed in the lowest level where its expiry shares all higher order bits
+ *          with the current wheel time, in the slot given by the expiry bits of that level. Timers
+ *          beyond the range of the top level are placed in the top level slot given by their
+ *          expiry bits, and are put back there when it is cascaded until they get within range.
+ *
+ * @param[in]  ticks_expiry   Wheel time of timer expiry.
+ *
+ * @return     Timing wheel slot (level * WHEEL_SLOTS + index).
+ */
+static uint32_t wheel_slot_get(uint32_t ticks_expiry)
+{
+    uint32_t ticks_diff = ticks_expiry ^ m_wheel_now;
+    uint32_t level      = 0;
+
+    while ((level < WHEEL_LEVELS - 1) && ((ticks_diff >> (WHEEL_SLOT_BITS * (level + 1))) != 0))
+    {
+        level++;
+    }
+
+    return (level * WHEEL_SLOTS) + ((ticks_expiry >> (WHEEL_SLOT_BITS * level)) & WHEEL_SLOT_MASK);
+}
+
+
+/**@brief Function for inserting a timer in the timing wheel.
+ *
+ * @param[in]  timer_id   Id of timer to insert. ticks_to_expire must hold the wheel time of expiry.
+ */
+static void wheel_insert(app_timer_id_t timer_id)
+{
+    timer_node_t * p_timer = &mp_nodes[timer_id];
+    uint32_t       slot    = wheel_slot_get(p_timer->ticks_to_expire);
+    uint8_t        head    = m_wheel_head[slot];
+
+    p_timer->slot = slot;
+    p_timer->prev = TIMER_NULL;
+    p_timer->next = (head != WHEEL_NULL) ? head : TIMER_NULL;
+
+    if (head != WHEEL_NULL)
+    {
+        mp_nodes[head].prev = timer_id;
+    }
+
+    if ((head == WHEEL_NULL) ||
+        (wheel_deadline_get(timer_id) < wheel_deadline_get(m_wheel_min[slot])))
+    {
+        m_wheel_min[slot] = (uint8_t)timer_id;
+    }
+
+    m_wheel_head[slot]               = (uint8_t)timer_id;
+    m_wheel_map[slot / WHEEL_SLOTS] |= ((uint64_t)1 << (slot & WHEEL_SLOT_MASK));
+}
+
+
+/**@brief Function for removing a timer from the timing wheel.
+ *
+ * @param[in]  timer_id   Id of timer to remove.
+ */
+static void wheel_remove(app_timer_id_t timer_id)
+{
+    timer_node_t * p_timer = &mp_nodes[timer_id];
+
+    if (p_timer->prev != TIMER_NULL)
+    {
+        mp_nodes[p_timer->prev].next = p_timer->next;
+    }
+    else if (p_timer->next != TIMER_NULL)
+    {
+        m_wheel_head[p_timer->slot] = (uint8_t)p_timer->next;
+    }
+    else
+    {
+        // Last timer in the slot.
+        m_wheel_head[p_timer->slot]               = WHEEL_NULL;
+        m_wheel_map[p_timer->slot / WHEEL_SLOTS] &= ~((uint64_t)1 << (p_timer->slot & WHEEL_SLOT_MASK));
+    }
+
+    if (p_timer->next != TIMER_NULL)
+    {
+        mp_nodes[p_timer->next].prev = p_timer->prev;
+    }
+
+    // Only the removal of the timer with the earliest deadline requires a walk of the slot.
+    if ((m_wheel_min[p_timer->slot] == timer_id) && (m_wheel_head[p_timer->slot] != WHEEL_NULL))
+    {
+        app_timer_id_t id = m_wheel_head[p_timer->slot];
+
+        m_wheel_min[p_timer->slot] = (uint8_t)id;
+        for (id = mp_nodes[id].next; id != TIMER_NULL; id = mp_nodes[id].next)
+        {
+            if (wheel_deadline_get(id) < wheel_deadline_get(m_wheel_min[p_timer->slot]))
+            {
+                m_wheel_min[p_timer->slot] = (uint8_t)id;
+            }
+        }
+    }
+}
+
+
+/**@brief Function for detaching all timers from a timing wheel slot.
+ *
+ * @param[in]  slot   Timing wheel slot to empty.
+ *
+ * @return     Id of first timer in the detached slot list, TIMER_NULL if the slot was empty.
+ */
+static app_timer_id_t wheel_slot_detach(uint32_t slot)
+{
+    uint8_t head = m_wheel_head[slot];
+
+    if (head == WHEEL_NULL)
+    {
+        return TIMER_NULL;
+    }
+
+    m_wheel_head[slot]               = WHEEL_NULL;
+    m_wheel_map[slot / WHEEL_SLOTS] &= ~((uint64_t)1 << (slot & WHEEL_SLOT_MASK));
+
+    return head;
+}
+
+
+/**@brief Function for finding the next occupied slot of a timing wheel level.
+ *
+ * @param[in]  level   Timing wheel level.
+ * @param[in]  index   Current slot index of the level.
+ *
+ * @return     Number of slots (1 to WHEEL_SLOTS) from index to the next occupied slot, 0 if the
+ *             level is empty.
+ */
+static uint32_t wheel_slot_distance_get(uint32_t level, uint32_t index)
+{
+    uint64_t map      = m_wheel_map[level];
+    uint32_t shift    = (index + 1) & WHEEL_SLOT_MASK;
+    uint32_t distance = 1;
+
+    if (map == 0)
+    {
+        return 0;
+    }
+
+    // Rotate the map so that bit 0 is the slot following index.
+    map = (map >> shift) | (map << ((WHEEL_SLOTS - shift) & WHEEL_SLOT_MASK));
+
+    while ((map & 0xFF) == 0)
+    {
+        map      >>= 8;
+        distance  += 8;
+    }
+    while ((map & 1) == 0)
+    {
+        map      >>= 1;
+        distance  += 1;
+    }
+
+    return distance;
+}
+
+
+/**@brief Function for computing the number of ticks until the timing wheel must be serviced.
+ *
+ * @details This is the time until the next occupied level 0 slot expires or the next occupied
+ *          higher level slot must be cascaded, whichever comes first.
+ *
+ * @param[out] p_ticks_to_expire   Number of ticks from the current wheel time.
+ *
+ * @return     TRUE if any timer is running, FALSE otherwise.
+ */
+static bool wheel_next_expiry_get(uint32_t * p_ticks_to_expire)
+{
+    bool     is_running = false;
+    uint32_t level;
+
+    *p_ticks_to_expire = UINT32_MAX;
+
+    for (level = 0; level < WHEEL_LEVELS; level++)
+    {
+        uint32_t shift = WHEEL_SLOT_BITS * level;
+        uint32_t slots = wheel_slot_distance_get(level, (m_wheel_now >> shift) & WHEEL_SLOT_MASK);
+
+        if (slots != 0)
+        {
+            uint32_t ticks = (((m_wheel_now >> shift) + slots) << shift) - m_wheel_now;
+
+            *p_ticks_to_expire = MIN(*p_ticks_to_expire, ticks);
+            is_running         = true;
+        }
+    }
+
+    return is_running;
+}
+
+
+/**@brief Function for computing the number of ticks until the next RTC1 interrupt is needed.
+ *
+ * @details This is the earliest expiry plus slack of all running timers. The occupied slots of
+ *          each level are visited in order, until a slot starts after the earliest deadline found
+ *          so far. Only the timer with the earliest deadline of each visited slot is looked at.
+ *
+ * @param[out] p_ticks_to_expire   Number of ticks from the current wheel time.
+ *
+ * @return     TRUE if any timer is running, FALSE otherwise.
+ */
+static bool wheel_next_deadline_get(uint32_t * p_ticks_to_expire)
+{
+    bool     is_running = false;
+    uint32_t level;
+
+    for (level = 0; level < WHEEL_LEVELS; level++)
+    {
+        uint32_t shift = WHEEL_SLOT_BITS * level;
+        uint32_t index = (m_wheel_now >> shift) & WHEEL_SLOT_MASK;
+        uint32_t slots = wheel_slot_distance_get(level, index);
+
+        while ((slots != 0) && (slots <= WHEEL_SLOTS))
+        {
+            uint32_t slot_start = (((m_wheel_now >> shift) + slots) << shift) - m_wheel_now;
+            uint32_t deadline;
+
+            // All timers in this and later slots of the level expire after the deadline.
+            if (is_running && (slot_start >= *p_ticks_to_expire))
+            {
+                break;
+            }
+
+            deadline = wheel_deadline_get(m_wheel_min[(level * WHEEL_SLOTS) +
+                                                      ((index + slots) & WHEEL_SLOT_MASK)]);
+            if (!is_running || (deadline < *p_ticks_to_expire))
+            {
+                *p_ticks_to_expire = deadline;
+            }
+            is_running = true;
+
+            slots += wheel_slot_distance_get(level, (index + slots) & WHEEL_SLOT_MASK);
+        }
+    }
+
+    return is_running;
+}
+
+
+/**@brief Function for servicing the timing wheel at the current wheel time.
+ *
+ * @details Cascades the slots of all levels whose boundary has been reached, highest level first,
+ *          and then expires the timers in the current level 0 slot. Repeating timers are put back
+ *          in the wheel before their timeout handler is executed.
+ */
+static void wheel_slot_process(void)
+{
+    app_timer_id_t timer_id;
+    uint32_t       level;
+
+    for (level = WHEEL_LEVELS - 1; level > 0; level--)
+    {
+        uint32_t shift = WHEEL_SLOT_BITS * level;
+
+        if ((m_wheel_now & ((1UL << shift) - 1)) == 0)
+        {
+            timer_id = wheel_slot_detach((level * WHEEL_SLOTS) +
+                                         ((m_wheel_now >> shift) & WHEEL_SLOT_MASK));
+            while (timer_id != TIMER_NULL)
+            {
+                app_timer_id_t next = mp_nodes[timer_id].next;
+
+                wheel_insert(timer_id);
+                timer_id = next;
+            }
+        }
+    }
+
+    timer_id = wheel_slot_detach(m_wheel_now & WHEEL_SLOT_MASK);
+    while (timer_id != TIMER_NULL)
+    {
+        timer_node_t * p_timer = &mp_nodes[timer_id];
+        app_timer_id_t next    = p_timer->next;
+
+        if (p_timer->ticks_periodic_interval != 0)
+        {
+            p_timer->ticks_to_expire += p_timer->ticks_periodic_interval;
+            wheel_insert(timer_id);
+        }
+        else
+        {
+            p_timer->is_running = false;
+        }
+
+        timeout_handler_exec(p_timer);
+        timer_id = next;
+    }
+}
+
+
+/**@brief Function for updating the Capture Compare register from the timing wheel.
+ *
+ * @details When the wheel is empty the RTC is not stopped here, but by the timer list handler.
+ *          Timers started from timeout handlers are still in the operation queues, and stopping
+ *          the RTC would clear the counter their start time was taken from.
+ */
+static void wheel_compare_update(void)
+{
+    uint32_t ticks_to_expire;
+
+    if (wheel_next_deadline_get(&ticks_to_expire))
+    {
+        // Slots far ahead are serviced early rather than beyond the range of the RTC counter.
+        compare_reg_set(MIN(ticks_to_expire, MAX_RTC_COUNTER_VAL / 2));
+    }
+    else
+    {
+        timer_list_handler_sched();
+    }
+}
+
+
+/**@brief Function for checking for expired timers.
+ *
+ * @details Advances the timing wheel to the current RTC counter value, only visiting the slots
+ *          that hold timers.
+ */
+static void timer_timeouts_check(void)
+{
+    uint32_t ticks_now     = rtc1_counter_get();
+    uint32_t ticks_elapsed = ticks_diff_get(ticks_now, m_ticks_latest);
+    uint32_t ticks_to_expire;
+
+    while (wheel_next_expiry_get(&ticks_to_expire) && (ticks_to_expire <= ticks_elapsed))
+    {
+        m_wheel_now   += ticks_to_expire;
+        ticks_elapsed -= ticks_to_expire;
+
+        wheel_slot_process();
+    }
+
+    m_wheel_now   += ticks_elapsed;
+    m_ticks_latest = ticks_now;
+
+    wheel_compare_update();
+}
+
+
+/**@brief Function for handling the timer operations queued by all users.
+ */
+static void timer_list_handler(void)
+{
+    uint8_t  user_id = m_user_array_size;
+    uint32_t ticks_to_expire_old;
+    uint32_t ticks_to_expire_new;
+    bool     was_running;
+    bool     is_running;
+
+    // Remember the next deadline, so as to decide if new compare needs to be set.
+    was_running = wheel_next_deadline_get(&ticks_to_expire_old);
+
+    while (user_id--)
+    {
+        timer_user_t * p_user = &mp_users[user_id];
+
+        while (p_user->first != p_user->last)
+        {
+            timer_user_op_t * p_user_op = &p_user->p_user_op_queue[p_user->first];
+            timer_node_t *    p_timer;
+            uint32_t          i;
+
+            switch (p_user_op->op_type)
+            {
+                case TIMER_USER_OP_TYPE_START:
+                    p_timer = &mp_nodes[p_user_op->timer_id];
+                    if (!p_timer->is_running)
+                    {
+                        uint32_t ticks_to_expire;
+
+                        p_timer->ticks_at_start          = p_user_op->params.start.ticks_at_start;
+                        p_timer->ticks_first_interval    = p_user_op->params.start.ticks_first_interval;
+                        p_timer->ticks_periodic_interval = p_user_op->params.start.ticks_periodic_interval;
+                        p_timer->ticks_slack             = p_user_op->params.start.ticks_slack;
+                        p_timer->p_context               = p_user_op->params.start.p_context;
+
+                        // A timer already due expires at the next wheel tick.
+                        ticks_to_expire          = timer_first_expiry_get(p_timer);
+                        p_timer->ticks_to_expire = m_wheel_now + MAX(ticks_to_expire, 1);
+                        p_timer->is_running      = true;
+
+                        wheel_insert(p_user_op->timer_id);
+                    }
+                    break;
+
+                case TIMER_USER_OP_TYPE_STOP:
+                    p_timer = &mp_nodes[p_user_op->timer_id];
+                    if (p_timer->is_running)
+                    {
+                        wheel_remove(p_user_op->timer_id);
+                        p_timer->is_running = false;
+                    }
+                    break;
+
+                case TIMER_USER_OP_TYPE_STOP_ALL:
+                    for (i = 0; i < m_node_array_size; i++)
+                    {
+                        mp_nodes[i].is_running = false;
+                    }
+                    memset(m_wheel_head, WHEEL_NULL, sizeof(m_wheel_head));
+                    memset(m_wheel_map, 0, sizeof(m_wheel_map));
+                    break;
+
+                default:
+                    // No implementation needed.
+                    break;
+            }
+
+            // Release the queue entry only after it has been read.
+            p_user->first++;
+            if (p_user->first == p_user->user_op_queue_size)
+            {
+                p_user->first = 0;
+            }
+        }
+    }
+
+    is_running = wheel_next_deadline_get(&ticks_to_expire_new);
+    if (!is_running)
+    {
+        if (m_rtc1_running)
+        {
+            // No timers are running, stop RTC
+            rtc1_stop();
+        }
+    }
+    else if (!was_running || (ticks_to_expire_new != ticks_to_expire_old))
+    {
+        wheel_compare_update();
+    }
+}
+#else
 /**@brief Function for checking for expired timers.
  */
 static void timer_timeouts_check(void)
@@ -632,34 +1215,12 @@ static bool list_insertions_handler(app_timer_id_t restart_list_head)
                 p_timer->ticks_at_start          = p_user_op->params.start.ticks_at_start;
                 p_timer->ticks_first_interval    = p_user_op->params.start.ticks_first_interval;
                 p_timer->ticks_periodic_interval = p_user_op->params.start.ticks_periodic_interval;
+                p_timer->ticks_slack             = p_user_op->params.start.ticks_slack;
                 p_timer->p_context               = p_user_op->params.start.p_context;
             }
 
             // Prepare the node to be inserted 
-            if (
-                 ((p_timer->ticks_at_start - m_ticks_latest) & MAX_RTC_COUNTER_VAL)
-                 <
-                 (MAX_RTC_COUNTER_VAL / 2)
-                )
-            {
-                p_timer->ticks_to_expire = ticks_diff_get(p_timer->ticks_at_start, m_ticks_latest) + 
-                                           p_timer->ticks_first_interval;
-            }
-            else
-            {
-                uint32_t delta_current_start;
-
-                delta_current_start = ticks_diff_get(m_ticks_latest, p_timer->ticks_at_start);
-                if (p_timer->ticks_first_interval > delta_current_start)
-                {
-                    p_timer->ticks_to_expire = p_timer->ticks_first_interval - delta_current_start;
-                }
-                else
-                {
-                    p_timer->ticks_to_expire = 0;
-                }
-            }
-
+            p_timer->ticks_to_expire      = timer_first_expiry_get(p_timer);
             p_timer->ticks_at_start       = 0;
             p_timer->ticks_first_interval = 0;
             p_timer->is_running           = true;
@@ -678,40 +1239,12 @@ static bool list_insertions_handler(app_timer_id_t restart_list_head)
  */
 static void compare_reg_update(app_timer_id_t timer_id_head_old)
 {
-    // Setup the timeout for timers on the head of the list 
-    if (m_timer_id_head != TIMER_NULL)
-    {
-        uint32_t ticks_to_expire = mp_nodes[m_timer_id_head].ticks_to_expire;
-        uint32_t pre_counter_val = rtc1_counter_get();
-        uint32_t cc              = m_ticks_latest;
-        uint32_t ticks_elapsed   = ticks_diff_get(pre_counter_val, cc) + RTC_COMPARE_OFFSET_MIN;
-
-        if (!m_rtc1_running)
-        {
-            // No timers were already running, start RTC
-            rtc1_start();
-        }
-
-        cc += (ticks_elapsed < ticks_to_expire) ? ticks_to_expire : ticks_elapsed;
-        cc &= MAX_RTC_COUNTER_VAL;
-        
-        rtc1_compare0_set(cc);
-
-        uint32_t post_counter_val = rtc1_counter_get();
+    uint32_t ticks_to_expire;
 
-        if (
-            (ticks_diff_get(post_counter_val, pre_counter_val) + RTC_COMPARE_OFFSET_MIN)
-            >
-            ticks_diff_get(cc, pre_counter_val)
-           )
-        {
-            // When this happens the COMPARE event may not be triggered by the RTC.
-            // The nRF51 Series User Specification states that if the COUNTER value is N
-            // (i.e post_counter_val = N), writing N or N+1 to a CC register may not trigger a
-            // COMPARE event. Hence the RTC interrupt is forcefully pended by calling the following
-            // function.
-            timer_timeouts_check_sched();
-        }
+    // Setup the timeout for timers on the head of the list, delayed within their slack
+    if (timer_list_deadline_get(&ticks_to_expire))
+    {
+        compare_reg_set(ticks_to_expire);
     }
     else
     {
@@ -731,10 +1264,14 @@ static void timer_list_handler(void)
     bool           ticks_have_elapsed;
     bool           compare_update;
     app_timer_id_t timer_id_head_old;
+    uint32_t       deadline_old;
+    uint32_t       deadline_new;
+    bool           deadline_old_valid;
     
     // Back up the previous known tick and previous list head
-    ticks_previous    = m_ticks_latest;
-    timer_id_head_old = m_timer_id_head;
+    ticks_previous     = m_ticks_latest;
+    timer_id_head_old  = m_timer_id_head;
+    deadline_old_valid = timer_list_deadline_get(&deadline_old);
     
     // Get number of elapsed ticks
     ticks_have_elapsed = elapsed_ticks_acquire(&ticks_elapsed);
@@ -755,12 +1292,19 @@ static void timer_list_handler(void)
         compare_update = true;
     }
 
+    // A timer inserted behind the head may have a deadline before the current one
+    if (!compare_update && deadline_old_valid && timer_list_deadline_get(&deadline_new))
+    {
+        compare_update = (deadline_new != deadline_old);
+    }
+
     // Update compare register if necessary
     if (compare_update)
     {
         compare_reg_update(timer_id_head_old);
     }
 }
+#endif // APP_TIMER_BACKEND == APP_TIMER_BACKEND_WHEEL
 
 
 /**@brief Function for enqueueing a new operations queue entry.
@@ -811,6 +1355,7 @@ static timer_user_op_t * user_op_alloc(timer_user_t * p_user, app_timer_id_t * p
  * @param[in]  timer_id          Id of timer to start.
  * @param[in]  timeout_initial   Time (in ticks) to first timer expiry.
  * @param[in]  timeout_periodic  Time (in ticks) between periodic expiries.
+ * @param[in]  timeout_slack     Time (in ticks) each expiry may be delayed.
  * @param[in]  p_context         General purpose pointer. Will be passed to the timeout handler when
  *                               the timer expires.
  * @return     NRF_SUCCESS on success, otherwise an error code.
@@ -819,6 +1364,7 @@ static uint32_t timer_start_op_schedule(timer_user_id_t user_id,
                                         app_timer_id_t  timer_id,
                                         uint32_t        timeout_initial,
                                         uint32_t        timeout_periodic,
+                                        uint32_t        timeout_slack,
                                         void *          p_context)
 {
     app_timer_id_t last_index;
@@ -834,6 +1380,7 @@ static uint32_t timer_start_op_schedule(timer_user_id_t user_id,
     p_user_op->params.start.ticks_at_start          = rtc1_counter_get();
     p_user_op->params.start.ticks_first_interval    = timeout_initial;
     p_user_op->params.start.ticks_periodic_interval = timeout_periodic;
+    p_user_op->params.start.ticks_slack             = timeout_slack;
     p_user_op->params.start.p_context               = p_context;
     
     user_op_enque(&mp_users[user_id], last_index);    
@@ -985,9 +1532,15 @@ uint32_t app_timer_init(uint32_t                      prescaler,
         p_buffer = &((uint8_t *)p_buffer)[op_queues_size * sizeof(timer_user_op_t)];
     }
 
+#if (APP_TIMER_BACKEND == APP_TIMER_BACKEND_WHEEL)
+    memset(m_wheel_head, WHEEL_NULL, sizeof(m_wheel_head));
+    memset(m_wheel_map, 0, sizeof(m_wheel_map));
+    m_wheel_now = 0;
+#else
     m_timer_id_head             = TIMER_NULL;
     m_ticks_elapsed_q_read_ind  = 0;
     m_ticks_elapsed_q_write_ind = 0;
+#endif
 
     NVIC_ClearPendingIRQ(SWI0_IRQn);
     NVIC_SetPriority(SWI0_IRQn, SWI0_IRQ_PRI);
@@ -1069,6 +1622,15 @@ static timer_user_id_t user_id_get(void)
 
 
 uint32_t app_timer_start(app_timer_id_t timer_id, uint32_t timeout_ticks, void * p_context)
+{
+    return app_timer_start_with_slack(timer_id, timeout_ticks, 0, p_context);
+}
+
+
+uint32_t app_timer_start_with_slack(app_timer_id_t timer_id,
+                                    uint32_t       timeout_ticks,
+                                    uint32_t       slack_ticks,
+                                    void *         p_context)
 {
     uint32_t timeout_periodic;
     
@@ -1081,6 +1643,10 @@ uint32_t app_timer_start(app_timer_id_t timer_id, uint32_t timeout_ticks, void *
     {
         return NRF_ERROR_INVALID_PARAM;
     }
+    if (slack_ticks >= timeout_ticks)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
     if (mp_nodes[timer_id].state != STATE_ALLOCATED)
     {
         return NRF_ERROR_INVALID_STATE;
@@ -1093,6 +1659,7 @@ uint32_t app_timer_start(app_timer_id_t timer_id, uint32_t timeout_ticks, void *
                                    timer_id,
                                    timeout_ticks,
                                    timeout_periodic,
+                                   slack_ticks,
                                    p_context);
 }
 
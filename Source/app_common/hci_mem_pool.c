@@ -12,9 +12,13 @@
  
 #include "hci_mem_pool.h"
 #include "hci_mem_pool_internal.h"
+#include "app_util.h"
 #include <stdbool.h>
 #include <stdio.h>
 
+// TX buffers are allocated round robin with an index masked by TX_BUF_QUEUE_SIZE - 1.
+STATIC_ASSERT(IS_POWER_OF_TWO(TX_BUF_QUEUE_SIZE));
+
 /**@brief RX buffer element instance structure. 
  */
 typedef struct 
@@ -36,14 +40,17 @@ typedef struct
     uint32_t           free_index;                                  /**< Free position index. */                                                                                                                  
 } rx_buffer_queue_t;
 
-static bool              m_is_tx_allocated;                         /**< Boolean value to determine if the TX buffer is allocated. */
+static uint8_t           m_tx_buffer[TX_BUF_QUEUE_SIZE][TX_BUF_SIZE]; /**< TX buffer memory arrays. */
+static uint32_t          m_tx_alloc_count;                          /**< Number of allocated TX buffers. */
+static uint32_t          m_tx_alloc_index;                          /**< Index of the TX buffer to be allocated next. */
 static rx_buffer_elem_t  m_rx_buffer_elem_queue[RX_BUF_QUEUE_SIZE]; /**< RX buffer element instances. */
 static rx_buffer_queue_t m_rx_buffer_queue;                         /**< RX buffer queue element instance. */
 
 
 uint32_t hci_mem_pool_open(void)
 {
-    m_is_tx_allocated                      = false;    
+    m_tx_alloc_count                       = 0;
+    m_tx_alloc_index                       = 0;
     m_rx_buffer_queue.p_buffer             = m_rx_buffer_elem_queue;
     m_rx_buffer_queue.free_window_count    = RX_BUF_QUEUE_SIZE;
     m_rx_buffer_queue.free_available_count = 0;
@@ -64,8 +71,6 @@ uint32_t hci_mem_pool_close(void)
 
 uint32_t hci_mem_pool_tx_alloc(void ** pp_buffer)
 {
-    static uint8_t tx_buffer[TX_BUF_SIZE];  
-
     uint32_t err_code;
     
     if (pp_buffer == NULL)
@@ -73,11 +78,12 @@ uint32_t hci_mem_pool_tx_alloc(void ** pp_buffer)
         return NRF_ERROR_NULL;
     }
     
-    if (!m_is_tx_allocated)
+    if (m_tx_alloc_count != TX_BUF_QUEUE_SIZE)
     {        
-            m_is_tx_allocated = true;
-            *pp_buffer        = tx_buffer;
-            err_code          = NRF_SUCCESS;
+            ++m_tx_alloc_count;
+            *pp_buffer       = m_tx_buffer[m_tx_alloc_index];
+            m_tx_alloc_index = (m_tx_alloc_index + 1u) & (TX_BUF_QUEUE_SIZE - 1u);
+            err_code         = NRF_SUCCESS;
     }
     else
     {
@@ -90,7 +96,12 @@ uint32_t hci_mem_pool_tx_alloc(void ** pp_buffer)
 
 uint32_t hci_mem_pool_tx_free(void)
 {
-    m_is_tx_allocated = false;
+    // @note: buffers are freed in the order they were allocated, the oldest allocated buffer is 
+    // located at m_tx_alloc_index minus m_tx_alloc_count.
+    if (m_tx_alloc_count != 0)
+    {
+        --m_tx_alloc_count;
+    }
     
     return NRF_SUCCESS;
 }
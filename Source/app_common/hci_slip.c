@@ -14,12 +14,10 @@
 #include <stdlib.h>
 #include "hci_transport_config.h"
 #include "app_uart.h"
+#include "slip.h"
 #include "nrf51_bitfields.h"
 
-#define APP_SLIP_END        0xC0                            /**< SLIP code for identifying the beginning and end of a packet frame.. */
-#define APP_SLIP_ESC        0xDB                            /**< SLIP escape code. This code is used to specify that the following character is specially encoded. */
-#define APP_SLIP_ESC_END    0xDC                            /**< SLIP special code. When this code follows 0xDB, this character is interpreted as payload data 0xC0.. */
-#define APP_SLIP_ESC_ESC    0xDD                            /**< SLIP special code. When this code follows 0xDB, this character is interpreted as payload data 0xDB. */
+#define TX_CHUNK_SIZE       16                              /**< Size of the buffer for SLIP encoded bytes waiting to be transferred to the UART. */
 
 /** @brief States for the SLIP state machine. */
 typedef enum
@@ -36,127 +34,28 @@ static hci_slip_event_handler_t m_slip_event_handler;       /** Event callback f
 
 static const uint8_t *          mp_tx_buffer;               /** Pointer to the current TX buffer that is in transmission. */
 static uint32_t                 m_tx_buffer_length;         /** Length of the current TX buffer that is in transmission. */
-static volatile uint32_t        m_tx_buffer_index;          /** Current index for next byte to transmit in the mp_tx_buffer. */
+static slip_encoder_t           m_tx_encoder;               /** SLIP encoder of the current TX buffer. */
+static uint8_t                  m_tx_chunk[TX_CHUNK_SIZE];  /** SLIP encoded bytes to transfer to the UART. */
+static uint32_t                 m_tx_chunk_length;          /** Number of bytes in m_tx_chunk. */
+static uint32_t                 m_tx_chunk_index;           /** Index of the next byte of m_tx_chunk to transfer to the UART. */
+static bool                     m_tx_end_encoded;           /** The SLIP end byte of the packet has been added to m_tx_chunk. */
 
-static uint8_t *                mp_rx_buffer;               /** Pointer to the current RX buffer where the next SLIP decoded packet will be stored. */
-static uint32_t                 m_rx_buffer_length;         /** Length of the current RX buffer. */
-static uint32_t                 m_rx_received_count;        /** Number of SLIP decoded bytes received and stored in mp_rx_buffer. */
+static slip_decoder_t           m_rx_decoder;               /** SLIP decoder of the current RX buffer where the next SLIP decoded packet will be stored. */
 
 
-/**@brief Function for parsing bytes received on the UART until a SLIP escape byte is received.
- *
- * @param[in]  byte  Byte received in UART module.
- */
-static void handle_rx_byte_default(uint8_t byte);
-
-/**@brief Function for parsing bytes received on the UART until SLIP end byte is received.
- *
- * @param[in]  byte  Byte received in UART module.
- */
-static void handle_rx_byte_wait_start(uint8_t byte);
-
-/**@brief Function for decoding a received SLIP escape byte.
- *        It will ensure correct decoding of the byte following the SLIP escape byte.
- *
- * @param[in]  byte  Byte received in UART module.
- */
-static void handle_rx_byte_esc(uint8_t byte);
-
-/**@brief Function pointer for parsing and decoding SLIP bytes from the UART module.
- *
- * @param[in]  byte  Byte received in UART module.
- */
-static void (*handle_rx_byte) (uint8_t byte) = handle_rx_byte_wait_start;
-
-/**@brief Function pointer for sending a byte through the UART module.
- */
-static uint32_t send_tx_byte_default(void);
-
-/**@brief Function for transferring a SLIP escape byte (0xDB) when special bytes are transferred,
- *        that is 0xC0 and 0xDB.
- */
-static uint32_t send_tx_byte_esc(void);
-
-/**@brief Function for transferring a byte when it collides with SLIP commands and follows the SLIP
- *        escape byte, that is 0xC0 => 0xDC and 0xDB => 0xDD.
- */
-static uint32_t send_tx_byte_encoded(void);
-
-/**@brief Function for transferring the SLIP end frame byte, 0xC0.
- */
-static uint32_t send_tx_byte_end(void);
-
-/**@brief Function pointer for sending a byte through the UART module.
+/** @brief Function for filling m_tx_chunk with the next SLIP encoded bytes of the current packet,
+ *         including the SLIP end byte following the packet.
  */
-uint32_t (*send_tx_byte) (void) = send_tx_byte_default;
-
-
-static uint32_t send_tx_byte_end(void)
+static void tx_chunk_fill(void)
 {
-    uint32_t err_code = app_uart_put(APP_SLIP_END);
+    m_tx_chunk_index  = 0;
+    m_tx_chunk_length = slip_encode(&m_tx_encoder, m_tx_chunk, sizeof(m_tx_chunk));
 
-    if ((err_code == NRF_SUCCESS) && (m_tx_buffer_index == 0))
+    if (slip_encoder_is_done(&m_tx_encoder) && (m_tx_chunk_length < sizeof(m_tx_chunk)))
     {
-        // Packet transmission started.
-        send_tx_byte = send_tx_byte_default;
+        m_tx_chunk[m_tx_chunk_length++] = SLIP_END;
+        m_tx_end_encoded                = true;
     }
-
-    return err_code;
-}
-
-
-static uint32_t send_tx_byte_default(void)
-{
-    uint32_t err_code = app_uart_put(mp_tx_buffer[m_tx_buffer_index]);
-
-    if (err_code == NRF_SUCCESS)
-    {
-        m_tx_buffer_index++;
-    }
-
-    return err_code;
-}
-
-
-static uint32_t send_tx_byte_encoded(void)
-{
-    uint32_t err_code;
-
-    switch(mp_tx_buffer[m_tx_buffer_index])
-    {
-        case APP_SLIP_END:
-            err_code = app_uart_put(APP_SLIP_ESC_END);
-            break;
-
-        case APP_SLIP_ESC:
-            err_code = app_uart_put(APP_SLIP_ESC_ESC);
-            break;
-
-        default:
-            err_code = NRF_ERROR_NO_MEM;
-            break;
-    }
-
-    if (err_code == NRF_SUCCESS)
-    {
-        m_tx_buffer_index++;
-        send_tx_byte = send_tx_byte_default;
-    }
-
-    return err_code;
-}
-
-
-static uint32_t send_tx_byte_esc(void)
-{
-    uint32_t err_code = app_uart_put(APP_SLIP_ESC);
-
-    if (err_code == NRF_SUCCESS)
-    {
-        send_tx_byte = send_tx_byte_encoded;
-    }
-
-    return err_code;
 }
 
 
@@ -166,144 +65,103 @@ static uint32_t send_tx_byte_esc(void)
  */
 static void transmit_buffer(void)
 {
-    uint32_t err_code = NRF_SUCCESS;
+    uint32_t err_code;
 
-    while (m_tx_buffer_index < m_tx_buffer_length)
+    for (;;)
     {
-        if ((mp_tx_buffer[m_tx_buffer_index] == APP_SLIP_END  ||
-             mp_tx_buffer[m_tx_buffer_index] == APP_SLIP_ESC) &&
-             send_tx_byte == send_tx_byte_default)
+        if (m_tx_chunk_index == m_tx_chunk_length)
         {
-            send_tx_byte = send_tx_byte_esc;
+            if (m_tx_end_encoded)
+            {
+                break;
+            }
+            tx_chunk_fill();
         }
 
-        err_code = send_tx_byte();
+        err_code = app_uart_put(m_tx_chunk[m_tx_chunk_index]);
 
         if (err_code == NRF_ERROR_NO_MEM)
         {
             // No memory left in UART TX buffer. Abort and wait for APP_UART_TX_EMPTY to continue.
             return;
         }
+        m_tx_chunk_index++;
     }
 
-    send_tx_byte = send_tx_byte_end;
+    // Packet transmission ended. Notify higher level.
+    m_current_state = SLIP_READY;
 
-    err_code = send_tx_byte();
-
-    if (err_code == NRF_SUCCESS)
+    if (m_slip_event_handler != NULL)
     {
-        // Packet transmission ended. Notify higher level.
-        m_current_state = SLIP_READY;
-
-        if (m_slip_event_handler != NULL)
-        {
-            hci_slip_evt_t event = {HCI_SLIP_TX_DONE, mp_tx_buffer, m_tx_buffer_index};
+        hci_slip_evt_t event = {HCI_SLIP_TX_DONE, mp_tx_buffer, m_tx_buffer_length};
 
-            m_slip_event_handler(event);
-        }
+        m_slip_event_handler(event);
     }
 }
 
 
-/** @brief Function for handling the reception of a SLIP end byte.
- *         If the number of bytes received is greater than zero it will call m_slip_event_handler
- *         with number of bytes received and invalidate the mp_rx_buffer to protect against data
- *         corruption.
- *         No new bytes can be received until a new RX buffer is supplied.
+/** @brief Function for reporting that a received byte was discarded as the RX buffer is full or
+ *         not available. If an event handler has been registered, the callback function will be
+ *         executed.
  */
-static void handle_slip_end(void)
+static void rx_buffer_overflowed(void)
 {
-    if (m_rx_received_count > 0)
+    if (m_slip_event_handler != NULL)
     {
-        // Full packet received, push it up.
-        if (m_slip_event_handler != NULL)
-        {
-            hci_slip_evt_t event = {HCI_SLIP_RX_RDY, mp_rx_buffer, m_rx_received_count};
-
-            m_rx_received_count  = 0;
-            mp_rx_buffer         = NULL;
-
-            m_slip_event_handler(event);
-        }
+        hci_slip_evt_t event = {HCI_SLIP_RX_OVERFLOW, m_rx_decoder.p_buffer, m_rx_decoder.length};
+        m_slip_event_handler(event);
     }
 }
 
 
-static void handle_rx_byte_esc(uint8_t byte)
+/** @brief Function for decoding a span of bytes received on the UART.
+ *         Upon a complete packet m_slip_event_handler is called with number of bytes received and
+ *         the RX buffer is invalidated to protect against data corruption. No new bytes can be
+ *         received until a new RX buffer is supplied.
+ *
+ * @param[in]  p_data  Bytes received in UART module.
+ * @param[in]  length  Number of bytes received.
+ */
+static void rx_data_handle(const uint8_t * p_data, uint32_t length)
 {
-    switch (byte)
-    {
-        case APP_SLIP_END:
-            handle_slip_end();
-            break;
-
-        case APP_SLIP_ESC_END:
-            mp_rx_buffer[m_rx_received_count++] = APP_SLIP_END;
-            break;
-
-        case APP_SLIP_ESC_ESC:
-            mp_rx_buffer[m_rx_received_count++] = APP_SLIP_ESC;
-            break;
-
-        default:
-            mp_rx_buffer[m_rx_received_count++] = byte;
-            break;
-    }
-
-    handle_rx_byte = handle_rx_byte_default;
-}
-
+    uint32_t             consumed;
+    slip_decode_result_t result;
 
-static void handle_rx_byte_default(uint8_t byte)
-{
-    switch (byte)
+    while (length != 0)
     {
-        case APP_SLIP_END:
-            handle_slip_end();
-            break;
-
-        case APP_SLIP_ESC:
-            handle_rx_byte = handle_rx_byte_esc;
-            break;
-
-        default:
-            mp_rx_buffer[m_rx_received_count++] = byte;
-            break;
-    }
-}
-
+        if (m_rx_decoder.p_buffer == NULL)
+        {
+            result   = SLIP_DECODE_BUFFER_FULL;
+            consumed = 0;
+        }
+        else
+        {
+            consumed = length;
+            result   = slip_decode(&m_rx_decoder, p_data, &consumed);
+        }
+        p_data += consumed;
+        length -= consumed;
 
-static void handle_rx_byte_wait_start(uint8_t byte)
-{
-    if (byte == APP_SLIP_END)
-    {
-        handle_rx_byte = handle_rx_byte_default;
-    }
-}
+        if (result == SLIP_DECODE_FRAME_END)
+        {
+            // Full packet received, push it up.
+            if (m_slip_event_handler != NULL)
+            {
+                hci_slip_evt_t event = {HCI_SLIP_RX_RDY, m_rx_decoder.p_buffer, m_rx_decoder.length};
 
+                slip_decoder_init(&m_rx_decoder, NULL, 0);
 
-/** @brief Function for checking the current index and length of the RX buffer to determine if the
- *         buffer is full. If an event handler has been registered, the callback function will
- *         be executed..
- *
- * @retval true     If RX buffer has overflowed.
- * @retval false    otherwise.
- *
- */
-static bool rx_buffer_overflowed(void)
-{
-    if (mp_rx_buffer == NULL || m_rx_received_count >= m_rx_buffer_length)
-    {
-        if (m_slip_event_handler != NULL)
+                m_slip_event_handler(event);
+            }
+        }
+        else if (result == SLIP_DECODE_BUFFER_FULL)
         {
-            hci_slip_evt_t event = {HCI_SLIP_RX_OVERFLOW, mp_rx_buffer, m_rx_received_count};
-            m_slip_event_handler(event);
+            // Discard the byte which does not fit.
+            rx_buffer_overflowed();
+            p_data++;
+            length--;
         }
-
-        return true;
     }
-
-    return false;
 }
 
 
@@ -319,9 +177,9 @@ static void slip_uart_eventhandler(app_uart_evt_t * uart_event)
         transmit_buffer();
     }
 
-    if ((uart_event->evt_type == APP_UART_DATA) && (!rx_buffer_overflowed()))
+    if (uart_event->evt_type == APP_UART_DATA)
     {
-        handle_rx_byte(uart_event->data.value);
+        rx_data_handle(&uart_event->data.value, 1);
     }
 }
 
@@ -401,11 +259,14 @@ uint32_t hci_slip_write(const uint8_t * p_buffer, uint32_t length)
     switch (m_current_state)
     {
         case SLIP_READY:
-            m_tx_buffer_index  = 0;
             m_tx_buffer_length = length;
             mp_tx_buffer       = p_buffer;
             m_current_state    = SLIP_TRANSMITTING;
-            send_tx_byte       = send_tx_byte_end;
+            m_tx_end_encoded   = false;
+            m_tx_chunk_index   = 0;
+            m_tx_chunk_length  = 1;
+            m_tx_chunk[0]      = SLIP_END;
+            slip_encoder_init(&m_tx_encoder, p_buffer, length);
 
             transmit_buffer();
             return NRF_SUCCESS;
@@ -422,9 +283,6 @@ uint32_t hci_slip_write(const uint8_t * p_buffer, uint32_t length)
 
 uint32_t hci_slip_rx_buffer_register(uint8_t * p_buffer, uint32_t length)
 {
-    mp_rx_buffer        = p_buffer;
-    m_rx_buffer_length  = length;
-    m_rx_received_count = 0;
-    handle_rx_byte      = handle_rx_byte_wait_start;
+    slip_decoder_init(&m_rx_decoder, p_buffer, length);
     return NRF_SUCCESS;
 }
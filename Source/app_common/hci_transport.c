@@ -37,40 +37,42 @@
 #define RETRANSMISSION_TIMEOUT_IN_MS    (3u * MAX_TRANSMISSION_TIME)                                       /**< Retransmission timeout for application packet in units of mseconds. */      
 #define APP_TIMER_PRESCALER             0                                                                  /**< Value of the RTC1 PRESCALER register. */
 #define RETRANSMISSION_TIMEOUT_IN_TICKS APP_TIMER_TICKS(RETRANSMISSION_TIMEOUT_IN_MS, APP_TIMER_PRESCALER) /**< Retransmission timeout for application packet in units of timer ticks. */             
+#define RETRANSMISSION_MARGIN_MIN       APP_TIMER_TICKS(MAX_TRANSMISSION_TIME, APP_TIMER_PRESCALER)        /**< Min margin added to the smoothed round trip time for the adaptive retransmission timeout in units of timer ticks. */
+#define RETRANSMISSION_TIMEOUT_MAX      (4u * RETRANSMISSION_TIMEOUT_IN_TICKS)                             /**< Upper bound of the adaptive retransmission timeout in units of timer ticks. */
+#define TX_WINDOW_SIZE                  TX_BUF_QUEUE_SIZE                                                  /**< Max number of application packets transmitted and not yet acknowledged. */
 #define MAX_RETRY_COUNT                 5u                                                                 /**< Max retransmission retry count for application packets. */
 #define ACK_BUF_SIZE                    5u                                                                 /**< Length of module internal RX buffer which is big enough to hold an acknowledgement packet. */
 
-/**@brief States of the TX state machine. */
-typedef enum
-{
-    TX_STATE_IDLE,                                                   /**< State for: no application transmission packet processing in progress. */                                                                                             
-    TX_STATE_PENDING,                                                /**< State for: TX in progress in slip layer and TX-done event is waited for to signal the end of transmission. */
-    TX_STATE_ACTIVE                                                  /**< State for: application packet has been delivered to slip for transmission and peer transport entity acknowledgement packet is waited for. */
-} tx_state_t;
+#if (TX_WINDOW_SIZE > 7u) || !IS_POWER_OF_TWO(TX_WINDOW_SIZE)
+#error "TX_BUF_QUEUE_SIZE must be 1, 2 or 4: sequence numbers are 3 bits wide and window slots are indexed by packet counters modulo the window size."
+#endif
 
-/**@brief TX state machine events. */
-typedef enum
+/**@brief Application packet in the TX window. */
+typedef struct
 {
-    TX_EVENT_STATE_ENTRY,                                            /**< Event for: state entry use case. */                                                                                             
-    TX_EVENT_SLIP_TX_DONE,                                           /**< Event for: HCI_SLIP_TX_DONE event use case. */
-    TX_EVENT_TIMEOUT,                                                /**< Event for: retransmission timeout use case. */
-    TX_EVENT_VALID_RX_ACK                                            /**< Event for: valid acknowledgement received for TX packet use case. */
-} tx_event_t;
-
-static void tx_sm_state_change(tx_state_t new_state);
+    uint8_t * p_buffer;                                              /**< Packet data, including the packet header and CRC. */
+    uint32_t  length;                                                /**< Length of packet data in bytes. */
+} tx_pkt_t;
 
-static tx_state_t                      m_tx_state;                   /**< Current TX state. */
 static hci_transport_tx_done_handler_t m_transport_tx_done_handle;   /**< TX done event callback function. */
 static hci_transport_event_handler_t   m_transport_event_handle;     /**< Event handler callback function. */
 static uint8_t *                       mp_slip_used_rx_buffer;       /**< Reference to RX buffer used by the slip layer. */
 static uint32_t                        m_packet_expected_seq_number; /**< Sequence number counter of the packet expected to be received . */ 
-static uint32_t                        m_packet_transmit_seq_number; /**< Sequence number counter of the transmitted packet for which acknowledgement packet is waited for. */ 
-static uint8_t *                       mp_tx_buffer;                 /**< Pointer to TX application buffer to be transmitted. */
-static uint32_t                        m_tx_buffer_length;           /**< Length of application TX packet data to be transmitted in bytes. */
+static tx_pkt_t                        m_tx_window[TX_WINDOW_SIZE];  /**< Application packets written and not yet acknowledged, packet number n is located at index n % TX_WINDOW_SIZE. */
+static uint32_t                        m_tx_written_count;           /**< Number of application packets written. */
+static uint32_t                        m_tx_next_count;              /**< Number of the next application packet to be delivered to the slip layer. */
+static uint32_t                        m_tx_sent_count;              /**< Number of application packets delivered to the slip layer at least once. */
+static uint32_t                        m_tx_acked_count;             /**< Number of application packets acknowledged by the peer transport entity. */
+static bool                            m_is_tx_rewound;              /**< Boolean to determine has transmission been restarted from the oldest unacknowledged packet. */
 static bool                            m_is_slip_decode_ready;       /**< Boolean to determine has slip decode been completed or not. */
 static app_timer_id_t                  m_app_timer_id;               /**< Application timer id. */
 static uint32_t                        m_tx_retry_counter;           /**< Application packet retransmission counter. */
-static hci_transport_tx_done_result_t  m_tx_done_result_code;        /**< TX done event callback function result code. */
+static uint32_t                        m_rto;                        /**< Current retransmission timeout in units of timer ticks. */
+static uint32_t                        m_srtt;                       /**< Smoothed round trip time in units of 1/8 timer ticks, 0 until the first round trip time sample. */
+static uint32_t                        m_rttvar;                     /**< Round trip time variation in units of 1/4 timer ticks. */
+static bool                            m_is_rtt_sampling;            /**< Boolean to determine is a round trip time measurement in progress. */
+static uint32_t                        m_rtt_pkt_number;             /**< Number of the application packet whose round trip time is measured. */
+static uint32_t                        m_rtt_start_ticks;            /**< Timer ticks at the start of the round trip time measurement. */
 static uint8_t                         m_rx_ack_buffer[ACK_BUF_SIZE];/**< RX buffer big enough to hold an acknowledgement packet and which is taken in use upon receiving  HCI_SLIP_RX_OVERFLOW event. */
 
 
@@ -298,42 +300,31 @@ static void rx_vendor_specific_pkt_type_handle(const uint8_t * p_buffer, uint32_
 }
 
 
-/**@brief Function for getting the sequence number of a reliable TX packet for which peer protocol 
- * entity acknowledgment is pending.
+/**@brief Function for getting the sequence number of a reliable TX packet.
  *
- * @return sequence number of a reliable TX packet for which peer protocol entity acknowledgement
- * is pending.
- */
-static __INLINE uint8_t packet_number_to_transmit_get(void)
-{
-    return m_packet_transmit_seq_number;
-}
-
-
-/**@brief Function for getting the expected acknowledgement number.
+ * @param[in] pkt_number Number of the application packet, counted from when the channel was opened.
  *
- * @return expected acknowledgement number.
+ * @return sequence number of the application packet.
  */
-static __INLINE uint8_t expected_ack_number_get(void)
+static __INLINE uint8_t packet_number_to_transmit_get(uint32_t pkt_number)
 {
-    uint8_t seq_nmbr = packet_number_to_transmit_get(); 
-    ++seq_nmbr;
-    seq_nmbr &= 0x07u;
-    
-    return seq_nmbr;
+    return (uint8_t)((INITIAL_ACK_NUMBER_TX + pkt_number) & 0x07u);
 }
 
 
 /**@brief Function for processing a received acknowledgement packet.
  *
- * Verifies does the received acknowledgement packet has the expected acknowledgement number and 
- * that the header checksum is correct. 
+ * Verifies that the header checksum is correct and decodes how many application packets the 
+ * received acknowledgement packet acknowledges. The acknowledgement number is the sequence number of
+ * the next packet expected by the peer transport entity, so it acknowledges all packets before it.
  *
- * @param[in] p_buffer Pointer to the packet data. 
+ * @param[in]  p_buffer Pointer to the packet data. 
+ * @param[out] p_acked  Number of application packets acknowledged, 0 if the peer transport entity 
+ *                      still expects the oldest unacknowledged packet.
  *
  * @return true if valid acknowledgement packet received.
  */
-static __INLINE bool rx_ack_pkt_type_handle(const uint8_t * p_buffer)
+static __INLINE bool rx_ack_pkt_type_handle(const uint8_t * p_buffer, uint32_t * p_acked)
 {
     // @note: no pointer validation check needed as allready checked by calling function.
     
@@ -345,121 +336,224 @@ static __INLINE bool rx_ack_pkt_type_handle(const uint8_t * p_buffer)
         return false;
     }
     
-    const uint8_t ack_number = (p_buffer[0] >> 3u) & 0x07u;
+    const uint8_t  ack_number = (p_buffer[0] >> 3u) & 0x07u;
+    const uint32_t acked      = 
+        (ack_number - packet_number_to_transmit_get(m_tx_acked_count)) & 0x07u;
     
-    // Verify expected acknowledgment number.
-    return (ack_number == expected_ack_number_get());
+    // Verify that only application packets which have been transmitted are acknowledged.
+    if (acked > (m_tx_sent_count - m_tx_acked_count))
+    {
+        return false;
+    }
+    
+    *p_acked = acked;
+    return true;
 }
 
 
-/**@brief Function for incrementing the sequence number counter of the TX packet. 
+/**@brief Function for (re)starting the retransmission timer with the current timeout.
  */
-static __INLINE void packet_number_tx_inc(void)
+static void retransmission_timer_start(void)
 {
-    ++m_packet_transmit_seq_number;
-    m_packet_transmit_seq_number &= 0x07u;
+    uint32_t err_code = app_timer_stop(m_app_timer_id);
+    APP_ERROR_CHECK(err_code);
+    
+    err_code = app_timer_start(m_app_timer_id, m_rto, NULL);
+    APP_ERROR_CHECK(err_code);
 }
 
 
-/**@brief Function for TX state machine event processing in a state centric manner.
+/**@brief Function for updating the retransmission timeout with a round trip time sample.
+ *
+ * Jacobson/Karels algorithm: the timeout is the smoothed round trip time plus four times its mean 
+ * deviation, using gains of 1/8 and 1/4 respectively. The margin is at least the transmission time 
+ * of one application packet, as the acknowledgement can be delayed by a packet in transmission.
  *
- * @param[in] event Type of event occurred.
+ * @param[in] rtt Round trip time sample in units of timer ticks.
  */
-static void tx_sm_event_handle(tx_event_t event)
+static void rto_update(uint32_t rtt)
 {
-    uint32_t err_code;
+    if (m_srtt == 0)
+    {
+        m_srtt   = rtt << 3u;
+        m_rttvar = rtt << 1u;
+    }
+    else
+    {
+        int32_t delta = (int32_t)rtt - (int32_t)(m_srtt >> 3u);
+        
+        m_srtt += delta;
+        if (delta < 0)
+        {
+            delta = -delta;
+        }
+        delta    -= (int32_t)(m_rttvar >> 2u);
+        m_rttvar += delta;
+    }
+    
+    m_rto = (m_srtt >> 3u) + MAX(m_rttvar, RETRANSMISSION_MARGIN_MIN);
+    m_rto = MIN(m_rto, RETRANSMISSION_TIMEOUT_MAX);
+}
+
+
+/**@brief Function for delivering application packets of the TX window to the slip layer.
+ *
+ * The slip layer accepts one packet at a time, so in practice one packet is delivered and the next 
+ * one is delivered upon the HCI_SLIP_TX_DONE event.
+ *
+ * @retval NRF_SUCCESS              Operation success. Packets not accepted by the slip layer are 
+ *                                  delivered upon the next HCI_SLIP_TX_DONE event.
+ * @retval NRF_ERROR_INVALID_STATE  Operation failure. Slip layer is not open.
+ */
+static uint32_t tx_window_send(void)
+{
+    uint32_t err_code = NRF_SUCCESS;
     
-    switch (m_tx_state)
+    while ((m_tx_next_count != m_tx_written_count) && (err_code == NRF_SUCCESS))
     {
-        case TX_STATE_IDLE:
-            if (event == TX_EVENT_STATE_ENTRY)
-            {                 
-                err_code = app_timer_stop(m_app_timer_id);
-                APP_ERROR_CHECK(err_code);
-                
-                // Send TX-done event if registered handler exists.
-                if (m_transport_tx_done_handle != NULL)                
-                {
-                    m_transport_tx_done_handle(m_tx_done_result_code);
-                }                
-            }
-            break;
-            
-        case TX_STATE_PENDING:
-            if (event == TX_EVENT_SLIP_TX_DONE)
-            {     
-                // @note: this call should always succeed as called from HCI_SLIP_TX_DONE context 
-                // and error cases are managed by dedicated error event from the slip layer.
-                err_code = hci_slip_write(mp_tx_buffer, 
-                                         (m_tx_buffer_length + PKT_HDR_SIZE + PKT_CRC_SIZE));  
-                APP_ERROR_CHECK(err_code);                                                  
-                tx_sm_state_change(TX_STATE_ACTIVE);                                              
-            }        
-            break;
-            
-        case TX_STATE_ACTIVE:
-            switch (event)
+        const tx_pkt_t * p_pkt = &m_tx_window[m_tx_next_count % TX_WINDOW_SIZE];
+        
+        err_code = hci_slip_write(p_pkt->p_buffer, p_pkt->length);
+        if (err_code == NRF_SUCCESS)
+        {
+            if (m_tx_next_count == m_tx_sent_count)
             {
-                case TX_EVENT_VALID_RX_ACK:                    
-                    // Tx sequence number counter incremented as packet transmission 
-                    // acknowledged by peer transport entity.
-                    packet_number_tx_inc();                                  
-                    tx_sm_state_change(TX_STATE_IDLE);
-                    break;
-                    
-                case TX_EVENT_STATE_ENTRY:
-                    m_tx_retry_counter = 0;
-                    err_code = app_timer_start(m_app_timer_id, 
-                                               RETRANSMISSION_TIMEOUT_IN_TICKS, 
-                                               NULL);
+                // First transmission of the packet: measure its round trip time unless a 
+                // measurement is already in progress. Retransmitted packets are never measured as 
+                // the acknowledgement can not be matched to a specific transmission.
+                if (!m_is_rtt_sampling)
+                {
+                    err_code = app_timer_cnt_get(&m_rtt_start_ticks);
                     APP_ERROR_CHECK(err_code);
-                    break;
-                    
-                case TX_EVENT_TIMEOUT:
-                    if (m_tx_retry_counter != MAX_RETRY_COUNT)
-                    {
-                        ++m_tx_retry_counter;
-                        // @note: no return value check done for hci_slip_write(...) call as current 
-                        // system design allows use case where retransmission is not accepted by the 
-                        // slip layer due to existing acknowledgement packet transmission in the 
-                        // slip layer. 
-                        UNUSED_VARIABLE(hci_slip_write(mp_tx_buffer, 
-                                                      (m_tx_buffer_length + 
-                                                      PKT_HDR_SIZE        + 
-                                                      PKT_CRC_SIZE)));                
-                    }    
-                    else
-                    {
-                        // Application packet retransmission count reached: 
-                        // - set correct TX done event callback function result code
-                        // - execute state change    
-                        // @note: m_tx_retry_counter is reset in TX_STATE_ACTIVE state entry.
-                        m_tx_done_result_code = HCI_TRANSPORT_TX_DONE_FAILURE;         
-                        tx_sm_state_change(TX_STATE_IDLE);
-                    }                
-                    break;
                     
-                default:
-                    // No implementation needed.
-                    break;
+                    m_is_rtt_sampling = true;
+                    m_rtt_pkt_number  = m_tx_next_count;
+                }
+                ++m_tx_sent_count;
             }
-            break;
             
-        default:        
-            // No implementation needed.
-            break;
+            if (m_tx_next_count == m_tx_acked_count)
+            {
+                // Oldest unacknowledged packet delivered: time it.
+                retransmission_timer_start();
+            }
+            ++m_tx_next_count;
+        }
+    }
+    
+    return (err_code == NRF_ERROR_NO_MEM) ? NRF_SUCCESS : err_code;
+}
+
+
+/**@brief Function for restarting the transmission from the oldest unacknowledged packet.
+ *
+ * The peer transport entity discards every packet received out of sequence, so all packets 
+ * transmitted after a lost one are transmitted again.
+ */
+static void tx_window_rewind(void)
+{
+    m_tx_next_count   = m_tx_acked_count;
+    m_is_tx_rewound   = true;
+    m_is_rtt_sampling = false;
+    
+    const uint32_t err_code = tx_window_send();
+    APP_ERROR_CHECK(err_code);
+}
+
+
+/**@brief Function for processing a valid acknowledgement packet received for TX packets.
+ *
+ * @param[in] acked Number of application packets acknowledged.
+ */
+static void tx_ack_handle(uint32_t acked)
+{
+    uint32_t err_code;
+    uint32_t ticks;
+    
+    if (acked == 0)
+    {
+        // The peer transport entity received a packet out of sequence, which means that the oldest 
+        // unacknowledged packet was lost: retransmit it without waiting for the timeout. Following
+        // acknowledgements for the packets already in flight are ignored until it is received.
+        if ((m_tx_sent_count != m_tx_acked_count) && !m_is_tx_rewound)
+        {
+            tx_window_rewind();
+        }
+        return;
+    }
+    
+    m_tx_acked_count  += acked;
+    m_tx_retry_counter = 0;
+    m_is_tx_rewound    = false;
+    
+    if (m_is_rtt_sampling && ((int32_t)(m_rtt_pkt_number - m_tx_acked_count) < 0))
+    {
+        m_is_rtt_sampling = false;
+        
+        err_code = app_timer_cnt_get(&ticks);
+        APP_ERROR_CHECK(err_code);
+        err_code = app_timer_cnt_diff_compute(ticks, m_rtt_start_ticks, &ticks);
+        APP_ERROR_CHECK(err_code);
+        
+        rto_update(ticks);
+    }
+    
+    if ((int32_t)(m_tx_next_count - m_tx_acked_count) < 0)
+    {
+        // Packets to be retransmitted have been acknowledged already.
+        m_tx_next_count = m_tx_acked_count;
+    }
+    
+    if (m_tx_next_count != m_tx_acked_count)
+    {
+        // Time the next unacknowledged packet from now on.
+        retransmission_timer_start();
     }
+    else
+    {
+        err_code = app_timer_stop(m_app_timer_id);
+        APP_ERROR_CHECK(err_code);
+    }
+    
+    // Send TX-done event for every acknowledged packet if registered handler exists.
+    if (m_transport_tx_done_handle != NULL)
+    {
+        while (acked-- != 0)
+        {
+            m_transport_tx_done_handle(HCI_TRANSPORT_TX_DONE_SUCCESS);
+        }
+    }
+    
+    err_code = tx_window_send();
+    APP_ERROR_CHECK(err_code);
 }
 
 
-/**@brief Function for changing the state of the TX state machine.
+/**@brief Function for resetting the RX buffer of the slip layer after a packet has been dropped.
  *
- * @param[in] new_state State TX state machine transits to.
+ * If existing mem pool produced RX buffer exists reuse that one. If existing mem pool produced RX 
+ * buffer does not exist try to produce new one. If producing fails use the internal acknowledgement
+ * buffer.
  */
-static void tx_sm_state_change(tx_state_t new_state)
+static void rx_buffer_reset(void)
 {
-    m_tx_state = new_state;
-    tx_sm_event_handle(TX_EVENT_STATE_ENTRY);
+    uint32_t err_code;
+    
+    if (mp_slip_used_rx_buffer != NULL)
+    {
+        err_code = hci_slip_rx_buffer_register(mp_slip_used_rx_buffer, RX_BUF_SIZE);                                                            
+        APP_ERROR_CHECK(err_code);                                                                
+    }
+    else
+    {
+        err_code = hci_mem_pool_rx_produce(RX_BUF_SIZE, (void **)&mp_slip_used_rx_buffer); 
+        APP_ERROR_CHECK_BOOL((err_code == NRF_SUCCESS) || (err_code == NRF_ERROR_NO_MEM));
+
+        err_code = hci_slip_rx_buffer_register(
+            (err_code == NRF_SUCCESS) ? mp_slip_used_rx_buffer : m_rx_ack_buffer, 
+            (err_code == NRF_SUCCESS) ? RX_BUF_SIZE : ACK_BUF_SIZE);            
+        APP_ERROR_CHECK(err_code);                                                                
+    }
 }
 
 
@@ -471,11 +565,13 @@ void slip_event_handle(hci_slip_evt_t event)
 {    
     uint32_t return_code;
     uint32_t err_code;    
+    uint32_t acked;
     
     switch (event.evt_type)
     {
         case HCI_SLIP_TX_DONE:   
-            tx_sm_event_handle(TX_EVENT_SLIP_TX_DONE);
+            err_code = tx_window_send();
+            APP_ERROR_CHECK(err_code);
             break;
             
         case HCI_SLIP_RX_RDY:
@@ -488,45 +584,26 @@ void slip_event_handle(hci_slip_evt_t event)
                     break;
                     
                 case PKT_TYPE_ACK:
-                    if (rx_ack_pkt_type_handle(event.packet))
+                    if (rx_ack_pkt_type_handle(event.packet, &acked))
                     {
-                        // Valid expected acknowledgement packet received: set correct TX done event 
-                        // callback function result code and execute state change.
-                        m_tx_done_result_code = HCI_TRANSPORT_TX_DONE_SUCCESS; 
-                        tx_sm_event_handle(TX_EVENT_VALID_RX_ACK);
+                        tx_ack_handle(acked);
                     }
                 
                 /* fall-through */                
                 default:
                     // RX packet dropped: reset memory buffer to slip in order to avoid RX buffer 
                     // overflow. 
-                    // If existing mem pool produced RX buffer exists reuse that one. If existing 
-                    // mem pool produced RX buffer does not exist try to produce new one. If 
-                    // producing fails use the internal acknowledgement buffer.                    
-                    if (mp_slip_used_rx_buffer != NULL)
-                    {
-                        err_code = hci_slip_rx_buffer_register(mp_slip_used_rx_buffer, RX_BUF_SIZE);                                                            
-                        APP_ERROR_CHECK(err_code);                                                                
-                    }
-                    else
-                    {
-                        err_code = hci_mem_pool_rx_produce(RX_BUF_SIZE, 
-                                                           (void **)&mp_slip_used_rx_buffer); 
-                        APP_ERROR_CHECK_BOOL((err_code == NRF_SUCCESS) || 
-                                            (err_code == NRF_ERROR_NO_MEM));
-
-                        err_code = hci_slip_rx_buffer_register(
-                            (err_code == NRF_SUCCESS) ? mp_slip_used_rx_buffer : m_rx_ack_buffer, 
-                            (err_code == NRF_SUCCESS) ? RX_BUF_SIZE : ACK_BUF_SIZE);            
-                        APP_ERROR_CHECK(err_code);                                                                
-                    }
+                    rx_buffer_reset();
                     break;
             }
             break;
 
         case HCI_SLIP_RX_OVERFLOW:
-            err_code = hci_slip_rx_buffer_register(m_rx_ack_buffer, ACK_BUF_SIZE);                                                            
-            APP_ERROR_CHECK(err_code);                                                                
+            // The internal acknowledgement buffer overflows when an application packet is received 
+            // while no mem pool RX buffer is available. Retry producing one, as the application may
+            // have consumed RX packets in the meantime, otherwise the peer transport entity would 
+            // retransmit to the internal acknowledgement buffer until it gives up.
+            rx_buffer_reset();
             break;
         
         case HCI_SLIP_ERROR:
@@ -576,23 +653,65 @@ uint32_t hci_transport_tx_done_register(hci_transport_tx_done_handler_t event_ha
  */
 void hci_transport_timeout_handle(void * p_context)
 {
-    tx_sm_event_handle(TX_EVENT_TIMEOUT);
+    uint32_t pkt_count;
+    
+    if (m_tx_sent_count == m_tx_acked_count)
+    {
+        return;
+    }
+    
+    if (m_tx_retry_counter != MAX_RETRY_COUNT)
+    {
+        ++m_tx_retry_counter;
+        
+        // Back off the retransmission timeout until a new round trip time sample is taken.
+        m_rto = MIN(2u * m_rto, RETRANSMISSION_TIMEOUT_MAX);
+        
+        // @note: retransmission timer is restarted by tx_window_send(...) when the oldest 
+        // unacknowledged packet is accepted by the slip layer.
+        tx_window_rewind();
+    }
+    else
+    {
+        // Application packet retransmission count reached: discard all packets of the TX window 
+        // and send TX-done event with failure result code for each of them. The sequence number of 
+        // the oldest discarded packet is used for the next packet written.
+        pkt_count          = m_tx_written_count - m_tx_acked_count;
+        m_tx_written_count = m_tx_acked_count;
+        m_tx_next_count    = m_tx_acked_count;
+        m_tx_sent_count    = m_tx_acked_count;
+        m_tx_retry_counter = 0;
+        m_is_tx_rewound    = false;
+        m_is_rtt_sampling  = false;
+        
+        if (m_transport_tx_done_handle != NULL)
+        {
+            while (pkt_count-- != 0)
+            {
+                m_transport_tx_done_handle(HCI_TRANSPORT_TX_DONE_FAILURE);
+            }
+        }
+    }
 }
 
 
 uint32_t hci_transport_open(void)
 {
-    mp_tx_buffer                 = NULL;
-    m_tx_buffer_length           = 0;
+    m_tx_written_count           = 0;
+    m_tx_next_count              = 0;
+    m_tx_sent_count              = 0;
+    m_tx_acked_count             = 0;
+    m_is_tx_rewound              = false;
     m_tx_retry_counter           = 0;
+    m_rto                        = RETRANSMISSION_TIMEOUT_IN_TICKS;
+    m_srtt                       = 0;
+    m_rttvar                     = 0;
+    m_is_rtt_sampling            = false;
     m_is_slip_decode_ready       = false;
-    m_tx_state                   = TX_STATE_IDLE;
     m_packet_expected_seq_number = INITIAL_ACK_NUMBER_EXPECTED;
-    m_packet_transmit_seq_number = INITIAL_ACK_NUMBER_TX;
-    m_tx_done_result_code        = HCI_TRANSPORT_TX_DONE_FAILURE;
     
     uint32_t err_code = app_timer_create(&m_app_timer_id, 
-                                         APP_TIMER_MODE_REPEATED, 
+                                         APP_TIMER_MODE_SINGLE_SHOT, 
                                          hci_transport_timeout_handle);
     if (err_code != NRF_SUCCESS)
     {    
@@ -667,56 +786,54 @@ uint32_t hci_transport_tx_free(void)
 
 
 /**@brief Function for constructing 1st byte of the packet header of the packet to be transmitted.
+ *
+ * @param[in] pkt_number Number of the application packet to be transmitted.
  *
  * @return 1st byte of the packet header of the packet to be transmitted
  */
-static __INLINE uint8_t tx_packet_byte_zero_construct(void)
+static __INLINE uint8_t tx_packet_byte_zero_construct(uint32_t pkt_number)
 {
     const uint32_t value = DATA_INTEGRITY_MASK                  | 
                            RELIABLE_PKT_MASK                    | 
                            (packet_number_expected_get() << 3u) | 
-                           packet_number_to_transmit_get();   
+                           packet_number_to_transmit_get(pkt_number);   
     
     return (uint8_t) value;
 }
 
 
-/**@brief Function for handling the application packet write request in tx-idle state.
+/**@brief Function for adding an application packet to the TX window.
+ *
+ * @param[in] p_buffer Pointer to the application packet data.
+ * @param[in] length   Length of application packet data in bytes.
  */
-static uint32_t pkt_write_handle(void)
+static uint32_t pkt_write_handle(uint8_t * p_buffer, uint32_t length)
 {   
-    uint32_t err_code;     
+    uint32_t   err_code;     
+    tx_pkt_t * p_pkt = &m_tx_window[m_tx_written_count % TX_WINDOW_SIZE];
     
     // Set packet header fields.
 
-    mp_tx_buffer   -= PKT_HDR_SIZE;
-    mp_tx_buffer[0] = tx_packet_byte_zero_construct();
+    p_pkt->p_buffer    = p_buffer - PKT_HDR_SIZE;
+    p_pkt->length      = length + PKT_HDR_SIZE + PKT_CRC_SIZE;
+    p_pkt->p_buffer[0] = tx_packet_byte_zero_construct(m_tx_written_count);
                 
-    const uint16_t type_and_length_fields = ((m_tx_buffer_length << 4u) | PKT_TYPE_VENDOR_SPECIFIC);            
+    const uint16_t type_and_length_fields = ((length << 4u) | PKT_TYPE_VENDOR_SPECIFIC);            
     // @note: no use case for uint16_encode(...) return value.
-    UNUSED_VARIABLE(uint16_encode(type_and_length_fields, &(mp_tx_buffer[1])));
-    mp_tx_buffer[3] = header_checksum_calculate(mp_tx_buffer);
+    UNUSED_VARIABLE(uint16_encode(type_and_length_fields, &(p_pkt->p_buffer[1])));
+    p_pkt->p_buffer[3] = header_checksum_calculate(p_pkt->p_buffer);
     
     // Calculate, append CRC to the packet and write it.
         
-    const uint16_t crc = crc16_compute(mp_tx_buffer, (PKT_HDR_SIZE + m_tx_buffer_length), NULL);
+    const uint16_t crc = crc16_compute(p_pkt->p_buffer, (PKT_HDR_SIZE + length), NULL);
     // @note: no use case for uint16_encode(...) return value.
-    UNUSED_VARIABLE(uint16_encode(crc, &(mp_tx_buffer[PKT_HDR_SIZE + m_tx_buffer_length])));        
-    err_code = hci_slip_write(mp_tx_buffer, (m_tx_buffer_length + PKT_HDR_SIZE + PKT_CRC_SIZE));        
-    switch (err_code)
+    UNUSED_VARIABLE(uint16_encode(crc, &(p_pkt->p_buffer[PKT_HDR_SIZE + length])));        
+    
+    ++m_tx_written_count;
+    err_code = tx_window_send();
+    if (err_code != NRF_SUCCESS)
     {
-        case NRF_SUCCESS:
-            tx_sm_state_change(TX_STATE_ACTIVE);
-            break;
-                
-        case NRF_ERROR_NO_MEM:
-            tx_sm_state_change(TX_STATE_PENDING);            
-            err_code = NRF_SUCCESS;
-            break;
-                
-        default:
-            // No implementation needed.
-            break;
+        --m_tx_written_count;
     }
     
     return err_code;
@@ -729,17 +846,13 @@ uint32_t hci_transport_pkt_write(const uint8_t * p_buffer, uint16_t length)
     
     if (p_buffer)
     {          
-        switch (m_tx_state)
+        if ((m_tx_written_count - m_tx_acked_count) != TX_WINDOW_SIZE)
         {
-            case TX_STATE_IDLE:
-                mp_tx_buffer       = (uint8_t *)p_buffer;
-                m_tx_buffer_length = length;            
-                err_code = pkt_write_handle();
-                break;
-                
-            default:
-                err_code = NRF_ERROR_NO_MEM;
-                break;
+            err_code = pkt_write_handle((uint8_t *)p_buffer, length);
+        }
+        else
+        {
+            err_code = NRF_ERROR_NO_MEM;
         }
     }
     else
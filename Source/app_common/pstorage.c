@@ -25,6 +25,44 @@
 #define SOC_MAX_WRITE_SIZE 1024                            /**< Maximum write size allowed for a single call to \ref sd_flash_write as specified in the SoC API. */
 #define RAW_MODE_APP_ID    (PSTORAGE_MAX_APPLICATIONS + 1) /**< Application id for raw mode. */
 
+/**
+ * @defgroup flash_backend Flash backend.
+ *
+ * @details Flash access functions used by the module. By default the SoftDevice flash API is used,
+ *          but the macros can be defined in pstorage_platform.h to run the module on top of a
+ *          different flash driver, e.g. the flash simulator in Test/host/pstorage. Write and page
+ *          erase functions are asynchronous and return NRF_SUCCESS when the operation has been
+ *          started or NRF_ERROR_BUSY when it cannot be started now. The result of a started
+ *          operation is reported by calling pstorage_sys_event_handler with
+ *          NRF_EVT_FLASH_OPERATION_SUCCESS or NRF_EVT_FLASH_OPERATION_ERROR.
+ *
+ * @{
+ */
+
+#ifndef PSTORAGE_FLASH_WRITE
+/**@brief Starts writing WORDS words from P_SRC to flash address P_DST. */
+#define PSTORAGE_FLASH_WRITE(P_DST, P_SRC, WORDS)  sd_flash_write((P_DST), (P_SRC), (WORDS))
+#endif
+
+#ifndef PSTORAGE_FLASH_PAGE_ERASE
+/**@brief Starts erasing flash page number PAGE_NUM. */
+#define PSTORAGE_FLASH_PAGE_ERASE(PAGE_NUM)        sd_flash_page_erase(PAGE_NUM)
+#endif
+
+#ifndef PSTORAGE_FLASH_PTR
+/**@brief Converts flash address ADDR to a pointer the flash content can be read from. */
+#define PSTORAGE_FLASH_PTR(ADDR)                   ((uint32_t *)(ADDR))
+#endif
+
+/**@} */
+
+#ifndef PSTORAGE_WRITE_COMBINE_SIZE
+#define PSTORAGE_WRITE_COMBINE_SIZE 128            /**< Size of the buffer used to combine stores to consecutive addresses into a single flash write, 0 to disable. */
+#endif
+
+STATIC_ASSERT((PSTORAGE_WRITE_COMBINE_SIZE % sizeof(uint32_t)) == 0);
+STATIC_ASSERT(PSTORAGE_WRITE_COMBINE_SIZE <= SOC_MAX_WRITE_SIZE);
+
 /**
  * @defgroup api_param_check API Parameters check macros.
  *
@@ -223,6 +261,13 @@ static uint32_t            m_next_page_addr;             /**< Points to the flas
 static pstorage_size_t     m_round_val;                  /**< Round value for multiple round operations. For erase operations, the round value will contain current round counter which is identical to number of pages erased. For store operations, the round value contains current round of operation * SOC_MAX_WRITE_SIZE to ensure each store to the SoC Flash API is within the SoC limit. */
 static bool                m_module_initialized = false; /**< Flag for checking if module has been initialized. */
 static swap_backup_state_t m_swap_state;                 /**< Swap page state. */
+static swap_backup_state_t m_swap_state_issued;          /**< Swap page state in which the flash access in progress was requested, restored to retry the access if it fails. */
+static cmd_queue_element_t m_cmd_exec;                   /**< Flash access operation in progress. Executes one or more queued commands, starting with the one at the read pointer. */
+static uint8_t             m_cmd_exec_count;             /**< Number of queued commands completed by the operation in progress, 0 if no operation has been prepared. */
+
+#if (PSTORAGE_WRITE_COMBINE_SIZE > 0)
+static uint32_t            m_write_combine_buf[PSTORAGE_WRITE_COMBINE_SIZE / sizeof(uint32_t)]; /**< Data of stores combined into a single flash write. */
+#endif
 
 
 static pstorage_module_table_t m_app_table[PSTORAGE_MAX_APPLICATIONS]; /**< Registered application information table. */
@@ -285,6 +330,7 @@ static void cmd_queue_init(void)
 
     m_round_val              = 0;
     m_swap_state             = STATE_INIT;
+    m_cmd_exec_count         = 0;
     m_cmd_queue.rp           = 0;
     m_cmd_queue.count        = 0;
     m_cmd_queue.flash_access = false;
@@ -334,6 +380,7 @@ static uint32_t cmd_queue_enqueue(uint8_t             opcode,
         m_cmd_queue.cmd[write_index].size         = size;
         m_cmd_queue.cmd[write_index].offset       = offset;
         retval                                    = NRF_SUCCESS;
+        m_cmd_queue.count++;
         if (m_cmd_queue.flash_access == false)
         {
             retval = cmd_process();
@@ -343,7 +390,6 @@ static uint32_t cmd_queue_enqueue(uint8_t             opcode,
                 retval = NRF_SUCCESS;
             }
         }
-        m_cmd_queue.count++;
     }
     else
     {
@@ -391,32 +437,143 @@ static uint32_t cmd_queue_dequeue(void)
 /**
  * @brief Routine to notify application of any errors.
  *
+ * @details All commands executed by the flash access operation in progress are notified, in the
+ *          order in which they were queued.
+ *
  * @param[in] result Result of event being notified.
  */
 static void app_notify(uint32_t result)
 {
-    pstorage_ntf_cb_t ntf_cb;
-    uint8_t           op_code = m_cmd_queue.cmd[m_cmd_queue.rp].op_code;
+    pstorage_ntf_cb_t     ntf_cb;
+    cmd_queue_element_t * p_cmd;
+    uint32_t              index = m_cmd_queue.rp;
+    uint32_t              count = (m_cmd_exec_count != 0) ? m_cmd_exec_count : 1;
+
+    for (; count > 0; count--)
+    {
+        p_cmd = &m_cmd_queue.cmd[index];
 
 #ifdef PSTORAGE_RAW_MODE_ENABLE
-    if (m_cmd_queue.cmd[m_cmd_queue.rp].storage_addr.module_id == RAW_MODE_APP_ID)
+        if (p_cmd->storage_addr.module_id == RAW_MODE_APP_ID)
+        {
+            ntf_cb = m_raw_app_table.cb;
+        }
+        else
+#endif // PSTORAGE_RAW_MODE_ENABLE
+        {
+            ntf_cb = m_app_table[p_cmd->storage_addr.module_id].cb;
+        }
+
+        // Indicate result to client.
+        // For PSTORAGE_CLEAR_OP_CODE no size is returned as the size field is used only internally
+        // for clients registering multiple pages.
+        ntf_cb(&p_cmd->storage_addr,
+               p_cmd->op_code,
+               result,
+               p_cmd->p_data_addr,
+               p_cmd->size);
+
+        index++;
+        if (index >= PSTORAGE_CMD_QUEUE_SIZE)
+        {
+            index -= PSTORAGE_CMD_QUEUE_SIZE;
+        }
+    }
+}
+
+
+/**
+ * @brief Routine to combine a queued command with the flash access operation being prepared.
+ *
+ * @param[in] p_next Command queued after the commands already combined in the operation.
+ *
+ * @retval    true   if the command is executed by the operation.
+ * @retval    false  if the command can not be combined with the operation.
+ */
+static bool cmd_combine(const cmd_queue_element_t * p_next)
+{
+    if (p_next->op_code != m_cmd_exec.op_code)
     {
-        ntf_cb = m_raw_app_table.cb;
+        return false;
     }
-    else
-#endif // PSTORAGE_RAW_MODE_ENABLE
+
+    switch (m_cmd_exec.op_code)
     {
-        ntf_cb = m_app_table[m_cmd_queue.cmd[m_cmd_queue.rp].storage_addr.module_id].cb;
+#if (PSTORAGE_WRITE_COMBINE_SIZE > 0)
+        case PSTORAGE_STORE_OP_CODE:
+        {
+            // Stores to consecutive addresses within one flash page are written at once.
+            const uint32_t start = m_cmd_exec.storage_addr.block_id + m_cmd_exec.offset;
+            const uint32_t end   = start + m_cmd_exec.size;
+
+            if (((p_next->storage_addr.block_id + p_next->offset) != end) ||
+                ((m_cmd_exec.size + p_next->size) > PSTORAGE_WRITE_COMBINE_SIZE) ||
+                ((start / PSTORAGE_FLASH_PAGE_SIZE) !=
+                 ((end + p_next->size - 1) / PSTORAGE_FLASH_PAGE_SIZE)))
+            {
+                return false;
+            }
+
+            if (m_cmd_exec.p_data_addr != (uint8_t *)m_write_combine_buf)
+            {
+                memcpy(m_write_combine_buf, m_cmd_exec.p_data_addr, m_cmd_exec.size);
+                m_cmd_exec.p_data_addr = (uint8_t *)m_write_combine_buf;
+            }
+
+            memcpy(((uint8_t *)m_write_combine_buf) + m_cmd_exec.size,
+                   p_next->p_data_addr,
+                   p_next->size);
+            m_cmd_exec.size += p_next->size;
+            return true;
+        }
+#endif // PSTORAGE_WRITE_COMBINE_SIZE
+
+        case PSTORAGE_UPDATE_OP_CODE:
+            // An update overwritten entirely by the next update of the same block is not
+            // executed, so that the page is swapped once.
+            if ((p_next->storage_addr.block_id != m_cmd_exec.storage_addr.block_id) ||
+                (p_next->offset > m_cmd_exec.offset) ||
+                ((p_next->offset + p_next->size) < (m_cmd_exec.offset + m_cmd_exec.size)))
+            {
+                return false;
+            }
+
+            m_cmd_exec = (*p_next);
+            return true;
+
+        default:
+            return false;
     }
+}
+
+
+/**
+ * @brief Routine to prepare the flash access operation for the command at the read pointer.
+ *
+ * @details Commands queued after it are combined into the same operation as long as possible.
+ *          Every combined command is notified to its application when the operation ends.
+ */
+static void cmd_exec_prepare(void)
+{
+    uint32_t index = m_cmd_queue.rp;
+
+    m_cmd_exec       = m_cmd_queue.cmd[index];
+    m_cmd_exec_count = 1;
+
+    while (m_cmd_exec_count < m_cmd_queue.count)
+    {
+        index++;
+        if (index >= PSTORAGE_CMD_QUEUE_SIZE)
+        {
+            index -= PSTORAGE_CMD_QUEUE_SIZE;
+        }
 
-    // Indicate result to client.
-    // For PSTORAGE_CLEAR_OP_CODE no size is returned as the size field is used only internally
-    // for clients registering multiple pages.
-    ntf_cb(&m_cmd_queue.cmd[m_cmd_queue.rp].storage_addr,
-           op_code,
-           result,
-           m_cmd_queue.cmd[m_cmd_queue.rp].p_data_addr,
-           m_cmd_queue.cmd[m_cmd_queue.rp].size);
+        if (!cmd_combine(&m_cmd_queue.cmd[index]))
+        {
+            break;
+        }
+        m_cmd_exec_count++;
+    }
 }
 
 
@@ -464,7 +621,7 @@ void pstorage_sys_event_handler(uint32_t sys_evt)
         {
             case NRF_EVT_FLASH_OPERATION_SUCCESS:
             {
-                p_cmd = &m_cmd_queue.cmd[m_cmd_queue.rp];
+                p_cmd = &m_cmd_exec;
                 m_round_val++;
 
                 const bool store_finished =
@@ -493,16 +650,19 @@ void pstorage_sys_event_handler(uint32_t sys_evt)
 
                     app_notify(retval);
 
-                    // Initialize/free the element as it is now processed.
-                    cmd_queue_element_init(m_cmd_queue.rp);
-                    m_round_val = 0;
-                    m_cmd_queue.count--;
-                    m_cmd_queue.rp++;
-
-                    if (m_cmd_queue.rp >= PSTORAGE_CMD_QUEUE_SIZE)
+                    // Initialize/free the elements as they are now processed.
+                    for (; m_cmd_exec_count > 0; m_cmd_exec_count--)
                     {
-                        m_cmd_queue.rp -= PSTORAGE_CMD_QUEUE_SIZE;
+                        cmd_queue_element_init(m_cmd_queue.rp);
+                        m_cmd_queue.count--;
+                        m_cmd_queue.rp++;
+
+                        if (m_cmd_queue.rp >= PSTORAGE_CMD_QUEUE_SIZE)
+                        {
+                            m_cmd_queue.rp -= PSTORAGE_CMD_QUEUE_SIZE;
+                        }
                     }
+                    m_round_val = 0;
                 }
                 // Schedule any queued flash access operations.
                 retval = cmd_queue_dequeue();
@@ -516,6 +676,16 @@ void pstorage_sys_event_handler(uint32_t sys_evt)
 
             case NRF_EVT_FLASH_OPERATION_ERROR:
                 app_notify(NRF_ERROR_TIMEOUT);
+
+                // The swap state was advanced when the failed flash access was requested. Go back
+                // and retry the access, the command is still at the head of the queue.
+                m_swap_state = m_swap_state_issued;
+
+                retval = cmd_queue_dequeue();
+                if (retval != NRF_SUCCESS)
+                {
+                    app_notify(retval);
+                }
                 break;
 
             default:
@@ -569,9 +739,9 @@ static uint32_t swap_state_process(cmd_queue_element_t * p_cmd,
     {
         case STATE_DATA_TO_SWAP_WRITE:
             // Backup previous content into swap page.
-            retval = sd_flash_write((uint32_t *)(PSTORAGE_SWAP_ADDR),
-                                    (uint32_t *)(page_number * PSTORAGE_FLASH_PAGE_SIZE),
-                                    PSTORAGE_FLASH_PAGE_SIZE / sizeof(uint32_t));
+            retval = PSTORAGE_FLASH_WRITE((uint32_t *)(PSTORAGE_SWAP_ADDR),
+                                          PSTORAGE_FLASH_PTR(page_number * PSTORAGE_FLASH_PAGE_SIZE),
+                                          PSTORAGE_FLASH_PAGE_SIZE / sizeof(uint32_t));
             if (retval == NRF_SUCCESS)
             {
                 m_swap_state = STATE_DATA_ERASE;
@@ -580,7 +750,7 @@ static uint32_t swap_state_process(cmd_queue_element_t * p_cmd,
 
         case STATE_DATA_ERASE:
             // Clear the application data page.
-            retval = sd_flash_page_erase(page_number);
+            retval = PSTORAGE_FLASH_PAGE_ERASE(page_number);
             if (retval == NRF_SUCCESS)
             {
                 if (head_word_size == 0)
@@ -610,9 +780,9 @@ static uint32_t swap_state_process(cmd_queue_element_t * p_cmd,
 
         case STATE_HEAD_RESTORE:
             // Restore head from swap to application data page.
-            retval = sd_flash_write((uint32_t *)(page_number * PSTORAGE_FLASH_PAGE_SIZE),
-                                    (uint32_t *)PSTORAGE_SWAP_ADDR,
-                                    head_word_size);
+            retval = PSTORAGE_FLASH_WRITE((uint32_t *)(page_number * PSTORAGE_FLASH_PAGE_SIZE),
+                                          PSTORAGE_FLASH_PTR(PSTORAGE_SWAP_ADDR),
+                                          head_word_size);
             if (retval == NRF_SUCCESS)
             {
                 if (tail_word_size == 0)
@@ -635,13 +805,13 @@ static uint32_t swap_state_process(cmd_queue_element_t * p_cmd,
 
         case STATE_TAIL_RESTORE:
             // Restore tail from swap to application data page.
-            retval = sd_flash_write((uint32_t *)((page_number * PSTORAGE_FLASH_PAGE_SIZE) +
-                                                 (head_word_size * sizeof(uint32_t)) +
-                                                 p_cmd->size),
-                                    (uint32_t *)(PSTORAGE_SWAP_ADDR +
-                                                 (head_word_size * sizeof(uint32_t)) +
-                                                 p_cmd->size),
-                                    tail_word_size);
+            retval = PSTORAGE_FLASH_WRITE((uint32_t *)((page_number * PSTORAGE_FLASH_PAGE_SIZE) +
+                                                       (head_word_size * sizeof(uint32_t)) +
+                                                       p_cmd->size),
+                                          PSTORAGE_FLASH_PTR(PSTORAGE_SWAP_ADDR +
+                                                             (head_word_size * sizeof(uint32_t)) +
+                                                             p_cmd->size),
+                                          tail_word_size);
             if (retval == NRF_SUCCESS)
             {
                 if (p_cmd->op_code == PSTORAGE_CLEAR_OP_CODE)
@@ -657,10 +827,10 @@ static uint32_t swap_state_process(cmd_queue_element_t * p_cmd,
 
         case STATE_NEW_BODY_WRITE:
             // Write new data (body) to application data page.
-            retval = sd_flash_write((uint32_t *)((page_number * PSTORAGE_FLASH_PAGE_SIZE) +
-                                                 (head_word_size * sizeof(uint32_t))),
-                                    (uint32_t *)p_cmd->p_data_addr,
-                                    p_cmd->size / sizeof(uint32_t));
+            retval = PSTORAGE_FLASH_WRITE((uint32_t *)((page_number * PSTORAGE_FLASH_PAGE_SIZE) +
+                                                       (head_word_size * sizeof(uint32_t))),
+                                          (uint32_t *)p_cmd->p_data_addr,
+                                          p_cmd->size / sizeof(uint32_t));
             if (retval == NRF_SUCCESS)
             {
                 if ((head_word_size == 0) && (tail_word_size == 0))
@@ -676,7 +846,7 @@ static uint32_t swap_state_process(cmd_queue_element_t * p_cmd,
 
         case STATE_SWAP_ERASE:
             // Clear the swap page for subsequent use.
-            retval = sd_flash_page_erase(PSTORAGE_SWAP_ADDR / PSTORAGE_FLASH_PAGE_SIZE);
+            retval = PSTORAGE_FLASH_PAGE_ERASE(PSTORAGE_SWAP_ADDR / PSTORAGE_FLASH_PAGE_SIZE);
             if (retval == NRF_SUCCESS)
             {
                 m_swap_state = STATE_COMPLETE;
@@ -704,9 +874,15 @@ static uint32_t cmd_process(void)
 
     retval = NRF_ERROR_FORBIDDEN;
 
-    p_cmd = &m_cmd_queue.cmd[m_cmd_queue.rp];
+    if (m_cmd_exec_count == 0)
+    {
+        cmd_exec_prepare();
+    }
+
+    p_cmd = &m_cmd_exec;
 
-    storage_addr = p_cmd->storage_addr.block_id;
+    storage_addr        = p_cmd->storage_addr.block_id;
+    m_swap_state_issued = m_swap_state;
 
     switch (p_cmd->op_code)
     {
@@ -723,15 +899,15 @@ static uint32_t cmd_process(void)
 
             if (size < SOC_MAX_WRITE_SIZE)
             {
-                retval = sd_flash_write(((uint32_t *)storage_addr),
-                                        (uint32_t *)p_data_addr,
-                                        size / sizeof(uint32_t));
+                retval = PSTORAGE_FLASH_WRITE(((uint32_t *)storage_addr),
+                                              (uint32_t *)p_data_addr,
+                                              size / sizeof(uint32_t));
             }
             else
             {
-                retval = sd_flash_write(((uint32_t *)storage_addr),
-                                        (uint32_t *)p_data_addr,
-                                        SOC_MAX_WRITE_SIZE / sizeof(uint32_t));
+                retval = PSTORAGE_FLASH_WRITE(((uint32_t *)storage_addr),
+                                              (uint32_t *)p_data_addr,
+                                              SOC_MAX_WRITE_SIZE / sizeof(uint32_t));
             }
         }
         break;
@@ -756,7 +932,7 @@ static uint32_t cmd_process(void)
             {
                 page_number = ((storage_addr / PSTORAGE_FLASH_PAGE_SIZE) + m_round_val);
 
-                retval = sd_flash_page_erase(page_number);
+                retval = PSTORAGE_FLASH_PAGE_ERASE(page_number);
             }
             // If one block is to be erased.
             else
@@ -843,7 +1019,7 @@ uint32_t pstorage_init(void)
     m_swap_state = STATE_SWAP_DIRTY;
 
     // Erase swap region in case it is dirty.
-    retval = sd_flash_page_erase(PSTORAGE_SWAP_ADDR / PSTORAGE_FLASH_PAGE_SIZE);
+    retval = PSTORAGE_FLASH_PAGE_ERASE(PSTORAGE_SWAP_ADDR / PSTORAGE_FLASH_PAGE_SIZE);
     if (retval == NRF_SUCCESS)
     {
         m_cmd_queue.flash_access = true;
@@ -1014,7 +1190,7 @@ uint32_t pstorage_load(uint8_t           * p_dest,
         return NRF_ERROR_INVALID_ADDR;
     }
 
-    memcpy(p_dest, (((uint8_t *)p_src->block_id) + offset), size);
+    memcpy(p_dest, (((uint8_t *)PSTORAGE_FLASH_PTR(p_src->block_id)) + offset), size);
 
     m_app_table[p_src->module_id].cb(p_src, PSTORAGE_LOAD_OP_CODE, NRF_SUCCESS, p_dest, size);
 
@@ -0,0 +1,228 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include "slip.h"
+#include <stdlib.h>
+#include <string.h>
+#include "nordic_common.h"
+
+#define WORD_SIZE           sizeof(uint32_t)                /**< Number of bytes searched at a time. */
+#define WORD_PATTERN(byte)  ((byte) * 0x01010101u)          /**< Word with every byte set to byte. */
+
+/**@brief Macro for checking if any byte of a word is zero.
+ *
+ * @details Subtracting one from a zero byte sets its most significant bit. Masking with the
+ *          complement of the word discards the bytes which had the bit set already, so the result
+ *          is non-zero if and only if the word contains a zero byte.
+ */
+#define WORD_HAS_ZERO_BYTE(word) ((((word) - 0x01010101u) & ~(word) & 0x80808080u) != 0)
+
+
+uint32_t slip_special_byte_find(const uint8_t * p_data, uint32_t length)
+{
+    uint32_t index = 0;
+    uint32_t word;
+
+    // Search byte by byte up to a word boundary.
+    while ((index < length) && ((((uintptr_t)&p_data[index]) & (WORD_SIZE - 1)) != 0))
+    {
+        if ((p_data[index] == SLIP_END) || (p_data[index] == SLIP_ESC))
+        {
+            return index;
+        }
+        index++;
+    }
+
+    // Search a word at a time until a word containing an END or ESC byte.
+    while ((length - index) >= WORD_SIZE)
+    {
+        memcpy(&word, &p_data[index], WORD_SIZE);
+
+        if (WORD_HAS_ZERO_BYTE(word ^ WORD_PATTERN(SLIP_END)) ||
+            WORD_HAS_ZERO_BYTE(word ^ WORD_PATTERN(SLIP_ESC)))
+        {
+            break;
+        }
+        index += WORD_SIZE;
+    }
+
+    // Locate the byte within the word, or search the tail of the span.
+    while (index < length)
+    {
+        if ((p_data[index] == SLIP_END) || (p_data[index] == SLIP_ESC))
+        {
+            return index;
+        }
+        index++;
+    }
+
+    return length;
+}
+
+
+void slip_encoder_init(slip_encoder_t * p_encoder, const uint8_t * p_data, uint32_t length)
+{
+    p_encoder->p_data = p_data;
+    p_encoder->length = length;
+    p_encoder->index  = 0;
+    p_encoder->escape = false;
+}
+
+
+uint32_t slip_encode(slip_encoder_t * p_encoder, uint8_t * p_output, uint32_t size)
+{
+    uint32_t count = 0;
+    uint32_t run;
+    uint32_t run_max;
+
+    while (count < size)
+    {
+        if (p_encoder->escape)
+        {
+            // Output the special code of the escaped byte.
+            p_output[count++]  = (p_encoder->p_data[p_encoder->index] == SLIP_END) ? SLIP_ESC_END
+                                                                                   : SLIP_ESC_ESC;
+            p_encoder->index++;
+            p_encoder->escape  = false;
+        }
+
+        if (p_encoder->index == p_encoder->length)
+        {
+            break;
+        }
+
+        // Copy the bytes up to the next END or ESC byte as they are.
+        run_max = MIN(p_encoder->length - p_encoder->index, size - count);
+        run     = slip_special_byte_find(&p_encoder->p_data[p_encoder->index], run_max);
+
+        memcpy(&p_output[count], &p_encoder->p_data[p_encoder->index], run);
+        count            += run;
+        p_encoder->index += run;
+
+        if (run != run_max)
+        {
+            // END or ESC byte found, there is room for the escape code at least.
+            p_output[count++] = SLIP_ESC;
+            p_encoder->escape = true;
+        }
+    }
+
+    return count;
+}
+
+
+void slip_decoder_init(slip_decoder_t * p_decoder, uint8_t * p_buffer, uint32_t buffer_size)
+{
+    p_decoder->p_buffer     = p_buffer;
+    p_decoder->buffer_size  = buffer_size;
+    p_decoder->length       = 0;
+    p_decoder->escape       = false;
+    p_decoder->synchronized = false;
+}
+
+
+slip_decode_result_t slip_decode(slip_decoder_t * p_decoder,
+                                 const uint8_t  * p_data,
+                                 uint32_t       * p_length)
+{
+    slip_decode_result_t result = SLIP_DECODE_CONTINUE;
+    uint32_t             index  = 0;
+    uint32_t             run;
+    uint32_t             run_max;
+    uint8_t              byte;
+
+    while (index < *p_length)
+    {
+        if (!p_decoder->synchronized)
+        {
+            // Discard bytes up to and including the next END byte.
+            const uint8_t * p_end = memchr(&p_data[index], SLIP_END, *p_length - index);
+
+            if (p_end == NULL)
+            {
+                index = *p_length;
+                break;
+            }
+            index                   = (uint32_t)(p_end - p_data) + 1;
+            p_decoder->length       = 0;
+            p_decoder->escape       = false;
+            p_decoder->synchronized = true;
+            continue;
+        }
+
+        if (!p_decoder->escape)
+        {
+            // Copy the bytes up to the next END or ESC byte as they are.
+            run_max = MIN(*p_length - index, p_decoder->buffer_size - p_decoder->length);
+            run     = slip_special_byte_find(&p_data[index], run_max);
+
+            if (run != 0)
+            {
+                memcpy(&p_decoder->p_buffer[p_decoder->length], &p_data[index], run);
+                p_decoder->length += run;
+                index             += run;
+            }
+
+            if (index == *p_length)
+            {
+                break;
+            }
+        }
+
+        byte = p_data[index];
+
+        if (byte == SLIP_END)
+        {
+            // An END byte terminates the frame also when it follows an ESC byte.
+            index++;
+            p_decoder->escape = false;
+
+            if (p_decoder->length != 0)
+            {
+                p_decoder->synchronized = false;
+                result                  = SLIP_DECODE_FRAME_END;
+                break;
+            }
+        }
+        else if (!p_decoder->escape && (byte == SLIP_ESC))
+        {
+            index++;
+            p_decoder->escape = true;
+        }
+        else if (p_decoder->length == p_decoder->buffer_size)
+        {
+            result = SLIP_DECODE_BUFFER_FULL;
+            break;
+        }
+        else
+        {
+            if (p_decoder->escape)
+            {
+                // Special codes are decoded, other bytes following an ESC byte are kept as they are.
+                if (byte == SLIP_ESC_END)
+                {
+                    byte = SLIP_END;
+                }
+                else if (byte == SLIP_ESC_ESC)
+                {
+                    byte = SLIP_ESC;
+                }
+                p_decoder->escape = false;
+            }
+            p_decoder->p_buffer[p_decoder->length++] = byte;
+            index++;
+        }
+    }
+
+    *p_length = index;
+    return result;
+}
@@ -0,0 +1,139 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include "ble_gatts_router.h"
+#include <stdlib.h>
+#include "nordic_common.h"
+#include "nrf_error.h"
+
+
+/**@brief Route from an attribute handle to its handler. */
+typedef struct
+{
+    uint16_t                   handle;                              /**< Attribute handle. */
+    ble_gatts_router_handler_t handler;                             /**< Handler for events on the attribute handle. */
+    void *                     p_context;                           /**< Context passed to the handler. */
+} route_t;
+
+static route_t  m_routes[BLE_GATTS_ROUTER_ROUTES_MAX];              /**< Registered routes, sorted by attribute handle. */
+static uint16_t m_route_count;                                      /**< Number of registered routes. */
+
+
+/**@brief Function for finding the first route with an attribute handle not less than a given one.
+ *
+ * @param[in]   handle   Attribute handle.
+ *
+ * @return      Index of the route, or m_route_count if all routes have a lower attribute handle.
+ */
+static uint16_t route_lower_bound(uint16_t handle)
+{
+    uint16_t low  = 0;
+    uint16_t high = m_route_count;
+
+    while (low < high)
+    {
+        uint16_t mid = (uint16_t)((low + high) / 2);
+
+        if (m_routes[mid].handle < handle)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+
+uint32_t ble_gatts_router_register(uint16_t                   handle,
+                                   ble_gatts_router_handler_t handler,
+                                   void *                     p_context)
+{
+    uint16_t index;
+    uint16_t i;
+
+    if (handler == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    if (handle == BLE_GATT_HANDLE_INVALID)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    index = route_lower_bound(handle);
+
+    if ((index == m_route_count) || (m_routes[index].handle != handle))
+    {
+        if (m_route_count >= BLE_GATTS_ROUTER_ROUTES_MAX)
+        {
+            return NRF_ERROR_NO_MEM;
+        }
+
+        // Make room for the new route, keeping the routes sorted.
+        for (i = m_route_count; i > index; i--)
+        {
+            m_routes[i] = m_routes[i - 1];
+        }
+        m_route_count++;
+    }
+
+    m_routes[index].handle    = handle;
+    m_routes[index].handler   = handler;
+    m_routes[index].p_context = p_context;
+
+    return NRF_SUCCESS;
+}
+
+
+void ble_gatts_router_on_ble_evt(ble_evt_t * p_ble_evt)
+{
+    ble_gatts_evt_t * p_gatts_evt = &p_ble_evt->evt.gatts_evt;
+    uint16_t          handle;
+    uint16_t          index;
+
+    switch (p_ble_evt->header.evt_id)
+    {
+        case BLE_GATTS_EVT_WRITE:
+            handle = p_gatts_evt->params.write.handle;
+            break;
+
+        case BLE_GATTS_EVT_RW_AUTHORIZE_REQUEST:
+            if (p_gatts_evt->params.authorize_request.type == BLE_GATTS_AUTHORIZE_TYPE_READ)
+            {
+                handle = p_gatts_evt->params.authorize_request.request.read.handle;
+            }
+            else
+            {
+                handle = p_gatts_evt->params.authorize_request.request.write.handle;
+            }
+            break;
+
+        case BLE_GATTS_EVT_HVC:
+            handle = p_gatts_evt->params.hvc.handle;
+            break;
+
+        default:
+            // No implementation needed.
+            return;
+    }
+
+    index = route_lower_bound(handle);
+    if ((index < m_route_count) && (m_routes[index].handle == handle))
+    {
+        m_routes[index].handler(m_routes[index].p_context, p_ble_evt);
+    }
+}
@@ -15,6 +15,7 @@
 #include <string.h>
 #include "nordic_common.h"
 #include "ble_srv_common.h"
+#include "ble_gatts_router.h"
 #include "app_util.h"
 
 
@@ -44,19 +45,25 @@ static void on_disconnect(ble_cis_t * p_cis, ble_evt_t * p_ble_evt)
 }
 
 
-/**@brief Function for handling the Write event.
+/**@brief Function for handling GATT Server events on the LED characteristic value.
  *
- * @param[in]   p_cis       Battery Service structure.
+ * @details Called by the @ref ble_sdk_lib_gatts_router for the LED characteristic value handle.
+ *
+ * @param[in]   p_context   Identify Service structure.
  * @param[in]   p_ble_evt   Event received from the BLE stack.
  */
-static void on_write(ble_cis_t * p_cis, ble_evt_t * p_ble_evt)
+static void on_led_value_evt(void * p_context, ble_evt_t * p_ble_evt)
 {
+    ble_cis_t *             p_cis       = (ble_cis_t *)p_context;
     ble_gatts_evt_write_t * p_evt_write = &p_ble_evt->evt.gatts_evt.params.write;
+
+    if (p_ble_evt->header.evt_id != BLE_GATTS_EVT_WRITE)
+    {
+        return;
+    }
+
     debug(0,"Handling on write \n\r ");
-    if (
-        (p_evt_write->handle == p_cis->led_char_handles.value_handle)
-        &&(p_evt_write->len == 1)&&(p_cis->led_write_handler != NULL)
-       )
+    if ((p_evt_write->len == 1) && (p_cis->led_write_handler != NULL))
     {
         p_cis->led_write_handler(p_cis, p_evt_write->data[0]);
     }
@@ -76,10 +83,6 @@ void ble_cis_on_ble_evt(ble_cis_t * p_cis, ble_evt_t * p_ble_evt)
             on_disconnect(p_cis, p_ble_evt);
             break;
 
-        case BLE_GATTS_EVT_WRITE:
-            on_write(p_cis, p_ble_evt);
-            break;
-
         default:
             // No implementation needed.
             break;
@@ -223,8 +226,9 @@ uint32_t ble_cis_init(ble_cis_t * p_cis, const ble_cis_init_t * p_cis_init)
     {
         return err_code;
     }
-    
-    return NRF_SUCCESS;
+
+    // Have writes to the LED characteristic routed to this service.
+    return ble_gatts_router_register(p_cis->led_char_handles.value_handle, on_led_value_evt, p_cis);
 }
 /*
 uint32_t ble_cis_on_button_change(ble_cis_t * p_cis, uint8_t button_state)
@@ -17,6 +17,7 @@
 #include "ble_gls.h"
 #include <string.h>
 #include "ble_srv_common.h"
+#include "ble_gatts_router.h"
 #include "ble_racp.h"
 #include "ble_gls_db.h"
 
@@ -315,6 +316,9 @@ static uint32_t record_access_control_point_char_add(ble_gls_t * p_gls)
 }
 
 
+static void on_gatts_evt(void * p_context, ble_evt_t * p_ble_evt);
+
+
 uint32_t ble_gls_init(ble_gls_t * p_gls, const ble_gls_init_t * p_gls_init)
 {
     uint32_t   err_code;
@@ -375,7 +379,14 @@ uint32_t ble_gls_init(ble_gls_t * p_gls, const ble_gls_init_t * p_gls_init)
         return err_code;
     }
 
-    return NRF_SUCCESS;
+    // Have events on the measurement CCCD and the control point routed to this service
+    err_code = ble_gatts_router_register(p_gls->glm_handles.cccd_handle, on_gatts_evt, p_gls);
+    if (err_code != NRF_SUCCESS)
+    {
+        return err_code;
+    }
+
+    return ble_gatts_router_register(p_gls->racp_handles.value_handle, on_gatts_evt, p_gls);
 }
 
 
@@ -1124,28 +1135,6 @@ static void on_glm_cccd_write(ble_gls_t * p_gls, ble_gatts_evt_write_t * p_evt_w
 }
 
 
-/**@brief Function for handling the WRITE event.
- *
- * @details Handles WRITE events from the BLE stack.
- *
- * @param[in]   p_gls      Glucose Service structure.
- * @param[in]   p_ble_evt  Event received from the BLE stack.
- */
-static void on_write(ble_gls_t * p_gls, ble_evt_t * p_ble_evt)
-{
-    ble_gatts_evt_write_t * p_evt_write = &p_ble_evt->evt.gatts_evt.params.write;
-
-    if (p_evt_write->handle == p_gls->glm_handles.cccd_handle)
-    {
-        on_glm_cccd_write(p_gls, p_evt_write);
-    }
-    else if (p_evt_write->handle == p_gls->racp_handles.value_handle)
-    {
-        on_racp_value_write(p_gls, p_evt_write);
-    }
-}
-
-
 /**@brief Function for handling the TX_COMPLETE event.
  *
  * @details Handles TX_COMPLETE events from the BLE stack.
@@ -1170,43 +1159,69 @@ static void on_tx_complete(ble_gls_t * p_gls, ble_evt_t * p_ble_evt)
 
 /**@brief Function for handling the HVC event.
  *
- * @details Handles HVC events from the BLE stack.
+ * @details Handles HVC events from the BLE stack on the Record Access Control Point.
  *
  * @param[in]   p_gls      Glucose Service structure.
- * @param[in]   p_ble_evt  Event received from the BLE stack.
  */
-static void on_hvc(ble_gls_t * p_gls, ble_evt_t * p_ble_evt)
+static void on_racp_hvc(ble_gls_t * p_gls)
 {
-    ble_gatts_evt_hvc_t * p_hvc = &p_ble_evt->evt.gatts_evt.params.hvc;
-
-    if (p_hvc->handle == p_gls->racp_handles.value_handle)
+    if (m_gls_state == STATE_RACP_RESPONSE_IND_VERIF)
     {
-        if (m_gls_state == STATE_RACP_RESPONSE_IND_VERIF)
-        {
-            // Indication has been acknowledged. Return to default state.
-            state_set(STATE_NO_COMM);
-        }
-        else
+        // Indication has been acknowledged. Return to default state.
+        state_set(STATE_NO_COMM);
+    }
+    else
+    {
+        // We did not expect this event in this state. Report error to application.
+        if (p_gls->error_handler != NULL)
         {
-            // We did not expect this event in this state. Report error to application.
-            if (p_gls->error_handler != NULL)
-            {
-                p_gls->error_handler(NRF_ERROR_INVALID_STATE);
-            }
+            p_gls->error_handler(NRF_ERROR_INVALID_STATE);
         }
     }
 }
 
 
-static void on_rw_authorize_request(ble_gls_t * p_gls, ble_gatts_evt_t * p_gatts_evt)
+/**@brief Function for handling GATT Server events on the service's attributes.
+ *
+ * @details Called by the @ref ble_sdk_lib_gatts_router for the Glucose Measurement CCCD and the
+ *          Record Access Control Point value handles.
+ *
+ * @param[in]   p_context  Glucose Service structure.
+ * @param[in]   p_ble_evt  Event received from the BLE stack.
+ */
+static void on_gatts_evt(void * p_context, ble_evt_t * p_ble_evt)
 {
-    ble_gatts_evt_rw_authorize_request_t * p_auth_req = &p_gatts_evt->params.authorize_request;
-    if (p_auth_req->type == BLE_GATTS_AUTHORIZE_TYPE_WRITE)
+    ble_gls_t *                            p_gls       = (ble_gls_t *)p_context;
+    ble_gatts_evt_write_t *                p_evt_write = &p_ble_evt->evt.gatts_evt.params.write;
+    ble_gatts_evt_rw_authorize_request_t * p_auth_req  = &p_ble_evt->evt.gatts_evt.params.authorize_request;
+
+    switch (p_ble_evt->header.evt_id)
     {
-        if (p_auth_req->request.write.handle == p_gls->racp_handles.value_handle)
-        {
-            on_racp_value_write(p_gls, &p_auth_req->request.write);
-        }
+        case BLE_GATTS_EVT_WRITE:
+            if (p_evt_write->handle == p_gls->glm_handles.cccd_handle)
+            {
+                on_glm_cccd_write(p_gls, p_evt_write);
+            }
+            else
+            {
+                on_racp_value_write(p_gls, p_evt_write);
+            }
+            break;
+
+        case BLE_GATTS_EVT_RW_AUTHORIZE_REQUEST:
+            if (p_auth_req->type == BLE_GATTS_AUTHORIZE_TYPE_WRITE)
+            {
+                on_racp_value_write(p_gls, &p_auth_req->request.write);
+            }
+            break;
+
+        case BLE_GATTS_EVT_HVC:
+            on_racp_hvc(p_gls);
+            break;
+
+        default:
+            // No implementation needed.
+            break;
     }
 }
 
@@ -1223,22 +1238,10 @@ void ble_gls_on_ble_evt(ble_gls_t * p_gls, ble_evt_t * p_ble_evt)
             p_gls->conn_handle = BLE_CONN_HANDLE_INVALID;
             break;
 
-        case BLE_GATTS_EVT_WRITE:
-            on_write(p_gls, p_ble_evt);
-            break;
-
         case BLE_EVT_TX_COMPLETE:
             on_tx_complete(p_gls, p_ble_evt);
             break;
 
-        case BLE_GATTS_EVT_RW_AUTHORIZE_REQUEST:
-            on_rw_authorize_request(p_gls, &p_ble_evt->evt.gatts_evt);
-            break;
-
-        case BLE_GATTS_EVT_HVC:
-            on_hvc(p_gls, p_ble_evt);
-            break;
-
         default:
             // No implementation needed.
             break;
@@ -20,6 +20,7 @@
 #include "app_error.h"
 #include "nordic_common.h"
 #include "ble_srv_common.h"
+#include "ble_gatts_router.h"
 #include "app_util.h"
 
 
@@ -243,88 +244,114 @@ static void on_report_value_read_auth(ble_hids_t         * p_hids,
     }
 }
 
-/**@brief Function for finding the Characteristic Id of a characteristic corresponding to a CCCD handle.
+/**@brief Function for handling GATT Server events on a report characteristic.
  *
- * @param[in]   p_hids      HID Service structure.
- * @param[in]   handle      Handle to search for.
- * @param[out]  p_char_id   Id of report characteristic.
- *
- * @return      TRUE if CCCD handle was found, FALSE otherwise.
+ * @param[in]   p_rep         Report characteristic the event is for.
+ * @param[in]   p_rep_array   Array of reports of the same type as p_rep.
+ * @param[in]   rep_type      Type of report.
+ * @param[in]   p_ble_evt     Event received from the BLE stack.
  */
-static bool inp_rep_cccd_identify(ble_hids_t         * p_hids,
-                                  uint16_t             handle,
-                                  ble_hids_char_id_t * p_char_id)
+static void on_rep_evt(ble_hids_rep_char_t * p_rep,
+                       ble_hids_rep_char_t * p_rep_array,
+                       uint8_t               rep_type,
+                       ble_evt_t           * p_ble_evt)
 {
-    uint8_t i;
+    ble_gatts_evt_t *  p_gatts_evt = &p_ble_evt->evt.gatts_evt;
+    ble_hids_char_id_t char_id     = make_char_id(BLE_UUID_REPORT_CHAR,
+                                                  rep_type,
+                                                  (uint8_t)(p_rep - p_rep_array));
 
-    for (i = 0; i < p_hids->inp_rep_count; i++)
+    switch (p_ble_evt->header.evt_id)
     {
-        if (handle == p_hids->inp_rep_array[i].char_handles.cccd_handle)
-        {
-            *p_char_id = make_char_id(BLE_UUID_REPORT_CHAR, BLE_HIDS_REP_TYPE_INPUT, i);
-            return true;
-        }
+        case BLE_GATTS_EVT_WRITE:
+            if (p_gatts_evt->params.write.handle == p_rep->char_handles.cccd_handle)
+            {
+                on_report_cccd_write(p_rep->p_hids, &char_id, &p_gatts_evt->params.write);
+            }
+            else
+            {
+                on_report_value_write(p_rep->p_hids, p_ble_evt, &char_id);
+            }
+            break;
+
+        case BLE_GATTS_EVT_RW_AUTHORIZE_REQUEST:
+            if (p_gatts_evt->params.authorize_request.type == BLE_GATTS_AUTHORIZE_TYPE_READ)
+            {
+                on_report_value_read_auth(p_rep->p_hids, &char_id, p_ble_evt);
+            }
+            break;
+
+        default:
+            // No implementation needed.
+            break;
     }
+}
+
+
+/**@brief Function for handling GATT Server events on an Input Report characteristic.
+ *
+ * @details Called by the @ref ble_sdk_lib_gatts_router for the value and CCCD handles.
+ *
+ * @param[in]   p_context   Input Report characteristic (in ble_hids_t.inp_rep_array).
+ * @param[in]   p_ble_evt   Event received from the BLE stack.
+ */
+static void on_inp_rep_evt(void * p_context, ble_evt_t * p_ble_evt)
+{
+    ble_hids_rep_char_t * p_rep = (ble_hids_rep_char_t *)p_context;
 
-    return false;
+    on_rep_evt(p_rep, p_rep->p_hids->inp_rep_array, BLE_HIDS_REP_TYPE_INPUT, p_ble_evt);
 }
 
 
-/**@brief Function for finding the Characteristic Id of a characteristic corresponding to a value handle.
+/**@brief Function for handling GATT Server events on an Output Report characteristic.
  *
- * @param[in]   p_hids      HID Service structure.
- * @param[in]   handle      Handle to search for.
- * @param[out]  p_char_id   Id of report characteristic.
+ * @details Called by the @ref ble_sdk_lib_gatts_router for the value handle.
  *
- * @return      TRUE if value handle was found, FALSE otherwise.
+ * @param[in]   p_context   Output Report characteristic (in ble_hids_t.outp_rep_array).
+ * @param[in]   p_ble_evt   Event received from the BLE stack.
  */
-static bool rep_value_identify(ble_hids_t         * p_hids,
-                               uint16_t             handle,
-                               ble_hids_char_id_t * p_char_id)
+static void on_outp_rep_evt(void * p_context, ble_evt_t * p_ble_evt)
 {
-    uint8_t i;
+    ble_hids_rep_char_t * p_rep = (ble_hids_rep_char_t *)p_context;
 
-    for (i = 0; i < p_hids->inp_rep_count; i++)
-    {
-        if (handle == p_hids->inp_rep_array[i].char_handles.value_handle)
-        {
-            *p_char_id = make_char_id(BLE_UUID_REPORT_CHAR, BLE_HIDS_REP_TYPE_INPUT, i);
-            return true;
-        }
-    }
+    on_rep_evt(p_rep, p_rep->p_hids->outp_rep_array, BLE_HIDS_REP_TYPE_OUTPUT, p_ble_evt);
+}
 
-    for (i = 0; i < p_hids->outp_rep_count; i++)
-    {
-        if (handle == p_hids->outp_rep_array[i].char_handles.value_handle)
-        {
-            *p_char_id = make_char_id(BLE_UUID_REPORT_CHAR, BLE_HIDS_REP_TYPE_OUTPUT, i);
-            return true;
-        }
-    }
 
-    for (i = 0; i < p_hids->feature_rep_count; i++)
-    {
-        if (handle == p_hids->feature_rep_array[i].char_handles.value_handle)
-        {
-            *p_char_id = make_char_id(BLE_UUID_REPORT_CHAR, BLE_HIDS_REP_TYPE_FEATURE, i);
-            return true;
-        }
-    }
+/**@brief Function for handling GATT Server events on a Feature Report characteristic.
+ *
+ * @details Called by the @ref ble_sdk_lib_gatts_router for the value handle.
+ *
+ * @param[in]   p_context   Feature Report characteristic (in ble_hids_t.feature_rep_array).
+ * @param[in]   p_ble_evt   Event received from the BLE stack.
+ */
+static void on_feature_rep_evt(void * p_context, ble_evt_t * p_ble_evt)
+{
+    ble_hids_rep_char_t * p_rep = (ble_hids_rep_char_t *)p_context;
 
-    return false;
+    on_rep_evt(p_rep, p_rep->p_hids->feature_rep_array, BLE_HIDS_REP_TYPE_FEATURE, p_ble_evt);
 }
 
 
-/**@brief Function for handling the Write event.
+/**@brief Function for handling GATT Server events on the HID Control Point, the Protocol Mode and
+ *        the Boot Input Report characteristics.
  *
- * @param[in]   p_hids      HID Service structure.
+ * @details Called by the @ref ble_sdk_lib_gatts_router for the handles of these characteristics.
+ *
+ * @param[in]   p_context   HID Service structure.
  * @param[in]   p_ble_evt   Event received from the BLE stack.
  */
-static void on_write(ble_hids_t * p_hids, ble_evt_t * p_ble_evt)
+static void on_hids_evt(void * p_context, ble_evt_t * p_ble_evt)
 {
+    ble_hids_t *            p_hids      = (ble_hids_t *)p_context;
     ble_gatts_evt_write_t * p_evt_write = &p_ble_evt->evt.gatts_evt.params.write;
     ble_hids_char_id_t      char_id;
 
+    if (p_ble_evt->header.evt_id != BLE_GATTS_EVT_WRITE)
+    {
+        return;
+    }
+
     if (p_evt_write->handle == p_hids->hid_control_point_handles.value_handle)
     {
         on_control_point_write(p_hids, p_evt_write);
@@ -353,41 +380,12 @@ static void on_write(ble_hids_t * p_hids, ble_evt_t * p_ble_evt)
         char_id = make_char_id(BLE_UUID_BOOT_MOUSE_INPUT_REPORT_CHAR, 0, 0);
         on_report_value_write(p_hids, p_ble_evt, &char_id);
     }
-    else if (inp_rep_cccd_identify(p_hids, p_evt_write->handle, &char_id))
-    {
-        on_report_cccd_write(p_hids, &char_id, p_evt_write);
-    }
-    else if (rep_value_identify(p_hids, p_evt_write->handle, &char_id))
-    {
-        on_report_value_write(p_hids, p_ble_evt, &char_id);
-    }
     else
     {
         // No implementation needed.
     }
 }
 
-/**@brief Read/write authorize request event handler.
- *
- * @param[in]   p_hids      HID Service structure.
- * @param[in]   p_ble_evt   Event received from the BLE stack.
- */
-static void on_rw_authorize_request(ble_hids_t * p_hids, ble_evt_t * p_ble_evt)
-{
-    ble_gatts_evt_rw_authorize_request_t * evt_rw_auth = &p_ble_evt->evt.gatts_evt.params.authorize_request;
-    ble_hids_char_id_t                     char_id;
-
-    if (evt_rw_auth->type != BLE_GATTS_AUTHORIZE_TYPE_READ)
-    {
-        // Unexpected operation
-        return;
-    }
-
-    if (rep_value_identify(p_hids, evt_rw_auth->request.read.handle, &char_id))
-    {
-        on_report_value_read_auth(p_hids, &char_id, p_ble_evt);
-    }
-}
 
 void ble_hids_on_ble_evt(ble_hids_t * p_hids, ble_evt_t * p_ble_evt)
 {
@@ -401,13 +399,6 @@ void ble_hids_on_ble_evt(ble_hids_t * p_hids, ble_evt_t * p_ble_evt)
             on_disconnect(p_hids, p_ble_evt);
             break;
 
-        case BLE_GATTS_EVT_WRITE:
-            on_write(p_hids, p_ble_evt);
-            break;
-
-        case BLE_GATTS_EVT_RW_AUTHORIZE_REQUEST:
-            on_rw_authorize_request(p_hids, p_ble_evt);
-            break;
         default:
             // No implementation needed.
             break;
@@ -1080,6 +1071,102 @@ static uint32_t includes_add(ble_hids_t * p_hids, const ble_hids_init_t * p_hids
 }
 
 
+/**@brief Function for registering a handler for GATT Server events on an attribute handle.
+ *
+ * @details Characteristics without the attribute (e.g. a report without CCCD) are skipped.
+ *
+ * @param[in]   handle      Attribute handle, BLE_GATT_HANDLE_INVALID if not present.
+ * @param[in]   handler     Function to be called for events on the attribute handle.
+ * @param[in]   p_context   Context passed to the handler.
+ *
+ * @return      NRF_SUCCESS on success, otherwise an error code.
+ */
+static uint32_t route_register(uint16_t                   handle,
+                               ble_gatts_router_handler_t handler,
+                               void                     * p_context)
+{
+    if (handle == BLE_GATT_HANDLE_INVALID)
+    {
+        return NRF_SUCCESS;
+    }
+
+    return ble_gatts_router_register(handle, handler, p_context);
+}
+
+
+/**@brief Function for having GATT Server events on the service's attributes routed to the service.
+ *
+ * @param[in]   p_hids   HID Service structure.
+ *
+ * @return      NRF_SUCCESS on success, otherwise an error code.
+ */
+static uint32_t routes_register(ble_hids_t * p_hids)
+{
+    const uint16_t hids_handles[] =
+    {
+        p_hids->hid_control_point_handles.value_handle,
+        p_hids->protocol_mode_handles.value_handle,
+        p_hids->boot_kb_inp_rep_handles.value_handle,
+        p_hids->boot_kb_inp_rep_handles.cccd_handle,
+        p_hids->boot_mouse_inp_rep_handles.value_handle,
+        p_hids->boot_mouse_inp_rep_handles.cccd_handle
+    };
+    uint32_t err_code;
+    uint8_t  i;
+
+    for (i = 0; i < sizeof(hids_handles) / sizeof(hids_handles[0]); i++)
+    {
+        err_code = route_register(hids_handles[i], on_hids_evt, p_hids);
+        if (err_code != NRF_SUCCESS)
+        {
+            return err_code;
+        }
+    }
+
+    for (i = 0; i < p_hids->inp_rep_count; i++)
+    {
+        ble_hids_rep_char_t * p_rep = &p_hids->inp_rep_array[i];
+
+        p_rep->p_hids = p_hids;
+        err_code      = route_register(p_rep->char_handles.value_handle, on_inp_rep_evt, p_rep);
+        if (err_code == NRF_SUCCESS)
+        {
+            err_code = route_register(p_rep->char_handles.cccd_handle, on_inp_rep_evt, p_rep);
+        }
+        if (err_code != NRF_SUCCESS)
+        {
+            return err_code;
+        }
+    }
+
+    for (i = 0; i < p_hids->outp_rep_count; i++)
+    {
+        ble_hids_rep_char_t * p_rep = &p_hids->outp_rep_array[i];
+
+        p_rep->p_hids = p_hids;
+        err_code      = route_register(p_rep->char_handles.value_handle, on_outp_rep_evt, p_rep);
+        if (err_code != NRF_SUCCESS)
+        {
+            return err_code;
+        }
+    }
+
+    for (i = 0; i < p_hids->feature_rep_count; i++)
+    {
+        ble_hids_rep_char_t * p_rep = &p_hids->feature_rep_array[i];
+
+        p_rep->p_hids = p_hids;
+        err_code      = route_register(p_rep->char_handles.value_handle, on_feature_rep_evt, p_rep);
+        if (err_code != NRF_SUCCESS)
+        {
+            return err_code;
+        }
+    }
+
+    return NRF_SUCCESS;
+}
+
+
 uint32_t ble_hids_init(ble_hids_t * p_hids, const ble_hids_init_t * p_hids_init)
 {
     uint32_t   err_code;
@@ -1101,6 +1188,12 @@ uint32_t ble_hids_init(ble_hids_t * p_hids, const ble_hids_init_t * p_hids_init)
     p_hids->feature_rep_count = p_hids_init->feature_rep_count;
     p_hids->conn_handle       = BLE_CONN_HANDLE_INVALID;
 
+    // Characteristics which are not added keep invalid handles, and are not routed.
+    memset(&p_hids->protocol_mode_handles, 0, sizeof(p_hids->protocol_mode_handles));
+    memset(&p_hids->boot_kb_inp_rep_handles, 0, sizeof(p_hids->boot_kb_inp_rep_handles));
+    memset(&p_hids->boot_kb_outp_rep_handles, 0, sizeof(p_hids->boot_kb_outp_rep_handles));
+    memset(&p_hids->boot_mouse_inp_rep_handles, 0, sizeof(p_hids->boot_mouse_inp_rep_handles));
+
     // Add service.
     BLE_UUID_BLE_ASSIGN(ble_uuid, BLE_UUID_HUMAN_INTERFACE_DEVICE_SERVICE);
 
@@ -1206,7 +1299,8 @@ uint32_t ble_hids_init(ble_hids_t * p_hids, const ble_hids_init_t * p_hids_init)
         return err_code;
     }
 
-    return NRF_SUCCESS;
+    // Have writes and read authorize requests routed to this service.
+    return routes_register(p_hids);
 }
 
 
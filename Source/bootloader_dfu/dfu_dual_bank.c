@@ -40,7 +40,11 @@ static uint32_t                     m_image_size;               /**< Size of the
 static dfu_start_packet_t           m_start_packet;             /**< Start packet received for this update procedure. Contains update mode and image sizes information to be used for image transfer. */
 static uint32_t                     m_init_packet[16];          /**< Init packet, can hold CRC, Hash, Signed Hash and similar, for image validation, integrety check and authorization checking. */ 
 static uint8_t                      m_init_packet_length;       /**< Length of init packet received. */
-static uint16_t                     m_image_crc;                /**< Calculated CRC of the image received. */
+static uint16_t                     m_image_crc;                /**< Calculated CRC of the image received, updated with every data packet. */
+#if DFU_POST_WRITE_VERIFY
+static uint16_t                     m_flash_crc;                /**< CRC of the image content in flash, updated when storing of a data packet completes. */
+static uint32_t                     m_data_verified;            /**< Amount of received data for which CRC of the flash content has been calculated. */
+#endif
 
 static app_timer_id_t               m_dfu_timer_id;             /**< Application timer id. */
 static bool                         m_dfu_timed_out = false;    /**< Boolean flag value for tracking DFU timer timeout state. */
@@ -53,6 +57,51 @@ static dfu_callback_t               m_data_pkt_cb;              /**< Callback fr
 static dfu_bank_func_t              m_functions;                /**< Structure holding operations for the selected update process. */
 
 
+
+#if DFU_POST_WRITE_VERIFY
+/**@brief Function for verifying a data packet written to flash.
+ *
+ * @details Called when storing of a data packet has completed. Stores complete in the order in
+ *          which they were requested, so CRC of the flash content is calculated in chunks, in the
+ *          background, while the image is being received.
+ *
+ * @param[in] data_len  Length of the data packet written.
+ */
+static void dfu_written_data_verify(uint32_t data_len)
+{
+    if ((m_data_verified + data_len) <= m_data_received)
+    {
+        m_flash_crc      = crc16_update(m_flash_crc,
+                                        (uint8_t *)(mp_storage_handle_active->block_id + m_data_verified),
+                                        data_len);
+        m_data_verified += data_len;
+    }
+}
+
+
+/**@brief Function for checking that the image written to flash matches the data received.
+ *
+ * @retval NRF_SUCCESS             Flash content matches the received data.
+ * @retval NRF_ERROR_BUSY          Not all data packets have been written to flash yet.
+ * @retval NRF_ERROR_INVALID_DATA  Flash content does not match the received data.
+ */
+static uint32_t dfu_written_data_check(void)
+{
+    if (m_data_verified != m_image_size)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    if (crc16_final(m_flash_crc) != m_image_crc)
+    {
+        return NRF_ERROR_INVALID_DATA;
+    }
+
+    return NRF_SUCCESS;
+}
+#endif // DFU_POST_WRITE_VERIFY
+
+
 /**@brief Function for handling callbacks from pstorage module.
  *
  * @details Handles pstorage results for clear and storage operation. For detailed description of
@@ -69,6 +118,12 @@ static void pstorage_callback_handler(pstorage_handle_t * p_handle,
         switch (op_code)
         {
             case PSTORAGE_STORE_OP_CODE:
+#if DFU_POST_WRITE_VERIFY
+                if (result == NRF_SUCCESS)
+                {
+                    dfu_written_data_verify(data_len);
+                }
+#endif
                 if (m_dfu_state == DFU_STATE_RX_DATA_PKT)
                 {
                     m_data_pkt_cb(DATA_PACKET, result, p_data);
@@ -419,6 +474,12 @@ uint32_t dfu_start_pkt_handle(dfu_update_packet_t * p_packet)
             {
                 return err_code;
             }
+
+            m_image_crc     = crc16_init();
+#if DFU_POST_WRITE_VERIFY
+            m_flash_crc     = crc16_init();
+            m_data_verified = 0;
+#endif
             m_functions.prepare(m_image_size);
 
             break;
@@ -490,6 +551,9 @@ uint32_t dfu_data_pkt_handle(dfu_update_packet_t * p_packet)
                 return err_code;
             }
 
+            // Update CRC of the image with the packet, so that no pass over the whole image is
+            // needed during validation.
+            m_image_crc      = crc16_update(m_image_crc, (uint8_t *)p_data, data_length);
             m_data_received += data_length;
 
             if (m_data_received != m_image_size)
@@ -579,10 +643,8 @@ uint32_t dfu_image_validate()
                 err_code = dfu_timer_restart();
                 if (err_code == NRF_SUCCESS)
                 {
-                    // calculate CRC from active block.
-                    m_image_crc = crc16_compute((uint8_t *)mp_storage_handle_active->block_id,
-                                                m_image_size,
-                                                NULL);
+                    // CRC has been calculated while receiving data packets.
+                    m_image_crc  = crc16_final(m_image_crc);
                     received_crc = uint16_decode((uint8_t *)&m_init_packet[0]);
 
                     if ((m_init_packet_length != 0) && (m_image_crc != received_crc))
@@ -612,6 +674,16 @@ uint32_t dfu_image_activate()
     {
         case DFU_STATE_WAIT_4_ACTIVATE:
 
+#if DFU_POST_WRITE_VERIFY
+            // Do not activate an image which was not written to flash correctly. The DFU Timer is
+            // left running, so the update still times out if the peer gives up.
+            err_code = dfu_written_data_check();
+            if (err_code != NRF_SUCCESS)
+            {
+                return err_code;
+            }
+#endif
+
             // Stop the DFU Timer because the peer activity need not be monitored any longer.
             err_code = app_timer_stop(m_dfu_timer_id);
             APP_ERROR_CHECK(err_code);
@@ -37,7 +37,11 @@ static uint32_t                m_image_size;                 /**< Size of the im
 static dfu_start_packet_t      m_start_packet;               /**< Start packet received for this update procedure. Contains update mode and image sizes information to be used for image transfer. */
 static uint32_t                m_init_packet[16];            /**< Init packet, can hold CRC, Hash, Signed Hash and similar, for image validation, integrety check and authorization checking. */
 static uint8_t                 m_init_packet_length;         /**< Length of init packet received. */
-static uint16_t                m_image_crc;                  /**< Calculated CRC of the image received. */
+static uint16_t                m_image_crc;                  /**< Calculated CRC of the image received, updated with every data packet. */
+#if DFU_POST_WRITE_VERIFY
+static uint16_t                m_flash_crc;                  /**< CRC of the image content in flash, updated when storing of a data packet completes. */
+static uint32_t                m_data_verified;              /**< Amount of received data for which CRC of the flash content has been calculated. */
+#endif
 static app_timer_id_t          m_dfu_timer_id;               /**< Application timer id. */
 static bool                    m_dfu_timed_out = false;      /**< Boolean flag value for tracking DFU timer timeout state. */
 static pstorage_handle_t       m_storage_handle_app;
@@ -45,6 +49,50 @@ static pstorage_module_param_t m_storage_module_param;
 static dfu_callback_t          m_data_pkt_cb;
 
 
+#if DFU_POST_WRITE_VERIFY
+/**@brief Function for verifying a data packet written to flash.
+ *
+ * @details Called when storing of a data packet has completed. Stores complete in the order in
+ *          which they were requested, so CRC of the flash content is calculated in chunks, in the
+ *          background, while the image is being received.
+ *
+ * @param[in] data_len  Length of the data packet written.
+ */
+static void dfu_written_data_verify(uint32_t data_len)
+{
+    if ((m_data_verified + data_len) <= m_data_received)
+    {
+        m_flash_crc      = crc16_update(m_flash_crc,
+                                        (uint8_t *)(DFU_BANK_0_REGION_START + m_data_verified),
+                                        data_len);
+        m_data_verified += data_len;
+    }
+}
+
+
+/**@brief Function for checking that the image written to flash matches the data received.
+ *
+ * @retval NRF_SUCCESS             Flash content matches the received data.
+ * @retval NRF_ERROR_BUSY          Not all data packets have been written to flash yet.
+ * @retval NRF_ERROR_INVALID_DATA  Flash content does not match the received data.
+ */
+static uint32_t dfu_written_data_check(void)
+{
+    if (m_data_verified != m_image_size)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    if (crc16_final(m_flash_crc) != m_image_crc)
+    {
+        return NRF_ERROR_INVALID_DATA;
+    }
+
+    return NRF_SUCCESS;
+}
+#endif // DFU_POST_WRITE_VERIFY
+
+
 static void pstorage_callback_handler(pstorage_handle_t * handle, 
                                       uint8_t             op_code, 
                                       uint32_t            result, 
@@ -56,6 +104,12 @@ static void pstorage_callback_handler(pstorage_handle_t * handle,
         switch (op_code)
         {
             case PSTORAGE_STORE_OP_CODE:
+#if DFU_POST_WRITE_VERIFY
+                if (result == NRF_SUCCESS)
+                {
+                    dfu_written_data_verify(data_len);
+                }
+#endif
                 if (m_dfu_state == DFU_STATE_RX_DATA_PKT)
                 {
                     m_data_pkt_cb(DATA_PACKET, result, p_data);
@@ -228,6 +282,12 @@ uint32_t dfu_start_pkt_handle(dfu_update_packet_t * p_packet)
                 return err_code;
             }        
             
+            m_image_crc     = crc16_init();
+#if DFU_POST_WRITE_VERIFY
+            m_flash_crc     = crc16_init();
+            m_data_verified = 0;
+#endif
+
             if (IS_UPDATING_APP(m_start_packet))
             {
                 dfu_app_erase(m_image_size);
@@ -291,6 +351,10 @@ uint32_t dfu_data_pkt_handle(dfu_update_packet_t * p_packet)
             {
                 return err_code;
             }
+
+            // Update CRC of the image with the packet, so that no pass over the whole image is
+            // needed during validation.
+            m_image_crc      = crc16_update(m_image_crc, p_data, data_length);
             m_data_received += data_length;        
             
             break;
@@ -365,10 +429,8 @@ uint32_t dfu_image_validate()
                 // Valid peer activity detected. Hence restart the DFU timer.
                 err_code = dfu_timer_restart();
                 
-                // Calculate CRC from DFU_BANK_0_REGION_START to mp_app_write_address.
-                m_image_crc  = crc16_compute((uint8_t*)DFU_BANK_0_REGION_START, 
-                                             m_image_size, 
-                                             NULL);
+                // CRC has been calculated while receiving data packets.
+                m_image_crc  = crc16_final(m_image_crc);
                 received_crc = uint16_decode((uint8_t*)&m_init_packet[0]);
                     
                 if ((m_init_packet_length != 0) && (m_image_crc != received_crc))
@@ -398,8 +460,19 @@ uint32_t dfu_image_activate()
     switch (m_dfu_state)
     {    
         case DFU_STATE_WAIT_4_ACTIVATE:            
+#if DFU_POST_WRITE_VERIFY
+            // Do not activate an image which was not written to flash correctly. The DFU Timer is
+            // left running, so the update still times out if the peer gives up.
+            err_code = dfu_written_data_check();
+            if (err_code != NRF_SUCCESS)
+            {
+                return err_code;
+            }
+#endif
+
             // Stop the DFU Timer because the peer activity need not be monitored any longer.
             err_code = app_timer_stop(m_dfu_timer_id);
+            APP_ERROR_CHECK(err_code);
         
             update_status.status_code = DFU_UPDATE_APP_COMPLETE;
             update_status.app_crc     = m_image_crc;
@@ -33,7 +33,6 @@
 #include "app_timer.h"
 #include "ble_flash.h"
 #include "ble_conn_params.h"
-#include "hci_mem_pool.h"
 #include "bootloader.h"
 
 #define ADVERTISING_LED_PIN_NO               LED_0                                                   /**< Is on when device is advertising. */
@@ -71,6 +70,12 @@
 
 #define IS_CONNECTED()                       (m_conn_handle != BLE_CONN_HANDLE_INVALID)              /**< Macro to determine if the device is in connected state. */
 
+#define DATA_CHUNK_SIZE                      CODE_PAGE_SIZE                                          /**< Size (in bytes) of the chunks firmware data packets are gathered into before being written to flash. Must divide CODE_PAGE_SIZE, so that a chunk never crosses a flash page, and must not exceed the 1024 bytes a single flash write is limited to. */
+#define DATA_CHUNK_QUEUE_DEPTH               2                                                       /**< Number of chunks which can wait for being written to flash at the same time. */
+
+STATIC_ASSERT(((CODE_PAGE_SIZE % DATA_CHUNK_SIZE) == 0) && (DATA_CHUNK_SIZE <= 1024));
+STATIC_ASSERT((DATA_CHUNK_SIZE % sizeof(uint32_t)) == 0);
+
 /**@brief Packet type enumeration.
  */
 typedef enum
@@ -89,7 +94,11 @@ static uint8_t              m_update_mode;
 static uint32_t             m_num_of_firmware_bytes_rcvd;                                            /**< Cumulative number of bytes of firmware data received. */
 static uint16_t             m_pkt_notif_target;                                                      /**< Number of packets of firmware data to be received before transmitting the next Packet Receipt Notification to the DFU Controller. */
 static uint16_t             m_pkt_notif_target_cnt;                                                  /**< Number of packets of firmware data received after sending last Packet Receipt Notification or since the receipt of a @ref BLE_DFU_PKT_RCPT_NOTIF_ENABLED event from the DFU service, which ever occurs later.*/
-static uint8_t              * mp_rx_buffer;                                                          /**< Pointer to a RX buffer.*/
+static uint32_t             m_image_size;                                                            /**< Total size of the image(s) being transferred, as given in the start packet. */
+static uint32_t             m_data_chunk[DATA_CHUNK_QUEUE_DEPTH][DATA_CHUNK_SIZE / sizeof(uint32_t)]; /**< Chunks firmware data packets are gathered into. Used as a ring, chunks are written to flash in order. */
+static uint8_t              m_data_chunk_head;                                                       /**< Index of the oldest chunk waiting for being written to flash. */
+static uint8_t              m_data_chunks_pending;                                                   /**< Number of chunks waiting for being written to flash. */
+static uint32_t             m_data_chunk_len;                                                        /**< Number of bytes gathered in the chunk being filled. */
 static bool                 m_tear_down_in_progress   = false;                                       /**< Variable to indicate whether a tear down is in progress. A tear down could be because the application has initiated it or the peer has disconnected. */
 static bool                 m_pkt_rcpt_notif_enabled  = false;                                       /**< Variable to denote whether packet receipt notification has been enabled by the DFU controller.*/
 static uint16_t             m_conn_handle             = BLE_CONN_HANDLE_INVALID;                     /**< Handle of the current connection. */
@@ -166,8 +175,10 @@ static void dfu_cb_handler(uint32_t packet, uint32_t result, uint8_t * p_data)
             }
             else
             {
-                err_code = hci_mem_pool_rx_consume(p_data);
-                APP_ERROR_CHECK(err_code);
+                // Chunks are written in order, so the oldest one has been written. It can be
+                // filled again.
+                m_data_chunk_head = (m_data_chunk_head + 1) % DATA_CHUNK_QUEUE_DEPTH;
+                m_data_chunks_pending--;
             }
             break;
         
@@ -256,7 +267,16 @@ static void start_data_process(ble_dfu_t * p_dfu, ble_dfu_evt_t * p_evt)
         }
 
         err_code = dfu_start_pkt_handle(&update_packet);
-        if (err_code != NRF_SUCCESS)
+        if (err_code == NRF_SUCCESS)
+        {
+            m_image_size          = start_packet.sd_image_size +
+                                    start_packet.bl_image_size +
+                                    start_packet.app_image_size;
+            m_data_chunk_head     = 0;
+            m_data_chunks_pending = 0;
+            m_data_chunk_len      = 0;
+        }
+        else
         {
             // Translate the err_code returned by the above function to DFU Response Value.
             ble_dfu_resp_val_t resp_val;
@@ -320,6 +340,45 @@ static void init_data_process(ble_dfu_t * p_dfu, ble_dfu_evt_t * p_evt)
 }
 
 
+/**@brief     Function for getting the chunk being filled with firmware data.
+ *
+ * @return    Pointer to the chunk.
+ */
+static uint32_t * data_chunk_fill_get(void)
+{
+    return m_data_chunk[(m_data_chunk_head + m_data_chunks_pending) % DATA_CHUNK_QUEUE_DEPTH];
+}
+
+
+/**@brief     Function for passing the chunk being filled to the DFU module to be written to flash.
+ *
+ * @details   Writing a whole chunk instead of every packet separately reduces the number of flash
+ *            operations, which limit the DFU throughput, so the DFU Controller can use a larger
+ *            packet receipt notification interval. The chunk stays in use until the DFU module
+ *            reports it has been written (see @ref dfu_cb_handler).
+ *
+ * @return    Return value of @ref dfu_data_pkt_handle.
+ */
+static uint32_t data_chunk_write(void)
+{
+    uint32_t            err_code;
+    dfu_update_packet_t dfu_pkt;
+
+    dfu_pkt.packet_type                      = DATA_PACKET;
+    dfu_pkt.params.data_packet.packet_length = m_data_chunk_len / sizeof(uint32_t);
+    dfu_pkt.params.data_packet.p_data_packet = data_chunk_fill_get();
+
+    err_code = dfu_data_pkt_handle(&dfu_pkt);
+    if ((err_code == NRF_SUCCESS) || (err_code == NRF_ERROR_INVALID_LENGTH))
+    {
+        m_data_chunks_pending++;
+        m_data_chunk_len = 0;
+    }
+
+    return err_code;
+}
+
+
 /**@brief     Function for processing application data written by the peer to the DFU Packet
  *            Characteristic.
  *
@@ -340,39 +399,36 @@ static void app_data_process(ble_dfu_t * p_dfu, ble_dfu_evt_t * p_evt)
         return;
     }
 
-    uint32_t length = p_evt->evt.ble_dfu_pkt_write.len;
-    
-    err_code = hci_mem_pool_rx_produce(length, (void**) &mp_rx_buffer);
-    if (err_code != NRF_SUCCESS)
-    {
-        dfu_error_notify(p_dfu, err_code);
-        return;
-    }
-    
     uint8_t * p_data_packet = p_evt->evt.ble_dfu_pkt_write.p_data;
-    memcpy(mp_rx_buffer, p_data_packet, length);
+    uint32_t  length        = p_evt->evt.ble_dfu_pkt_write.len;
+    uint32_t  received      = m_num_of_firmware_bytes_rcvd;
 
-    err_code = hci_mem_pool_rx_data_size_set(length);
-    if (err_code != NRF_SUCCESS)
+    // Gather the packet into the current chunk. A chunk is passed to the DFU module when it is full
+    // or when the last packet of the image has been received.
+    err_code = NRF_ERROR_INVALID_LENGTH;
+    while ((length > 0) && (err_code == NRF_ERROR_INVALID_LENGTH))
     {
-        dfu_error_notify(p_dfu, err_code);
-        return;
-    }
+        if (m_data_chunks_pending == DATA_CHUNK_QUEUE_DEPTH)
+        {
+            // All chunks are waiting for flash write. The peer is sending data too fast.
+            err_code = NRF_ERROR_NO_MEM;
+            break;
+        }
 
-    err_code = hci_mem_pool_rx_extract(&mp_rx_buffer, &length);
-    if (err_code != NRF_SUCCESS)
-    {
-        dfu_error_notify(p_dfu, err_code);
-        return;
-    }
+        uint32_t copy_length = MIN(length, (DATA_CHUNK_SIZE - m_data_chunk_len));
 
-    dfu_update_packet_t dfu_pkt;
+        memcpy((uint8_t *)data_chunk_fill_get() + m_data_chunk_len, p_data_packet, copy_length);
 
-    dfu_pkt.packet_type                      = DATA_PACKET;
-    dfu_pkt.params.data_packet.packet_length = length / sizeof(uint32_t);
-    dfu_pkt.params.data_packet.p_data_packet = (uint32_t*)mp_rx_buffer;
-    
-    err_code = dfu_data_pkt_handle(&dfu_pkt);
+        m_data_chunk_len += copy_length;
+        p_data_packet    += copy_length;
+        length           -= copy_length;
+        received         += copy_length;
+
+        if ((m_data_chunk_len == DATA_CHUNK_SIZE) || (received == m_image_size))
+        {
+            err_code = data_chunk_write();
+        }
+    }
 
     if (err_code == NRF_SUCCESS)
     {
@@ -410,12 +466,6 @@ static void app_data_process(ble_dfu_t * p_dfu, ble_dfu_evt_t * p_evt)
     }
     else
     {
-        uint32_t hci_error = hci_mem_pool_rx_consume(mp_rx_buffer);
-        if (hci_error != NRF_SUCCESS)
-        {
-            dfu_error_notify(p_dfu, hci_error);
-        }
-        
         dfu_error_notify(p_dfu, err_code);
     }
 }
@@ -835,12 +885,6 @@ uint32_t dfu_transport_update_start()
 
     dfu_register_callback(dfu_cb_handler);
     
-    err_code = hci_mem_pool_open();
-    if (err_code != NRF_SUCCESS)
-    {
-        return err_code;
-    }
-    
     gap_params_init();
     services_init();
     advertising_init();
@@ -38,6 +38,23 @@ static uint8_t *                      m_evt_buffer;                     /**< Buf
 static uint16_t                       m_ble_evt_buffer_size;            /**< Size of BLE event buffer. */
 #endif
 
+#if defined(BLE_STACK_SUPPORT_REQD) && (BLE_STACK_EVT_BATCH_SIZE > 1)
+static ble_evt_batch_handler_t        m_ble_evt_batch_handler;          /**< Application event handler for handling batches of BLE events. */
+#endif
+
+#if defined(BLE_STACK_SUPPORT_REQD) && (BLE_STACK_EVT_HANDLERS_MAX > 0)
+/**@brief BLE event registry entry. */
+typedef struct
+{
+    uint16_t                   evt_id;                                  /**< Event id the handler is registered for. */
+    ble_evt_registry_handler_t handler;                                 /**< Handler to be called for the event. */
+    void *                     p_context;                               /**< Context passed to the handler. */
+} ble_evt_registry_entry_t;
+
+static ble_evt_registry_entry_t       m_ble_evt_registry[BLE_STACK_EVT_HANDLERS_MAX];   /**< Registered BLE event handlers, sorted by event id. */
+static uint8_t                        m_ble_evt_registry_count;         /**< Number of registered BLE event handlers. */
+#endif
+
 static volatile bool                  m_softdevice_enabled = false;     /**< Variable to indicate whether the SoftDevice is enabled. */
 
 #ifdef BLE_STACK_SUPPORT_REQD
@@ -67,6 +84,149 @@ void softdevice_assertion_handler(uint32_t pc, uint16_t line_num, const uint8_t
 }
 
 
+#if defined(BLE_STACK_SUPPORT_REQD) && (BLE_STACK_EVT_HANDLERS_MAX > 0)
+/**@brief Function for passing a BLE event to the handlers in the registry with the event's id.
+ *
+ * @param[in] p_ble_evt  BLE event.
+ */
+static void ble_evt_registry_dispatch(ble_evt_t * p_ble_evt)
+{
+    uint16_t evt_id = p_ble_evt->header.evt_id;
+    uint8_t  low    = 0;
+    uint8_t  high   = m_ble_evt_registry_count;
+
+    // Find the first entry for the event id.
+    while (low < high)
+    {
+        uint8_t mid = (uint8_t)((low + high) / 2);
+
+        if (m_ble_evt_registry[mid].evt_id < evt_id)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    for (; (low < m_ble_evt_registry_count) && (m_ble_evt_registry[low].evt_id == evt_id); low++)
+    {
+        m_ble_evt_registry[low].handler(m_ble_evt_registry[low].p_context, p_ble_evt);
+    }
+}
+#endif
+
+
+#ifdef BLE_STACK_SUPPORT_REQD
+/**@brief Function for checking if any BLE event handler is registered.
+ */
+static bool ble_evt_handler_registered(void)
+{
+    bool registered = (m_ble_evt_handler != NULL);
+
+#if (BLE_STACK_EVT_BATCH_SIZE > 1)
+    registered = registered || (m_ble_evt_batch_handler != NULL);
+#endif
+#if (BLE_STACK_EVT_HANDLERS_MAX > 0)
+    registered = registered || (m_ble_evt_registry_count != 0);
+#endif
+
+    return registered;
+}
+
+
+/**@brief Function for passing a BLE event to the application.
+ *
+ * @details The event is passed to the handler registered with softdevice_ble_evt_handler_set(),
+ *          and then to the handlers in the registry with the event's id.
+ *
+ * @param[in] p_ble_evt  BLE event.
+ */
+static void ble_evt_dispatch(ble_evt_t * p_ble_evt)
+{
+    if (m_ble_evt_handler != NULL)
+    {
+        // Call application's BLE stack event handler.
+        m_ble_evt_handler(p_ble_evt);
+    }
+
+#if (BLE_STACK_EVT_HANDLERS_MAX > 0)
+    ble_evt_registry_dispatch(p_ble_evt);
+#endif
+}
+#endif
+
+
+#if defined(BLE_STACK_SUPPORT_REQD) && (BLE_STACK_EVT_BATCH_SIZE > 1)
+/**@brief Function for fetching a batch of BLE events and dispatching it to the application.
+ *
+ * @details Events are pulled into consecutive parts of the event buffer until the batch is full or
+ *          the SoftDevice has no more events, and are then passed on in one pass.
+ *
+ * @return  true if the SoftDevice has no more BLE events, false otherwise.
+ */
+static bool ble_evt_batch_execute(void)
+{
+    ble_evt_t * evts[BLE_STACK_EVT_BATCH_SIZE];
+    uint8_t     evt_count    = 0;
+    bool        no_more_evts = false;
+    uint8_t     i;
+
+    while (evt_count < BLE_STACK_EVT_BATCH_SIZE)
+    {
+        uint8_t * p_evt   = &m_evt_buffer[evt_count * m_ble_evt_buffer_size];
+        uint16_t  evt_len = m_ble_evt_buffer_size;
+        uint32_t  err_code;
+
+        // Pull event from stack
+        err_code = sd_ble_evt_get(p_evt, &evt_len);
+        if (err_code == NRF_ERROR_NOT_FOUND)
+        {
+            no_more_evts = true;
+            break;
+        }
+        else if (err_code != NRF_SUCCESS)
+        {
+            APP_ERROR_HANDLER(err_code);
+            break;
+        }
+
+        evts[evt_count++] = (ble_evt_t *)p_evt;
+    }
+
+    if (evt_count == 0)
+    {
+        return no_more_evts;
+    }
+
+    if (m_ble_evt_batch_handler != NULL)
+    {
+        // Call application's BLE stack event batch handler.
+        m_ble_evt_batch_handler(evts, evt_count);
+
+#if (BLE_STACK_EVT_HANDLERS_MAX > 0)
+        // Modules registered for single events still get them, in the order they were fetched.
+        for (i = 0; i < evt_count; i++)
+        {
+            ble_evt_registry_dispatch(evts[i]);
+        }
+#endif
+    }
+    else
+    {
+        // Pass each event on to the application.
+        for (i = 0; i < evt_count; i++)
+        {
+            ble_evt_dispatch(evts[i]);
+        }
+    }
+
+    return no_more_evts;
+}
+#endif
+
+
 void intern_softdevice_events_execute(void)
 {
     if (!m_softdevice_enabled)
@@ -79,7 +239,7 @@ void intern_softdevice_events_execute(void)
 
     bool no_more_soc_evts = (m_sys_evt_handler == NULL);
 #ifdef BLE_STACK_SUPPORT_REQD
-    bool no_more_ble_evts = (m_ble_evt_handler == NULL);
+    bool no_more_ble_evts = !ble_evt_handler_registered();
 #endif
 #ifdef ANT_STACK_SUPPORT_REQD
     bool no_more_ant_evts = (m_ant_evt_handler == NULL);
@@ -115,6 +275,9 @@ void intern_softdevice_events_execute(void)
         // Fetch BLE Events.
         if (!no_more_ble_evts)
         {
+#if (BLE_STACK_EVT_BATCH_SIZE > 1)
+            no_more_ble_evts = ble_evt_batch_execute();
+#else
             // Pull event from stack
             uint16_t evt_len = m_ble_evt_buffer_size;
 
@@ -129,9 +292,10 @@ void intern_softdevice_events_execute(void)
             }
             else
             {
-                // Call application's BLE stack event handler.
-                m_ble_evt_handler((ble_evt_t *)m_evt_buffer);
+                // Pass the event on to the application.
+                ble_evt_dispatch((ble_evt_t *)m_evt_buffer);
             }
+#endif
         }
 #endif
 
@@ -219,7 +383,13 @@ uint32_t softdevice_handler_init(nrf_clock_lfclksrc_t           clock_source,
 #endif
 
 #if defined (BLE_STACK_SUPPORT_REQD)     
+#if (BLE_STACK_EVT_BATCH_SIZE > 1)
+    // Split the buffer into word aligned buffers, one per event in a batch.
+    m_ble_evt_buffer_size = (evt_buffer_size / BLE_STACK_EVT_BATCH_SIZE) &
+                            ~(uint16_t)(sizeof(uint32_t) - 1);
+#else
     m_ble_evt_buffer_size = evt_buffer_size;
+#endif
 #else
     // The variable evt_buffer_size is not needed if BLE Stack support is NOT required.
     UNUSED_PARAMETER(evt_buffer_size);
@@ -263,6 +433,64 @@ uint32_t softdevice_ble_evt_handler_set(ble_evt_handler_t ble_evt_handler)
 
     return NRF_SUCCESS;
 }
+
+
+uint32_t softdevice_ble_evt_batch_handler_set(ble_evt_batch_handler_t ble_evt_batch_handler)
+{
+#if (BLE_STACK_EVT_BATCH_SIZE > 1)
+    if (ble_evt_batch_handler == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    m_ble_evt_batch_handler = ble_evt_batch_handler;
+
+    return NRF_SUCCESS;
+#else
+    // Every batch would hold a single event, so batches are not supported.
+    UNUSED_PARAMETER(ble_evt_batch_handler);
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+
+uint32_t softdevice_ble_evt_handler_register(uint16_t                   evt_id,
+                                             ble_evt_registry_handler_t handler,
+                                             void *                     p_context)
+{
+#if (BLE_STACK_EVT_HANDLERS_MAX > 0)
+    uint8_t i;
+
+    if (handler == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    if (m_ble_evt_registry_count >= BLE_STACK_EVT_HANDLERS_MAX)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    // Insert after all entries with the same or a lower event id, to keep the table sorted and
+    // handlers for the same event in registration order.
+    for (i = m_ble_evt_registry_count; (i > 0) && (m_ble_evt_registry[i - 1].evt_id > evt_id); i--)
+    {
+        m_ble_evt_registry[i] = m_ble_evt_registry[i - 1];
+    }
+
+    m_ble_evt_registry[i].evt_id    = evt_id;
+    m_ble_evt_registry[i].handler   = handler;
+    m_ble_evt_registry[i].p_context = p_context;
+    m_ble_evt_registry_count++;
+
+    return NRF_SUCCESS;
+#else
+    UNUSED_PARAMETER(evt_id);
+    UNUSED_PARAMETER(handler);
+    UNUSED_PARAMETER(p_context);
+    return NRF_ERROR_NO_MEM;
+#endif
+}
 #endif
 
 
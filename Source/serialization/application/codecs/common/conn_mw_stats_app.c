@@ -0,0 +1,70 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include <stdint.h>
+#include "app_error.h"
+#include "conn_mw_stats_app.h"
+#include "ble_serialization.h"
+#include "nrf_error.h"
+#include "ser_sd_transport.h"
+
+/**@brief Output parameter of @ref ser_conn_mw_stats_get. */
+static ser_conn_mw_stats_t * mp_stats;
+
+
+/**@brief Command response callback function for @ref ser_conn_mw_stats_get command.
+ *
+ * @param[in] p_buffer  Pointer to begin of command response buffer.
+ * @param[in] length    Length of data in bytes.
+ *
+ * @return Decoded command response return code.
+ */
+static uint32_t conn_mw_stats_get_rsp_handler(const uint8_t * p_buffer, uint16_t length)
+{
+    uint32_t result_code;
+
+    const uint32_t err_code = conn_mw_stats_get_rsp_dec(p_buffer, length, mp_stats, &result_code);
+    APP_ERROR_CHECK(err_code);
+
+    return result_code;
+}
+
+
+uint32_t ser_conn_mw_stats_get(uint8_t opcode, ser_conn_mw_stats_t * const p_stats)
+{
+    uint8_t * p_buffer;
+    uint32_t  buffer_length = 0;
+    uint32_t  err_code;
+
+    if (p_stats == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    do
+    {
+        err_code = ser_sd_transport_tx_alloc(&p_buffer, (uint16_t *)&buffer_length);
+    }
+    while (err_code != NRF_SUCCESS);
+
+    p_buffer[SER_PKT_TYPE_POS] = SER_PKT_TYPE_CMD;
+    buffer_length             -= SER_PKT_TYPE_SIZE;
+    mp_stats                   = p_stats;
+
+    err_code = conn_mw_stats_get_req_enc(opcode, &p_buffer[SER_PKT_OP_CODE_POS], &buffer_length);
+    APP_ERROR_CHECK(err_code);
+
+    //@note: Increment buffer length as internally managed packet type field must be included.
+    return ser_sd_transport_cmd_write(p_buffer,
+                                      buffer_length + SER_PKT_TYPE_SIZE,
+                                      conn_mw_stats_get_rsp_handler);
+}
@@ -0,0 +1,72 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include "conn_mw_stats_app.h"
+#include "ble_serialization.h"
+#include "nrf_error.h"
+
+uint32_t conn_mw_stats_get_req_enc(uint8_t          opcode,
+                                   uint8_t * const  p_buf,
+                                   uint32_t * const p_buf_len)
+{
+    SER_ASSERT_NOT_NULL(p_buf);
+    SER_ASSERT_NOT_NULL(p_buf_len);
+
+    uint32_t index = 0;
+
+    SER_ASSERT_LENGTH_LEQ(SER_OP_CODE_SIZE + 1, *p_buf_len);
+
+    p_buf[index++] = SER_CONN_MW_STATS_GET_OP_CODE;
+    p_buf[index++] = opcode;
+
+    *p_buf_len = index;
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t conn_mw_stats_get_rsp_dec(uint8_t const * const       p_buf,
+                                   uint32_t                    packet_len,
+                                   ser_conn_mw_stats_t * const p_stats,
+                                   uint32_t * const            p_result_code)
+{
+    SER_ASSERT_NOT_NULL(p_buf);
+    SER_ASSERT_NOT_NULL(p_stats);
+    SER_ASSERT_NOT_NULL(p_result_code);
+
+    uint32_t index         = 0;
+    uint32_t decode_result = ser_ble_cmd_rsp_result_code_dec(p_buf, &index, packet_len,
+                                                             SER_CONN_MW_STATS_GET_OP_CODE,
+                                                             p_result_code);
+
+    if (decode_result != NRF_SUCCESS)
+    {
+        return decode_result;
+    }
+
+    if (*p_result_code != NRF_SUCCESS)
+    {
+        SER_ASSERT_LENGTH_EQ(index, packet_len);
+
+        return NRF_SUCCESS;
+    }
+
+    decode_result = uint32_t_dec(p_buf, packet_len, &index, &p_stats->call_count);
+    SER_ASSERT(decode_result == NRF_SUCCESS, decode_result);
+
+    decode_result = uint32_t_dec(p_buf, packet_len, &index, &p_stats->ticks);
+    SER_ASSERT(decode_result == NRF_SUCCESS, decode_result);
+
+    SER_ASSERT_LENGTH_EQ(index, packet_len);
+
+    return NRF_SUCCESS;
+}
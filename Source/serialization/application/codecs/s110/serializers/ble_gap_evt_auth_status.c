@@ -61,11 +61,11 @@ uint32_t ble_gap_evt_auth_status_dec(uint8_t const * const p_buf,
     p_decoded_evt->periph_kex.ltk       = (p_buf[index] >> 0) & 0x01;
     index++;
 
-    p_decoded_evt->central_kex.ltk       = (p_buf[index] >> 4) & 0x01;
-    p_decoded_evt->central_kex.ediv_rand = (p_buf[index] >> 3) & 0x01;
+    p_decoded_evt->central_kex.csrk      = (p_buf[index] >> 4) & 0x01;
+    p_decoded_evt->central_kex.address   = (p_buf[index] >> 3) & 0x01;
     p_decoded_evt->central_kex.irk       = (p_buf[index] >> 2) & 0x01;
-    p_decoded_evt->central_kex.address   = (p_buf[index] >> 1) & 0x01;
-    p_decoded_evt->central_kex.csrk      = (p_buf[index] >> 0) & 0x01;
+    p_decoded_evt->central_kex.ediv_rand = (p_buf[index] >> 1) & 0x01;
+    p_decoded_evt->central_kex.ltk       = (p_buf[index] >> 0) & 0x01;
     index++;
 
     uint16_dec(p_buf, packet_len, &index, &p_decoded_evt->periph_keys.enc_info.div);
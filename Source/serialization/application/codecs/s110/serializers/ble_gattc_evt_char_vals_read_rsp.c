@@ -32,7 +32,7 @@ uint32_t ble_gattc_evt_char_vals_read_rsp_dec(uint8_t const * const p_buf,
     SER_ASSERT_NOT_NULL(p_buf);
     SER_ASSERT_NOT_NULL(p_event_len);
 
-    SER_ASSERT_LENGTH_LEQ(10, packet_len);
+    SER_ASSERT_LENGTH_LEQ(8, packet_len);
 
     event_len = (uint16_t) (offsetof(ble_evt_t, evt.gattc_evt.params.char_vals_read_rsp.values)) -
                 sizeof (ble_evt_hdr_t) +
@@ -13,6 +13,7 @@
 #include "ble_gattc_evt_app.h"
 #include <string.h>
 #include "ble_serialization.h"
+#include "ble_gattc_struct_serialization.h"
 #include "app_util.h"
 
 
@@ -22,6 +23,8 @@ uint32_t ble_gattc_evt_hvx_dec(uint8_t const * const p_buf,
                                uint32_t * const      p_event_len)
 {
     uint32_t index = 0;
+    uint32_t struct_len;
+    uint32_t err_code;
     uint16_t tmp_attr_len;
 
     SER_ASSERT_NOT_NULL(p_buf);
@@ -44,20 +47,11 @@ uint32_t ble_gattc_evt_hvx_dec(uint8_t const * const p_buf,
 
     p_event->header.evt_id  = BLE_GATTC_EVT_HVX;
     p_event->header.evt_len = event_len;
-    uint16_dec(p_buf, packet_len, &index, &(p_event->evt.gattc_evt.conn_handle));
-    uint16_dec(p_buf, packet_len, &index, &(p_event->evt.gattc_evt.gatt_status));
-    uint16_dec(p_buf, packet_len, &index, &(p_event->evt.gattc_evt.error_handle));
-    uint16_dec(p_buf, packet_len, &index, &(p_event->evt.gattc_evt.params.hvx.handle));
-    uint8_dec(p_buf, packet_len, &index, &(p_event->evt.gattc_evt.params.hvx.type));
-    uint16_dec(p_buf, packet_len, &index, &(p_event->evt.gattc_evt.params.hvx.len));
 
-    SER_ASSERT_LENGTH_LEQ(index + tmp_attr_len, packet_len);
-
-    if (tmp_attr_len > 0)
-    {
-        memcpy(&(p_event->evt.gattc_evt.params.hvx.data[0]), &(p_buf[index]), tmp_attr_len);
-        index += tmp_attr_len;
-    }
+    struct_len = *p_event_len - offsetof(ble_evt_t, evt.gattc_evt);
+    err_code   = ser_struct_dec(&ble_gattc_evt_hvx_desc, p_buf, packet_len, &index, &struct_len,
+                                &(p_event->evt.gattc_evt));
+    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
 
     SER_ASSERT_LENGTH_EQ(index, packet_len);
     *p_event_len = event_len;
@@ -60,6 +60,7 @@ uint32_t ble_gattc_evt_rel_disc_rsp_dec(uint8_t const * const p_buf,
     SER_ASSERT(error_code == NRF_SUCCESS, error_code);
 
     SER_ASSERT_LENGTH_EQ(index, packet_len);
+    *p_event_len = event_len;
 
     return error_code;
 }
@@ -21,7 +21,6 @@ uint32_t ble_l2cap_evt_rx_dec(uint8_t const * const p_buf,
                               uint32_t * const      p_event_len)
 {
     SER_ASSERT_NOT_NULL(p_buf);
-    SER_ASSERT_NOT_NULL(p_event);
     SER_ASSERT_NOT_NULL(p_event_len);
 
     uint32_t index        = 0;
@@ -29,17 +28,16 @@ uint32_t ble_l2cap_evt_rx_dec(uint8_t const * const p_buf,
 
     *p_event_len = offsetof(ble_l2cap_evt_t, params);
 
-    uint16_t evt_id;
+    uint16_t conn_handle;
 
-    uint32_t err_code = uint16_t_dec(p_buf, packet_len, &index, &evt_id);
+    uint32_t err_code = uint16_t_dec(p_buf, packet_len, &index, &conn_handle);
     SER_ASSERT(err_code == NRF_SUCCESS, err_code);
 
     void * p_rx = NULL;
 
     if (p_event)
     {
-        err_code = uint16_t_dec(p_buf, packet_len, &index, &(p_event->evt.l2cap_evt.conn_handle));
-        SER_ASSERT(err_code == NRF_SUCCESS, err_code);
+        p_event->evt.l2cap_evt.conn_handle = conn_handle;
 
         p_rx = &(p_event->evt.l2cap_evt.params.rx);
     }
@@ -17,10 +17,33 @@
 #include "ser_hal_transport.h"
 #include "nrf_error.h"
 #include "app_error.h"
+#include "app_util.h"
 #include "ble_serialization.h"
+#include "ser_config.h"
 
 #include "ser_app_power_system_off.h"
 
+STATIC_ASSERT(IS_POWER_OF_TWO(SER_SD_TRANSPORT_MAX_PENDING_CMDS));
+
+/** Mask used to get pending commands table index from command sequence number. */
+#define PENDING_CMDS_MASK (SER_SD_TRANSPORT_MAX_PENDING_CMDS - 1)
+
+/** Max number of commands in a batch packet. Responses to all of them must fit in one batch
+ *  response packet, otherwise the connectivity chip would not execute the last ones. */
+#define BATCH_CMDS_MAX    MIN(SER_SD_TRANSPORT_MAX_BATCH_CMDS,                                \
+                              (SER_HAL_TRANSPORT_RX_MAX_PKT_SIZE - SER_PKT_TYPE_SIZE) /       \
+                              (SER_BATCH_ITEM_LEN_SIZE + SER_BATCH_RSP_MAX_SIZE))
+
+STATIC_ASSERT(BATCH_CMDS_MAX > 0);
+
+/** Structure describing a command which waits for its response. */
+typedef struct
+{
+    ser_sd_transport_rsp_handler_t rsp_dec_handler; /**< User decoder handler for expected response packet. */
+    bool                           pipelined;       /**< Command was sent in pipelined mode. */
+    uint8_t                        seq;             /**< Sequence number of the command. */
+} pending_cmd_t;
+
 /** SoftDevice event handler. */
 static ser_sd_transport_evt_handler_t m_evt_handler = NULL;
 
@@ -36,15 +59,132 @@ static ser_sd_transport_rsp_set_handler_t m_os_rsp_set_handler = NULL;
 /** Handler called when hal_transport notifies that packet reception has started. */
 static ser_sd_transport_rx_notification_handler_t m_rx_notify_handler = NULL;
 
-/** User decoder handler for expected response packet. */
-static ser_sd_transport_rsp_handler_t m_rsp_dec_handler = NULL;
+/** Handler called when response to a command sent in pipelined mode is processed. */
+static ser_sd_transport_cmd_cmpl_handler_t m_cmd_cmpl_handler = NULL;
+
+/** Commands waiting for response, stored in order in which they were sent. */
+static pending_cmd_t m_pending_cmds[SER_SD_TRANSPORT_MAX_PENDING_CMDS];
+
+/** Sequence number of the oldest command waiting for response. Modified only in serial peripheral
+ *  interrupt context. */
+static volatile uint32_t m_pending_head = 0;
+
+/** Index of the next pending commands table slot. Modified only in task context. */
+static volatile uint32_t m_pending_tail = 0;
+
+/** Sequence number to be given to the next command, see @ref ser_sd_transport_next_seq_get.
+ *  Modified only in task context. */
+static uint8_t m_cmd_seq = 0;
+
+/** Flag indicated whether module works in pipelined mode. */
+static bool m_pipeline_active = false;
+
+/** First failure returned by SoftDevice for commands sent in the current pipelined burst. */
+static volatile uint32_t m_pipeline_err_code = NRF_SUCCESS;
+
+/** Flag indicated whether module works in batch mode. */
+static bool m_batch_active = false;
+
+/** TX buffer collecting commands of the current batch. NULL if not allocated yet. */
+static uint8_t * mp_batch_buf = NULL;
+
+/** Size of the batch TX buffer. */
+static uint16_t m_batch_buf_size;
+
+/** Number of bytes used in the batch TX buffer (including packet type field). */
+static uint16_t m_batch_len;
+
+/** Number of commands in the batch TX buffer. */
+static uint8_t m_batch_cmd_count;
+
+/** Sequence number of the first command in the batch TX buffer. */
+static uint8_t m_batch_seq;
+
+/** User decoder handlers for responses to commands in the batch TX buffer. */
+static ser_sd_transport_rsp_handler_t m_batch_rsp_handlers[BATCH_CMDS_MAX];
 
-/** Flag indicated whether module is waiting for response packet. */
-static volatile bool m_rsp_wait = false;
+/** First failure returned by SoftDevice for commands sent in the current batch. */
+static uint32_t m_batch_err_code = NRF_SUCCESS;
 
 /** SoftDevice call return value decoded by user decoder handler. */
 static uint32_t m_return_value;
 
+static uint32_t cmd_send(const uint8_t *                p_buffer,
+                         uint16_t                       length,
+                         ser_sd_transport_rsp_handler_t cmd_rsp_decode_callback);
+
+/**@brief Function for decoding a batch response packet.
+ *
+ * @details Responses are passed to user decoder handlers of commands from the batch in order.
+ *          Commands for which no response was included have not been executed by the connectivity
+ *          chip and are reported with NRF_ERROR_DATA_SIZE.
+ *
+ * @param[in]   p_buffer   Pointer to the batch response (without packet type field).
+ * @param[in]   length     Length of the batch response.
+ *
+ * @return First error code returned by SoftDevice for commands from the batch.
+ */
+static uint32_t batch_rsp_dec(const uint8_t * p_buffer, uint16_t length)
+{
+    uint32_t index = 0;
+    uint32_t i;
+
+    for (i = 0; i < m_batch_cmd_count; i++)
+    {
+        uint32_t result = NRF_ERROR_DATA_SIZE;
+
+        if (index + SER_BATCH_ITEM_LEN_SIZE <= length)
+        {
+            const uint16_t rsp_len = uint16_decode(&p_buffer[index]);
+            index += SER_BATCH_ITEM_LEN_SIZE;
+
+            if (index + rsp_len <= length)
+            {
+                result = m_batch_rsp_handlers[i] ?
+                         m_batch_rsp_handlers[i](&p_buffer[index], rsp_len) : NRF_SUCCESS;
+                index += rsp_len;
+            }
+            else
+            {
+                index = length;
+            }
+        }
+
+        if (m_batch_err_code == NRF_SUCCESS)
+        {
+            m_batch_err_code = result;
+        }
+
+        if (m_cmd_cmpl_handler)
+        {
+            m_cmd_cmpl_handler((uint8_t)(m_batch_seq + i), result);
+        }
+    }
+
+    return m_batch_err_code;
+}
+
+/**@brief Function for sending the batch TX buffer and waiting for the batch response.
+ *
+ * @retval NRF_SUCCESS   Operation success.
+ * @return First error code returned by SoftDevice for commands from the batch.
+ */
+static uint32_t batch_flush(void)
+{
+    uint32_t err_code = NRF_SUCCESS;
+
+    if (m_batch_cmd_count != 0)
+    {
+        err_code = cmd_send(mp_batch_buf, m_batch_len, batch_rsp_dec);
+
+        /* TX buffer is freed by HAL Transport layer after transmission. */
+        mp_batch_buf       = NULL;
+        m_batch_cmd_count  = 0;
+    }
+
+    return err_code;
+}
+
 /**@brief Function for handling the rx packets comming from hal_transport.
  *
  * @details
@@ -67,14 +207,36 @@ static void ser_sd_transport_rx_packet_handler(uint8_t * p_data, uint16_t length
         {
             case SER_PKT_TYPE_RESP:
             case SER_PKT_TYPE_DTM_RESP:
+            case SER_PKT_TYPE_BATCH:
 
-                if (m_rsp_wait)
+                if (m_pending_head != m_pending_tail)
                 {
-                    m_return_value = m_rsp_dec_handler(p_data, length);
+                    /* Connectivity chip processes commands one by one, so responses arrive in the
+                     * order in which commands were sent - the oldest pending command is the owner. */
+                    const uint32_t        seq    = m_pending_head;
+                    pending_cmd_t * const p_cmd  = &m_pending_cmds[seq & PENDING_CMDS_MASK];
+                    const uint32_t        result = p_cmd->rsp_dec_handler(p_data, length);
                     (void)ser_sd_transport_rx_free(p_data);
 
-                    /* Reset response flag - cmd_write function is pending on it.*/
-                    m_rsp_wait = false;
+                    if (p_cmd->pipelined)
+                    {
+                        if (m_pipeline_err_code == NRF_SUCCESS)
+                        {
+                            m_pipeline_err_code = result;
+                        }
+
+                        if (m_cmd_cmpl_handler)
+                        {
+                            m_cmd_cmpl_handler(p_cmd->seq, result);
+                        }
+                    }
+                    else
+                    {
+                        m_return_value = result;
+                    }
+
+                    /* Release the slot - cmd_write and pipeline_end functions are pending on it.*/
+                    m_pending_head = seq + 1;
 
                     /* If os handler is set, signal os that response has arrived.*/
                     if (m_os_rsp_set_handler)
@@ -137,6 +299,11 @@ uint32_t ser_sd_transport_open(ser_sd_transport_evt_handler_t             evt_ha
     m_rx_notify_handler   = rx_notify_handler;
     m_ot_rsp_wait_handler = NULL;
     m_evt_handler         = evt_handler;
+    m_cmd_cmpl_handler    = NULL;
+    m_pipeline_active     = false;
+    m_batch_active        = false;
+    mp_batch_buf          = NULL;
+    m_pending_head        = m_pending_tail;
 
     if (evt_handler == NULL)
     {
@@ -152,9 +319,16 @@ uint32_t ser_sd_transport_close(void)
     m_os_rsp_wait_handler = NULL;
     m_os_rsp_set_handler  = NULL;
     m_ot_rsp_wait_handler = NULL;
+    m_cmd_cmpl_handler    = NULL;
+    m_pipeline_active     = false;
+    m_batch_active        = false;
+    mp_batch_buf          = NULL;
 
     ser_hal_transport_close();
 
+    /* Responses will not arrive any more. */
+    m_pending_head = m_pending_tail;
+
     return NRF_SUCCESS;
 }
 
@@ -167,14 +341,136 @@ uint32_t ser_sd_transport_ot_rsp_wait_handler_set(ser_sd_transport_rsp_wait_hand
 
 bool ser_sd_transport_is_busy(void)
 {
-    return m_rsp_wait;
+    return (m_pending_head != m_pending_tail);
+}
+
+uint32_t ser_sd_transport_pipeline_begin(ser_sd_transport_cmd_cmpl_handler_t cmd_cmpl_handler)
+{
+    if (m_pipeline_active || m_batch_active || ser_sd_transport_is_busy())
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    m_cmd_cmpl_handler  = cmd_cmpl_handler;
+    m_pipeline_err_code = NRF_SUCCESS;
+    m_pipeline_active   = true;
+
+    return NRF_SUCCESS;
+}
+
+uint32_t ser_sd_transport_pipeline_end(void)
+{
+    uint32_t err_code;
+
+    if (!m_pipeline_active)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    /* Wait until responses to all commands from the burst are processed. */
+    while (ser_sd_transport_is_busy())
+    {
+        m_os_rsp_wait_handler();
+    }
+
+    err_code            = m_pipeline_err_code;
+    m_pipeline_active   = false;
+    m_cmd_cmpl_handler  = NULL;
+    m_pipeline_err_code = NRF_SUCCESS;
+
+    return err_code;
+}
+
+uint8_t ser_sd_transport_next_seq_get(void)
+{
+    return m_cmd_seq;
+}
+
+uint32_t ser_sd_transport_batch_begin(ser_sd_transport_cmd_cmpl_handler_t cmd_cmpl_handler)
+{
+    if (m_pipeline_active || m_batch_active || ser_sd_transport_is_busy())
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    m_cmd_cmpl_handler = cmd_cmpl_handler;
+    m_batch_err_code   = NRF_SUCCESS;
+    m_batch_cmd_count  = 0;
+    mp_batch_buf       = NULL;
+    m_batch_active     = true;
+
+    return NRF_SUCCESS;
+}
+
+uint32_t ser_sd_transport_batch_end(void)
+{
+    uint32_t err_code;
+
+    if (!m_batch_active)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    if (m_batch_cmd_count != 0)
+    {
+        (void)batch_flush();
+    }
+    else if (mp_batch_buf != NULL)
+    {
+        (void)ser_hal_transport_tx_pkt_free(mp_batch_buf);
+        mp_batch_buf = NULL;
+    }
+
+    err_code           = m_batch_err_code;
+    m_batch_active     = false;
+    m_cmd_cmpl_handler = NULL;
+    m_batch_err_code   = NRF_SUCCESS;
+
+    return err_code;
 }
 
 uint32_t ser_sd_transport_tx_alloc(uint8_t * * pp_data, uint16_t * p_len)
 {
     uint32_t err_code;
+    uint32_t pending = m_pending_tail - m_pending_head;
 
-    if (m_rsp_wait)
+    if (m_batch_active)
+    {
+        err_code = NRF_SUCCESS;
+
+        /* Send the batch collected so far if the next command might not fit in it. */
+        if ((m_batch_cmd_count == BATCH_CMDS_MAX) ||
+            ((mp_batch_buf != NULL) &&
+             (m_batch_buf_size - m_batch_len < SER_SD_TRANSPORT_BATCH_FLUSH_THRESHOLD)))
+        {
+            (void)batch_flush();
+        }
+
+        if (mp_batch_buf == NULL)
+        {
+            err_code = ser_hal_transport_tx_pkt_alloc(&mp_batch_buf, &m_batch_buf_size);
+
+            if (err_code == NRF_SUCCESS)
+            {
+                mp_batch_buf[SER_PKT_TYPE_POS] = SER_PKT_TYPE_BATCH;
+                m_batch_len                    = SER_PKT_TYPE_SIZE;
+            }
+            else
+            {
+                mp_batch_buf = NULL;
+            }
+        }
+
+        if (err_code == NRF_SUCCESS)
+        {
+            /* Command is placed right after its length field. Packet type field written by the
+             * caller overlaps the length field and is replaced in ser_sd_transport_cmd_write. */
+            *pp_data = &mp_batch_buf[m_batch_len + SER_BATCH_ITEM_LEN_SIZE - SER_PKT_TYPE_SIZE];
+            *p_len   = m_batch_buf_size - m_batch_len - SER_BATCH_ITEM_LEN_SIZE + SER_PKT_TYPE_SIZE;
+        }
+    }
+    else if ((m_pipeline_active && (pending >= SER_SD_TRANSPORT_MAX_PENDING_CMDS)) ||
+        (!m_pipeline_active && (pending != 0)))
     {
         err_code = NRF_ERROR_BUSY;
     }
@@ -187,6 +483,13 @@ uint32_t ser_sd_transport_tx_alloc(uint8_t * * pp_data, uint16_t * p_len)
 
 uint32_t ser_sd_transport_tx_free(uint8_t * p_data)
 {
+    /* In batch mode the buffer is shared by all commands of the batch and is released when the
+     * batch is sent. */
+    if (m_batch_active)
+    {
+        return NRF_SUCCESS;
+    }
+
     return ser_hal_transport_tx_pkt_free(p_data);
 }
 
@@ -202,13 +505,76 @@ uint32_t ser_sd_transport_cmd_write(const uint8_t *                p_buffer,
 {
     uint32_t err_code = NRF_SUCCESS;
 
-    m_rsp_wait        = true;
-    m_rsp_dec_handler = cmd_rsp_decode_callback;
-    err_code          = ser_hal_transport_tx_pkt_send(p_buffer, length);
+    if (m_batch_active)
+    {
+        uint8_t * p_item = mp_batch_buf + m_batch_len;
+
+        /* Command has to be encoded to the buffer given by ser_sd_transport_tx_alloc. */
+        if ((mp_batch_buf == NULL) ||
+            (p_buffer != p_item + SER_BATCH_ITEM_LEN_SIZE - SER_PKT_TYPE_SIZE))
+        {
+            err_code = NRF_ERROR_INVALID_ADDR;
+        }
+        else
+        {
+            /* Replace packet type field written by the caller with command length. */
+            (void)uint16_encode(length - SER_PKT_TYPE_SIZE, p_item);
+
+            if (m_batch_cmd_count == 0)
+            {
+                m_batch_seq = m_cmd_seq;
+            }
+            m_cmd_seq++;
+
+            m_batch_rsp_handlers[m_batch_cmd_count++] = cmd_rsp_decode_callback;
+            m_batch_len += SER_BATCH_ITEM_LEN_SIZE + length - SER_PKT_TYPE_SIZE;
+        }
+    }
+    else
+    {
+        err_code = cmd_send(p_buffer, length, cmd_rsp_decode_callback);
+    }
+
+    return err_code;
+}
+
+/**@brief Function for sending a command packet and waiting for its response unless module works in
+ *        pipelined mode.
+ *
+ * @param[in] p_buffer                 Pointer to command packet.
+ * @param[in] length                   Length of command packet.
+ * @param[in] cmd_rsp_decode_callback  Pointer to function for decoding response packet.
+ *
+ * @return SoftDevice call return value decoded from the response or error code from HAL Transport.
+ */
+static uint32_t cmd_send(const uint8_t *                p_buffer,
+                         uint16_t                       length,
+                         ser_sd_transport_rsp_handler_t cmd_rsp_decode_callback)
+{
+    uint32_t       err_code = NRF_SUCCESS;
+    const uint32_t seq      = m_pending_tail;
+
+    if (cmd_rsp_decode_callback)
+    {
+        /* Command has to be registered before sending as response may arrive immediately. */
+        m_pending_cmds[seq & PENDING_CMDS_MASK].rsp_dec_handler = cmd_rsp_decode_callback;
+        m_pending_cmds[seq & PENDING_CMDS_MASK].pipelined       = m_pipeline_active;
+        m_pending_cmds[seq & PENDING_CMDS_MASK].seq             = m_cmd_seq;
+        m_pending_tail                                          = seq + 1;
+
+        /* A batch packet does not take a sequence number, commands in it already have them. */
+        if (!m_batch_active)
+        {
+            m_cmd_seq++;
+        }
+    }
+
+    err_code = ser_hal_transport_tx_pkt_send(p_buffer, length);
     APP_ERROR_CHECK(err_code);
 
-    /* Execute callback for response decoding only if one was provided.*/
-    if ((err_code == NRF_SUCCESS) && cmd_rsp_decode_callback)
+    /* Execute callback for response decoding only if one was provided. In pipelined mode the
+     * response is reported through completion handler instead of waiting for it here. */
+    if ((err_code == NRF_SUCCESS) && cmd_rsp_decode_callback && !m_pipeline_active)
     {
         if (m_ot_rsp_wait_handler)
         {
@@ -219,9 +585,14 @@ uint32_t ser_sd_transport_cmd_write(const uint8_t *                p_buffer,
         m_os_rsp_wait_handler();
         err_code = m_return_value;
     }
-    else
+    else if ((err_code != NRF_SUCCESS) && cmd_rsp_decode_callback)
     {
-        m_rsp_wait = false;
+        m_pending_tail = seq;
+
+        if (!m_batch_active)
+        {
+            m_cmd_seq--;
+        }
     }
     return err_code;
 }
@@ -20,6 +20,32 @@
 #include "ser_config.h"
 #include "nrf_soc.h"
 
+#if SER_SD_EVT_ZERO_COPY
+STATIC_ASSERT(SER_HAL_TRANSPORT_RX_PKT_COUNT > 1);
+
+#define SD_BLE_EVT_PINNED_MAX         (SER_HAL_TRANSPORT_RX_PKT_COUNT - 1) /**< Max number of queued events holding an RX buffer. One buffer is always left for a command response. */
+#define SD_BLE_EVT_COPY_QUEUE_SIZE    4                                    /**< Number of decoded event copies used when no RX buffer can be held. */
+#define SD_BLE_EVT_MAILBOX_QUEUE_SIZE (SD_BLE_EVT_PINNED_MAX + SD_BLE_EVT_COPY_QUEUE_SIZE) /**< Size of mailbox queue. */
+
+/** @brief Structure used to pass packet details through mailbox.
+ */
+typedef struct
+{
+    uint8_t * p_data;    /**< Pointer to received event packet, or to decoded event copy. RX buffer is freed after decoding. */
+    uint16_t  length;    /**< Length of received event packet. */
+    bool      is_copied; /**< True if p_data points to a decoded event copy. */
+} ser_sd_handler_evt_data_t;
+
+/** @brief Decoded events copied out of RX buffers. Used as a ring - copies are taken in interrupt
+ *         context and released by sd_ble_evt_get in the same order as they were taken.
+ */
+static uint32_t m_evt_copy[SD_BLE_EVT_COPY_QUEUE_SIZE][CEIL_DIV(BLE_STACK_EVT_MSG_BUF_SIZE, sizeof (uint32_t))];
+
+static volatile uint32_t m_evt_copy_taken_cnt    = 0; /**< Number of taken copies. Modified only by the event handler. */
+static volatile uint32_t m_evt_copy_released_cnt = 0; /**< Number of released copies. Modified only by sd_ble_evt_get. */
+static volatile uint32_t m_evt_pinned_cnt        = 0; /**< Number of held RX buffers. Modified only by the event handler. */
+static volatile uint32_t m_evt_unpinned_cnt      = 0; /**< Number of freed RX buffers. Modified only by sd_ble_evt_get. */
+#else
 #define SD_BLE_EVT_MAILBOX_QUEUE_SIZE 5 /**< Size of mailbox queue. */
 
 /** @brief Structure used to pass packet details through mailbox.
@@ -28,6 +54,7 @@ typedef struct
 {
     uint32_t evt_data[CEIL_DIV(BLE_STACK_EVT_MSG_BUF_SIZE, sizeof (uint32_t))]; /**< Buffer for decoded event */
 } ser_sd_handler_evt_data_t;
+#endif
 
 /** @brief
  *   Mailbox used for communication between event handler (called from serial stream
@@ -59,13 +86,47 @@ static void ser_softdevice_evt_handler(uint8_t * p_data, uint16_t length)
 {
     ser_sd_handler_evt_data_t item;
     uint32_t                  err_code;
-    uint32_t                  len32 = sizeof (item.evt_data);
+
+#if SER_SD_EVT_ZERO_COPY
+    if ((m_evt_pinned_cnt - m_evt_unpinned_cnt) < SD_BLE_EVT_PINNED_MAX)
+    {
+        /* RX buffer stays allocated until the event is pulled by sd_ble_evt_get. */
+        item.p_data    = p_data;
+        item.length    = length;
+        item.is_copied = false;
+        m_evt_pinned_cnt++;
+    }
+    else
+    {
+        /* The last RX buffer is reserved for a response to a command which may be waiting for it,
+         * so decode the event to a copy and free the RX buffer immediately. */
+        uint32_t len32 = sizeof (m_evt_copy[0]);
+
+        err_code = ((m_evt_copy_taken_cnt - m_evt_copy_released_cnt) < SD_BLE_EVT_COPY_QUEUE_SIZE) ?
+                   NRF_SUCCESS : NRF_ERROR_NO_MEM;
+        APP_ERROR_CHECK(err_code);
+
+        item.p_data    = (uint8_t *)m_evt_copy[m_evt_copy_taken_cnt % SD_BLE_EVT_COPY_QUEUE_SIZE];
+        item.length    = 0;
+        item.is_copied = true;
+
+        err_code = ble_event_dec(p_data, length, (ble_evt_t *)item.p_data, &len32);
+        APP_ERROR_CHECK(err_code);
+
+        err_code = ser_sd_transport_rx_free(p_data);
+        APP_ERROR_CHECK(err_code);
+
+        m_evt_copy_taken_cnt++;
+    }
+#else
+    uint32_t len32 = sizeof (item.evt_data);
 
     err_code = ble_event_dec(p_data, length, (ble_evt_t *)item.evt_data, &len32);
     APP_ERROR_CHECK(err_code);
 
     err_code = ser_sd_transport_rx_free(p_data);
     APP_ERROR_CHECK(err_code);
+#endif
 
     err_code = app_mailbox_put(m_ble_evt_mailbox_id, &item);
     APP_ERROR_CHECK(err_code);
@@ -94,6 +155,58 @@ uint32_t sd_evt_get(uint32_t * p_evt_id)
     return NRF_ERROR_NOT_FOUND;
 }
 
+#if SER_SD_EVT_ZERO_COPY
+uint32_t sd_ble_evt_get(uint8_t * p_data, uint16_t * p_len)
+{
+    ser_sd_handler_evt_data_t item;
+    uint32_t                  err_code;
+    uint32_t                  free_err_code;
+    uint32_t                  len32 = *p_len;
+
+    err_code = app_mailbox_get(m_ble_evt_mailbox_id, &item);
+
+    if ((err_code == NRF_SUCCESS) && item.is_copied)
+    {
+        uint16_t evt_len = ((ble_evt_t *)item.p_data)->header.evt_len;
+
+        if ((sizeof (ble_evt_hdr_t) + evt_len) > *p_len)
+        {
+            err_code = NRF_ERROR_DATA_SIZE;
+        }
+        else
+        {
+            memcpy(p_data, item.p_data, sizeof (ble_evt_hdr_t) + evt_len);
+            *p_len = evt_len;
+        }
+
+        m_evt_copy_released_cnt++;
+    }
+    else if (err_code == NRF_SUCCESS) //if anything in the mailbox
+    {
+        /* Decode straight to the caller's buffer and give the RX buffer back. */
+        err_code = ble_event_dec(item.p_data, item.length, (ble_evt_t *)p_data, &len32);
+
+        free_err_code = ser_sd_transport_rx_free(item.p_data);
+        APP_ERROR_CHECK(free_err_code);
+        m_evt_unpinned_cnt++;
+
+        if (err_code == NRF_SUCCESS)
+        {
+            *p_len = ((ble_evt_t *)p_data)->header.evt_len;
+        }
+        else if (err_code != NRF_ERROR_DATA_SIZE)
+        {
+            APP_ERROR_CHECK(err_code);
+        }
+    }
+    else
+    {
+        err_code = NRF_ERROR_NOT_FOUND;
+    }
+
+    return err_code;
+}
+#else
 uint32_t sd_ble_evt_get(uint8_t * p_data, uint16_t * p_len)
 {
     uint32_t err_code;
@@ -118,6 +231,7 @@ uint32_t sd_ble_evt_get(uint8_t * p_data, uint16_t * p_len)
 
     return err_code;
 }
+#endif
 
 uint32_t sd_softdevice_enable(nrf_clock_lfclksrc_t           clock_source,
                               softdevice_assertion_handler_t assertion_handler)
@@ -345,6 +345,7 @@ uint32_t count16_cond_data16_dec(uint8_t const * const p_buf,
     if (!is_present)
     {
         *pp_data = NULL;
+        *p_count = count;
         return NRF_SUCCESS;
     }
     else
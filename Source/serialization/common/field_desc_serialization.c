@@ -0,0 +1,409 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+#include "field_desc_serialization.h"
+#include "ble_serialization.h"
+#include "nrf_error.h"
+#include "nrf_assert.h"
+#include "app_util.h"
+#include <string.h>
+
+static ser_field_desc_t const m_uint16_fields[] =
+{
+    {SER_FIELD_TYPE_UINT16, 0, 0, NULL}
+};
+
+ser_struct_desc_t const ser_uint16_desc = SER_STRUCT_DESC(m_uint16_fields, sizeof (uint16_t), 1, 2);
+
+
+/**@brief Function for encoding the first count fields of a structure, which have fixed length.
+ *        Buffer length is checked by the caller.
+ *
+ * @return Encoded length of the fields.
+ */
+static uint32_t fixed_fields_enc(ser_struct_desc_t const * p_desc,
+                                 uint32_t                  count,
+                                 uint8_t const *           p_struct,
+                                 uint8_t *                 p_out)
+{
+    uint32_t        len = 0;
+    uint32_t        i;
+    uint8_t const * p_value;
+
+    for (i = 0; i < count; i++)
+    {
+        ser_field_desc_t const * p_field = &p_desc->p_fields[i];
+
+        p_value = &p_struct[p_field->offset];
+
+        switch (p_field->type)
+        {
+            case SER_FIELD_TYPE_UINT8:
+                p_out[len++] = *p_value;
+                break;
+
+            case SER_FIELD_TYPE_UINT16:
+                len += uint16_encode(*(uint16_t const *)p_value, &p_out[len]);
+                break;
+
+            case SER_FIELD_TYPE_UINT32:
+                len += uint32_encode(*(uint32_t const *)p_value, &p_out[len]);
+                break;
+
+            case SER_FIELD_TYPE_STRUCT:
+                len += fixed_fields_enc(p_field->p_desc,
+                                        p_field->p_desc->field_count,
+                                        p_value,
+                                        &p_out[len]);
+                break;
+
+            default:
+                // fixed_count of the descriptor covers a variable length field.
+                ASSERT(false);
+                break;
+        }
+    }
+
+    return len;
+}
+
+
+/**@brief Function for decoding the first count fields of a structure, which have fixed length.
+ *        Buffer length is checked by the caller.
+ *
+ * @return Encoded length of the fields.
+ */
+static uint32_t fixed_fields_dec(ser_struct_desc_t const * p_desc,
+                                 uint32_t                  count,
+                                 uint8_t const *           p_in,
+                                 uint8_t *                 p_struct)
+{
+    uint32_t  len = 0;
+    uint32_t  i;
+    uint8_t * p_value;
+
+    for (i = 0; i < count; i++)
+    {
+        ser_field_desc_t const * p_field = &p_desc->p_fields[i];
+
+        p_value = &p_struct[p_field->offset];
+
+        switch (p_field->type)
+        {
+            case SER_FIELD_TYPE_UINT8:
+                *p_value = p_in[len++];
+                break;
+
+            case SER_FIELD_TYPE_UINT16:
+                *(uint16_t *)p_value = uint16_decode(&p_in[len]);
+                len                 += 2;
+                break;
+
+            case SER_FIELD_TYPE_UINT32:
+                *(uint32_t *)p_value = uint32_decode(&p_in[len]);
+                len                 += 4;
+                break;
+
+            case SER_FIELD_TYPE_STRUCT:
+                len += fixed_fields_dec(p_field->p_desc,
+                                        p_field->p_desc->field_count,
+                                        &p_in[len],
+                                        p_value);
+                break;
+
+            default:
+                // fixed_count of the descriptor covers a variable length field.
+                ASSERT(false);
+                break;
+        }
+    }
+
+    return len;
+}
+
+
+static uint32_t struct_enc(ser_struct_desc_t const * p_desc,
+                           uint8_t const *           p_struct,
+                           uint8_t * const           p_buf,
+                           uint32_t                  buf_len,
+                           uint32_t * const          p_index);
+
+
+/**@brief Function for encoding a field following the fixed length fields of a structure. */
+static uint32_t field_enc(ser_field_desc_t const * p_field,
+                          uint8_t const *          p_struct,
+                          uint8_t * const          p_buf,
+                          uint32_t                 buf_len,
+                          uint32_t * const         p_index)
+{
+    uint8_t const * p_value = &p_struct[p_field->offset];
+    void const *    p_cond;
+    uint16_t        len;
+
+    switch (p_field->type)
+    {
+        case SER_FIELD_TYPE_UINT8:
+            SER_ASSERT_LENGTH_LEQ(1, buf_len - *p_index);
+            p_buf[*p_index] = *p_value;
+            *p_index       += 1;
+            return NRF_SUCCESS;
+
+        case SER_FIELD_TYPE_UINT16:
+            SER_ASSERT_LENGTH_LEQ(2, buf_len - *p_index);
+            *p_index += uint16_encode(*(uint16_t const *)p_value, &p_buf[*p_index]);
+            return NRF_SUCCESS;
+
+        case SER_FIELD_TYPE_UINT32:
+            SER_ASSERT_LENGTH_LEQ(4, buf_len - *p_index);
+            *p_index += uint32_encode(*(uint32_t const *)p_value, &p_buf[*p_index]);
+            return NRF_SUCCESS;
+
+        case SER_FIELD_TYPE_STRUCT:
+            return struct_enc(p_field->p_desc, p_value, p_buf, buf_len, p_index);
+
+        case SER_FIELD_TYPE_COND_STRUCT:
+            p_cond = *(void const * const *)p_value;
+
+            SER_ASSERT_LENGTH_LEQ(1, buf_len - *p_index);
+            p_buf[*p_index] = (p_cond == NULL) ? SER_FIELD_NOT_PRESENT : SER_FIELD_PRESENT;
+            *p_index       += 1;
+
+            if (p_cond == NULL)
+            {
+                return NRF_SUCCESS;
+            }
+            return struct_enc(p_field->p_desc, p_cond, p_buf, buf_len, p_index);
+
+        case SER_FIELD_TYPE_LEN16_ARRAY:
+            len = *(uint16_t const *)&p_struct[p_field->len_offset];
+
+            SER_ASSERT_LENGTH_LEQ(2 + (uint32_t)len, buf_len - *p_index);
+            *p_index += uint16_encode(len, &p_buf[*p_index]);
+            memcpy(&p_buf[*p_index], p_value, len);
+            *p_index += len;
+            return NRF_SUCCESS;
+
+        default:
+            return NRF_ERROR_INVALID_PARAM;
+    }
+}
+
+
+static uint32_t struct_enc(ser_struct_desc_t const * p_desc,
+                           uint8_t const *           p_struct,
+                           uint8_t * const           p_buf,
+                           uint32_t                  buf_len,
+                           uint32_t * const          p_index)
+{
+    uint32_t err_code;
+    uint32_t i;
+
+    // Encode the leading fixed length fields with one length check.
+    SER_ASSERT_LENGTH_LEQ(p_desc->fixed_len, buf_len - *p_index);
+    *p_index += fixed_fields_enc(p_desc, p_desc->fixed_count, p_struct, &p_buf[*p_index]);
+
+    for (i = p_desc->fixed_count; i < p_desc->field_count; i++)
+    {
+        err_code = field_enc(&p_desc->p_fields[i], p_struct, p_buf, buf_len, p_index);
+        SER_ASSERT(err_code == NRF_SUCCESS, err_code);
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+static uint32_t struct_dec(ser_struct_desc_t const * p_desc,
+                           uint8_t const * const     p_buf,
+                           uint32_t                  buf_len,
+                           uint32_t * const          p_index,
+                           uint32_t                  struct_len,
+                           uint32_t * const          p_array_len,
+                           uint8_t *                 p_struct);
+
+
+/**@brief Function for decoding a field following the fixed length fields of a structure. Field is
+ *        skipped if p_struct is NULL.
+ */
+static uint32_t field_dec(ser_field_desc_t const * p_field,
+                          uint8_t const * const    p_buf,
+                          uint32_t                 buf_len,
+                          uint32_t * const         p_index,
+                          uint32_t                 struct_len,
+                          uint32_t * const         p_array_len,
+                          uint8_t *                p_struct)
+{
+    uint8_t * p_value    = (p_struct != NULL) ? &p_struct[p_field->offset] : NULL;
+    uint8_t * p_cond     = NULL;
+    uint32_t  nested_len = 0;
+    uint8_t   is_present;
+    uint16_t  len;
+
+    switch (p_field->type)
+    {
+        case SER_FIELD_TYPE_UINT8:
+            SER_ASSERT_LENGTH_LEQ(1, buf_len - *p_index);
+            if (p_value != NULL)
+            {
+                *p_value = p_buf[*p_index];
+            }
+            *p_index += 1;
+            return NRF_SUCCESS;
+
+        case SER_FIELD_TYPE_UINT16:
+            SER_ASSERT_LENGTH_LEQ(2, buf_len - *p_index);
+            if (p_value != NULL)
+            {
+                *(uint16_t *)p_value = uint16_decode(&p_buf[*p_index]);
+            }
+            *p_index += 2;
+            return NRF_SUCCESS;
+
+        case SER_FIELD_TYPE_UINT32:
+            SER_ASSERT_LENGTH_LEQ(4, buf_len - *p_index);
+            if (p_value != NULL)
+            {
+                *(uint32_t *)p_value = uint32_decode(&p_buf[*p_index]);
+            }
+            *p_index += 4;
+            return NRF_SUCCESS;
+
+        case SER_FIELD_TYPE_STRUCT:
+            return struct_dec(p_field->p_desc, p_buf, buf_len, p_index,
+                              p_field->p_desc->struct_size, &nested_len, p_value);
+
+        case SER_FIELD_TYPE_COND_STRUCT:
+            SER_ASSERT_LENGTH_LEQ(1, buf_len - *p_index);
+            is_present = p_buf[*p_index];
+            *p_index  += 1;
+
+            if (is_present == SER_FIELD_NOT_PRESENT)
+            {
+                if (p_value != NULL)
+                {
+                    *(void **)p_value = NULL;
+                }
+                return NRF_SUCCESS;
+            }
+            SER_ERROR_CHECK(is_present == SER_FIELD_PRESENT, NRF_ERROR_INVALID_DATA);
+
+            if (p_value != NULL)
+            {
+                p_cond = *(uint8_t **)p_value;
+                SER_ASSERT_NOT_NULL(p_cond);
+            }
+            return struct_dec(p_field->p_desc, p_buf, buf_len, p_index,
+                              p_field->p_desc->struct_size, &nested_len, p_cond);
+
+        case SER_FIELD_TYPE_LEN16_ARRAY:
+            SER_ASSERT_LENGTH_LEQ(2, buf_len - *p_index);
+            len       = uint16_decode(&p_buf[*p_index]);
+            *p_index += 2;
+
+            SER_ASSERT_LENGTH_LEQ(len, buf_len - *p_index);
+
+            if (p_struct != NULL)
+            {
+                SER_ASSERT_LENGTH_LEQ(p_field->offset + (uint32_t)len, struct_len);
+                *(uint16_t *)&p_struct[p_field->len_offset] = len;
+                memcpy(p_value, &p_buf[*p_index], len);
+            }
+            *p_index    += len;
+            *p_array_len = len;
+            return NRF_SUCCESS;
+
+        default:
+            return NRF_ERROR_INVALID_PARAM;
+    }
+}
+
+
+static uint32_t struct_dec(ser_struct_desc_t const * p_desc,
+                           uint8_t const * const     p_buf,
+                           uint32_t                  buf_len,
+                           uint32_t * const          p_index,
+                           uint32_t                  struct_len,
+                           uint32_t * const          p_array_len,
+                           uint8_t *                 p_struct)
+{
+    uint32_t err_code;
+    uint32_t i;
+
+    // Decode the leading fixed length fields with one length check.
+    SER_ASSERT_LENGTH_LEQ(p_desc->fixed_len, buf_len - *p_index);
+
+    if (p_struct != NULL)
+    {
+        (void)fixed_fields_dec(p_desc, p_desc->fixed_count, &p_buf[*p_index], p_struct);
+    }
+    *p_index += p_desc->fixed_len;
+
+    for (i = p_desc->fixed_count; i < p_desc->field_count; i++)
+    {
+        err_code = field_dec(&p_desc->p_fields[i],
+                             p_buf,
+                             buf_len,
+                             p_index,
+                             struct_len,
+                             p_array_len,
+                             p_struct);
+        SER_ASSERT(err_code == NRF_SUCCESS, err_code);
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t ser_struct_enc(ser_struct_desc_t const * const p_desc,
+                        void const * const              p_struct,
+                        uint8_t * const                 p_buf,
+                        uint32_t                        buf_len,
+                        uint32_t * const                p_index)
+{
+    SER_ASSERT_NOT_NULL(p_desc);
+    SER_ASSERT_NOT_NULL(p_struct);
+    SER_ASSERT_NOT_NULL(p_buf);
+    SER_ASSERT_NOT_NULL(p_index);
+
+    return struct_enc(p_desc, (uint8_t const *)p_struct, p_buf, buf_len, p_index);
+}
+
+
+uint32_t ser_struct_dec(ser_struct_desc_t const * const p_desc,
+                        uint8_t const * const           p_buf,
+                        uint32_t                        buf_len,
+                        uint32_t * const                p_index,
+                        uint32_t * const                p_struct_len,
+                        void * const                    p_struct)
+{
+    SER_ASSERT_NOT_NULL(p_desc);
+    SER_ASSERT_NOT_NULL(p_buf);
+    SER_ASSERT_NOT_NULL(p_index);
+
+    uint32_t err_code;
+    uint32_t array_len  = 0;
+    uint32_t struct_len = (p_struct_len != NULL) ? *p_struct_len : p_desc->struct_size;
+
+    if (p_struct != NULL)
+    {
+        SER_ASSERT_LENGTH_LEQ(p_desc->struct_size, struct_len);
+    }
+
+    err_code = struct_dec(p_desc, p_buf, buf_len, p_index, struct_len, &array_len,
+                          (uint8_t *)p_struct);
+    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
+
+    if (p_struct_len != NULL)
+    {
+        *p_struct_len = p_desc->struct_size + array_len;
+    }
+
+    return NRF_SUCCESS;
+}
@@ -13,9 +13,34 @@
 #include "ble_gap_struct_serialization.h"
 #include "ble_serialization.h"
 #include "cond_field_serialization.h"
+#include "field_desc_serialization.h"
 #include "app_util.h"
 #include "string.h"
 
+static ser_field_desc_t const m_ble_gap_conn_params_t_fields[] =
+{
+    SER_FIELD_UINT16(ble_gap_conn_params_t, min_conn_interval),
+    SER_FIELD_UINT16(ble_gap_conn_params_t, max_conn_interval),
+    SER_FIELD_UINT16(ble_gap_conn_params_t, slave_latency),
+    SER_FIELD_UINT16(ble_gap_conn_params_t, conn_sup_timeout)
+};
+
+static ser_struct_desc_t const m_ble_gap_conn_params_t_desc =
+    SER_STRUCT_DESC(m_ble_gap_conn_params_t_fields, sizeof (ble_gap_conn_params_t), 4, 4 * 2);
+
+static ser_field_desc_t const m_ble_gap_opt_local_conn_latency_t_fields[] =
+{
+    SER_FIELD_UINT16(ble_gap_opt_local_conn_latency_t, conn_handle),
+    SER_FIELD_UINT16(ble_gap_opt_local_conn_latency_t, requested_latency),
+    SER_FIELD_COND_STRUCT(ble_gap_opt_local_conn_latency_t, p_actual_latency, ser_uint16_desc)
+};
+
+static ser_struct_desc_t const m_ble_gap_opt_local_conn_latency_t_desc =
+    SER_STRUCT_DESC(m_ble_gap_opt_local_conn_latency_t_fields,
+                    sizeof (ble_gap_opt_local_conn_latency_t),
+                    2,
+                    2 + 2);
+
 uint32_t ble_gap_irk_enc(void const * const p_data,
                          uint8_t * const    p_buf,
                          uint32_t           buf_len,
@@ -450,22 +475,8 @@ uint32_t ble_gap_conn_params_t_enc(void const * const p_void_conn_params,
                                    uint32_t           buf_len,
                                    uint32_t * const   p_index)
 {
-    ble_gap_conn_params_t * p_conn_params = (ble_gap_conn_params_t *)p_void_conn_params;
-    uint32_t                err_code      = NRF_SUCCESS;
-
-    err_code = uint16_t_enc(&p_conn_params->min_conn_interval, p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = uint16_t_enc(&p_conn_params->max_conn_interval, p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = uint16_t_enc(&p_conn_params->slave_latency, p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = uint16_t_enc(&p_conn_params->conn_sup_timeout, p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    return err_code;
+    return ser_struct_enc(&m_ble_gap_conn_params_t_desc, p_void_conn_params, p_buf, buf_len,
+                          p_index);
 }
 
 uint32_t ble_gap_conn_params_t_dec(uint8_t const * const p_buf,
@@ -473,21 +484,8 @@ uint32_t ble_gap_conn_params_t_dec(uint8_t const * const p_buf,
                                    uint32_t * const      p_index,
                                    void * const          p_void_conn_params)
 {
-    ble_gap_conn_params_t * p_conn_params = (ble_gap_conn_params_t *)p_void_conn_params;
-
-    SER_ASSERT_LENGTH_LEQ(*p_index + 2, buf_len);
-    uint16_dec(p_buf, buf_len, p_index, &p_conn_params->min_conn_interval);
-
-    SER_ASSERT_LENGTH_LEQ(*p_index + 2, buf_len);
-    uint16_dec(p_buf, buf_len, p_index, &p_conn_params->max_conn_interval);
-
-    SER_ASSERT_LENGTH_LEQ(*p_index + 2, buf_len);
-    uint16_dec(p_buf, buf_len, p_index, &p_conn_params->slave_latency);
-
-    SER_ASSERT_LENGTH_LEQ(*p_index + 2, buf_len);
-    uint16_dec(p_buf, buf_len, p_index, &p_conn_params->conn_sup_timeout);
-
-    return NRF_SUCCESS;
+    return ser_struct_dec(&m_ble_gap_conn_params_t_desc, p_buf, buf_len, p_index, NULL,
+                          p_void_conn_params);
 }
 
 uint32_t ble_gap_evt_disconnected_t_enc(void const * const p_void_disconnected,
@@ -523,23 +521,8 @@ uint32_t ble_gap_opt_local_conn_latency_t_enc(void const * const p_void_local_co
                                               uint32_t           buf_len,
                                               uint32_t * const   p_index)
 {
-    SER_ASSERT_NOT_NULL(p_buf);
-    SER_ASSERT_NOT_NULL(p_index);
-
-    ble_gap_opt_local_conn_latency_t * p_latency =
-        (ble_gap_opt_local_conn_latency_t *)p_void_local_conn_latency;
-    uint32_t err_code = NRF_SUCCESS;
-
-    err_code = uint16_t_enc(&(p_latency->conn_handle), p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = uint16_t_enc(&(p_latency->requested_latency), p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = cond_field_enc(p_latency->p_actual_latency, p_buf, buf_len, p_index, uint16_t_enc);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    return err_code;
+    return ser_struct_enc(&m_ble_gap_opt_local_conn_latency_t_desc, p_void_local_conn_latency,
+                          p_buf, buf_len, p_index);
 }
 
 uint32_t ble_gap_opt_local_conn_latency_t_dec(uint8_t const * const p_buf,
@@ -547,24 +530,8 @@ uint32_t ble_gap_opt_local_conn_latency_t_dec(uint8_t const * const p_buf,
                                               uint32_t * const      p_index,
                                               void * const          p_void_local_conn_latency)
 {
-    SER_ASSERT_NOT_NULL(p_buf);
-    SER_ASSERT_NOT_NULL(p_index);
-
-    ble_gap_opt_local_conn_latency_t * p_latency =
-        (ble_gap_opt_local_conn_latency_t *)p_void_local_conn_latency;
-    uint32_t err_code = NRF_SUCCESS;
-
-    err_code = uint16_t_dec(p_buf, buf_len, p_index, &(p_latency->conn_handle));
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = uint16_t_dec(p_buf, buf_len, p_index, &(p_latency->requested_latency));
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = cond_field_dec(p_buf, buf_len, p_index, (void **) &(p_latency->p_actual_latency),
-                              uint16_t_dec);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    return err_code;
+    return ser_struct_dec(&m_ble_gap_opt_local_conn_latency_t_desc, p_buf, buf_len, p_index, NULL,
+                          p_void_local_conn_latency);
 }
 
 uint32_t ble_gap_opt_passkey_t_enc(void const * const p_void_passkey,
@@ -15,8 +15,36 @@
 #include "app_util.h"
 #include "ble_gattc.h"
 #include "cond_field_serialization.h"
+#include "field_desc_serialization.h"
 #include <string.h>
 
+static ser_field_desc_t const m_ble_gattc_handle_range_t_fields[] =
+{
+    SER_FIELD_UINT16(ble_gattc_handle_range_t, start_handle),
+    SER_FIELD_UINT16(ble_gattc_handle_range_t, end_handle)
+};
+
+static ser_struct_desc_t const m_ble_gattc_handle_range_t_desc =
+    SER_STRUCT_DESC(m_ble_gattc_handle_range_t_fields, sizeof (ble_gattc_handle_range_t), 2, 2 + 2);
+
+static ser_field_desc_t const m_ble_gattc_evt_hvx_fields[] =
+{
+    SER_FIELD_UINT16(ble_gattc_evt_t, conn_handle),
+    SER_FIELD_UINT16(ble_gattc_evt_t, gatt_status),
+    SER_FIELD_UINT16(ble_gattc_evt_t, error_handle),
+    SER_FIELD_UINT16(ble_gattc_evt_t, params.hvx.handle),
+    SER_FIELD_UINT8(ble_gattc_evt_t, params.hvx.type),
+    SER_FIELD_LEN16_ARRAY(ble_gattc_evt_t, params.hvx.data, params.hvx.len)
+};
+
+STATIC_ASSERT(offsetof(ble_gattc_evt_t, params.hvx.len) <= UINT8_MAX);
+
+ser_struct_desc_t const ble_gattc_evt_hvx_desc =
+    SER_STRUCT_DESC(m_ble_gattc_evt_hvx_fields,
+                    offsetof(ble_gattc_evt_t, params.hvx.data),
+                    5,
+                    4 * 2 + 1);
+
 uint32_t ble_gattc_evt_char_val_by_uuid_read_rsp_t_enc(void const * const p_void_struct,
                                                        uint8_t * const    p_buf,
                                                        uint32_t           buf_len,
@@ -155,16 +183,7 @@ uint32_t ble_gattc_handle_range_t_enc(void const * const p_void_struct,
                                       uint32_t           buf_len,
                                       uint32_t * const   p_index)
 {
-    ble_gattc_handle_range_t * p_range  = (ble_gattc_handle_range_t *) p_void_struct;
-    uint32_t                   err_code = NRF_SUCCESS;
-
-    err_code = uint16_t_enc(&(p_range->start_handle), p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = uint16_t_enc(&(p_range->end_handle), p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    return err_code;
+    return ser_struct_enc(&m_ble_gattc_handle_range_t_desc, p_void_struct, p_buf, buf_len, p_index);
 }
 
 uint32_t ble_gattc_handle_range_t_dec(uint8_t const * const p_buf,
@@ -172,14 +191,8 @@ uint32_t ble_gattc_handle_range_t_dec(uint8_t const * const p_buf,
                                       uint32_t * const      p_index,
                                       void * const          p_void_struct)
 {
-    ble_gattc_handle_range_t * p_range  = (ble_gattc_handle_range_t *) p_void_struct;
-    uint32_t                   err_code = NRF_SUCCESS;
-
-    SER_ASSERT_LENGTH_LEQ(4, buf_len - *p_index);
-    uint16_dec(p_buf, buf_len, p_index, &(p_range->start_handle));
-    uint16_dec(p_buf, buf_len, p_index, &(p_range->end_handle));
-
-    return err_code;
+    return ser_struct_dec(&m_ble_gattc_handle_range_t_desc, p_buf, buf_len, p_index, NULL,
+                          p_void_struct);
 }
 
 
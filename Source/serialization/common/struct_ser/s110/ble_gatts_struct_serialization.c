@@ -17,24 +17,62 @@
 #include "app_util.h"
 #include "ble_gatts.h"
 #include "cond_field_serialization.h"
+#include "field_desc_serialization.h"
 #include <string.h>
 
+#define BLE_GATTS_ATTR_CONTEXT_T_ENC_LEN (3 * BLE_UUID_T_ENC_LEN + 2 + 2 + 1) /**< Encoded length of ble_gatts_attr_context_t. */
+
+static ser_field_desc_t const m_ble_gatts_char_pf_t_fields[] =
+{
+    SER_FIELD_UINT8(ble_gatts_char_pf_t, format),
+    SER_FIELD_UINT8(ble_gatts_char_pf_t, exponent),
+    SER_FIELD_UINT16(ble_gatts_char_pf_t, unit),
+    SER_FIELD_UINT8(ble_gatts_char_pf_t, name_space),
+    SER_FIELD_UINT16(ble_gatts_char_pf_t, desc)
+};
+
+static ser_struct_desc_t const m_ble_gatts_char_pf_t_desc =
+    SER_STRUCT_DESC(m_ble_gatts_char_pf_t_fields, sizeof (ble_gatts_char_pf_t), 5, 1 + 1 + 2 + 1 + 2);
+
+static ser_field_desc_t const m_ble_gatts_attr_context_t_fields[] =
+{
+    SER_FIELD_STRUCT(ble_gatts_attr_context_t, srvc_uuid, ble_uuid_t_desc),
+    SER_FIELD_STRUCT(ble_gatts_attr_context_t, char_uuid, ble_uuid_t_desc),
+    SER_FIELD_STRUCT(ble_gatts_attr_context_t, desc_uuid, ble_uuid_t_desc),
+    SER_FIELD_UINT16(ble_gatts_attr_context_t, srvc_handle),
+    SER_FIELD_UINT16(ble_gatts_attr_context_t, value_handle),
+    SER_FIELD_UINT8(ble_gatts_attr_context_t, type)
+};
+
+static ser_struct_desc_t const m_ble_gatts_attr_context_t_desc =
+    SER_STRUCT_DESC(m_ble_gatts_attr_context_t_fields,
+                    sizeof (ble_gatts_attr_context_t),
+                    6,
+                    BLE_GATTS_ATTR_CONTEXT_T_ENC_LEN);
+
+static ser_field_desc_t const m_ble_gatts_evt_write_t_fields[] =
+{
+    SER_FIELD_UINT16(ble_gatts_evt_write_t, handle),
+    SER_FIELD_UINT8(ble_gatts_evt_write_t, op),
+    SER_FIELD_STRUCT(ble_gatts_evt_write_t, context, m_ble_gatts_attr_context_t_desc),
+    SER_FIELD_UINT16(ble_gatts_evt_write_t, offset),
+    SER_FIELD_LEN16_ARRAY(ble_gatts_evt_write_t, data, len)
+};
+
+STATIC_ASSERT(offsetof(ble_gatts_evt_write_t, len) <= UINT8_MAX);
+
+static ser_struct_desc_t const m_ble_gatts_evt_write_t_desc =
+    SER_STRUCT_DESC(m_ble_gatts_evt_write_t_fields,
+                    offsetof(ble_gatts_evt_write_t, data),
+                    4,
+                    2 + 1 + BLE_GATTS_ATTR_CONTEXT_T_ENC_LEN + 2);
+
 uint32_t ser_ble_gatts_char_pf_dec(uint8_t const * const p_buf,
                                    uint32_t              buf_len,
                                    uint32_t * const      p_index,
                                    void * const          p_void_char_pf)
 {
-    ble_gatts_char_pf_t * p_char_pf = (ble_gatts_char_pf_t *)p_void_char_pf;
-
-    SER_ASSERT_LENGTH_LEQ(7, buf_len - *p_index);
-
-    uint8_dec(p_buf, buf_len, p_index, &p_char_pf->format);
-    uint8_dec(p_buf, buf_len, p_index, (uint8_t *)&p_char_pf->exponent);
-    uint16_dec(p_buf, buf_len, p_index, &p_char_pf->unit);
-    uint8_dec(p_buf, buf_len, p_index, &p_char_pf->name_space);
-    uint16_dec(p_buf, buf_len, p_index, &p_char_pf->desc);
-
-    return NRF_SUCCESS;
+    return ser_struct_dec(&m_ble_gatts_char_pf_t_desc, p_buf, buf_len, p_index, NULL, p_void_char_pf);
 }
 
 uint32_t ser_ble_gatts_char_pf_enc(void const * const p_void_char_pf,
@@ -42,25 +80,7 @@ uint32_t ser_ble_gatts_char_pf_enc(void const * const p_void_char_pf,
                                    uint32_t           buf_len,
                                    uint32_t * const   p_index)
 {
-    ble_gatts_char_pf_t * p_char_pf = (ble_gatts_char_pf_t *)p_void_char_pf;
-    uint32_t              err_code  = NRF_SUCCESS;
-
-    err_code = uint8_t_enc(&p_char_pf->format, p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = uint8_t_enc(&p_char_pf->exponent, p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = uint16_t_enc(&p_char_pf->unit, p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = uint8_t_enc(&p_char_pf->name_space, p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = uint16_t_enc(&p_char_pf->desc, p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    return err_code;
+    return ser_struct_enc(&m_ble_gatts_char_pf_t_desc, p_void_char_pf, p_buf, buf_len, p_index);
 }
 
 uint32_t ble_gatts_attr_md_enc(void const * const p_void_attr_md,
@@ -429,22 +449,8 @@ uint32_t ble_gatts_attr_context_t_enc(void const * const p_void_attr_context,
                                       uint32_t           buf_len,
                                       uint32_t * const   p_index)
 {
-    uint32_t                   error_code = NRF_SUCCESS;
-    ble_gatts_attr_context_t * p_context  = (ble_gatts_attr_context_t *) p_void_attr_context;
-
-    error_code = ble_uuid_t_enc(&(p_context->srvc_uuid), p_buf, buf_len, p_index);
-    SER_ASSERT(error_code == NRF_SUCCESS, error_code);
-    error_code = ble_uuid_t_enc(&(p_context->char_uuid), p_buf, buf_len, p_index);
-    SER_ASSERT(error_code == NRF_SUCCESS, error_code);
-    error_code = ble_uuid_t_enc(&(p_context->desc_uuid), p_buf, buf_len, p_index);
-    SER_ASSERT(error_code == NRF_SUCCESS, error_code);
-    error_code = uint16_t_enc(&(p_context->srvc_handle), p_buf, buf_len, p_index);
-    SER_ASSERT(error_code == NRF_SUCCESS, error_code);
-    error_code = uint16_t_enc(&(p_context->value_handle), p_buf, buf_len, p_index);
-    SER_ASSERT(error_code == NRF_SUCCESS, error_code);
-    error_code = uint8_t_enc(&(p_context->type), p_buf, buf_len, p_index);
-
-    return error_code;
+    return ser_struct_enc(&m_ble_gatts_attr_context_t_desc, p_void_attr_context, p_buf, buf_len,
+                          p_index);
 }
 
 uint32_t ble_gatts_attr_context_t_dec(uint8_t const * const p_buf,
@@ -452,21 +458,8 @@ uint32_t ble_gatts_attr_context_t_dec(uint8_t const * const p_buf,
                                       uint32_t * const      p_index,
                                       void * const          p_void_attr_context)
 {
-    uint32_t                   error_code = NRF_SUCCESS;
-    ble_gatts_attr_context_t * p_context  = (ble_gatts_attr_context_t *) p_void_attr_context;
-
-    error_code = ble_uuid_t_dec(p_buf, buf_len, p_index, &(p_context->srvc_uuid));
-    SER_ASSERT(error_code == NRF_SUCCESS, error_code);
-    error_code = ble_uuid_t_dec(p_buf, buf_len, p_index, &(p_context->char_uuid));
-    SER_ASSERT(error_code == NRF_SUCCESS, error_code);
-    error_code = ble_uuid_t_dec(p_buf, buf_len, p_index, &(p_context->desc_uuid));
-    SER_ASSERT(error_code == NRF_SUCCESS, error_code);
-
-    SER_ASSERT_LENGTH_LEQ(5, buf_len - *p_index);
-    uint16_dec(p_buf, buf_len, p_index, &(p_context->srvc_handle));
-    uint16_dec(p_buf, buf_len, p_index, &(p_context->value_handle));
-    uint8_dec(p_buf, buf_len, p_index, &(p_context->type));
-    return error_code;
+    return ser_struct_dec(&m_ble_gatts_attr_context_t_desc, p_buf, buf_len, p_index, NULL,
+                          p_void_attr_context);
 }
 
 uint32_t ble_gatts_evt_write_t_enc(void const * const p_void_write,
@@ -474,26 +467,7 @@ uint32_t ble_gatts_evt_write_t_enc(void const * const p_void_write,
                                    uint32_t           buf_len,
                                    uint32_t * const   p_index)
 {
-    ble_gatts_evt_write_t * p_write    = (ble_gatts_evt_write_t *) p_void_write;
-    uint32_t                error_code = NRF_SUCCESS;
-
-    error_code = uint16_t_enc(&(p_write->handle), p_buf, buf_len, p_index);
-    SER_ASSERT(error_code == NRF_SUCCESS, error_code);
-    error_code = uint8_t_enc(&(p_write->op), p_buf, buf_len, p_index);
-    SER_ASSERT(error_code == NRF_SUCCESS, error_code);
-    error_code = ble_gatts_attr_context_t_enc(&(p_write->context), p_buf, buf_len, p_index);
-    SER_ASSERT(error_code == NRF_SUCCESS, error_code);
-    error_code = uint16_t_enc(&(p_write->offset), p_buf, buf_len, p_index);
-    SER_ASSERT(error_code == NRF_SUCCESS, error_code);
-
-    uint16_t data_len = p_write->len;
-    error_code = uint16_t_enc(&data_len, p_buf, buf_len, p_index);
-    SER_ASSERT(error_code == NRF_SUCCESS, error_code);
-    SER_ASSERT_LENGTH_LEQ(data_len, buf_len - *p_index);
-    memcpy(&p_buf[*p_index], p_write->data, data_len);
-    *p_index += data_len;
-
-    return error_code;
+    return ser_struct_enc(&m_ble_gatts_evt_write_t_desc, p_void_write, p_buf, buf_len, p_index);
 }
 
 uint32_t ble_gatts_evt_write_t_dec(uint8_t const * const p_buf,
@@ -502,58 +476,10 @@ uint32_t ble_gatts_evt_write_t_dec(uint8_t const * const p_buf,
                                    uint32_t * const      p_struct_len,
                                    void * const          p_void_write)
 {
-    SER_ASSERT_NOT_NULL(p_buf);
-    SER_ASSERT_NOT_NULL(p_index);
     SER_ASSERT_NOT_NULL(p_struct_len);
 
-    uint32_t err_code      = NRF_SUCCESS;
-    uint32_t in_struct_len = *p_struct_len;
-
-    *p_struct_len = offsetof(ble_gatts_evt_write_t, data);
-
-    uint16_t handle;
-    err_code = uint16_t_dec(p_buf, buf_len, p_index, &handle);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    uint8_t op;
-    err_code = uint8_t_dec(p_buf, buf_len, p_index, &op);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    ble_gatts_attr_context_t context;
-    err_code = ble_gatts_attr_context_t_dec(p_buf, buf_len, p_index, &context);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    uint16_t offset;
-    err_code = uint16_t_dec(p_buf, buf_len, p_index, &offset);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    uint16_t len;
-    err_code = uint16_t_dec(p_buf, buf_len, p_index, &len);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    *p_struct_len += len;
-
-    if (p_void_write != NULL)
-    {
-        ble_gatts_evt_write_t * p_write = (ble_gatts_evt_write_t *)p_void_write;
-
-        SER_ASSERT_LENGTH_LEQ(*p_struct_len, in_struct_len);
-
-        p_write->handle = handle;
-        p_write->op     = op;
-
-        memcpy(&(p_write->context), &context, sizeof (ble_gatts_attr_context_t));
-
-        p_write->offset = offset;
-        p_write->len    = len;
-
-        SER_ASSERT_LENGTH_LEQ(p_write->len, buf_len - *p_index);
-        memcpy(p_write->data, &p_buf[*p_index], p_write->len);
-    }
-
-    *p_index += len;
-
-    return err_code;
+    return ser_struct_dec(&m_ble_gatts_evt_write_t_desc, p_buf, buf_len, p_index, p_struct_len,
+                          p_void_write);
 }
 
 uint32_t ble_gatts_evt_read_t_enc(void const * const p_void_read,
@@ -17,24 +17,25 @@
 #include "ble_l2cap.h"
 #include "ble.h"
 #include "cond_field_serialization.h"
+#include "field_desc_serialization.h"
 #include <string.h>
 
 
+static ser_field_desc_t const m_ble_uuid_t_fields[] =
+{
+    SER_FIELD_UINT16(ble_uuid_t, uuid),
+    SER_FIELD_UINT8(ble_uuid_t, type)
+};
+
+ser_struct_desc_t const ble_uuid_t_desc =
+    SER_STRUCT_DESC(m_ble_uuid_t_fields, sizeof (ble_uuid_t), 2, BLE_UUID_T_ENC_LEN);
+
 uint32_t ble_uuid_t_enc(void const * const p_void_uuid,
                         uint8_t * const    p_buf,
                         uint32_t           buf_len,
                         uint32_t * const   p_index)
 {
-    ble_uuid_t * p_uuid   = (ble_uuid_t *)p_void_uuid;
-    uint32_t     err_code = NRF_SUCCESS;
-
-    err_code = uint16_t_enc(&p_uuid->uuid, p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    err_code = uint8_t_enc(&p_uuid->type, p_buf, buf_len, p_index);
-    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
-
-    return err_code;
+    return ser_struct_enc(&ble_uuid_t_desc, p_void_uuid, p_buf, buf_len, p_index);
 }
 
 uint32_t ble_uuid_t_dec(uint8_t const * const p_buf,
@@ -42,13 +43,7 @@ uint32_t ble_uuid_t_dec(uint8_t const * const p_buf,
                         uint32_t * const      p_index,
                         void * const          p_void_uuid)
 {
-    ble_uuid_t * p_uuid = (ble_uuid_t *)p_void_uuid;
-
-    SER_ASSERT_LENGTH_LEQ(3, buf_len - *p_index);
-    uint16_dec(p_buf, buf_len, p_index, &p_uuid->uuid);
-    uint8_dec(p_buf, buf_len, p_index, &p_uuid->type);
-
-    return NRF_SUCCESS;
+    return ser_struct_dec(&ble_uuid_t_desc, p_buf, buf_len, p_index, NULL, p_void_uuid);
 }
 
 uint32_t ble_uuid128_t_enc(void const * const p_void_uuid,
@@ -186,6 +181,12 @@ uint32_t ble_l2cap_evt_rx_t_dec(uint8_t const * const p_buf,
         memcpy(p_evt_rx->data, &p_buf[*p_index], p_evt_rx->header.len);
         *p_index += p_evt_rx->header.len;
     }
+    else
+    {
+        /* Skip header and data */
+        SER_ASSERT_LENGTH_LEQ(4 + len, buf_len - *p_index);
+        *p_index += 4 + len;
+    }
 
     return err_code;
 }
@@ -13,10 +13,16 @@
 #include <stdbool.h>
 #include <string.h>
 #include "app_error.h"
+#include "app_util.h"
 #include "ser_config.h"
 #include "ser_phy.h"
 #include "ser_hal_transport.h"
 
+// TX buffers are indexed by free running counters modulo the count, so the index must not jump
+// when a counter wraps around.
+STATIC_ASSERT(IS_POWER_OF_TWO(SER_HAL_TRANSPORT_TX_PKT_COUNT));
+STATIC_ASSERT(SER_HAL_TRANSPORT_RX_PKT_COUNT > 0);
+
 /**
  * @brief States of the RX state machine.
  */
@@ -26,22 +32,28 @@ typedef enum
     HAL_TRANSP_RX_STATE_IDLE,
     HAL_TRANSP_RX_STATE_RECEIVING,
     HAL_TRANSP_RX_STATE_DROPPING,
-    HAL_TRANSP_RX_STATE_RECEIVED,
-    HAL_TRANSP_RX_STATE_RECEIVED_PENDING_BUF_REQ,
-    HAL_TRANSP_RX_STATE_RECEIVED_DROPPING,
+    HAL_TRANSP_RX_STATE_PENDING_BUF_REQ,
     HAL_TRANSP_RX_STATE_MAX
 }ser_hal_transp_rx_states_t;
 
 /**
- * @brief States of the TX state machine.
+ * @brief States of a single RX buffer.
+ */
+typedef enum
+{
+    HAL_TRANSP_RX_BUF_STATE_FREE = 0,
+    HAL_TRANSP_RX_BUF_STATE_RECEIVING,
+    HAL_TRANSP_RX_BUF_STATE_RECEIVED,
+    HAL_TRANSP_RX_BUF_STATE_MAX
+}ser_hal_transp_rx_buf_states_t;
+
+/**
+ * @brief TX state.
  */
 typedef enum
 {
     HAL_TRANSP_TX_STATE_CLOSED = 0,
-    HAL_TRANSP_TX_STATE_IDLE,
-    HAL_TRANSP_TX_STATE_TX_ALLOCATED,
-    HAL_TRANSP_TX_STATE_TRANSMITTING,
-    HAL_TRANSP_TX_STATE_TRANSMITTED,
+    HAL_TRANSP_TX_STATE_OPEN,
     HAL_TRANSP_TX_STATE_MAX
 }ser_hal_transp_tx_states_t;
 
@@ -55,13 +67,40 @@ static ser_hal_transp_rx_states_t m_rx_state = HAL_TRANSP_RX_STATE_CLOSED;
 static ser_hal_transp_tx_states_t m_tx_state = HAL_TRANSP_TX_STATE_CLOSED;
 
 /**
- * @brief Transmission buffer.
+ * @brief Transmission buffers. They are used as a ring - packets are allocated, sent and released
+ *        in the same order.
+ */
+static uint8_t m_tx_buffer[SER_HAL_TRANSPORT_TX_PKT_COUNT][SER_HAL_TRANSPORT_TX_MAX_PKT_SIZE];
+/**
+ * @brief Lengths of packets queued for transmission.
+ */
+static uint16_t m_tx_length[SER_HAL_TRANSPORT_TX_PKT_COUNT];
+/**
+ * @brief Number of allocated TX buffers. Modified only by an upper layer.
+ */
+static volatile uint32_t m_tx_alloc_cnt = 0;
+/**
+ * @brief Number of TX buffers queued for transmission. Modified only by an upper layer.
+ */
+static volatile uint32_t m_tx_queued_cnt = 0;
+/**
+ * @brief Number of TX buffers passed to the PHY layer. Modified with PHY interrupts disabled.
+ */
+static volatile uint32_t m_tx_started_cnt = 0;
+/**
+ * @brief Number of transmitted and released TX buffers. Modified only in PHY interrupt context.
+ */
+static volatile uint32_t m_tx_released_cnt = 0;
+
+/**
+ * @brief Reception buffers.
  */
-static uint8_t m_tx_buffer[SER_HAL_TRANSPORT_TX_MAX_PKT_SIZE];
+static uint8_t m_rx_buffer[SER_HAL_TRANSPORT_RX_PKT_COUNT][SER_HAL_TRANSPORT_RX_MAX_PKT_SIZE];
 /**
- * @brief Reception buffer.
+ * @brief States of reception buffers. A buffer is taken only in PHY interrupt context and released
+ *        only by an upper layer, so no locking is needed.
  */
-static uint8_t m_rx_buffer[SER_HAL_TRANSPORT_RX_MAX_PKT_SIZE];
+static volatile uint8_t m_rx_buf_state[SER_HAL_TRANSPORT_RX_PKT_COUNT];
 
 /**
  * @brief Callback function handler for Serialization HAL Transport layer events.
@@ -69,6 +108,83 @@ static uint8_t m_rx_buffer[SER_HAL_TRANSPORT_RX_MAX_PKT_SIZE];
 static ser_hal_transport_events_handler_t m_events_handler = NULL;
 
 
+/**
+ * @brief A function for getting a TX buffer assigned to a given sequence number.
+ */
+static __INLINE uint8_t * tx_buffer_get(uint32_t cnt)
+{
+    return m_tx_buffer[cnt % SER_HAL_TRANSPORT_TX_PKT_COUNT];
+}
+
+
+/**
+ * @brief A function for passing the oldest queued TX packet to the PHY layer if it is idle.
+ *
+ * @note Has to be called with PHY interrupts disabled or from PHY interrupt context.
+ */
+static uint32_t tx_queue_process(void)
+{
+    uint32_t err_code = NRF_SUCCESS;
+    uint32_t cnt      = m_tx_started_cnt;
+
+    if ((cnt == m_tx_released_cnt) && (cnt != m_tx_queued_cnt))
+    {
+        err_code = ser_phy_tx_pkt_send(tx_buffer_get(cnt),
+                                       m_tx_length[cnt % SER_HAL_TRANSPORT_TX_PKT_COUNT]);
+
+        if (NRF_SUCCESS == err_code)
+        {
+            m_tx_started_cnt = cnt + 1;
+        }
+    }
+
+    return err_code;
+}
+
+
+/**
+ * @brief A function for taking a free RX buffer.
+ *
+ * @return Pointer to a buffer or NULL if all buffers are in use.
+ */
+static uint8_t * rx_buffer_take(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < SER_HAL_TRANSPORT_RX_PKT_COUNT; i++)
+    {
+        if (HAL_TRANSP_RX_BUF_STATE_FREE == m_rx_buf_state[i])
+        {
+            m_rx_buf_state[i] = HAL_TRANSP_RX_BUF_STATE_RECEIVING;
+            return m_rx_buffer[i];
+        }
+    }
+
+    return NULL;
+}
+
+
+/**
+ * @brief A function for finding an index of an RX buffer.
+ *
+ * @return Index of a buffer or SER_HAL_TRANSPORT_RX_PKT_COUNT if address is not valid.
+ */
+static uint32_t rx_buffer_index_get(uint8_t const * p_buffer)
+{
+    uint32_t i;
+
+    for (i = 0; i < SER_HAL_TRANSPORT_RX_PKT_COUNT; i++)
+    {
+        if (p_buffer == m_rx_buffer[i])
+        {
+            break;
+        }
+    }
+
+    return i;
+}
+
+
 /**
  * @brief A callback function to be used to handle a PHY module events. This function is called in
  *        an interrupt context.
@@ -85,10 +201,14 @@ static void phy_events_handler(ser_phy_evt_t phy_event)
     {
         case SER_PHY_EVT_TX_PKT_SENT:
         {
-            if (HAL_TRANSP_TX_STATE_TRANSMITTING == m_tx_state)
+            if (m_tx_started_cnt != m_tx_released_cnt)
             {
-                m_tx_state = HAL_TRANSP_TX_STATE_TRANSMITTED;
-                err_code   = ser_hal_transport_tx_pkt_free(m_tx_buffer);
+                /* Release the transmitted buffer and pass the next queued packet (if any) to the
+                 * PHY layer. */
+                hal_transp_event.evt_params.tx_pkt_sent.p_buffer =
+                    tx_buffer_get(m_tx_released_cnt);
+                m_tx_released_cnt++;
+                err_code = tx_queue_process();
                 APP_ERROR_CHECK(err_code);
                 /* An event to an upper layer that a packet has been transmitted. */
                 hal_transp_event.evt_type = SER_HAL_TRANSP_EVT_TX_PKT_SENT;
@@ -104,63 +224,58 @@ static void phy_events_handler(ser_phy_evt_t phy_event)
 
         case SER_PHY_EVT_RX_BUF_REQUEST:
         {
-            /* An event to an upper layer that a packet is being scheduled to receive or to drop. */
-            hal_transp_event.evt_type = SER_HAL_TRANSP_EVT_RX_PKT_RECEIVING;
-
-            /* Receive or drop a packet. */
-            if (phy_event.evt_params.rx_buf_request.num_of_bytes <= sizeof (m_rx_buffer))
+            if (HAL_TRANSP_RX_STATE_IDLE == m_rx_state)
             {
-                if (HAL_TRANSP_RX_STATE_IDLE == m_rx_state)
-                {
-                    m_events_handler(hal_transp_event);
-                    err_code = ser_phy_rx_buf_set(m_rx_buffer);
-                    APP_ERROR_CHECK(err_code);
-                    m_rx_state = HAL_TRANSP_RX_STATE_RECEIVING;
-                }
-                else if (HAL_TRANSP_RX_STATE_RECEIVED == m_rx_state)
+                /* An event to an upper layer that a packet is being scheduled to receive or to
+                 * drop. */
+                hal_transp_event.evt_type = SER_HAL_TRANSP_EVT_RX_PKT_RECEIVING;
+                m_events_handler(hal_transp_event);
+
+                /* Receive or drop a packet. */
+                if (phy_event.evt_params.rx_buf_request.num_of_bytes <=
+                    SER_HAL_TRANSPORT_RX_MAX_PKT_SIZE)
                 {
-                    /* It is OK to get know higher layer at this point that we are going to receive
-                     * a new packet even though we will start receiving when rx buffer is freed. */
-                    m_events_handler(hal_transp_event);
-                    m_rx_state = HAL_TRANSP_RX_STATE_RECEIVED_PENDING_BUF_REQ;
+                    uint8_t * p_rx_buffer = rx_buffer_take();
+
+                    if (NULL != p_rx_buffer)
+                    {
+                        err_code = ser_phy_rx_buf_set(p_rx_buffer);
+                        APP_ERROR_CHECK(err_code);
+                        m_rx_state = HAL_TRANSP_RX_STATE_RECEIVING;
+                    }
+                    else
+                    {
+                        /* All buffers are in use. Reception is going to be started when one of
+                         * them is freed. */
+                        m_rx_state = HAL_TRANSP_RX_STATE_PENDING_BUF_REQ;
+                    }
                 }
                 else
                 {
-                    /* Lower layer should not generate this event in current state. */
-                    APP_ERROR_CHECK_BOOL(false);
-                }
-            }
-            else
-            {
-                /* There is not enough memory but packet has to be received to dummy location. */
-                if (HAL_TRANSP_RX_STATE_IDLE == m_rx_state)
-                {
-                    m_events_handler(hal_transp_event);
+                    /* There is not enough memory but packet has to be received to dummy
+                     * location. */
                     err_code = ser_phy_rx_buf_set(NULL);
                     APP_ERROR_CHECK(err_code);
                     m_rx_state = HAL_TRANSP_RX_STATE_DROPPING;
                 }
-                else if (HAL_TRANSP_RX_STATE_RECEIVED == m_rx_state)
-                {
-                    m_events_handler(hal_transp_event);
-                    err_code = ser_phy_rx_buf_set(NULL);
-                    APP_ERROR_CHECK(err_code);
-                    m_rx_state = HAL_TRANSP_RX_STATE_RECEIVED_DROPPING;
-                }
-                else
-                {
-                    /* Lower layer should not generate this event in current state. */
-                    APP_ERROR_CHECK_BOOL(false);
-                }
+            }
+            else
+            {
+                /* Lower layer should not generate this event in current state. */
+                APP_ERROR_CHECK_BOOL(false);
             }
             break;
         }
 
         case SER_PHY_EVT_RX_PKT_RECEIVED:
         {
-            if (HAL_TRANSP_RX_STATE_RECEIVING == m_rx_state)
+            uint32_t index = rx_buffer_index_get(phy_event.evt_params.rx_pkt_received.p_buffer);
+
+            if ((HAL_TRANSP_RX_STATE_RECEIVING == m_rx_state) &&
+                (index < SER_HAL_TRANSPORT_RX_PKT_COUNT))
             {
-                m_rx_state = HAL_TRANSP_RX_STATE_RECEIVED;
+                m_rx_buf_state[index] = HAL_TRANSP_RX_BUF_STATE_RECEIVED;
+                m_rx_state            = HAL_TRANSP_RX_STATE_IDLE;
                 /* Generate the event to an upper layer. */
                 hal_transp_event.evt_type =
                     SER_HAL_TRANSP_EVT_RX_PKT_RECEIVED;
@@ -187,13 +302,6 @@ static void phy_events_handler(ser_phy_evt_t phy_event)
                 m_events_handler(hal_transp_event);
                 m_rx_state = HAL_TRANSP_RX_STATE_IDLE;
             }
-            else if (HAL_TRANSP_RX_STATE_RECEIVED_DROPPING == m_rx_state)
-            {
-                /* Generate the event to an upper layer. */
-                hal_transp_event.evt_type = SER_HAL_TRANSP_EVT_RX_PKT_DROPPED;
-                m_events_handler(hal_transp_event);
-                m_rx_state = HAL_TRANSP_RX_STATE_RECEIVED;
-            }
             else
             {
                 /* Lower layer should not generate this event in current state. */
@@ -259,8 +367,14 @@ uint32_t ser_hal_transport_open(ser_hal_transport_events_handler_t events_handle
         /* We have to change states before calling lower layer because ser_phy_open() function is
          * going to enable interrupts. On success an event from PHY layer can be emitted immediately
          * after return from ser_phy_open(). */
+        memset((void *)m_rx_buf_state, HAL_TRANSP_RX_BUF_STATE_FREE, sizeof (m_rx_buf_state));
+        m_tx_alloc_cnt    = 0;
+        m_tx_queued_cnt   = 0;
+        m_tx_started_cnt  = 0;
+        m_tx_released_cnt = 0;
+
         m_rx_state = HAL_TRANSP_RX_STATE_IDLE;
-        m_tx_state = HAL_TRANSP_TX_STATE_IDLE;
+        m_tx_state = HAL_TRANSP_TX_STATE_OPEN;
 
         m_events_handler = events_handler;
 
@@ -300,6 +414,7 @@ void ser_hal_transport_close(void)
 uint32_t ser_hal_transport_rx_pkt_free(uint8_t * p_buffer)
 {
     uint32_t err_code = NRF_SUCCESS;
+    uint32_t index    = rx_buffer_index_get(p_buffer);
 
     ser_phy_interrupts_disable();
 
@@ -307,21 +422,20 @@ uint32_t ser_hal_transport_rx_pkt_free(uint8_t * p_buffer)
     {
         err_code = NRF_ERROR_NULL;
     }
-    else if (p_buffer != m_rx_buffer)
+    else if (index >= SER_HAL_TRANSPORT_RX_PKT_COUNT)
     {
         err_code = NRF_ERROR_INVALID_ADDR;
     }
-    else if (HAL_TRANSP_RX_STATE_RECEIVED == m_rx_state)
+    else if (HAL_TRANSP_RX_BUF_STATE_RECEIVED != m_rx_buf_state[index])
     {
-        m_rx_state = HAL_TRANSP_RX_STATE_IDLE;
-    }
-    else if (HAL_TRANSP_RX_STATE_RECEIVED_DROPPING == m_rx_state)
-    {
-        m_rx_state = HAL_TRANSP_RX_STATE_DROPPING;
+        /* Upper layer should not call this function in current state. */
+        err_code = NRF_ERROR_INVALID_STATE;
     }
-    else if (HAL_TRANSP_RX_STATE_RECEIVED_PENDING_BUF_REQ == m_rx_state)
+    else if (HAL_TRANSP_RX_STATE_PENDING_BUF_REQ == m_rx_state)
     {
-        err_code = ser_phy_rx_buf_set(m_rx_buffer);
+        /* PHY layer is waiting for a buffer - pass the freed one directly. */
+        m_rx_buf_state[index] = HAL_TRANSP_RX_BUF_STATE_RECEIVING;
+        err_code              = ser_phy_rx_buf_set(p_buffer);
 
         if (NRF_SUCCESS == err_code)
         {
@@ -334,8 +448,7 @@ uint32_t ser_hal_transport_rx_pkt_free(uint8_t * p_buffer)
     }
     else
     {
-        /* Upper layer should not call this function in current state. */
-        err_code = NRF_ERROR_INVALID_STATE;
+        m_rx_buf_state[index] = HAL_TRANSP_RX_BUF_STATE_FREE;
     }
     ser_phy_interrupts_enable();
 
@@ -355,11 +468,13 @@ uint32_t ser_hal_transport_tx_pkt_alloc(uint8_t * * pp_memory, uint16_t * p_num_
     {
         err_code = NRF_ERROR_INVALID_STATE;
     }
-    else if (HAL_TRANSP_TX_STATE_IDLE == m_tx_state)
+    else if ((m_tx_alloc_cnt == m_tx_queued_cnt) &&
+             ((m_tx_alloc_cnt - m_tx_released_cnt) < SER_HAL_TRANSPORT_TX_PKT_COUNT))
     {
-        m_tx_state      = HAL_TRANSP_TX_STATE_TX_ALLOCATED;
-        *pp_memory      = &m_tx_buffer[0];
-        *p_num_of_bytes = (uint16_t)sizeof (m_tx_buffer);
+        /* Only one buffer can be allocated and not yet sent at a time. */
+        *pp_memory      = tx_buffer_get(m_tx_alloc_cnt);
+        *p_num_of_bytes = (uint16_t)SER_HAL_TRANSPORT_TX_MAX_PKT_SIZE;
+        m_tx_alloc_cnt++;
     }
     else
     {
@@ -384,25 +499,31 @@ uint32_t ser_hal_transport_tx_pkt_send(const uint8_t * p_buffer, uint16_t num_of
     {
         err_code = NRF_ERROR_INVALID_PARAM;
     }
-    else if (p_buffer != m_tx_buffer)
+    else if ((HAL_TRANSP_TX_STATE_CLOSED == m_tx_state) || (m_tx_alloc_cnt == m_tx_queued_cnt))
+    {
+        err_code = NRF_ERROR_INVALID_STATE;
+    }
+    else if (p_buffer != tx_buffer_get(m_tx_queued_cnt))
     {
         err_code = NRF_ERROR_INVALID_ADDR;
     }
-    else if (num_of_bytes > sizeof (m_tx_buffer))
+    else if (num_of_bytes > SER_HAL_TRANSPORT_TX_MAX_PKT_SIZE)
     {
         err_code = NRF_ERROR_DATA_SIZE;
     }
-    else if (HAL_TRANSP_TX_STATE_TX_ALLOCATED == m_tx_state)
+    else
     {
+        m_tx_length[m_tx_queued_cnt % SER_HAL_TRANSPORT_TX_PKT_COUNT] = num_of_bytes;
+
         ser_phy_interrupts_disable();
-        err_code = ser_phy_tx_pkt_send(p_buffer, num_of_bytes);
+        m_tx_queued_cnt++;
+        err_code = tx_queue_process();
 
-        if (NRF_SUCCESS == err_code)
-        {
-            m_tx_state = HAL_TRANSP_TX_STATE_TRANSMITTING;
-        }
-        else
+        if (NRF_SUCCESS != err_code)
         {
+            /* Packet stays allocated, so it can be sent again or freed. */
+            m_tx_queued_cnt--;
+
             if (NRF_ERROR_BUSY != err_code)
             {
                 err_code = NRF_ERROR_INTERNAL;
@@ -410,10 +531,6 @@ uint32_t ser_hal_transport_tx_pkt_send(const uint8_t * p_buffer, uint16_t num_of
         }
         ser_phy_interrupts_enable();
     }
-    else
-    {
-        err_code = NRF_ERROR_INVALID_STATE;
-    }
 
     return err_code;
 }
@@ -427,19 +544,18 @@ uint32_t ser_hal_transport_tx_pkt_free(uint8_t * p_buffer)
     {
         err_code = NRF_ERROR_NULL;
     }
-    else if (p_buffer != m_tx_buffer)
+    else if (m_tx_alloc_cnt == m_tx_queued_cnt)
     {
-        err_code = NRF_ERROR_INVALID_ADDR;
+        err_code = NRF_ERROR_INVALID_STATE;
     }
-    else if ((HAL_TRANSP_TX_STATE_TX_ALLOCATED == m_tx_state) ||
-             (HAL_TRANSP_TX_STATE_TRANSMITTED == m_tx_state))
+    else if (p_buffer != tx_buffer_get(m_tx_queued_cnt))
     {
-        /* Release TX buffer for use. */
-        m_tx_state = HAL_TRANSP_TX_STATE_IDLE;
+        err_code = NRF_ERROR_INVALID_ADDR;
     }
     else
     {
-        err_code = NRF_ERROR_INVALID_STATE;
+        /* Release TX buffer for use. */
+        m_tx_alloc_cnt--;
     }
 
     return err_code;
@@ -58,6 +58,12 @@
                                                          APP_TIMER_PRESCALER)) /**< Retransmission timeout for application packet in units of timer ticks. */
 #define MAX_RETRY_COUNT                 5                                      /**< Max retransmission retry count for application packets. */
 
+#define TX_WINDOW_SLOTS                 8                                      /**< Number of TX window slots, one for each 3-bit sequence number. */
+
+#if (SER_PHY_HCI_TX_WINDOW_SIZE < 1) || (SER_PHY_HCI_TX_WINDOW_SIZE > TX_WINDOW_SLOTS - 1)
+#error "SER_PHY_HCI_TX_WINDOW_SIZE must be 1 - 7, sequence numbers are 3 bits wide."
+#endif
+
 #if   (defined(HCI_TIMER0))
 #define HCI_TIMER            NRF_TIMER0
 #define HCI_TIMER_IRQn       TIMER0_IRQn
@@ -79,11 +85,7 @@
 typedef enum
 {
     HCI_TX_STATE_DISABLE,
-    HCI_TX_STATE_SEND,
-    HCI_TX_STATE_WAIT_FOR_FIRST_TX_END,
-    HCI_TX_STATE_WAIT_FOR_ACK_OR_TX_END,
-    HCI_TX_STATE_WAIT_FOR_ACK,
-    HCI_TX_STATE_WAIT_FOR_TX_END
+    HCI_TX_STATE_SEND
 } hci_tx_fsm_state_t;
 
 typedef enum
@@ -125,6 +127,13 @@ typedef struct
     ser_phy_int_evt_type_t evt_type; /**< Type of an event. */
 } ser_phy_int_evt_t;
 
+/**@brief A reliable packet in the TX window. */
+typedef struct
+{
+    uint8_t * p_payload; /**< Packet payload. */
+    uint16_t  length;    /**< Length of the payload in bytes. */
+} hci_tx_pkt_t;
+
 typedef struct
 {
     hci_evt_source_t evt_source; /**< source of an event. */
@@ -142,11 +151,32 @@ _static uint8_t m_tx_ack_packet[PKT_HDR_SIZE];
 
 
 _static uint32_t m_packet_ack_number; // Sequence number counter of the packet expected to be received
-_static uint32_t m_packet_seq_number; // Sequence number counter of the transmitted packet for which acknowledgement packet is waited for
 
 
 _static uint32_t m_tx_retry_count;
 
+// TX window. Packets are counted with free running counters; packet number n is sent with sequence
+// number (INITIAL_SEQ_NUMBER + n) mod 8 and is held in the slot of that sequence number until it is
+// acknowledged. The payload copies are used in turn, at most SER_PHY_HCI_TX_WINDOW_SIZE consecutive
+// packets are held at any time.
+_static hci_tx_pkt_t m_tx_window[TX_WINDOW_SLOTS];
+#if (SER_PHY_HCI_TX_WINDOW_SIZE > 1)
+_static uint8_t      m_tx_window_buf[SER_PHY_HCI_TX_WINDOW_SIZE][SER_HAL_TRANSPORT_MAX_PKT_SIZE];
+_static uint8_t      m_tx_window_buf_index; // Payload copy of the next packet accepted by ser_phy_tx_pkt_send.
+#endif
+
+_static uint32_t m_tx_queued_cnt;    // Packets accepted by ser_phy_tx_pkt_send.
+_static uint32_t m_tx_released_cnt;  // Packets reported to the upper layer as sent.
+_static uint32_t m_tx_requested_cnt; // Packets passed to the TX FSM.
+_static uint32_t m_tx_next_cnt;      // Number of the next packet to be transmitted.
+_static uint32_t m_tx_sent_cnt;      // Packets passed to the SLIP layer at least once.
+_static uint32_t m_tx_done_cnt;      // Packets transmitted completely at least once.
+_static uint32_t m_tx_acked_cnt;     // Packets acknowledged by the peer.
+_static uint32_t m_tx_slip_pkt;      // Number of the packet being transmitted by the SLIP layer.
+_static bool     m_tx_slip_busy;     // A packet from the window is being transmitted by the SLIP layer.
+_static bool     m_tx_timer_running; // Retransmission timer is running for the oldest unacknowledged packet.
+_static bool     m_tx_rewound;       // Transmission restarted from the oldest unacknowledged packet.
+
 
 // _static uint32_t m_tx_retx_counter = 0;
 // _static uint32_t m_rx_drop_counter = 0;
@@ -173,8 +203,8 @@ _static bool m_buffer_reqested_flag = false;
 _static uint8_t * m_p_rx_buffer = NULL;
 _static uint16_t  m_rx_packet_length;
 _static uint8_t * m_p_rx_packet;
-_static uint8_t * m_p_tx_payload = NULL;
-_static uint16_t  m_tx_payload_length;
+_static hci_evt_t m_rx_pending_evt;          // Packet received while an ACK was being transmitted.
+_static bool      m_rx_pending_flag = false;
 
 _static ser_phy_events_handler_t m_ser_phy_callback = NULL;
 
@@ -355,15 +385,15 @@ static __INLINE uint8_t packet_ack_get(void)
 }
 
 
-/**@brief Function for getting the sequence number of a reliable TX packet for which peer protocol
- * entity acknowledgment is pending.
+/**@brief Function for getting the sequence number of a reliable TX packet.
  *
- * @return sequence number of a reliable TX packet for which peer protocol entity acknowledgement
- * is pending.
+ * @param[in] pkt_number Number of the packet, counted from when the PHY was opened.
+ *
+ * @return sequence number of the packet.
  */
-static __INLINE uint8_t packet_seq_get(void)
+static __INLINE uint8_t packet_seq_get(uint32_t pkt_number)
 {
-    return m_packet_seq_number;
+    return (uint8_t)((INITIAL_SEQ_NUMBER + pkt_number) & 0x07u);
 }
 
 
@@ -374,13 +404,15 @@ static __INLINE uint8_t packet_seq_nmbr_extract(const uint8_t * p_buffer)
 
 
 /**@brief Function for constructing 1st byte of the packet header of the packet to be transmitted.
+ *
+ * @param[in] pkt_number Number of the packet to be transmitted.
  *
  * @return 1st byte of the packet header of the packet to be transmitted
  */
-static __INLINE uint8_t tx_packet_byte_zero_construct(void)
+static __INLINE uint8_t tx_packet_byte_zero_construct(uint32_t pkt_number)
 {
     const uint32_t value = DATA_INTEGRITY_MASK | RELIABLE_PKT_MASK |
-                           (packet_ack_get() << 3u) | packet_seq_get();
+                           (packet_ack_get() << 3u) | packet_seq_get(pkt_number);
 
     return (uint8_t) value;
 }
@@ -407,48 +439,19 @@ static __INLINE uint8_t header_checksum_calculate(const uint8_t * p_hdr)
 }
 
 
-/**@brief Function for getting the expected ACK number.
- *
- * @return expected ACK number.
- */
-static __INLINE uint8_t expected_ack_number_get(void)
-{
-    uint8_t seq_nmbr = packet_seq_get();
-
-    ++seq_nmbr;
-    seq_nmbr &= 0x07u;
-
-    return seq_nmbr;
-}
-
-
-/**@brief Function for getting the expected ACK number.
- *
- * @return next expected ACK number.
- */
-
-static __INLINE uint8_t next_expected_ack_number_get(void)
-{
-    uint8_t seq_nmbr = expected_ack_number_get();
-
-    ++seq_nmbr;
-    seq_nmbr &= 0x07u;
-
-    return seq_nmbr;
-}
-
-
 /**@brief Function for processing a received acknowledgement packet.
  *
- * Verifies does the received acknowledgement packet has the expected acknowledgement number and
- * that the header checksum is correct.
+ * Verifies the header checksum of the received acknowledgement packet and decodes how many packets
+ * of the TX window it acknowledges. The acknowledgement number is the sequence number of the next
+ * packet the peer expects, so it acknowledges all packets sent before it.
  *
- * @param[in] p_buffer Pointer to the packet data.
+ * @param[in]  p_buffer   Pointer to the packet data.
+ * @param[out] p_acked    Number of newly acknowledged packets. 0 if the peer still expects the
+ *                        oldest unacknowledged packet.
  *
  * @return true if valid acknowledgement packet received.
  */
-
-static bool rx_ack_pkt_valid(const uint8_t * p_buffer)
+static bool rx_ack_pkt_decode(const uint8_t * p_buffer, uint32_t * p_acked)
 {
     // @note: no pointer validation check needed as allready checked by calling function.
 
@@ -461,11 +464,17 @@ static bool rx_ack_pkt_valid(const uint8_t * p_buffer)
         return false;
     }
 
-    const uint8_t ack_number = (p_buffer[0] >> 3u) & 0x07u;
+    const uint8_t  ack_number = (p_buffer[0] >> 3u) & 0x07u;
+    const uint32_t acked      = (ack_number - packet_seq_get(m_tx_acked_cnt)) & 0x07u;
 
-    // Verify expected acknowledgment number.
-    return ( (ack_number == expected_ack_number_get()) ||
-             (ack_number == next_expected_ack_number_get()) );
+    // Verify that only packets which have been sent are acknowledged.
+    if (acked > (m_tx_sent_cnt - m_tx_acked_cnt))
+    {
+        return false;
+    }
+
+    *p_acked = acked;
+    return true;
 }
 
 
@@ -664,16 +673,17 @@ static void hci_slip_event_handler(ser_phy_hci_slip_evt_t * p_event)
 }
 
 
-static void hci_pkt_send(void)
+static void hci_pkt_send(uint32_t pkt_number)
 {
-    uint32_t err_code;
+    uint32_t             err_code;
+    const hci_tx_pkt_t * p_pkt = &m_tx_window[packet_seq_get(pkt_number)];
 
-    m_tx_packet_header[0] = tx_packet_byte_zero_construct();
-    uint16_t type_and_length_fields = ((m_tx_payload_length << 4u) | PKT_TYPE_VENDOR_SPECIFIC);
+    m_tx_packet_header[0] = tx_packet_byte_zero_construct(pkt_number);
+    uint16_t type_and_length_fields = ((p_pkt->length << 4u) | PKT_TYPE_VENDOR_SPECIFIC);
     (void)uint16_encode(type_and_length_fields, &(m_tx_packet_header[1]));
     m_tx_packet_header[3] = header_checksum_calculate(m_tx_packet_header);
     uint16_t crc = crc16_compute(m_tx_packet_header, PKT_HDR_SIZE, NULL);
-    crc = crc16_compute(m_p_tx_payload, m_tx_payload_length, &crc);
+    crc = crc16_compute(p_pkt->p_payload, p_pkt->length, &crc);
     (void)uint16_encode(crc, m_tx_packet_crc);
 
     ser_phy_hci_pkt_params_t pkt_header;
@@ -682,8 +692,8 @@ static void hci_pkt_send(void)
 
     pkt_header.p_buffer      = m_tx_packet_header;
     pkt_header.num_of_bytes  = PKT_HDR_SIZE;
-    pkt_payload.p_buffer     = m_p_tx_payload;
-    pkt_payload.num_of_bytes = m_tx_payload_length;
+    pkt_payload.p_buffer     = p_pkt->p_payload;
+    pkt_payload.num_of_bytes = p_pkt->length;
     pkt_crc.p_buffer         = m_tx_packet_crc;
     pkt_crc.num_of_bytes     = PKT_CRC_SIZE;
     DEBUG_EVT_SLIP_PACKET_TX(0);
@@ -694,17 +704,70 @@ static void hci_pkt_send(void)
 }
 
 
+/**@brief Function for transmitting the next packet of the TX window, if any.
+ *
+ * @details Only one packet is passed to the SLIP layer at a time, as the packet header and CRC
+ *          buffers are shared. The next packet is sent when the SLIP layer reports the end of the
+ *          transmission.
+ */
+static void hci_window_send(void)
+{
+    if (!m_tx_slip_busy && (m_tx_next_cnt != m_tx_requested_cnt))
+    {
+        m_tx_slip_busy = true;
+        m_tx_slip_pkt  = m_tx_next_cnt;
+        m_tx_next_cnt++;
+        if ((int32_t)(m_tx_next_cnt - m_tx_sent_cnt) > 0)
+        {
+            m_tx_sent_cnt = m_tx_next_cnt;
+        }
+        hci_pkt_send(m_tx_slip_pkt);
+    }
+}
+
+
+/**@brief Function for reporting transmitted packets to the upper layer.
+ *
+ * @details A packet is reported as sent once it has been transmitted and there is room in the TX
+ *          window for the next one, so that the upper layer can always pass the next packet on.
+ *          With a window of one packet this means when the packet has been acknowledged, and the
+ *          payload is not copied. A window slot is only reused when its packet is not being
+ *          retransmitted by the SLIP layer.
+ */
 static void hci_pkt_sent_upcall(void)
 {
-    m_packet_seq_number++; // incoming ACK is valid, increment SEQ
-    m_packet_seq_number &= 0x07u;
-    m_p_tx_payload       = NULL;
-    packet_transmitted_callback();
+    uint32_t free_cnt = m_tx_acked_cnt;
+
+    if (m_tx_slip_busy && ((int32_t)(m_tx_slip_pkt - free_cnt) < 0))
+    {
+        free_cnt = m_tx_slip_pkt;
+    }
+
+    while ((m_tx_released_cnt != m_tx_done_cnt) &&
+           ((m_tx_requested_cnt - free_cnt) < SER_PHY_HCI_TX_WINDOW_SIZE))
+    {
+        m_tx_released_cnt++;
+        packet_transmitted_callback();
+    }
 
     return;
 }
 
 
+/**@brief Function for restarting transmission from the oldest unacknowledged packet.
+ *
+ * @details The peer drops every packet received out of sequence, so all packets sent after a lost
+ *          one are sent again.
+ */
+static void hci_window_rewind(void)
+{
+    m_tx_next_cnt = m_tx_acked_cnt;
+    m_tx_rewound  = true;
+    DEBUG_HCI_RETX(0);
+    hci_window_send();
+}
+
+
 static void hci_release_ack_buffer(hci_evt_t * p_event)
 {
     uint32_t err_code;
@@ -717,123 +780,114 @@ static void hci_release_ack_buffer(hci_evt_t * p_event)
 }
 
 
-static void hci_process_orphaned_ack(hci_evt_t * p_event)
-{
-    hci_release_ack_buffer(p_event);
-    return;
-}
-
-
-/* main tx fsm   */
-static void hci_tx_fsm_event_process(hci_evt_t * p_event)
+/**@brief Function for processing a received acknowledgement packet in the TX FSM.
+ *
+ * @param[in] p_event Event with the received packet.
+ */
+static void hci_ack_process(hci_evt_t * p_event)
 {
+    uint32_t acked;
 
-    switch (m_hci_tx_fsm_state)
+    if (rx_ack_pkt_decode(p_event->evt.ser_phy_slip_evt.evt_params.received_pkt.p_buffer, &acked))
     {
-        case HCI_TX_STATE_SEND:
+        if (acked != 0)
+        {
+            m_tx_acked_cnt  += acked;
+            m_tx_retry_count = MAX_RETRY_COUNT;
+            m_tx_rewound     = false;
 
-            if ((p_event->evt_source == HCI_SER_PHY_EVT) &&
-                (p_event->evt.ser_phy_evt.evt_type == HCI_SER_PHY_TX_REQUEST))
+            if ((int32_t)(m_tx_next_cnt - m_tx_acked_cnt) < 0)
             {
-                hci_pkt_send();
-                hci_timeout_setup(0);
-                m_tx_retry_count   = MAX_RETRY_COUNT;
-                m_hci_tx_fsm_state = HCI_TX_STATE_WAIT_FOR_FIRST_TX_END;
+                // Packets to be sent again after a rewind have been acknowledged already.
+                m_tx_next_cnt = m_tx_acked_cnt;
             }
-            else if ((p_event->evt_source == HCI_SLIP_EVT) &&
-                     (p_event->evt.ser_phy_slip_evt.evt_type == SER_PHY_HCI_SLIP_EVT_PKT_RECEIVED))
-            {
-                hci_process_orphaned_ack(p_event);
-            }
-
-            break;
 
-        case HCI_TX_STATE_WAIT_FOR_FIRST_TX_END:
-
-            if ((p_event->evt_source == HCI_SLIP_EVT) &&
-                (p_event->evt.ser_phy_slip_evt.evt_type == SER_PHY_HCI_SLIP_EVT_PKT_SENT))
+            // Time the next unacknowledged packet, if any, from now on.
+            hci_timeout_setup(0);
+            m_tx_timer_running = false;
+            if ((m_tx_sent_cnt != m_tx_acked_cnt) && !m_tx_slip_busy)
             {
                 hci_timeout_setup(1);
-                m_hci_tx_fsm_state = HCI_TX_STATE_WAIT_FOR_ACK;
-            }
-            else if ((p_event->evt_source == HCI_SLIP_EVT) &&
-                     (p_event->evt.ser_phy_slip_evt.evt_type == SER_PHY_HCI_SLIP_EVT_PKT_RECEIVED))
-            {
-                hci_process_orphaned_ack(p_event);
+                m_tx_timer_running = true;
             }
-            break;
 
-        case HCI_TX_STATE_WAIT_FOR_ACK_OR_TX_END:
+            hci_pkt_sent_upcall();
+            hci_window_send();
+        }
+        else if ((m_tx_sent_cnt != m_tx_acked_cnt) && !m_tx_rewound)
+        {
+            // The peer received a packet out of sequence, so the oldest unacknowledged packet was
+            // lost. Send it again without waiting for the timeout. Acknowledgements for the rest of
+            // the packets already in flight are ignored until the peer receives it.
+            hci_window_rewind();
+        }
+    }
+    hci_release_ack_buffer(p_event);
+}
 
-            if ((p_event->evt_source == HCI_SLIP_EVT) &&
-                (p_event->evt.ser_phy_slip_evt.evt_type == SER_PHY_HCI_SLIP_EVT_PKT_SENT))
-            {
-                hci_timeout_setup(1);
-                m_hci_tx_fsm_state = HCI_TX_STATE_WAIT_FOR_ACK;
-            }
-            else if ((p_event->evt_source == HCI_SLIP_EVT) &&
-                     (p_event->evt.ser_phy_slip_evt.evt_type == SER_PHY_HCI_SLIP_EVT_PKT_RECEIVED))
-            {
-                if (rx_ack_pkt_valid(p_event->evt.ser_phy_slip_evt.evt_params.received_pkt.p_buffer))
-                {
-                    hci_timeout_setup(0);
-                    m_hci_tx_fsm_state = HCI_TX_STATE_WAIT_FOR_TX_END;
-                }
-                hci_release_ack_buffer(p_event);
-            }
-            break;
 
-        case HCI_TX_STATE_WAIT_FOR_ACK:
+/* main tx fsm   */
+static void hci_tx_fsm_event_process(hci_evt_t * p_event)
+{
+    if (m_hci_tx_fsm_state != HCI_TX_STATE_SEND)
+    {
+        ser_phy_hci_assert(false);
+        return;
+    }
 
-            if ((p_event->evt_source == HCI_SLIP_EVT) &&
-                (p_event->evt.ser_phy_slip_evt.evt_type == SER_PHY_HCI_SLIP_EVT_PKT_RECEIVED))
-            {
-                if (rx_ack_pkt_valid(p_event->evt.ser_phy_slip_evt.evt_params.received_pkt.p_buffer))
-                {
-                    hci_timeout_setup(0);
-                    hci_pkt_sent_upcall();
-                    m_hci_tx_fsm_state = HCI_TX_STATE_SEND;
-                }
-                hci_release_ack_buffer(p_event);
-            }
-            else if (p_event->evt_source == HCI_TIMER_EVT)
-            {
-                m_tx_retry_count--;
+    if ((p_event->evt_source == HCI_SER_PHY_EVT) &&
+        (p_event->evt.ser_phy_evt.evt_type == HCI_SER_PHY_TX_REQUEST))
+    {
+        if (m_tx_requested_cnt == m_tx_acked_cnt)
+        {
+            m_tx_retry_count = MAX_RETRY_COUNT;
+        }
+        m_tx_requested_cnt++;
+        hci_window_send();
+    }
+    else if ((p_event->evt_source == HCI_SLIP_EVT) &&
+             (p_event->evt.ser_phy_slip_evt.evt_type == SER_PHY_HCI_SLIP_EVT_PKT_SENT))
+    {
+        m_tx_slip_busy = false;
 
-                // m_tx_retx_counter++; // global retransmissions counter
-                if (m_tx_retry_count)
-                {
-                    hci_pkt_send();
-                    DEBUG_HCI_RETX(0);
-                    m_hci_tx_fsm_state = HCI_TX_STATE_WAIT_FOR_ACK_OR_TX_END;
-                }
-                else
-                {
-                    error_callback();
-                    m_hci_tx_fsm_state = HCI_TX_STATE_SEND;
-                }
-            }
-            break;
+        if ((int32_t)(m_tx_slip_pkt + 1 - m_tx_done_cnt) > 0)
+        {
+            m_tx_done_cnt = m_tx_slip_pkt + 1;
+        }
 
-        case HCI_TX_STATE_WAIT_FOR_TX_END:
+        if ((m_tx_sent_cnt != m_tx_acked_cnt) && !m_tx_timer_running)
+        {
+            hci_timeout_setup(1);
+            m_tx_timer_running = true;
+        }
 
-            if ((p_event->evt_source == HCI_SLIP_EVT) &&
-                (p_event->evt.ser_phy_slip_evt.evt_type == SER_PHY_HCI_SLIP_EVT_PKT_SENT))
+        hci_pkt_sent_upcall();
+        hci_window_send();
+    }
+    else if ((p_event->evt_source == HCI_SLIP_EVT) &&
+             (p_event->evt.ser_phy_slip_evt.evt_type == SER_PHY_HCI_SLIP_EVT_PKT_RECEIVED))
+    {
+        hci_ack_process(p_event);
+    }
+    else if (p_event->evt_source == HCI_TIMER_EVT)
+    {
+        hci_timeout_setup(0);
+        m_tx_timer_running = false;
+
+        if (m_tx_sent_cnt != m_tx_acked_cnt)
+        {
+            m_tx_retry_count--;
+
+            // m_tx_retx_counter++; // global retransmissions counter
+            if (m_tx_retry_count)
             {
-                hci_pkt_sent_upcall();
-                m_hci_tx_fsm_state = HCI_TX_STATE_SEND;
+                hci_window_rewind();
             }
-            else if ((p_event->evt_source == HCI_SLIP_EVT) &&
-                     (p_event->evt.ser_phy_slip_evt.evt_type == SER_PHY_HCI_SLIP_EVT_PKT_RECEIVED))
+            else
             {
-                hci_process_orphaned_ack(p_event);
+                error_callback();
             }
-
-            break;
-
-        default:
-            ser_phy_hci_assert(false);
-            break;
+        }
     }
 }
 
@@ -856,6 +910,40 @@ static void hci_inc_ack()
 }
 
 
+static void hci_rx_fsm_event_process(hci_evt_t * p_event);
+
+
+/**@brief Function for returning the RX FSM to the receive state.
+ *
+ * @details A packet which was received while an ACK was being transmitted is processed now. The
+ *          peer can send the next packet without waiting for the ACK when its TX window is larger
+ *          than one packet.
+ */
+static void hci_rx_receive_resume(void)
+{
+    m_hci_rx_fsm_state = HCI_RX_STATE_RECEIVE;
+
+    if (m_rx_pending_flag)
+    {
+        m_rx_pending_flag = false;
+        hci_rx_fsm_event_process(&m_rx_pending_evt);
+    }
+}
+
+
+/**@brief Function for keeping a packet received while an ACK is being transmitted.
+ *
+ * @param[in] p_event Event with the received packet.
+ */
+static void hci_rx_pending_set(hci_evt_t * p_event)
+{
+    // The SLIP layer holds no more packets until this one is freed.
+    ser_phy_hci_assert(!m_rx_pending_flag);
+    m_rx_pending_evt  = *p_event;
+    m_rx_pending_flag = true;
+}
+
+
 static void hci_rx_fsm_event_process(hci_evt_t * p_event)
 {
     switch (m_hci_rx_fsm_state)
@@ -878,7 +966,8 @@ static void hci_rx_fsm_event_process(hci_evt_t * p_event)
                 {
                     // m_rx_drop_counter++;
                     m_hci_rx_fsm_state = HCI_RX_STATE_WAIT_FOR_SLIP_NACK_END;
-                    (void) ser_phy_hci_slip_rx_buf_free(m_p_rx_packet); // and drop a packet
+                    (void) ser_phy_hci_slip_rx_buf_free(               // and drop a packet
+                        p_event->evt.ser_phy_slip_evt.evt_params.received_pkt.p_buffer);
                     ack_transmit();                                     // send NACK with valid ACK
                 }
             }
@@ -918,12 +1007,27 @@ static void hci_rx_fsm_event_process(hci_evt_t * p_event)
                 {
                     packet_dropped_callback();
                 }
-                m_hci_rx_fsm_state = HCI_RX_STATE_RECEIVE;
+                hci_rx_receive_resume();
+            }
+            else if ((p_event->evt_source == HCI_SLIP_EVT) &&
+                     (p_event->evt.ser_phy_slip_evt.evt_type == SER_PHY_HCI_SLIP_EVT_PKT_RECEIVED))
+            {
+                hci_rx_pending_set(p_event);
             }
             break;
 
         case HCI_RX_STATE_WAIT_FOR_SLIP_NACK_END:
-            m_hci_rx_fsm_state = HCI_RX_STATE_RECEIVE;
+
+            if ((p_event->evt_source == HCI_SLIP_EVT) &&
+                (p_event->evt.ser_phy_slip_evt.evt_type == SER_PHY_HCI_SLIP_EVT_ACK_SENT))
+            {
+                hci_rx_receive_resume();
+            }
+            else if ((p_event->evt_source == HCI_SLIP_EVT) &&
+                     (p_event->evt.ser_phy_slip_evt.evt_type == SER_PHY_HCI_SLIP_EVT_PKT_RECEIVED))
+            {
+                hci_rx_pending_set(p_event);
+            }
             break;
 
         default:
@@ -1169,20 +1273,35 @@ uint32_t ser_phy_tx_pkt_send(const uint8_t * p_buffer, uint16_t num_of_bytes)
         return NRF_ERROR_NULL;
     }
 
-    if ( m_p_tx_payload == NULL)
+    if (m_tx_queued_cnt != m_tx_released_cnt)
     {
-        m_tx_payload_length = num_of_bytes;
-        m_p_tx_payload      = (uint8_t *)p_buffer;
-        DEBUG_EVT_TX_REQ(0);
-        event.evt_source               = HCI_SER_PHY_EVT;
-        event.evt.ser_phy_evt.evt_type = HCI_SER_PHY_TX_REQUEST;
-        hci_tx_event_handler(&event);
+        return NRF_ERROR_BUSY;
     }
-    else
+
+    hci_tx_pkt_t * p_pkt = &m_tx_window[packet_seq_get(m_tx_queued_cnt)];
+
+#if (SER_PHY_HCI_TX_WINDOW_SIZE > 1)
+    // The packet is reported as sent before it is acknowledged, so keep a copy for retransmission.
+    if (num_of_bytes > SER_HAL_TRANSPORT_MAX_PKT_SIZE)
     {
-        status = NRF_ERROR_BUSY;
+        return NRF_ERROR_INVALID_PARAM;
     }
 
+    p_pkt->p_payload = m_tx_window_buf[m_tx_window_buf_index];
+    memcpy(p_pkt->p_payload, p_buffer, num_of_bytes);
+
+    m_tx_window_buf_index = (m_tx_window_buf_index + 1) % SER_PHY_HCI_TX_WINDOW_SIZE;
+#else
+    p_pkt->p_payload = (uint8_t *)p_buffer;
+#endif
+    p_pkt->length = num_of_bytes;
+    m_tx_queued_cnt++;
+
+    DEBUG_EVT_TX_REQ(0);
+    event.evt_source               = HCI_SER_PHY_EVT;
+    event.evt.ser_phy_evt.evt_type = HCI_SER_PHY_TX_REQUEST;
+    hci_tx_event_handler(&event);
+
     return status;
 }
 
@@ -1278,8 +1397,21 @@ uint32_t ser_phy_open(ser_phy_events_handler_t events_handler)
     if (err_code == NRF_SUCCESS)
     {
         m_packet_ack_number = INITIAL_ACK_NUMBER_EXPECTED;
-        m_packet_seq_number = INITIAL_SEQ_NUMBER;
+        m_tx_queued_cnt     = 0;
+        m_tx_released_cnt   = 0;
+        m_tx_requested_cnt  = 0;
+        m_tx_next_cnt       = 0;
+        m_tx_sent_cnt       = 0;
+        m_tx_done_cnt       = 0;
+        m_tx_acked_cnt      = 0;
+#if (SER_PHY_HCI_TX_WINDOW_SIZE > 1)
+        m_tx_window_buf_index = 0;
+#endif
+        m_tx_slip_busy      = false;
+        m_tx_timer_running  = false;
+        m_tx_rewound        = false;
         m_hci_tx_fsm_state  = HCI_TX_STATE_SEND;
+        m_rx_pending_flag   = false;
         m_hci_rx_fsm_state  = HCI_RX_STATE_RECEIVE;
         m_ser_phy_callback  = events_handler;
     }
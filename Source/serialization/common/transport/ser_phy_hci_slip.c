@@ -40,6 +40,7 @@
 #include "nrf_error.h"
 #include "nrf_gpio.h"
 #include "app_uart.h"
+#include "slip.h"
 #include "ser_phy_hci.h"
 
 #include "app_util_platform.h"
@@ -53,15 +54,12 @@
 
 #include "ser_config.h"
 
-#define APP_SLIP_END     0xC0 /**< SLIP code for identifying the beginning and end of a packet frame.. */
-#define APP_SLIP_ESC     0xDB /**< SLIP escape code. This code is used to specify that the following character is specially encoded. */
-#define APP_SLIP_ESC_END 0xDC /**< SLIP special code. When this code follows 0xDB, this character is interpreted as payload data 0xC0.. */
-#define APP_SLIP_ESC_ESC 0xDD /**< SLIP special code. When this code follows 0xDB, this character is interpreted as payload data 0xDB. */
-
 #define HDR_SIZE 4
 #define CRC_SIZE 2
 #define PKT_SIZE (SER_HAL_TRANSPORT_MAX_PKT_SIZE + HDR_SIZE + CRC_SIZE)
 
+#define TX_CHUNK_SIZE 16 /**< Size of the buffer for SLIP encoded bytes waiting to be transferred to the UART. */
+
 static const app_uart_comm_params_t comm_params =
 {
     .rx_pin_no  = SER_PHY_UART_RX,
@@ -79,7 +77,6 @@ static uint8_t m_big_buffer[PKT_SIZE];
 
 static uint8_t * mp_small_buffer = NULL;
 static uint8_t * mp_big_buffer   = NULL;
-static uint8_t * mp_buffer       = NULL;
 
 static ser_phy_hci_pkt_params_t m_header;
 static ser_phy_hci_pkt_params_t m_payload;
@@ -94,19 +91,20 @@ static ser_phy_hci_slip_event_handler_t m_ser_phy_hci_slip_event_handler; /**< E
 static bool    m_other_side_active = false; /**< Flag indicating that the other side is running */
 static uint8_t m_rx_byte;                   /**< Rx byte passed from low-level driver */
 
-static bool m_rx_escape = false;
-static bool m_tx_escape = false;
-
 static bool m_tx_busy = false; /**< Flag indicating that currently some transmission is ongoing */
 
-static uint32_t                   m_tx_index;
-static uint32_t                   m_rx_index;
-static ser_phy_hci_pkt_params_t * mp_data = NULL;
+static slip_encoder_t             m_tx_encoder;              /**< SLIP encoder of the packet part being transmitted */
+static ser_phy_hci_pkt_params_t * mp_data = NULL;            /**< Packet part being transmitted */
+static uint8_t                    m_tx_chunk[TX_CHUNK_SIZE]; /**< SLIP encoded bytes to transfer to the UART */
+static uint32_t                   m_tx_chunk_length;         /**< Number of bytes in m_tx_chunk */
+static uint32_t                   m_tx_chunk_index;          /**< Index of the next byte of m_tx_chunk to transfer */
+static bool                       m_tx_end_encoded;          /**< The SLIP end byte of the packet has been added to m_tx_chunk */
+
+static slip_decoder_t             m_rx_decoder;              /**< SLIP decoder of the packet being received */
 
 /* Function declarations */
 static uint32_t ser_phy_hci_tx_byte(void);
-static bool     slip_decode(uint8_t * p_received_byte);
-static void     ser_phi_hci_rx_byte(uint8_t rx_byte);
+static void     ser_phy_hci_rx_data(const uint8_t * p_data, uint32_t length);
 // ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 static __INLINE void callback_hw_error(uint32_t error_src)
@@ -119,24 +117,49 @@ static __INLINE void callback_hw_error(uint32_t error_src)
 }
 
 
-static __INLINE void slip_encode(void)
+/* Start transmission of the packet in m_header, m_payload and m_crc - the packet starts with 0xC0*/
+static void tx_packet_start(void)
 {
-    switch (mp_data->p_buffer[m_tx_index])
-    {
-        case APP_SLIP_END:
-            m_tx_escape = true;
-            (void)app_uart_put(APP_SLIP_ESC);
-            break;
+    mp_data = &m_header;
+    slip_encoder_init(&m_tx_encoder, m_header.p_buffer, m_header.num_of_bytes);
 
-        case APP_SLIP_ESC:
-            m_tx_escape = true;
-            (void)app_uart_put(APP_SLIP_ESC);
-            break;
+    m_tx_chunk[0]     = SLIP_END;
+    m_tx_chunk_length = 1;
+    m_tx_chunk_index  = 0;
+    m_tx_end_encoded  = false;
+}
 
-        default:
-            (void)app_uart_put(mp_data->p_buffer[m_tx_index]);
-            m_tx_index++;
-            break;
+
+/* Fill m_tx_chunk with the next SLIP encoded bytes of the packet - header, payload and CRC.
+ * Packet without payload (ACK) consists of the header only. The packet ends with 0xC0*/
+static void tx_chunk_fill(void)
+{
+    m_tx_chunk_length = 0;
+    m_tx_chunk_index  = 0;
+
+    while (!m_tx_end_encoded && (m_tx_chunk_length < sizeof (m_tx_chunk)))
+    {
+        if (!slip_encoder_is_done(&m_tx_encoder))
+        {
+            m_tx_chunk_length += slip_encode(&m_tx_encoder,
+                                             &m_tx_chunk[m_tx_chunk_length],
+                                             sizeof (m_tx_chunk) - m_tx_chunk_length);
+        }
+        else if ((mp_data == &m_header) && (m_payload.p_buffer != NULL))
+        {
+            mp_data = &m_payload;
+            slip_encoder_init(&m_tx_encoder, m_payload.p_buffer, m_payload.num_of_bytes);
+        }
+        else if ((mp_data == &m_payload) && (m_crc.p_buffer != NULL))
+        {
+            mp_data = &m_crc;
+            slip_encoder_init(&m_tx_encoder, m_crc.p_buffer, m_crc.num_of_bytes);
+        }
+        else
+        {
+            m_tx_chunk[m_tx_chunk_length++] = SLIP_END;
+            m_tx_end_encoded                = true;
+        }
     }
 }
 
@@ -158,10 +181,10 @@ static __INLINE bool check_pending_tx()
         m_crc_pending.p_buffer         = NULL;
         m_crc_pending.num_of_bytes     = 0;
 
-        m_tx_index  = 0; // may be also done in ser_phy_hci_tx_byte???
         tx_continue = true;
 
         /* Start sending pending packet */
+        tx_packet_start();
         (void)ser_phy_hci_tx_byte();
     }
 
@@ -171,106 +194,32 @@ static __INLINE bool check_pending_tx()
 
 static uint32_t ser_phy_hci_tx_byte()
 {
-    /* Flags informing about actually transmited part of packet*/
-    static bool header  = false;
-    static bool payload = false;
-    static bool crc     = false;
-
-    static bool ack_end    = false;
-    static bool packet_end = false;
-
-    if (ack_end == true)
-    {
-        ack_end   = false;
-        m_tx_busy = check_pending_tx();
-        /* Report end of ACK transmission*/
-        m_ser_phy_hci_slip_event.evt_type = SER_PHY_HCI_SLIP_EVT_ACK_SENT;
-        m_ser_phy_hci_slip_event_handler(&m_ser_phy_hci_slip_event);
-
-    }
-    else if (packet_end == true)
-    {
-        packet_end = false;
-        m_tx_busy  = check_pending_tx();
-        /* Report end of packet transmission*/
-        m_ser_phy_hci_slip_event.evt_type = SER_PHY_HCI_SLIP_EVT_PKT_SENT;
-        m_ser_phy_hci_slip_event_handler(&m_ser_phy_hci_slip_event);
-
-    }
-    else if ((m_tx_index == 0) && !header && !payload && !crc)
-    {
-        /* Beginning of packet - sent 0xC0*/
-        header  = true;
-        mp_data = &m_header;
-        (void)app_uart_put(APP_SLIP_END);
-    }
-    else if ((m_tx_index == mp_data->num_of_bytes) && crc == true)
-    {
-        /* End of packet - sent 0xC0*/
-        (void)app_uart_put(APP_SLIP_END);
+    bool ack_end;
 
-        m_crc.p_buffer = NULL;
-        crc            = false;
-        m_tx_index     = 0;
-        packet_end     = true;
-    }
-    else if ((m_tx_index == mp_data->num_of_bytes) && header == true)
+    if (m_tx_chunk_index == m_tx_chunk_length)
     {
-        /* End of header transmission*/
-        m_tx_index = 0;
-
-        if (m_payload.p_buffer != NULL)
+        if (!m_tx_end_encoded)
         {
-            header  = false;
-            payload = true;
-            mp_data = &m_payload;
-
-            /* Handle every character in buffer accordingly to SLIP protocol*/
-            slip_encode();
+            tx_chunk_fill();
         }
         else
         {
-            /* End of ACK - sent 0xC0*/
-            (void)app_uart_put(APP_SLIP_END);
+            /* 0xC0 at the end of packet has been sent*/
+            ack_end            = (m_payload.p_buffer == NULL);
+            m_payload.p_buffer = NULL;
+            m_crc.p_buffer     = NULL;
+            m_tx_busy          = check_pending_tx();
+
+            /* Report end of ACK or packet transmission*/
+            m_ser_phy_hci_slip_event.evt_type = ack_end ? SER_PHY_HCI_SLIP_EVT_ACK_SENT
+                                                        : SER_PHY_HCI_SLIP_EVT_PKT_SENT;
+            m_ser_phy_hci_slip_event_handler(&m_ser_phy_hci_slip_event);
 
-            header  = false;
-            ack_end = true;
+            return NRF_SUCCESS;
         }
     }
-    else if ((m_tx_index == mp_data->num_of_bytes) && payload == true)
-    {
-        /* End of payload transmission*/
-        m_tx_index = 0;
 
-        m_payload.p_buffer = NULL;
-        payload            = false;
-        crc                = true;
-        mp_data            = &m_crc;
-
-        /* Handle every character in buffer accordingly to SLIP protocol*/
-        slip_encode();
-    }
-    else if (m_tx_escape == false)
-    {
-        /* Handle every character in buffer accordingly to SLIP protocol*/
-        slip_encode();
-    }
-    else if (m_tx_escape == true)
-    {
-        /* Send SLIP special code*/
-        m_tx_escape = false;
-
-        if (mp_data->p_buffer[m_tx_index] == APP_SLIP_END)
-        {
-            (void)app_uart_put(APP_SLIP_ESC_END);
-            m_tx_index++;
-        }
-        else
-        {
-            (void)app_uart_put(APP_SLIP_ESC_ESC);
-            m_tx_index++;
-        }
-    }
+    (void)app_uart_put(m_tx_chunk[m_tx_chunk_index++]);
 
     return NRF_SUCCESS;
 }
@@ -324,6 +273,7 @@ uint32_t ser_phy_hci_slip_tx_pkt_send(const ser_phy_hci_pkt_params_t * p_header,
     if (!m_tx_busy)
     {
         m_tx_busy = true;
+        tx_packet_start();
         (void)ser_phy_hci_tx_byte();
     }
 
@@ -334,115 +284,60 @@ uint32_t ser_phy_hci_slip_tx_pkt_send(const ser_phy_hci_pkt_params_t * p_header,
 }
 
 
-/* Function returns false when last byte in packet is detected.*/
-static bool slip_decode(uint8_t * p_received_byte)
+/* Function provides a buffer for the decoded packet when the current one is full. Reception starts
+ * in the small (ACK) buffer, and continues in the big (PKT) buffer if the packet does not fit.
+ * Function returns false when the packet cannot be received.*/
+static bool rx_buffer_switch(void)
 {
-    switch (*p_received_byte)
+    if (m_rx_decoder.p_buffer == NULL)
     {
-        case APP_SLIP_END:
-            return false;
-
-        case APP_SLIP_ESC:
-            m_rx_escape = true;
-            break;
-
-        case APP_SLIP_ESC_END:
-
-            if (m_rx_escape == true)
-            {
-                m_rx_escape      = false;
-                *p_received_byte = APP_SLIP_END;
-            }
-            break;
-
-        case APP_SLIP_ESC_ESC:
-
-            if (m_rx_escape == true)
-            {
-                m_rx_escape      = false;
-                *p_received_byte = APP_SLIP_ESC;
-            }
-            break;
-
-        /* Normal character - decoding not needed*/
-        default:
-            break;
-    }
-
-    return true;
-}
-
-
-static void ser_phi_hci_rx_byte(uint8_t rx_byte)
-{
-    static bool rx_sync         = false;
-    uint8_t     received_byte   = rx_byte;
-    static bool big_buff_in_use = false;
-
-    /* Test received byte for SLIP packet start: 0xC0*/
-    if (!rx_sync)
-    {
-        if (received_byte == APP_SLIP_END)
+        /* Beginning of packet - check if small (ACK) buffer is available*/
+        if (mp_small_buffer != NULL)
         {
-            m_rx_index = 0;
-            rx_sync    = true;
+            m_rx_decoder.p_buffer    = mp_small_buffer;
+            m_rx_decoder.buffer_size = sizeof (m_small_buffer);
+            return true;
         }
-        return;
     }
-
-    /* Additional check needed in case rx_sync flag was set by end of previous packet*/
-    if ((m_rx_index) == 0 && (received_byte == APP_SLIP_END))
+    else if (m_rx_decoder.p_buffer != mp_small_buffer)
     {
-        return;
+        /* Big buffer is full - the packet is too big and cannot be handled by slip */
+        return false;
     }
 
-    /* Check if small (ACK) buffer is available*/
-    if ((mp_small_buffer != NULL) && (big_buff_in_use == false))
+    /* Check if big (PKT) buffer is available*/
+    if (mp_big_buffer != NULL)
     {
-        if (m_rx_index == 0)
+        /* Switch to big buffer, move the bytes already received in the small buffer*/
+        if (m_rx_decoder.p_buffer != NULL)
         {
-            mp_buffer = mp_small_buffer;
+            memcpy(m_big_buffer, m_rx_decoder.p_buffer, m_rx_decoder.length);
         }
+        m_rx_decoder.p_buffer    = mp_big_buffer;
+        m_rx_decoder.buffer_size = sizeof (m_big_buffer);
+        return true;
+    }
 
-        /* Check if switch between small and big buffer is needed*/
-        if (m_rx_index == sizeof (m_small_buffer) /*NEW!!!*/ && received_byte != APP_SLIP_END)
-        {
-            /* Check if big (PKT) buffer is available*/
-            if (mp_big_buffer != NULL)
-            {
-                /* Switch to big buffer*/
-                memcpy(m_big_buffer, m_small_buffer, sizeof (m_small_buffer));
-                mp_buffer = m_big_buffer;
-            }
-            else
-            {
-                /* Small buffer is too small and big buffer not available - cannot continue reception*/
-                rx_sync = false;
-                return;
-            }
-        }
+    return false;
+}
 
-        /* Check if big buffer is full */
-        if ((m_rx_index >= PKT_SIZE) && (received_byte != APP_SLIP_END))
-        {
-            /* Do not notify upper layer - the packet is too big and cannot be handled by slip */
-            rx_sync = false;
-            return;
-        }
 
-        /* Decode byte. Will return false when it is 0xC0 - end of packet*/
-        if (slip_decode(&received_byte))
-        {
-            /* Write Rx byte only if it is not escape char */
-            if (!m_rx_escape)
-            {
-                mp_buffer[m_rx_index++] = received_byte;
-            }
-        }
-        else
+static void ser_phy_hci_rx_data(const uint8_t * p_data, uint32_t length)
+{
+    uint32_t             consumed;
+    slip_decode_result_t result;
+
+    while (length != 0)
+    {
+        consumed = length;
+        result   = slip_decode(&m_rx_decoder, p_data, &consumed);
+        p_data  += consumed;
+        length  -= consumed;
+
+        if (result == SLIP_DECODE_FRAME_END)
         {
             /* Reset pointers to signalise buffers are locked waiting for upper layer */
-            if (mp_buffer == mp_small_buffer)
+            if (m_rx_decoder.p_buffer == mp_small_buffer)
             {
                 mp_small_buffer = NULL;
             }
@@ -453,59 +348,29 @@ static void ser_phi_hci_rx_byte(uint8_t rx_byte)
             /* Report packet reception end*/
             m_ser_phy_hci_slip_event.evt_type =
                 SER_PHY_HCI_SLIP_EVT_PKT_RECEIVED;
-            m_ser_phy_hci_slip_event.evt_params.received_pkt.p_buffer     = mp_buffer;
-            m_ser_phy_hci_slip_event.evt_params.received_pkt.num_of_bytes = m_rx_index;
-            m_ser_phy_hci_slip_event_handler(&m_ser_phy_hci_slip_event);
+            m_ser_phy_hci_slip_event.evt_params.received_pkt.p_buffer     = m_rx_decoder.p_buffer;
+            m_ser_phy_hci_slip_event.evt_params.received_pkt.num_of_bytes = m_rx_decoder.length;
 
-            rx_sync = false;
+            slip_decoder_init(&m_rx_decoder, NULL, 0);
+            m_ser_phy_hci_slip_event_handler(&m_ser_phy_hci_slip_event);
         }
-    }
-    else if (mp_big_buffer != NULL)
-    {
-        big_buff_in_use = true;
-        mp_buffer       = mp_big_buffer;
-
-        /* Check if big buffer is full */
-        if ((m_rx_index >= PKT_SIZE) && (received_byte != APP_SLIP_END))
+        else if ((result == SLIP_DECODE_BUFFER_FULL) && !rx_buffer_switch())
         {
-            /* Do not notify upper layer - the packet is too big and cannot be handled by slip */
-            rx_sync = false;
-            return;
-        }
+            /* Cannot continue reception - drop the packet and wait for the next 0xC0*/
+            bool stall = (m_rx_decoder.p_buffer == NULL);
 
-        /* Decode byte*/
-        if (slip_decode(&received_byte))
-        {
-            /* Write Rx byte only if it is not escape char */
-            if (!m_rx_escape)
+            slip_decoder_init(&m_rx_decoder, NULL, 0);
+            p_data++;
+            length--;
+
+            if (stall)
             {
-                mp_buffer[m_rx_index++] = received_byte;
+                /* Both buffers are not available - block RXRDY interrupts at this point*/
+                NRF_UART0->INTENCLR = (UART_INTENCLR_RXDRDY_Clear << UART_INTENCLR_RXDRDY_Pos);
+                return;
             }
         }
-        else
-        {
-            /* Report packet reception end*/
-            m_ser_phy_hci_slip_event.evt_type =
-                SER_PHY_HCI_SLIP_EVT_PKT_RECEIVED;
-            m_ser_phy_hci_slip_event.evt_params.received_pkt.p_buffer     = mp_buffer;
-            m_ser_phy_hci_slip_event.evt_params.received_pkt.num_of_bytes = m_rx_index;
-            m_ser_phy_hci_slip_event_handler(&m_ser_phy_hci_slip_event);
-
-            rx_sync         = false;
-            mp_big_buffer   = NULL;
-            big_buff_in_use = false;
-        }
     }
-    else
-    {
-        /* Both buffers are not available - cannot continue reception*/
-        rx_sync = false;
-
-        /* Block RXRDY interrupts at this point*/
-        NRF_UART0->INTENCLR = (UART_INTENCLR_RXDRDY_Clear << UART_INTENCLR_RXDRDY_Pos);
-        return;
-    }
-
 }
 
 
@@ -587,7 +452,7 @@ static void ser_phy_uart_evt_callback(app_uart_evt_t * uart_evt)
             }
 
             m_rx_byte = uart_evt->data.value;
-            ser_phi_hci_rx_byte(m_rx_byte);
+            ser_phy_hci_rx_data(&m_rx_byte, 1);
             break;
 
         default:
@@ -618,6 +483,7 @@ uint32_t ser_phy_hci_slip_open(ser_phy_hci_slip_event_handler_t events_handler)
 
     mp_small_buffer = m_small_buffer;
     mp_big_buffer   = m_big_buffer;
+    slip_decoder_init(&m_rx_decoder, NULL, 0);
 
     m_ser_phy_hci_slip_event_handler = events_handler;
 
@@ -12,12 +12,15 @@
 #include <stddef.h>
 
 #include "ble_serialization.h"
+#include "ser_config.h"
 #include "nrf_soc.h"
 #include "ble.h"
 #include "ble_l2cap.h"
 #include "ble_gap.h"
 #include "ble_gattc.h"
 #include "ble_gatts.h"
+#include "conn_mw.h"
+#include "conn_mw_stats_conn.h"
 
 /**@brief Connectivity middleware handler type. */
 typedef uint32_t (*conn_mw_handler_t)(uint8_t const * const p_rx_buf,
@@ -25,36 +28,38 @@ typedef uint32_t (*conn_mw_handler_t)(uint8_t const * const p_rx_buf,
                                       uint8_t * const       p_tx_buf,
                                       uint32_t * const      p_tx_buf_len);
 
-/**@brief Connectivity middleware item. */
-typedef struct
-{
-    uint8_t           opcode;     /**< Opcode by which specific codec is identified */
-    conn_mw_handler_t fp_handler; /**< Function pointer to handler associated with given opcode */
-} conn_mw_item_t;
+/**@brief Number of entries in the handlers table - one for every possible opcode. */
+#define CONN_MW_OPCODE_COUNT 256
 
 /* Include handlers for given softdevice */
 #include "conn_mw_items.c"
 
-/**@brief Number of registered connectivity middleware handlers. */
-static const uint32_t conn_mw_item_len = sizeof (conn_mw_item) / sizeof (conn_mw_item[0]);
+#if SER_CONN_MW_STATS_ENABLED
+/**@brief Statistics of every opcode. */
+static ser_conn_mw_stats_t m_conn_mw_stats[CONN_MW_OPCODE_COUNT];
 
-/**@brief Local function for finding connectivity middleware handler in the table.. */
-static conn_mw_handler_t conn_mw_handler_get(uint8_t opcode)
+uint32_t conn_mw_stats_get(uint8_t const * const p_rx_buf,
+                           uint32_t              rx_buf_len,
+                           uint8_t * const       p_tx_buf,
+                           uint32_t * const      p_tx_buf_len)
 {
-    conn_mw_handler_t fp_handler = NULL;
-    uint32_t          i;
+    SER_ASSERT_NOT_NULL(p_rx_buf);
+    SER_ASSERT_NOT_NULL(p_tx_buf);
+    SER_ASSERT_NOT_NULL(p_tx_buf_len);
 
-    for (i = 0; i < conn_mw_item_len; i++)
-    {
-        if (opcode == conn_mw_item[i].opcode)
-        {
-            fp_handler = conn_mw_item[i].fp_handler;
-            break;
-        }
-    }
+    uint8_t  opcode;
+    uint32_t err_code = NRF_SUCCESS;
+
+    err_code = conn_mw_stats_get_req_dec(p_rx_buf, rx_buf_len, &opcode);
+    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
 
-    return fp_handler;
+    err_code = conn_mw_stats_get_rsp_enc(NRF_SUCCESS, p_tx_buf, p_tx_buf_len,
+                                         &m_conn_mw_stats[opcode]);
+    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
+
+    return err_code;
 }
+#endif
 
 uint32_t conn_mw_handler(uint8_t const * const p_rx_buf,
                          uint32_t              rx_buf_len,
@@ -69,11 +74,19 @@ uint32_t conn_mw_handler(uint8_t const * const p_rx_buf,
     uint32_t          err_code = NRF_SUCCESS;
     uint8_t           opcode   = p_rx_buf[SER_CMD_OP_CODE_POS];
 
-    fp_handler = conn_mw_handler_get(opcode);
+    fp_handler = conn_mw_item[opcode];
 
     if (fp_handler)
     {
+#if SER_CONN_MW_STATS_ENABLED
+        uint32_t start = SER_CONN_MW_STATS_TIMESTAMP_GET();
+#endif
         err_code = fp_handler(p_rx_buf, rx_buf_len, p_tx_buf, p_tx_buf_len);
+#if SER_CONN_MW_STATS_ENABLED
+        m_conn_mw_stats[opcode].call_count++;
+        m_conn_mw_stats[opcode].ticks += (SER_CONN_MW_STATS_TIMESTAMP_GET() - start) &
+                                         SER_CONN_MW_STATS_TIMESTAMP_MASK;
+#endif
     }
     else
     {
@@ -0,0 +1,73 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include "conn_mw_stats_conn.h"
+#include "nrf_error.h"
+#include "ble_serialization.h"
+
+uint32_t conn_mw_stats_get_req_dec(uint8_t const * const p_buf,
+                                   uint32_t              packet_len,
+                                   uint8_t * const       p_opcode)
+{
+    SER_ASSERT_NOT_NULL(p_buf);
+    SER_ASSERT_NOT_NULL(p_opcode);
+
+    uint32_t index    = 0;
+    uint32_t err_code = NRF_SUCCESS;
+
+    SER_ASSERT_LENGTH_LEQ(SER_OP_CODE_SIZE, packet_len);
+    SER_ASSERT(p_buf[index] == SER_CONN_MW_STATS_GET_OP_CODE, NRF_ERROR_INVALID_PARAM);
+    index++;
+
+    err_code = uint8_t_dec(p_buf, packet_len, &index, p_opcode);
+    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
+
+    SER_ASSERT_LENGTH_EQ(index, packet_len);
+
+    return err_code;
+}
+
+uint32_t conn_mw_stats_get_rsp_enc(uint32_t                          return_code,
+                                   uint8_t * const                   p_buf,
+                                   uint32_t * const                  p_buf_len,
+                                   ser_conn_mw_stats_t const * const p_stats)
+{
+    SER_ASSERT_NOT_NULL(p_buf);
+    SER_ASSERT_NOT_NULL(p_buf_len);
+
+    uint32_t total_len = *p_buf_len;
+    uint32_t err_code  = ser_ble_cmd_rsp_status_code_enc(SER_CONN_MW_STATS_GET_OP_CODE,
+                                                         return_code, p_buf, p_buf_len);
+
+    if (err_code != NRF_SUCCESS)
+    {
+        return err_code;
+    }
+
+    if (return_code != NRF_SUCCESS)
+    {
+        return NRF_SUCCESS;
+    }
+
+    SER_ASSERT_NOT_NULL(p_stats);
+    uint32_t index = *p_buf_len;
+
+    err_code = uint32_t_enc(&p_stats->call_count, p_buf, total_len, &index);
+    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
+
+    err_code = uint32_t_enc(&p_stats->ticks, p_buf, total_len, &index);
+    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
+
+    *p_buf_len = index;
+
+    return err_code;
+}
@@ -13,6 +13,7 @@
 #include "ble_gattc_evt_conn.h"
 #include <string.h>
 #include "ble_serialization.h"
+#include "ble_gattc_struct_serialization.h"
 #include "app_util.h"
 
 
@@ -22,29 +23,18 @@ uint32_t ble_gattc_evt_hvx_enc(ble_evt_t const * const p_event,
                                uint32_t * const        p_buf_len)
 {
     uint32_t index = 0;
+    uint32_t err_code;
 
     SER_ASSERT_NOT_NULL(p_event);
     SER_ASSERT_NOT_NULL(p_buf);
     SER_ASSERT_NOT_NULL(p_buf_len);
 
-    SER_ASSERT_LENGTH_LEQ(index + SER_EVT_HEADER_SIZE + 11, *p_buf_len);
-    index         += uint16_encode(BLE_GATTC_EVT_HVX, &(p_buf[index]));
-    index         += uint16_encode(p_event->evt.gattc_evt.conn_handle, &(p_buf[index]));
-    index         += uint16_encode(p_event->evt.gattc_evt.gatt_status, &(p_buf[index]));
-    index         += uint16_encode(p_event->evt.gattc_evt.error_handle, &(p_buf[index]));
-    index         += uint16_encode(p_event->evt.gattc_evt.params.hvx.handle, &(p_buf[index]));
-    p_buf[index++] = p_event->evt.gattc_evt.params.hvx.type;
-    index         += uint16_encode(p_event->evt.gattc_evt.params.hvx.len, &(p_buf[index]));
-
-    SER_ASSERT_LENGTH_LEQ(index + p_event->evt.gattc_evt.params.hvx.len, *p_buf_len);
-
-    if (p_event->evt.gattc_evt.params.hvx.len > 0)
-    {
-        memcpy(&(p_buf[index]),
-               &(p_event->evt.gattc_evt.params.hvx.data[0]),
-               p_event->evt.gattc_evt.params.hvx.len);
-        index += p_event->evt.gattc_evt.params.hvx.len;
-    }
+    SER_ASSERT_LENGTH_LEQ(SER_EVT_HEADER_SIZE, *p_buf_len);
+    index += uint16_encode(BLE_GATTC_EVT_HVX, &(p_buf[index]));
+
+    err_code = ser_struct_enc(&ble_gattc_evt_hvx_desc, &(p_event->evt.gattc_evt),
+                              p_buf, *p_buf_len, &index);
+    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
 
     *p_buf_len = index;
 
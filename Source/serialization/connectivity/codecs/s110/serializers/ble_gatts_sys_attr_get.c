@@ -88,7 +88,6 @@ uint32_t ble_gatts_sys_attr_get_rsp_enc(uint32_t               return_code,
         return NRF_SUCCESS;
     }
 
-    SER_ASSERT_NOT_NULL(p_sys_attr_data);
     SER_ASSERT_NOT_NULL(p_sys_attr_data_len);
     uint32_t index        = *p_buf_len;
     uint16_t sys_attr_len = 0;
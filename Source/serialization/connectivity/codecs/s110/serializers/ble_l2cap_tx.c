@@ -42,15 +42,22 @@ uint32_t ble_l2cap_tx_req_dec(uint8_t const * const        p_buf,
 
     SER_ASSERT(err_code == NRF_SUCCESS, err_code);
 
-    if (*pp_l2cap_header != NULL)
+    uint8_t is_present;
+    err_code = uint8_t_dec(p_buf, buf_len, &index, &is_present);
+    SER_ASSERT(err_code == NRF_SUCCESS, err_code);
+
+    if (is_present == SER_FIELD_PRESENT)
     {
-        *pp_data = p_buf + index + 1;
-        index   += 1 + (*pp_l2cap_header)->len;
+        uint16_t data_len = (*pp_l2cap_header != NULL) ? (*pp_l2cap_header)->len : 0;
+
+        SER_ASSERT_LENGTH_LEQ(data_len, buf_len - index);
+        *pp_data = p_buf + index;
+        index   += data_len;
     }
     else
     {
+        SER_ASSERT(is_present == SER_FIELD_NOT_PRESENT, NRF_ERROR_INVALID_DATA);
         *pp_data = NULL;
-        index++;
     }
 
     SER_ASSERT_LENGTH_EQ(index, buf_len);
@@ -76,7 +76,7 @@ uint32_t ble_opt_set_rsp_enc(uint32_t                return_code,
     SER_ASSERT_NOT_NULL(p_buf);
     SER_ASSERT_NOT_NULL(p_buf_len);
 
-    uint32_t err_code = ser_ble_cmd_rsp_status_code_enc(SD_BLE_OPT_GET, return_code,
+    uint32_t err_code = ser_ble_cmd_rsp_status_code_enc(SD_BLE_OPT_SET, return_code,
                                                         p_buf, p_buf_len);
 
     if (err_code != NRF_SUCCESS)
@@ -44,7 +44,6 @@ uint32_t temp_get_rsp_enc(uint32_t         return_code,
                           int32_t * const  p_temp)
 {
     SER_ASSERT_NOT_NULL(p_buf);
-    SER_ASSERT_NOT_NULL(p_temp);
     SER_ASSERT_NOT_NULL(p_buf_len);
 
     uint32_t index    = 0;
@@ -61,6 +60,8 @@ uint32_t temp_get_rsp_enc(uint32_t         return_code,
 
     if (return_code == NRF_SUCCESS)
     {
+        SER_ASSERT_NOT_NULL(p_temp);
+
         err_code = uint32_t_enc(p_temp, p_buf, total_len, &index);
         SER_ASSERT(err_code == NRF_SUCCESS, err_code);
     }
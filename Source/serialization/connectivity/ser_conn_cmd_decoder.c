@@ -14,6 +14,7 @@
 #include <string.h>
 #include "nordic_common.h"
 #include "app_error.h"
+#include "app_util.h"
 #include "ble_serialization.h"
 #include "ser_config.h"
 #include "conn_mw.h"
@@ -58,7 +59,8 @@ uint32_t ser_conn_command_process(uint8_t * p_command, uint16_t command_len)
                            (opcode, NRF_ERROR_NOT_SUPPORTED,
                            &p_tx_buf[SER_PKT_OP_CODE_POS], &tx_buf_len, &index);
         }
-        else if (NRF_SUCCESS == err_code) /* Send a response. */
+
+        if (NRF_SUCCESS == err_code) /* Send a response. */
         {
             tx_buf_len += SER_PKT_TYPE_SIZE;
             err_code    = ser_hal_transport_tx_pkt_send(p_tx_buf, (uint16_t)tx_buf_len);
@@ -81,3 +83,88 @@ uint32_t ser_conn_command_process(uint8_t * p_command, uint16_t command_len)
 
     return err_code;
 }
+
+uint32_t ser_conn_batch_process(uint8_t * p_batch, uint16_t batch_len)
+{
+    SER_ASSERT_NOT_NULL(p_batch);
+
+    uint32_t  err_code   = NRF_SUCCESS;
+    uint8_t * p_tx_buf   = NULL;
+    uint32_t  tx_buf_len = 0;
+    uint32_t  rx_index   = 0;
+    uint32_t  tx_index   = SER_PKT_TYPE_SIZE;
+
+    /* Allocate a memory buffer from HAL Transport layer for transmitting the Batch Response.
+     * Loop until a buffer is available. */
+    do
+    {
+        err_code = ser_hal_transport_tx_pkt_alloc(&p_tx_buf, (uint16_t *)&tx_buf_len);
+    }
+    while (NRF_ERROR_NO_MEM == err_code);
+
+    if (NRF_SUCCESS == err_code)
+    {
+        /* Create a new batch response packet. */
+        p_tx_buf[SER_PKT_TYPE_POS] = SER_PKT_TYPE_BATCH;
+
+        /* Execute next command only if there is room for the longest response allowed in a batch.
+         * A SoftDevice call can not be undone, so it must not be made if its response might be
+         * lost. */
+        while ((rx_index + SER_BATCH_ITEM_LEN_SIZE + SER_OP_CODE_SIZE <= batch_len) &&
+               (tx_index + SER_BATCH_ITEM_LEN_SIZE + SER_BATCH_RSP_MAX_SIZE <= tx_buf_len))
+        {
+            uint16_t  command_len = uint16_decode(&p_batch[rx_index]);
+            uint8_t * p_command   = &p_batch[rx_index + SER_BATCH_ITEM_LEN_SIZE];
+            uint8_t * p_rsp       = &p_tx_buf[tx_index + SER_BATCH_ITEM_LEN_SIZE];
+            uint32_t  rsp_len     = tx_buf_len - tx_index - SER_BATCH_ITEM_LEN_SIZE;
+            uint32_t  index       = 0;
+
+            rx_index += SER_BATCH_ITEM_LEN_SIZE;
+
+            if ((command_len < SER_OP_CODE_SIZE) || (rx_index + command_len > batch_len))
+            {
+                /* Malformed batch. Responses to commands executed so far are sent anyway. */
+                APP_ERROR_CHECK(SER_WARNING_CODE);
+                break;
+            }
+            rx_index += command_len;
+
+            /* Decode a request, pass a memory for a response command (opcode + data) and encode it. */
+            err_code = conn_mw_handler(p_command, command_len, p_rsp, &rsp_len);
+
+            /* Command decoder not found, command could not be decoded or its response (longer than
+             * SER_BATCH_RSP_MAX_SIZE) could not be encoded. Report it with a common response so
+             * the Application Chip can match the remaining responses. */
+            if (NRF_SUCCESS != err_code)
+            {
+                APP_ERROR_CHECK(SER_WARNING_CODE);
+                rsp_len  = tx_buf_len - tx_index - SER_BATCH_ITEM_LEN_SIZE;
+                err_code = op_status_enc
+                               (p_command[SER_CMD_OP_CODE_POS], err_code, p_rsp, &rsp_len, &index);
+
+                if (NRF_SUCCESS != err_code)
+                {
+                    break;
+                }
+            }
+
+            (void)uint16_encode((uint16_t)rsp_len, &p_tx_buf[tx_index]);
+            tx_index += SER_BATCH_ITEM_LEN_SIZE + rsp_len;
+        }
+
+        /* Send a batch response. */
+        err_code = ser_hal_transport_tx_pkt_send(p_tx_buf, (uint16_t)tx_index);
+
+        /* TX buffer is going to be freed automatically in the HAL Transport layer. */
+        if (NRF_SUCCESS != err_code)
+        {
+            err_code = NRF_ERROR_INTERNAL;
+        }
+    }
+    else
+    {
+        err_code = NRF_ERROR_INTERNAL;
+    }
+
+    return err_code;
+}
@@ -19,6 +19,7 @@
 #include "ser_hal_transport.h"
 
 static bool                          m_is_ready_to_enter_dtm = false;
+static uint8_t const *               mp_dtm_rsp_buf          = NULL;
 static app_uart_stream_comm_params_t m_comm_params           = { 0 };
 
 uint32_t ser_conn_dtm_command_process(uint8_t * p_command, uint16_t command_len)
@@ -57,7 +58,9 @@ uint32_t ser_conn_dtm_command_process(uint8_t * p_command, uint16_t command_len)
 
             tx_buf_len += SER_PKT_TYPE_SIZE;
 
-            /* Set a flag that device is ready to enter DTM mode. */
+            /* Set a flag that device is ready to enter DTM mode once the response is sent. Packets
+             * queued ahead of the response may be sent first. */
+            mp_dtm_rsp_buf          = p_tx_buf;
             m_is_ready_to_enter_dtm = true;
 
             err_code = ser_hal_transport_tx_pkt_send(p_tx_buf, (uint16_t)tx_buf_len);
@@ -78,9 +81,9 @@ uint32_t ser_conn_dtm_command_process(uint8_t * p_command, uint16_t command_len)
 }
 
 
-void ser_conn_is_ready_to_enter_dtm(void)
+void ser_conn_is_ready_to_enter_dtm(uint8_t const * p_sent_buf)
 {
-    if (m_is_ready_to_enter_dtm)
+    if (m_is_ready_to_enter_dtm && (p_sent_buf == mp_dtm_rsp_buf))
     {
         /* Disable SoftDevice. */
         (void)sd_softdevice_disable();
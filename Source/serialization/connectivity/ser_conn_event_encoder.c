@@ -56,13 +56,17 @@ void ser_conn_ble_event_encoder(void * p_event_data, uint16_t event_size)
         tx_buf_len += SER_PKT_TYPE_SIZE;
         err_code    = ser_hal_transport_tx_pkt_send(p_tx_buf, (uint16_t)tx_buf_len);
         APP_ERROR_CHECK(err_code);
-        /* TX buffer is going to be freed automatically in the HAL Transport layer.
-         * Scheduler must be paused because this function returns before a packet is physically sent
+        /* TX buffer is going to be freed automatically in the HAL Transport layer. */
+#if (SER_HAL_TRANSPORT_TX_PKT_COUNT == 1)
+        /* Scheduler must be paused because this function returns before a packet is physically sent
          * by transport layer. This can cause start processing of a next event from the application
          * scheduler queue. In result the next event reserves the TX buffer before the current
          * packet is sent. If in meantime a command arrives a command response cannot be sent in
-         * result. Pausing the scheduler temporary prevents processing a next event. */
+         * result. Pausing the scheduler temporary prevents processing a next event.
+         * With more TX buffers the next event is encoded while this one is being sent and a
+         * command response is queued behind it, so no pausing is needed. */
         app_sched_pause();
+#endif
     }
     else
     {
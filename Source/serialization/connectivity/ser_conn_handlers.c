@@ -45,12 +45,14 @@ void ser_conn_hal_transport_event_handle(ser_hal_transport_evt_t event)
     {
         case SER_HAL_TRANSP_EVT_TX_PKT_SENT:
         {
+#if (SER_HAL_TRANSPORT_TX_PKT_COUNT == 1)
             /* SoftDevice event or response to received packet was sent, so unblock the application
              * scheduler to process a next event. */
             app_sched_resume();
+#endif
 
             /* Check if chip is ready to enter DTM mode. */
-            ser_conn_is_ready_to_enter_dtm();
+            ser_conn_is_ready_to_enter_dtm(event.evt_params.tx_pkt_sent.p_buffer);
 
             break;
         }
@@ -77,6 +79,11 @@ void ser_conn_hal_transport_event_handle(ser_hal_transport_evt_t event)
 
         case SER_HAL_TRANSP_EVT_RX_PKT_DROPPED:
         {
+#if (SER_HAL_TRANSPORT_TX_PKT_COUNT > 1)
+            /* No response is going to be sent for a dropped packet, so unblock the application
+             * scheduler paused on SER_HAL_TRANSP_EVT_RX_PKT_RECEIVING. */
+            app_sched_resume();
+#endif
             APP_ERROR_CHECK(SER_WARNING_CODE);
             break;
         }
@@ -106,6 +113,12 @@ uint32_t ser_conn_rx_process(void)
          * to get next packet before sending a response. */
         m_rx_pkt_to_process = false;
         err_code            = ser_conn_received_pkt_process(&m_rx_pkt_received_params);
+
+#if (SER_HAL_TRANSPORT_TX_PKT_COUNT > 1)
+        /* A response is already queued in the HAL Transport layer ahead of any next event, so the
+         * application scheduler can be unblocked without waiting until it is sent. */
+        app_sched_resume();
+#endif
     }
 
     return err_code;
@@ -42,6 +42,12 @@ uint32_t ser_conn_received_pkt_process(
                 break;
             }
 
+            case SER_PKT_TYPE_BATCH:
+            {
+                err_code = ser_conn_batch_process(p_command, command_len);
+                break;
+            }
+
             case SER_PKT_TYPE_DTM_CMD:
             {
                 err_code = ser_conn_dtm_command_process(p_command, command_len);
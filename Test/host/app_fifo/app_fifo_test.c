@@ -0,0 +1,397 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/** @file
+ *
+ * @brief Test and benchmark of app_fifo.
+ *
+ * @details Test: a byte stream is passed through the FIFO with random mixes of single byte,
+ *          block and in-place (span) accesses of random size, and must come out unchanged. Full
+ *          and empty FIFO results of every access are checked. The stream is passed once with
+ *          both sides in the same thread, and once with a producer thread and a consumer thread
+ *          running concurrently, which is only safe with APP_FIFO_SPSC set on a multi-core host.
+ *
+ *          Benchmark: bytes per second through the FIFO with single byte accesses, with blocks and
+ *          with spans, and between the two threads.
+ *
+ *          Usage: app_fifo_test [-n bytes] [-s seed]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include "app_fifo.h"
+#include "nordic_common.h"
+#include "nrf_error.h"
+
+#define FIFO_SIZE     256                                   /**< Size of the FIFO buffer. */
+#define BLOCK_SIZE    64                                    /**< Size of the blocks in the benchmark. */
+
+/**@brief FIFO access types. */
+typedef enum
+{
+    ACCESS_BYTE,                                            /**< app_fifo_put() and app_fifo_get(). */
+    ACCESS_BLOCK,                                           /**< app_fifo_write() and app_fifo_read(). */
+    ACCESS_SPAN,                                            /**< app_fifo_peek_span() and app_fifo_commit() (read only). */
+    ACCESS_COUNT
+} access_t;
+
+static const char * const m_access_names[ACCESS_COUNT] = {"byte", "block", "span"};
+
+static app_fifo_t m_fifo;                                   /**< FIFO under test. */
+static uint8_t    m_fifo_buf[FIFO_SIZE];                    /**< FIFO buffer. */
+static uint32_t   m_errors;                                 /**< Number of failed checks, updated by both threads. */
+static bool       m_concurrent;                             /**< The other side of the FIFO runs in another thread. */
+
+
+/**@brief Function for getting host time in nanoseconds. */
+static uint64_t host_ns_get(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ull) + (uint64_t)ts.tv_nsec;
+}
+
+
+/**@brief Function for getting byte n of the test stream. */
+static uint8_t stream_byte(uint32_t n)
+{
+    return (uint8_t)((n * 7) + (n >> 8));
+}
+
+
+/**@brief Function for reporting a failed check. */
+static void check(bool ok, char const * p_what, uint32_t n)
+{
+    if (!ok && (__atomic_fetch_add(&m_errors, 1, __ATOMIC_RELAXED) < 10))
+    {
+        printf("stream byte %u: %s\n", (unsigned)n, p_what);
+    }
+}
+
+
+/**@brief Function for writing up to size bytes of the stream to the FIFO.
+ *
+ * @return Number of bytes written.
+ */
+static uint32_t stream_write(access_t access, uint32_t pos, uint32_t size)
+{
+    uint8_t  data[FIFO_SIZE];
+    uint32_t requested;
+    uint32_t free_size;
+    uint32_t err_code;
+    uint32_t i;
+
+    (void)app_fifo_write(&m_fifo, NULL, &free_size);
+    check(free_size <= FIFO_SIZE, "free size out of range", pos);
+
+    if (access == ACCESS_BYTE)
+    {
+        for (i = 0; i < size; i++)
+        {
+            // The other thread may free more room than reported.
+            err_code = app_fifo_put(&m_fifo, stream_byte(pos + i));
+            check((err_code == NRF_SUCCESS) || ((i >= free_size) && (err_code == NRF_ERROR_NO_MEM)),
+                  "put result", pos + i);
+            check((err_code != NRF_SUCCESS) || (i < free_size) || m_concurrent, "put result", pos + i);
+            if (err_code != NRF_SUCCESS)
+            {
+                break;
+            }
+        }
+        return i;
+    }
+
+    for (i = 0; i < size; i++)
+    {
+        data[i] = stream_byte(pos + i);
+    }
+    requested = size;
+    err_code  = app_fifo_write(&m_fifo, data, &size);
+    check((size >= MIN(requested, free_size)) && (size <= requested), "write size", pos);
+    check((size <= free_size) || m_concurrent, "write size", pos);
+    check(err_code == ((size != 0) ? NRF_SUCCESS : NRF_ERROR_NO_MEM), "write result", pos);
+
+    return size;
+}
+
+
+/**@brief Function for reading up to size bytes of the stream from the FIFO.
+ *
+ * @return Number of bytes read.
+ */
+static uint32_t stream_read(access_t access, uint32_t pos, uint32_t size)
+{
+    uint8_t   data[FIFO_SIZE];
+    uint8_t * p_data = data;
+    uint32_t  requested;
+    uint32_t  length;
+    uint32_t  err_code;
+    uint32_t  i;
+
+    (void)app_fifo_read(&m_fifo, NULL, &length);
+    check(length <= FIFO_SIZE, "length out of range", pos);
+
+    switch (access)
+    {
+        case ACCESS_BYTE:
+            for (i = 0; i < size; i++)
+            {
+                // The other thread may add more data than reported.
+                err_code = app_fifo_get(&m_fifo, &data[i]);
+                check((err_code == NRF_SUCCESS) || ((i >= length) && (err_code == NRF_ERROR_NOT_FOUND)),
+                      "get result", pos + i);
+                check((err_code != NRF_SUCCESS) || (i < length) || m_concurrent, "get result", pos + i);
+                if (err_code != NRF_SUCCESS)
+                {
+                    break;
+                }
+            }
+            size = i;
+            break;
+
+        case ACCESS_BLOCK:
+            requested = size;
+            err_code  = app_fifo_read(&m_fifo, data, &size);
+            check((size >= MIN(requested, length)) && (size <= requested), "read size", pos);
+            check((size <= length) || m_concurrent, "read size", pos);
+            check(err_code == ((size != 0) ? NRF_SUCCESS : NRF_ERROR_NOT_FOUND), "read result", pos);
+            break;
+
+        default:
+            err_code = app_fifo_peek_span(&m_fifo, &p_data, &length);
+            if (err_code != NRF_SUCCESS)
+            {
+                check(err_code == NRF_ERROR_NOT_FOUND, "peek result", pos);
+                return 0;
+            }
+            size = MIN(size, length);
+            check(app_fifo_commit(&m_fifo, FIFO_SIZE + 1) == NRF_ERROR_INVALID_LENGTH,
+                  "commit beyond the end accepted", pos);
+            break;
+    }
+
+    for (i = 0; i < size; i++)
+    {
+        check(p_data[i] == stream_byte(pos + i), "wrong data", pos + i);
+    }
+
+    if (access == ACCESS_SPAN)
+    {
+        check(app_fifo_commit(&m_fifo, size) == NRF_SUCCESS, "commit result", pos);
+    }
+
+    return size;
+}
+
+
+/**@brief Random accesses of random size from both sides. */
+static void stream_test(uint32_t bytes)
+{
+    uint32_t write_pos = 0;
+    uint32_t read_pos  = 0;
+    uint32_t length;
+
+    check(app_fifo_init(&m_fifo, m_fifo_buf, FIFO_SIZE - 1) == NRF_ERROR_INVALID_LENGTH,
+          "size not a power of two accepted", 0);
+    check(app_fifo_init(&m_fifo, m_fifo_buf, FIFO_SIZE) == NRF_SUCCESS, "init result", 0);
+
+    while (read_pos < bytes)
+    {
+        // Both sides may access more than the FIFO can take or has.
+        write_pos += stream_write((access_t)(rand() % ACCESS_SPAN),
+                                  write_pos,
+                                  (uint32_t)rand() % (FIFO_SIZE + 1));
+        read_pos  += stream_read((access_t)(rand() % ACCESS_COUNT),
+                                 read_pos,
+                                 (uint32_t)rand() % (FIFO_SIZE + 1));
+
+        (void)app_fifo_read(&m_fifo, NULL, &length);
+        check(length == (write_pos - read_pos), "length", read_pos);
+    }
+
+    (void)app_fifo_flush(&m_fifo);
+    (void)app_fifo_read(&m_fifo, NULL, &length);
+    check(length == 0, "not empty after flush", read_pos);
+}
+
+
+/**@brief Producer thread, writing the stream with random accesses of random size. */
+static void * producer_thread(void * p_context)
+{
+    const uint32_t bytes     = *(uint32_t const *)p_context;
+    uint32_t       write_pos = 0;
+    uint32_t       size;
+    unsigned       seed      = bytes;
+
+    while (write_pos < bytes)
+    {
+        size = stream_write((access_t)(rand_r(&seed) % ACCESS_SPAN),
+                            write_pos,
+                            MIN((uint32_t)rand_r(&seed) % (FIFO_SIZE + 1), bytes - write_pos));
+        if (size == 0)
+        {
+            // Let the consumer run on a single core host.
+            (void)sched_yield();
+        }
+        write_pos += size;
+    }
+
+    return NULL;
+}
+
+
+/**@brief Producer and consumer in different threads, the consumer in the calling thread.
+ *
+ * @details Sizes are drawn with rand_r(), as rand() is not reentrant.
+ */
+static void thread_test(uint32_t bytes)
+{
+    pthread_t producer;
+    uint32_t  read_pos = 0;
+    uint32_t  size;
+    unsigned  seed     = ~bytes;
+    uint64_t  start_ns;
+    uint64_t  time_ns;
+
+    (void)app_fifo_init(&m_fifo, m_fifo_buf, FIFO_SIZE);
+    m_concurrent = true;
+
+    start_ns = host_ns_get();
+    if (pthread_create(&producer, NULL, producer_thread, &bytes) != 0)
+    {
+        printf("pthread_create failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    while (read_pos < bytes)
+    {
+        size = stream_read((access_t)(rand_r(&seed) % ACCESS_COUNT),
+                           read_pos,
+                           MIN((uint32_t)rand_r(&seed) % (FIFO_SIZE + 1), bytes - read_pos));
+        if (size == 0)
+        {
+            (void)sched_yield();
+        }
+        read_pos += size;
+    }
+
+    (void)pthread_join(producer, NULL);
+    time_ns = host_ns_get() - start_ns;
+    m_concurrent = false;
+
+    printf("  two threads, random accesses %8.1f MB/s, %5.2f ns/byte\n",
+           (bytes * 1e3) / time_ns, (double)time_ns / bytes);
+}
+
+
+/**@brief Function for measuring bytes per second, writing and reading the same access size. */
+static void throughput_bench(access_t access, uint32_t bytes)
+{
+    uint8_t   data[BLOCK_SIZE];
+    uint8_t * p_data;
+    uint32_t  count;
+    uint32_t  size;
+    uint32_t  i;
+    uint64_t  start_ns;
+    uint64_t  time_ns;
+
+    memset(data, 0x55, sizeof(data));
+    (void)app_fifo_init(&m_fifo, m_fifo_buf, FIFO_SIZE);
+
+    start_ns = host_ns_get();
+    for (count = 0; count < bytes; count += BLOCK_SIZE)
+    {
+        switch (access)
+        {
+            case ACCESS_BYTE:
+                for (i = 0; i < BLOCK_SIZE; i++)
+                {
+                    (void)app_fifo_put(&m_fifo, data[i]);
+                }
+                for (i = 0; i < BLOCK_SIZE; i++)
+                {
+                    (void)app_fifo_get(&m_fifo, &data[i]);
+                }
+                break;
+
+            case ACCESS_BLOCK:
+                size = BLOCK_SIZE;
+                (void)app_fifo_write(&m_fifo, data, &size);
+                (void)app_fifo_read(&m_fifo, data, &size);
+                break;
+
+            default:
+                size = BLOCK_SIZE;
+                (void)app_fifo_write(&m_fifo, data, &size);
+                while (app_fifo_peek_span(&m_fifo, &p_data, &size) == NRF_SUCCESS)
+                {
+                    (void)app_fifo_commit(&m_fifo, size);
+                }
+                break;
+        }
+    }
+    time_ns = host_ns_get() - start_ns;
+
+    printf("  %-5s %8.1f MB/s, %5.2f ns/byte\n",
+           m_access_names[access], (count * 1e3) / time_ns, (double)time_ns / count);
+}
+
+
+int main(int argc, char * argv[])
+{
+    uint32_t bytes = 10000000;
+    unsigned seed  = 1;
+    int      opt;
+    access_t access;
+
+    while ((opt = getopt(argc, argv, "n:s:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'n':
+                bytes = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+
+            case 's':
+                seed = (unsigned)strtoul(optarg, NULL, 0);
+                break;
+
+            default:
+                fprintf(stderr, "usage: %s [-n bytes] [-s seed]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    srand(seed);
+
+    printf("app_fifo, %u byte buffer, APP_FIFO_SPSC %u\n", FIFO_SIZE, APP_FIFO_SPSC);
+
+    stream_test(bytes / 10);
+
+    for (access = ACCESS_BYTE; access < ACCESS_COUNT; access++)
+    {
+        throughput_bench(access, bytes);
+    }
+
+    thread_test(bytes / 10);
+
+    printf("%s\n", (m_errors == 0) ? "PASS" : "FAIL");
+
+    return (m_errors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,558 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/** @file
+ *
+ * @brief Test and benchmark of the app_scheduler event storage (fixed slots or byte ring).
+ *
+ * @details Test: events of random size are put and executed in random bursts, also from inside
+ *          event handlers, and every event must reach its handler in order with its data. The
+ *          scheduler must hold QUEUE_SIZE events of EVENT_SIZE wherever the queue starts.
+ *          With APP_SCHED_PROFILE, events to more handlers than are profiled are put at random
+ *          times of a fake clock and take random run times, and the recorded latencies, run times,
+ *          histograms, queue depth and put failures must match those computed by the test.
+ *
+ *          Benchmark: RAM of the scheduler buffer, number of events held when it is full, and
+ *          events per second through app_sched_event_put() and app_sched_execute(), for events
+ *          of maximum size and for a mix of sizes.
+ *
+ *          Usage: app_sched_bench [-n events] [-s seed]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "app_scheduler.h"
+#include "app_error.h"
+#include "app_util.h"
+#include "nordic_common.h"
+#include "nrf_error.h"
+
+#define EVENT_SIZE     64                                           /**< Maximum event data size. */
+#define QUEUE_SIZE     16                                           /**< Number of events of EVENT_SIZE the scheduler must hold. */
+#define EXPECTED_SIZE  256                                          /**< Size of the FIFO of expected events, larger than any queue. */
+#define FILL_TRIALS    1000                                         /**< Number of fill measurements, each from a different queue position. */
+#define CLOCK_START    0x00FFF000                                   /**< Initial value of the fake profiling clock, shortly before its 24 bit counter wraps. */
+#define MAX_RUN_TIME   100                                          /**< Max run time of a profiled handler in clock ticks. */
+
+/**@brief Event size distribution. */
+typedef struct
+{
+    char const * p_name;                                            /**< Name in reports. */
+    uint16_t     sizes[10];                                         /**< Sizes, drawn with equal probability. */
+} size_mix_t;
+
+static const size_mix_t m_mix_max = {"max",  {64, 64, 64, 64, 64, 64, 64, 64, 64, 64}};
+static const size_mix_t m_mix_sdk = {"mixed", {0, 8, 8, 8, 8, 8, 16, 16, 24, 64}};   /**< Mostly timer and GPIOTE size events, a few BLE events. */
+
+static uint32_t             m_sched_buf[CEIL_DIV(APP_SCHED_BUF_SIZE(EVENT_SIZE, QUEUE_SIZE),
+                                                 sizeof(uint32_t))];      /**< Scheduler buffer. */
+static uint32_t             m_put_seq;                                    /**< Sequence number of the next event put. */
+static uint32_t             m_exec_seq;                                   /**< Sequence number of the next event expected. */
+static uint16_t             m_expected_size[EXPECTED_SIZE];               /**< Sizes of the events put, by sequence number. */
+static uint32_t             m_errors;                                     /**< Number of failed checks. */
+static uint32_t             m_nested_puts;                                /**< Events to put from inside the handler. */
+static size_mix_t const *   mp_mix;                                       /**< Size distribution of events put. */
+static bool                 m_check;                                      /**< Check the events executed. */
+
+#if (APP_SCHED_PROFILE)
+#define PROFILED_HANDLERS (APP_SCHED_PROFILE_HANDLERS + 2)                /**< Number of handlers in the profiling test, more than are profiled. */
+
+/**@brief Profiled event. */
+typedef struct
+{
+    uint32_t seq;                                                   /**< Sequence number of the event. */
+    uint32_t run_time;                                              /**< Time the handler takes, in clock ticks. */
+} profile_event_t;
+
+uint32_t                    app_sched_host_clock;                         /**< Fake profiling clock. */
+static uint32_t             m_put_time[EXPECTED_SIZE];                    /**< Clock when each event was put, by sequence number. */
+static app_sched_profile_t  m_expected_profile;                           /**< Profiling data computed by the test. */
+#endif
+
+
+void app_error_handler(uint32_t error_code, uint32_t line_num, const uint8_t * p_file_name)
+{
+    printf("error 0x%x at %s:%u\n", (unsigned)error_code, (char const *)p_file_name, (unsigned)line_num);
+    exit(EXIT_FAILURE);
+}
+
+
+/**@brief Function for getting host time in nanoseconds. */
+static uint64_t host_ns_get(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ull) + (uint64_t)ts.tv_nsec;
+}
+
+
+static void event_handler(void * p_event_data, uint16_t event_size);
+
+
+/**@brief Function for putting one event of a size drawn from the current mix.
+ *
+ * @return Result of app_sched_event_put().
+ */
+static uint32_t event_put(void)
+{
+    uint8_t  data[EVENT_SIZE];
+    uint16_t size = mp_mix->sizes[(uint32_t)rand() % 10];
+    uint32_t err_code;
+    uint32_t i;
+
+    for (i = 0; i < size; i++)
+    {
+        data[i] = (uint8_t)(m_put_seq + i);
+    }
+
+    err_code = app_sched_event_put((size != 0) ? data : NULL, size, event_handler);
+    if (err_code == NRF_SUCCESS)
+    {
+        m_expected_size[m_put_seq % EXPECTED_SIZE] = size;
+        m_put_seq++;
+    }
+
+    return err_code;
+}
+
+
+static void event_handler(void * p_event_data, uint16_t event_size)
+{
+    if (m_check)
+    {
+        const uint8_t * p_data = p_event_data;
+        uint32_t        i;
+        bool            ok     = (event_size == m_expected_size[m_exec_seq % EXPECTED_SIZE]);
+
+        for (i = 0; ok && (i < event_size); i++)
+        {
+            ok = (p_data[i] == (uint8_t)(m_exec_seq + i));
+        }
+
+        if (!ok)
+        {
+            printf("event %u: wrong size or data\n", (unsigned)m_exec_seq);
+            m_errors++;
+        }
+    }
+    m_exec_seq++;
+
+    // Events put while the scheduler is executing are executed in the same app_sched_execute().
+    if (m_nested_puts > 0)
+    {
+        m_nested_puts--;
+        (void)event_put();
+    }
+}
+
+
+/**@brief Function for (re)initializing the scheduler. */
+static void sched_init(void)
+{
+    if (app_sched_init(EVENT_SIZE, QUEUE_SIZE, m_sched_buf) != NRF_SUCCESS)
+    {
+        printf("app_sched_init failed\n");
+        exit(EXIT_FAILURE);
+    }
+    m_put_seq  = 0;
+    m_exec_seq = 0;
+}
+
+
+/**@brief Function for moving the start of the queue to a random position. */
+static void queue_position_randomize(void)
+{
+    uint32_t count = (uint32_t)rand() % (2 * QUEUE_SIZE);
+
+    while (count-- > 0)
+    {
+        (void)event_put();
+        if ((rand() % 2) == 0)
+        {
+            app_sched_execute();
+        }
+    }
+    app_sched_execute();
+}
+
+
+/**@brief Function for filling the empty scheduler.
+ *
+ * @return Number of events put before the scheduler was full.
+ */
+static uint32_t fill(void)
+{
+    uint32_t count = 0;
+
+    while (event_put() == NRF_SUCCESS)
+    {
+        count++;
+    }
+    app_sched_execute();
+
+    return count;
+}
+
+
+/**@brief Random bursts of puts and executes, with events also put from inside handlers. */
+static void order_test(uint32_t events)
+{
+    mp_mix  = &m_mix_sdk;
+    m_check = true;
+    sched_init();
+
+    while (m_put_seq < events)
+    {
+        uint32_t burst = 1 + ((uint32_t)rand() % QUEUE_SIZE);
+
+        while ((burst-- > 0) && (event_put() == NRF_SUCCESS))
+        {
+            // Put until the burst is done or the scheduler is full.
+        }
+        m_nested_puts = (uint32_t)rand() % 4;
+        app_sched_execute();
+    }
+    m_nested_puts = 0;
+    app_sched_execute();
+
+    if (m_exec_seq != m_put_seq)
+    {
+        printf("%u events put, %u executed\n", (unsigned)m_put_seq, (unsigned)m_exec_seq);
+        m_errors++;
+    }
+}
+
+
+/**@brief Events of maximum size must fit QUEUE_SIZE times, wherever the queue starts. */
+static void capacity_test(void)
+{
+    uint32_t trial;
+
+    mp_mix  = &m_mix_max;
+    m_check = true;
+    sched_init();
+
+    for (trial = 0; trial < FILL_TRIALS; trial++)
+    {
+        uint32_t count;
+
+        mp_mix = &m_mix_sdk;
+        queue_position_randomize();
+        mp_mix = &m_mix_max;
+
+        count = fill();
+        if (count < QUEUE_SIZE)
+        {
+            printf("only %u events of maximum size fit\n", (unsigned)count);
+            m_errors++;
+            return;
+        }
+    }
+
+    if (app_sched_event_put(NULL, EVENT_SIZE + 1, event_handler) != NRF_ERROR_INVALID_LENGTH)
+    {
+        printf("event larger than EVENT_SIZE accepted\n");
+        m_errors++;
+    }
+}
+
+
+#if (APP_SCHED_PROFILE)
+/**@brief Function for recording a profiled event in the expected profiling data.
+ *
+ * @param[in] handler   Handler of the event.
+ * @param[in] latency   Clock ticks from the event put until the handler was called.
+ * @param[in] run_time  Clock ticks spent in the handler.
+ */
+static void profile_expect(app_sched_event_handler_t handler, uint32_t latency, uint32_t run_time)
+{
+    app_sched_handler_profile_t * p_entry = NULL;
+    uint32_t                      bucket  = 0;
+    uint32_t                      i;
+
+    for (i = 0; (i < APP_SCHED_PROFILE_HANDLERS) && (p_entry == NULL); i++)
+    {
+        if ((m_expected_profile.handlers[i].handler == handler) ||
+            (m_expected_profile.handlers[i].handler == NULL))
+        {
+            p_entry          = &m_expected_profile.handlers[i];
+            p_entry->handler = handler;
+        }
+    }
+    if (p_entry == NULL)
+    {
+        m_expected_profile.untracked_events++;
+        return;
+    }
+
+    // Bucket 0 is zero ticks, bucket n is 2^(n-1) to 2^n - 1 ticks, the last one all longer.
+    while ((bucket < APP_SCHED_PROFILE_LATENCY_BUCKETS - 1) && (latency >= (1UL << bucket)))
+    {
+        bucket++;
+    }
+
+    p_entry->event_count++;
+    p_entry->latency_histogram[bucket]++;
+    p_entry->latency_max  = MAX(p_entry->latency_max, latency);
+    p_entry->run_time_max = MAX(p_entry->run_time_max, run_time);
+}
+
+
+/**@brief Function for handling a profiled event, which takes the run time given in the event. */
+static void profile_handler(app_sched_event_handler_t handler, void * p_event_data)
+{
+    profile_event_t event;
+
+    // Event data is only byte aligned with APP_SCHED_BYTE_RING.
+    memcpy(&event, p_event_data, sizeof(event));
+
+    if (event.seq != m_exec_seq)
+    {
+        printf("profiled event %u: executed as %u\n", (unsigned)event.seq, (unsigned)m_exec_seq);
+        m_errors++;
+    }
+    m_exec_seq++;
+
+    profile_expect(handler,
+                   (app_sched_host_clock - m_put_time[event.seq % EXPECTED_SIZE]) & APP_SCHED_PROFILE_CLOCK_MASK,
+                   event.run_time);
+    app_sched_host_clock += event.run_time;
+}
+
+
+#define PROFILE_HANDLER(N)                                                  \
+static void profile_handler_##N(void * p_event_data, uint16_t event_size)   \
+{                                                                           \
+    UNUSED_PARAMETER(event_size);                                           \
+    profile_handler(profile_handler_##N, p_event_data);                     \
+}
+
+PROFILE_HANDLER(0)
+PROFILE_HANDLER(1)
+PROFILE_HANDLER(2)
+PROFILE_HANDLER(3)
+PROFILE_HANDLER(4)
+PROFILE_HANDLER(5)
+PROFILE_HANDLER(6)
+PROFILE_HANDLER(7)
+PROFILE_HANDLER(8)
+PROFILE_HANDLER(9)
+
+static const app_sched_event_handler_t m_profile_handlers[] =
+{
+    profile_handler_0, profile_handler_1, profile_handler_2, profile_handler_3, profile_handler_4,
+    profile_handler_5, profile_handler_6, profile_handler_7, profile_handler_8, profile_handler_9
+};
+
+STATIC_ASSERT(sizeof(m_profile_handlers) / sizeof(m_profile_handlers[0]) == PROFILED_HANDLERS);
+
+
+/**@brief Function for checking a profiling data field. */
+static void profile_check(uint32_t actual, uint32_t expected, char const * p_what, uint32_t index)
+{
+    if (actual != expected)
+    {
+        printf("profile %s %u: %u, expected %u\n",
+               p_what, (unsigned)index, (unsigned)actual, (unsigned)expected);
+        m_errors++;
+    }
+}
+
+
+/**@brief Events to random handlers, put at random clock times and taking random run times, and
+ *        the profiling data recorded by the scheduler compared with the expected data. Then the
+ *        queue depth and put failures of a full scheduler.
+ */
+static void profile_test(uint32_t events)
+{
+    const app_sched_profile_t * p_profile = app_sched_profile_get();
+    profile_event_t             event;
+    uint32_t                    held;
+    uint32_t                    i;
+    uint32_t                    j;
+
+    sched_init();
+    app_sched_profile_reset();
+    memset(&m_expected_profile, 0, sizeof(m_expected_profile));
+    app_sched_host_clock = CLOCK_START;
+
+    while (m_put_seq < events)
+    {
+        uint32_t burst = 1 + ((uint32_t)rand() % QUEUE_SIZE);
+
+        for (i = 0; i < burst; i++)
+        {
+            event.seq      = m_put_seq;
+            event.run_time = (uint32_t)rand() % MAX_RUN_TIME;
+
+            // Mostly short gaps, sometimes long ones which fall in the last latency bucket.
+            app_sched_host_clock += ((rand() % 8) == 0) ? ((uint32_t)rand() % 1000) : ((uint32_t)rand() % 4);
+            m_put_time[m_put_seq % EXPECTED_SIZE] = app_sched_host_clock;
+
+            if (app_sched_event_put(&event, sizeof(event),
+                                    m_profile_handlers[(uint32_t)rand() % PROFILED_HANDLERS]) != NRF_SUCCESS)
+            {
+                break;
+            }
+            m_put_seq++;
+        }
+        app_sched_host_clock += (uint32_t)rand() % 64;
+        app_sched_execute();
+    }
+
+    if (app_sched_host_clock <= APP_SCHED_PROFILE_CLOCK_MASK)
+    {
+        printf("profile clock did not wrap\n");
+        m_errors++;
+    }
+
+    profile_check(p_profile->untracked_events, m_expected_profile.untracked_events, "untracked events", 0);
+    for (i = 0; i < APP_SCHED_PROFILE_HANDLERS; i++)
+    {
+        const app_sched_handler_profile_t * p_actual   = &p_profile->handlers[i];
+        const app_sched_handler_profile_t * p_expected = &m_expected_profile.handlers[i];
+
+        profile_check(p_actual->handler == p_expected->handler, true, "handler", i);
+        profile_check(p_actual->event_count, p_expected->event_count, "event count", i);
+        profile_check(p_actual->latency_max, p_expected->latency_max, "latency max", i);
+        profile_check(p_actual->run_time_max, p_expected->run_time_max, "run time max", i);
+        for (j = 0; j < APP_SCHED_PROFILE_LATENCY_BUCKETS; j++)
+        {
+            profile_check(p_actual->latency_histogram[j], p_expected->latency_histogram[j], "histogram", i);
+        }
+    }
+    profile_check(p_profile->put_failures, 0, "put failures", 0);
+
+    // A full scheduler. With the byte ring the depth is in bytes, which the test does not know.
+    app_sched_profile_reset();
+    mp_mix  = &m_mix_max;
+    m_check = false;
+    held    = fill();
+    profile_check(p_profile->put_failures, 1, "put failures", 0);
+    if (!APP_SCHED_BYTE_RING)
+    {
+        profile_check(p_profile->queue_depth_max, held, "queue depth", 0);
+    }
+}
+#endif
+
+
+/**@brief Function for measuring the number of events held by the full scheduler. */
+static void fill_bench(size_mix_t const * p_mix)
+{
+    uint32_t min   = UINT32_MAX;
+    uint32_t total = 0;
+    uint32_t trial;
+
+    m_check = false;
+    sched_init();
+
+    for (trial = 0; trial < FILL_TRIALS; trial++)
+    {
+        uint32_t count;
+
+        mp_mix = &m_mix_sdk;
+        queue_position_randomize();
+        mp_mix = p_mix;
+
+        count  = fill();
+        total += count;
+        min    = MIN(min, count);
+    }
+
+    printf("  %-5s events: holds %5.1f events on average, %2u at least\n",
+           p_mix->p_name, (double)total / FILL_TRIALS, (unsigned)min);
+}
+
+
+/**@brief Function for measuring events per second, putting bursts of events and executing them. */
+static void throughput_bench(size_mix_t const * p_mix, uint32_t events)
+{
+    uint64_t start_ns;
+    uint64_t time_ns;
+
+    mp_mix  = p_mix;
+    m_check = false;
+    sched_init();
+
+    start_ns = host_ns_get();
+    while (m_put_seq < events)
+    {
+        uint32_t burst = 1 + ((uint32_t)rand() % QUEUE_SIZE);
+
+        while ((burst-- > 0) && (event_put() == NRF_SUCCESS))
+        {
+            // Put until the burst is done or the scheduler is full.
+        }
+        app_sched_execute();
+    }
+    time_ns = host_ns_get() - start_ns;
+
+    printf("  %-5s events: %6.1f Mevents/s, %5.1f ns/event (put + execute)\n",
+           p_mix->p_name, (events * 1e3) / time_ns, (double)time_ns / events);
+}
+
+
+int main(int argc, char * argv[])
+{
+    uint32_t events = 1000000;
+    unsigned seed   = 1;
+    int      opt;
+
+    while ((opt = getopt(argc, argv, "n:s:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'n':
+                events = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+
+            case 's':
+                seed = (unsigned)strtoul(optarg, NULL, 0);
+                break;
+
+            default:
+                fprintf(stderr, "usage: %s [-n events] [-s seed]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    srand(seed);
+
+    printf("app_scheduler %s%s, EVENT_SIZE %u, QUEUE_SIZE %u\n",
+           APP_SCHED_BYTE_RING ? "byte ring" : "fixed slots",
+           APP_SCHED_PROFILE ? ", profiled" : "", EVENT_SIZE, QUEUE_SIZE);
+    printf("  buffer: %u bytes on target (%u byte headers), %u bytes on this host\n",
+           (unsigned)((APP_SCHED_BYTE_RING ? ((EVENT_SIZE + 3) & ~3) : EVENT_SIZE) +
+                      APP_SCHED_TARGET_EVENT_HEADER_SIZE) * (QUEUE_SIZE + 1),
+           (unsigned)APP_SCHED_TARGET_EVENT_HEADER_SIZE,
+           (unsigned)sizeof(m_sched_buf));
+
+    order_test(events / 10);
+    capacity_test();
+#if (APP_SCHED_PROFILE)
+    profile_test(events / 10);
+#endif
+
+    fill_bench(&m_mix_max);
+    fill_bench(&m_mix_sdk);
+    throughput_bench(&m_mix_max, events);
+    throughput_bench(&m_mix_sdk, events);
+
+    printf("%s\n", (m_errors == 0) ? "PASS" : "FAIL");
+
+    return (m_errors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
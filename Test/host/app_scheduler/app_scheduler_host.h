@@ -0,0 +1,43 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/** @file
+ *
+ * @brief Host build settings of app_scheduler, included before the module (-include).
+ *
+ * @details The event header holds a function pointer, so it is larger on a 64 bit host than on the
+ *          target. The target size is kept for reports. With APP_SCHED_PROFILE, events are time
+ *          stamped with a fake 24 bit clock which the test advances.
+ */
+
+#ifndef APP_SCHEDULER_HOST_H__
+#define APP_SCHEDULER_HOST_H__
+
+#include "host_cpu.h"
+#include "app_scheduler.h"
+
+enum
+{
+    APP_SCHED_TARGET_EVENT_HEADER_SIZE = APP_SCHED_EVENT_HEADER_SIZE  /**< Size of the event header on the target. */
+};
+
+#undef  APP_SCHED_EVENT_HEADER_SIZE
+#define APP_SCHED_EVENT_HEADER_SIZE 16
+
+#if (APP_SCHED_PROFILE)
+extern uint32_t app_sched_host_clock;   /**< Fake profiling clock, only its low 24 bits are read like those of the RTC counter. */
+
+#undef  APP_SCHED_PROFILE_CLOCK
+#define APP_SCHED_PROFILE_CLOCK()   (app_sched_host_clock & APP_SCHED_PROFILE_CLOCK_MASK)
+#endif
+
+#endif // APP_SCHEDULER_HOST_H__
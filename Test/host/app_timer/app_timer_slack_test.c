@@ -0,0 +1,320 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/** @file
+ *
+ * @brief Test of app_timer_start_with_slack() on the simulated RTC1.
+ *
+ * @details Every timeout is checked to come within [timeout, timeout + slack] of its nominal
+ *          expiry. The number of RTC1 wakeups per simulated hour is printed for a set of repeating
+ *          timers started without and with slack; slack has to save wakeups. Single shot timers
+ *          restarted with random timeout and slack from their own handler check the windows when
+ *          timers are started from the interrupt handler. In a second run, running timers are also
+ *          stopped between interrupts, and restarted or left stopped; a stopped timer must not
+ *          expire, and the timers left running must still come within their windows. Finally a
+ *          single timer is stopped and started again from its own handler, as a retransmission
+ *          timer is, so that the list of running timers becomes empty in between.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "app_timer.h"
+#include "app_error.h"
+#include "app_util.h"
+#include "nrf_error.h"
+
+#define PRESCALER       0                                               /**< RTC1 prescaler, 32768 ticks per second. */
+#define MAX_TIMERS      8                                               /**< Number of timers used by the test. */
+#define OP_QUEUE_SIZE   MAX_TIMERS                                      /**< Size of the timer operation queues, all timers may be restarted in one interrupt. */
+#define MAX_JITTER      3                                               /**< Documented positive jitter of timeouts close to each other. */
+#define HOUR_TICKS      (3600ull * APP_TIMER_CLOCK_FREQ)                /**< One hour in ticks. */
+#define ONE_SHOT_TICKS  (60ull * APP_TIMER_CLOCK_FREQ)                  /**< Duration of the single shot test. */
+
+/**@brief Timer under test. */
+typedef struct
+{
+    app_timer_id_t id;            /**< Timer id. */
+    uint32_t       period;        /**< Timeout (and period) in ticks. */
+    uint32_t       slack;         /**< Slack in ticks. */
+    uint64_t       nominal;       /**< Nominal time of the next expiry. */
+    uint32_t       expirations;   /**< Number of expirations. */
+    bool           is_running;    /**< False if the timer was stopped by the test. */
+} test_timer_t;
+
+static uint32_t     m_timer_buf[CEIL_DIV(APP_TIMER_BUF_SIZE(MAX_TIMERS, OP_QUEUE_SIZE + 1),
+                                         sizeof(uint32_t))];           /**< Buffer of the timer module. */
+static test_timer_t m_timers[MAX_TIMERS];                              /**< Timers under test. */
+static uint32_t     m_errors;                                          /**< Number of failed checks. */
+static uint32_t     m_stops;                                           /**< Number of timers stopped by the test. */
+
+/**@brief Periods of the repeating timers, in milliseconds. */
+static const uint32_t m_periods_ms[MAX_TIMERS] = {1000, 1300, 2100, 3000, 5000, 7700, 10000, 60000};
+
+
+void app_error_handler(uint32_t error_code, uint32_t line_num, const uint8_t * p_file_name)
+{
+    printf("error 0x%x at %s:%u\n", (unsigned)error_code, (char const *)p_file_name, (unsigned)line_num);
+    exit(EXIT_FAILURE);
+}
+
+
+/**@brief Function for checking that a timeout comes within its window. */
+static void expiry_check(test_timer_t * p_timer)
+{
+    const uint64_t now = rtc_sim_time_get();
+
+    if (!p_timer->is_running)
+    {
+        printf("timer %u: expired at %llu while stopped\n", (unsigned)p_timer->id, (unsigned long long)now);
+        m_errors++;
+    }
+    else if ((now < p_timer->nominal) || (now > (p_timer->nominal + p_timer->slack + MAX_JITTER)))
+    {
+        printf("timer %u: expired at %llu, window [%llu, %llu]\n",
+               (unsigned)p_timer->id,
+               (unsigned long long)now,
+               (unsigned long long)p_timer->nominal,
+               (unsigned long long)(p_timer->nominal + p_timer->slack));
+        m_errors++;
+    }
+    p_timer->expirations++;
+}
+
+
+static void repeated_timeout_handler(void * p_context)
+{
+    test_timer_t * p_timer = p_context;
+
+    expiry_check(p_timer);
+    p_timer->nominal += p_timer->period;
+}
+
+
+/**@brief Function for starting a single shot timer with random timeout and slack. */
+static void single_shot_start(test_timer_t * p_timer)
+{
+    p_timer->period  = APP_TIMER_MIN_TIMEOUT_TICKS + ((uint32_t)rand() % 2000);
+    p_timer->slack   = (uint32_t)rand() % p_timer->period;
+    p_timer->nominal    = rtc_sim_time_get() + p_timer->period;
+    p_timer->is_running = true;
+
+    APP_ERROR_CHECK(app_timer_start_with_slack(p_timer->id, p_timer->period, p_timer->slack, p_timer));
+}
+
+
+/**@brief Function for stopping a random timer, and restarting it or leaving it stopped. A stopped
+ *        timer is restarted when it is picked again. The last running timer is always restarted,
+ *        so that time keeps being interrupted.
+ */
+static void random_stop(void)
+{
+    test_timer_t * p_timer = &m_timers[(uint32_t)rand() % MAX_TIMERS];
+    uint32_t       running = 0;
+    uint32_t       i;
+
+    for (i = 0; i < MAX_TIMERS; i++)
+    {
+        running += m_timers[i].is_running ? 1 : 0;
+    }
+
+    if (p_timer->is_running)
+    {
+        APP_ERROR_CHECK(app_timer_stop(p_timer->id));
+        p_timer->is_running = false;
+        m_stops++;
+
+        if ((running > 1) && ((rand() % 2) != 0))
+        {
+            return;
+        }
+    }
+    single_shot_start(p_timer);
+}
+
+
+static void single_shot_timeout_handler(void * p_context)
+{
+    test_timer_t * p_timer = p_context;
+
+    expiry_check(p_timer);
+    single_shot_start(p_timer);
+}
+
+
+static void restart_timeout_handler(void * p_context)
+{
+    test_timer_t * p_timer = p_context;
+
+    expiry_check(p_timer);
+    APP_ERROR_CHECK(app_timer_stop(p_timer->id));
+    single_shot_start(p_timer);
+}
+
+
+/**@brief Function for (re)initializing the timer module and the simulated RTC1. */
+static void timers_init(void)
+{
+    APP_ERROR_CHECK(app_timer_init(PRESCALER, MAX_TIMERS, OP_QUEUE_SIZE + 1, m_timer_buf, NULL));
+    (void)rtc_sim_wakeups_get();
+}
+
+
+/**@brief Function for running simulated time for a given duration.
+ *
+ * @param[in] duration   Number of ticks to run.
+ * @param[in] stop       True to stop a random timer after every interrupt.
+ */
+static void time_run(uint64_t duration, bool stop)
+{
+    const uint64_t end = rtc_sim_time_get() + duration;
+
+    // Interrupts are handled in the simulator, timers stopped from thread mode take effect at once.
+    while (rtc_sim_run(end))
+    {
+        if (stop)
+        {
+            random_stop();
+        }
+    }
+}
+
+
+/**@brief Repeating timers for one hour, with slack of 1/slack_div of their period (no slack if 0).
+ *
+ * @return Number of RTC1 wakeups.
+ */
+static uint32_t repeated_run(uint32_t slack_div)
+{
+    uint32_t expirations = 0;
+    uint32_t wakeups;
+    uint32_t i;
+
+    timers_init();
+
+    for (i = 0; i < MAX_TIMERS; i++)
+    {
+        test_timer_t * p_timer = &m_timers[i];
+
+        APP_ERROR_CHECK(app_timer_create(&p_timer->id, APP_TIMER_MODE_REPEATED, repeated_timeout_handler));
+        p_timer->period      = APP_TIMER_TICKS(m_periods_ms[i], PRESCALER);
+        p_timer->slack       = (slack_div != 0) ? (p_timer->period / slack_div) : 0;
+        p_timer->nominal     = rtc_sim_time_get() + p_timer->period;
+        p_timer->expirations = 0;
+        p_timer->is_running  = true;
+        APP_ERROR_CHECK(app_timer_start_with_slack(p_timer->id, p_timer->period, p_timer->slack, p_timer));
+    }
+
+    time_run(HOUR_TICKS, false);
+    APP_ERROR_CHECK(app_timer_stop_all());
+    wakeups = rtc_sim_wakeups_get();
+
+    for (i = 0; i < MAX_TIMERS; i++)
+    {
+        // The last timeout of the hour may still be waiting for its deadline.
+        const uint32_t expected = (uint32_t)(HOUR_TICKS / m_timers[i].period);
+
+        if ((m_timers[i].expirations != expected) && (m_timers[i].expirations + 1 != expected))
+        {
+            printf("timer %u: %u expirations, expected %u\n",
+                   (unsigned)i, (unsigned)m_timers[i].expirations, (unsigned)expected);
+            m_errors++;
+        }
+        expirations += m_timers[i].expirations;
+    }
+
+    printf("slack period/%-3u %6u wakeups/hour for %6u timeouts\n",
+           (unsigned)slack_div,
+           (unsigned)wakeups,
+           (unsigned)expirations);
+
+    return wakeups;
+}
+
+
+/**@brief Single shot timers restarted from their handler with random timeout and slack.
+ *
+ * @param[in] stop   True to stop a random timer after every interrupt.
+ */
+static void single_shot_run(bool stop)
+{
+    uint32_t expirations = 0;
+    uint32_t i;
+
+    timers_init();
+    m_stops = 0;
+
+    for (i = 0; i < MAX_TIMERS; i++)
+    {
+        m_timers[i].expirations = 0;
+        APP_ERROR_CHECK(app_timer_create(&m_timers[i].id, APP_TIMER_MODE_SINGLE_SHOT, single_shot_timeout_handler));
+        single_shot_start(&m_timers[i]);
+    }
+
+    time_run(ONE_SHOT_TICKS, stop);
+    APP_ERROR_CHECK(app_timer_stop_all());
+
+    for (i = 0; i < MAX_TIMERS; i++)
+    {
+        expirations += m_timers[i].expirations;
+    }
+
+    printf("single shot, random slack%s: %u timeouts, %u stops, %u wakeups\n",
+           stop ? " and stops" : "",
+           (unsigned)expirations, (unsigned)m_stops, (unsigned)rtc_sim_wakeups_get());
+}
+
+
+/**@brief One single shot timer, stopped and started again from its own handler. */
+static void restart_run(void)
+{
+    test_timer_t * p_timer = &m_timers[0];
+
+    timers_init();
+
+    p_timer->expirations = 0;
+    APP_ERROR_CHECK(app_timer_create(&p_timer->id, APP_TIMER_MODE_SINGLE_SHOT, restart_timeout_handler));
+    single_shot_start(p_timer);
+
+    time_run(ONE_SHOT_TICKS, false);
+    APP_ERROR_CHECK(app_timer_stop_all());
+
+    printf("single shot, stopped and restarted from its handler: %u timeouts\n",
+           (unsigned)p_timer->expirations);
+}
+
+
+int main(void)
+{
+    uint32_t wakeups_no_slack;
+    uint32_t wakeups_slack;
+
+    srand(1);
+
+    printf("app_timer backend %s\n",
+           (APP_TIMER_BACKEND == APP_TIMER_BACKEND_WHEEL) ? "wheel" : "list");
+
+    wakeups_no_slack = repeated_run(0);
+    wakeups_slack    = repeated_run(4);
+    single_shot_run(false);
+    single_shot_run(true);
+    restart_run();
+
+    if (wakeups_slack >= wakeups_no_slack)
+    {
+        printf("slack did not reduce the number of wakeups\n");
+        m_errors++;
+    }
+
+    printf("%s\n", (m_errors == 0) ? "PASS" : "FAIL");
+
+    return (m_errors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,191 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include "rtc_sim.h"
+#include "nrf51_bitfields.h"
+
+#define RTC_COUNTER_MASK 0x00FFFFFF                 /**< The RTC counter has 24 bits. */
+
+NRF_RTC_Type rtc_sim_rtc1;
+SCB_Type     rtc_sim_scb;
+
+static bool     m_running;                          /**< RTC is counting. */
+static uint64_t m_time;                             /**< Ticks since the start of the simulation. */
+static uint32_t m_wakeups;                          /**< Number of COMPARE[0] interrupts. */
+static bool     m_in_irq;                           /**< An interrupt handler is running. */
+static bool     m_rtc1_enabled;                     /**< RTC1 interrupt enabled in the NVIC. */
+static bool     m_rtc1_pending;                     /**< RTC1 interrupt pending. */
+static bool     m_swi0_enabled;                     /**< SWI0 interrupt enabled in the NVIC. */
+static bool     m_swi0_pending;                     /**< SWI0 interrupt pending. */
+
+void RTC1_IRQHandler(void);
+void SWI0_IRQHandler(void);
+
+
+/**@brief Function for writing the read-only COUNTER register. */
+static void counter_set(uint32_t value)
+{
+    *(volatile uint32_t *)&rtc_sim_rtc1.COUNTER = value & RTC_COUNTER_MASK;
+}
+
+
+/**@brief Function for running pending interrupt handlers, one at a time. */
+static void irqs_run(void)
+{
+    m_in_irq = true;
+
+    for (;;)
+    {
+        if (m_rtc1_enabled && m_rtc1_pending)
+        {
+            m_rtc1_pending = false;
+            RTC1_IRQHandler();
+        }
+        else if (m_swi0_enabled && m_swi0_pending)
+        {
+            m_swi0_pending = false;
+            SWI0_IRQHandler();
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    m_in_irq = false;
+}
+
+
+void rtc_sim_irq_enable(IRQn_Type irqn, bool enable)
+{
+    if (irqn == RTC1_IRQn)
+    {
+        m_rtc1_enabled = enable;
+    }
+    else if (irqn == SWI0_IRQn)
+    {
+        m_swi0_enabled = enable;
+    }
+
+    if (enable && !m_in_irq)
+    {
+        irqs_run();
+    }
+}
+
+
+void rtc_sim_irq_pend(IRQn_Type irqn, bool pend)
+{
+    if (irqn == RTC1_IRQn)
+    {
+        m_rtc1_pending = pend;
+    }
+    else if (irqn == SWI0_IRQn)
+    {
+        m_swi0_pending = pend;
+    }
+
+    // Thread mode is preempted at once.
+    if (pend && !m_in_irq)
+    {
+        irqs_run();
+    }
+}
+
+
+void rtc_sim_tasks_process(void)
+{
+    if (rtc_sim_rtc1.TASKS_START != 0)
+    {
+        rtc_sim_rtc1.TASKS_START = 0;
+        m_running                = true;
+    }
+    if (rtc_sim_rtc1.TASKS_STOP != 0)
+    {
+        rtc_sim_rtc1.TASKS_STOP = 0;
+        m_running               = false;
+    }
+    if (rtc_sim_rtc1.TASKS_CLEAR != 0)
+    {
+        rtc_sim_rtc1.TASKS_CLEAR = 0;
+        counter_set(0);
+    }
+
+    // INTENSET and EVTENSET hold the enabled bits, clearing is applied here.
+    if (rtc_sim_rtc1.INTENCLR != 0)
+    {
+        rtc_sim_rtc1.INTENSET &= ~rtc_sim_rtc1.INTENCLR;
+        rtc_sim_rtc1.INTENCLR  = 0;
+    }
+    if (rtc_sim_rtc1.EVTENCLR != 0)
+    {
+        rtc_sim_rtc1.EVTENSET &= ~rtc_sim_rtc1.EVTENCLR;
+        rtc_sim_rtc1.EVTENCLR  = 0;
+    }
+}
+
+
+bool rtc_sim_run(uint64_t end_ticks)
+{
+    uint32_t ticks_to_compare;
+
+    rtc_sim_tasks_process();
+
+    if (!m_running || ((rtc_sim_rtc1.INTENSET & RTC_INTENSET_COMPARE0_Msk) == 0))
+    {
+        // The counter keeps running, but no interrupt will come.
+        if (m_running)
+        {
+            counter_set(rtc_sim_rtc1.COUNTER + (uint32_t)(end_ticks - m_time));
+        }
+        m_time = end_ticks;
+        return false;
+    }
+
+    // COMPARE[0] is generated when the counter changes to the value of CC[0].
+    ticks_to_compare = (rtc_sim_rtc1.CC[0] - rtc_sim_rtc1.COUNTER) & RTC_COUNTER_MASK;
+    if (ticks_to_compare == 0)
+    {
+        ticks_to_compare = RTC_COUNTER_MASK + 1;
+    }
+
+    if ((m_time + ticks_to_compare) > end_ticks)
+    {
+        counter_set(rtc_sim_rtc1.COUNTER + (uint32_t)(end_ticks - m_time));
+        m_time = end_ticks;
+        return false;
+    }
+
+    m_time += ticks_to_compare;
+    counter_set(rtc_sim_rtc1.CC[0]);
+    rtc_sim_rtc1.EVENTS_COMPARE[0] = 1;
+    m_wakeups++;
+
+    rtc_sim_irq_pend(RTC1_IRQn, true);
+
+    return true;
+}
+
+
+uint64_t rtc_sim_time_get(void)
+{
+    return m_time;
+}
+
+
+uint32_t rtc_sim_wakeups_get(void)
+{
+    uint32_t wakeups = m_wakeups;
+
+    m_wakeups = 0;
+    return wakeups;
+}
@@ -0,0 +1,88 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/** @file
+ *
+ * @defgroup rtc_sim RTC1 simulator
+ * @{
+ * @ingroup host_test
+ *
+ * @brief Host simulation of RTC1 and of the RTC1 and SWI0 interrupts used by app_timer.
+ *
+ * @details Included before app_timer.c (-include), this header redirects NRF_RTC1, SCB and the
+ *          NVIC functions to the simulator. RTC tasks take effect at the next nrf_delay_us(), as
+ *          app_timer waits for them that way. A pended interrupt runs at once in thread mode, and
+ *          after the running handler otherwise, as both interrupts have the same priority.
+ *          Time only moves on in rtc_sim_run(), which stops at every COMPARE[0] event.
+ *
+ *          The sizes in app_timer.h are those of the 32 bit target. They are widened here for
+ *          64 bit hosts, the module asserts that they are large enough.
+ */
+
+#ifndef RTC_SIM_H__
+#define RTC_SIM_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "nrf51.h"
+#include "nrf_delay.h"
+#include "app_timer.h"
+
+#undef  APP_TIMER_NODE_SIZE
+#define APP_TIMER_NODE_SIZE     64
+#undef  APP_TIMER_USER_OP_SIZE
+#define APP_TIMER_USER_OP_SIZE  32
+#undef  APP_TIMER_USER_SIZE
+#define APP_TIMER_USER_SIZE     16
+
+extern NRF_RTC_Type rtc_sim_rtc1;   /**< Simulated RTC1 registers. */
+extern SCB_Type     rtc_sim_scb;    /**< Simulated System Control Block, always in thread mode. */
+
+#undef  NRF_RTC1
+#define NRF_RTC1                    (&rtc_sim_rtc1)
+#undef  SCB
+#define SCB                         (&rtc_sim_scb)
+
+#define NVIC_SetPriority(IRQN, PRI) ((void)(IRQN), (void)(PRI))
+#define NVIC_EnableIRQ(IRQN)        rtc_sim_irq_enable((IRQN), true)
+#define NVIC_DisableIRQ(IRQN)       rtc_sim_irq_enable((IRQN), false)
+#define NVIC_SetPendingIRQ(IRQN)    rtc_sim_irq_pend((IRQN), true)
+#define NVIC_ClearPendingIRQ(IRQN)  rtc_sim_irq_pend((IRQN), false)
+#define nrf_delay_us(US)            rtc_sim_tasks_process()
+
+/**@brief Function for enabling or disabling the RTC1 or SWI0 interrupt. */
+void rtc_sim_irq_enable(IRQn_Type irqn, bool enable);
+
+/**@brief Function for setting or clearing the pending state of the RTC1 or SWI0 interrupt. */
+void rtc_sim_irq_pend(IRQn_Type irqn, bool pend);
+
+/**@brief Function for executing the RTC tasks triggered since the last call. */
+void rtc_sim_tasks_process(void);
+
+/**@brief Function for running time until the next COMPARE[0] event or until the given time.
+ *
+ * @param[in] end_ticks  Time (in ticks since the start of the simulation) not to run past.
+ *
+ * @retval true   A COMPARE[0] interrupt was handled.
+ * @retval false  End time reached.
+ */
+bool rtc_sim_run(uint64_t end_ticks);
+
+/**@brief Function for getting the time in ticks since the start of the simulation. */
+uint64_t rtc_sim_time_get(void);
+
+/**@brief Function for getting and resetting the number of COMPARE[0] interrupts. */
+uint32_t rtc_sim_wakeups_get(void);
+
+#endif // RTC_SIM_H__
+
+/** @} */
@@ -0,0 +1,408 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/** @file
+ *
+ * @brief Test and benchmark of the CRC-16 engines (crc16.c).
+ *
+ * @details crc16.c is compiled into this program once for every engine of @ref CRC16_ENGINES,
+ *          with its functions and tables renamed, so that the engines can be compared directly.
+ *
+ *          Test: the check value of every engine is compared with the CRC-16-CCITT one. The engines
+ *          are then fuzzed against each other and against a bitwise reference:
+ *          - crc16_compute() on random data of random length at every alignment, both with
+ *            p_crc NULL and with a random previous CRC value.
+ *          - The same data split into random blocks, chained through p_crc of crc16_compute() and
+ *            through crc16_init(), crc16_update() and crc16_final(), which must give the CRC of
+ *            the whole data.
+ *
+ *          Benchmark: nanoseconds per byte of every engine and of the bitwise reference, for
+ *          blocks of several lengths.
+ *
+ *          Usage: crc16_test [-n iterations] [-s seed]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "crc16.h"
+
+#undef  CRC16_ENGINE
+#define CRC16_ENGINE            CRC16_ENGINE_COMPACT
+#define crc16_init              compact_crc16_init
+#define crc16_update            compact_crc16_update
+#define crc16_final             compact_crc16_final
+#define crc16_compute           compact_crc16_compute
+#include "crc16.c"
+#undef  CRC16_INIT_VALUE
+#undef  crc16_init
+#undef  crc16_update
+#undef  crc16_final
+#undef  crc16_compute
+
+#undef  CRC16_ENGINE
+#define CRC16_ENGINE            CRC16_ENGINE_TABLE
+#define crc16_init              table_crc16_init
+#define crc16_update            table_crc16_update
+#define crc16_final             table_crc16_final
+#define crc16_compute           table_crc16_compute
+#define m_crc16_table           m_table_crc16_table
+#include "crc16.c"
+#undef  CRC16_INIT_VALUE
+#undef  crc16_init
+#undef  crc16_update
+#undef  crc16_final
+#undef  crc16_compute
+#undef  m_crc16_table
+
+#undef  CRC16_ENGINE
+#define CRC16_ENGINE            CRC16_ENGINE_SLICE_BY_4
+#define crc16_init              slice_crc16_init
+#define crc16_update            slice_crc16_update
+#define crc16_final             slice_crc16_final
+#define crc16_compute           slice_crc16_compute
+#define m_crc16_table           m_slice_crc16_table
+#define m_crc16_slice_table     m_slice_crc16_slice_table
+#include "crc16.c"
+#undef  CRC16_INIT_VALUE
+#undef  crc16_init
+#undef  crc16_update
+#undef  crc16_final
+#undef  crc16_compute
+#undef  m_crc16_table
+#undef  m_crc16_slice_table
+
+#define MAX_DATA_SIZE   1024                                /**< Max length of fuzzed data in bytes. */
+#define MAX_ALIGNMENT   8                                   /**< Fuzzed data starts at an offset from 0 to MAX_ALIGNMENT - 1. */
+#define MAX_BLOCKS      8                                   /**< Max number of blocks fuzzed data is split into. */
+#define BENCH_SIZE      (1024 * 1024)                       /**< Number of bytes processed by every benchmark. */
+#define CHECK_VALUE     0x29B1                              /**< CRC-16-CCITT of "123456789" with initial value 0xFFFF. */
+#define ARRAY_SIZE(a)   (sizeof(a) / sizeof((a)[0]))        /**< Number of elements of an array. */
+
+/**@brief CRC-16 engine under test. */
+typedef struct
+{
+    const char * p_name;                                                                        /**< Name of the engine. */
+    uint16_t  (* compute)(const uint8_t * p_data, uint32_t size, const uint16_t * p_crc);       /**< crc16_compute() of the engine. */
+    uint16_t  (* init)(void);                                                                   /**< crc16_init() of the engine. */
+    uint16_t  (* update)(uint16_t crc, const uint8_t * p_data, uint32_t size);                  /**< crc16_update() of the engine. */
+    uint16_t  (* final)(uint16_t crc);                                                          /**< crc16_final() of the engine. */
+} engine_t;
+
+static uint16_t ref_compute(const uint8_t * p_data, uint32_t size, const uint16_t * p_crc);
+static uint16_t ref_init(void);
+static uint16_t ref_update(uint16_t crc, const uint8_t * p_data, uint32_t size);
+static uint16_t ref_final(uint16_t crc);
+
+static const engine_t m_engines[] =
+{
+    {"compact",   compact_crc16_compute, compact_crc16_init, compact_crc16_update, compact_crc16_final},
+    {"table",     table_crc16_compute,   table_crc16_init,   table_crc16_update,   table_crc16_final},
+    {"slice-by-4", slice_crc16_compute,  slice_crc16_init,   slice_crc16_update,   slice_crc16_final},
+    {"reference", ref_compute,           ref_init,           ref_update,           ref_final},
+};
+
+static uint32_t m_errors;                                   /**< Number of failed checks. */
+
+
+/**@brief Function for getting host time in nanoseconds. */
+static uint64_t host_ns_get(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ull) + (uint64_t)ts.tv_nsec;
+}
+
+
+/**@brief Function for reporting a failed check. */
+static bool check(bool ok, char const * p_what, uint32_t iteration)
+{
+    if (!ok && (m_errors++ < 10))
+    {
+        printf("iteration %u: %s\n", (unsigned)iteration, p_what);
+    }
+    return ok;
+}
+
+
+/**@brief Function for getting a random number from 0 to limit - 1. */
+static uint32_t random_get(uint32_t limit)
+{
+    return (limit != 0) ? ((uint32_t)rand() % limit) : 0;
+}
+
+
+/**@brief Reference CRC-16-CCITT, one bit at a time. */
+static uint16_t ref_update(uint16_t crc, const uint8_t * p_data, uint32_t size)
+{
+    uint32_t i;
+    uint32_t bit;
+
+    for (i = 0; i < size; i++)
+    {
+        crc ^= (uint16_t)(p_data[i] << 8);
+        for (bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+
+static uint16_t ref_init(void)
+{
+    return 0xFFFF;
+}
+
+
+static uint16_t ref_final(uint16_t crc)
+{
+    return crc;
+}
+
+
+static uint16_t ref_compute(const uint8_t * p_data, uint32_t size, const uint16_t * p_crc)
+{
+    return ref_update((p_crc == NULL) ? ref_init() : *p_crc, p_data, size);
+}
+
+
+/**@brief Function for getting a random data length, biased towards lengths around a multiple
+ *        of four, where the slice-by-4 engine switches from four bytes to one byte per iteration.
+ */
+static uint32_t random_length_get(void)
+{
+    switch (random_get(3))
+    {
+        case 0:
+            return random_get(16);
+
+        case 1:
+            return 4 * random_get(MAX_DATA_SIZE / 4) + random_get(4);
+
+        default:
+            return random_get(MAX_DATA_SIZE + 1);
+    }
+}
+
+
+/**@brief The check value of every engine. */
+static void check_value_test(void)
+{
+    static const uint8_t data[] = "123456789";
+    uint32_t             i;
+
+    for (i = 0; i < ARRAY_SIZE(m_engines); i++)
+    {
+        check(m_engines[i].compute(data, sizeof(data) - 1, NULL) == CHECK_VALUE,
+              m_engines[i].p_name, 0);
+    }
+}
+
+
+/**@brief crc16_compute() of every engine on random data, compared with the reference. */
+static void compute_fuzz(uint32_t iterations)
+{
+    static uint8_t buffer[MAX_ALIGNMENT + MAX_DATA_SIZE];
+
+    uint8_t * p_data;
+    uint32_t  length;
+    uint16_t  seed;
+    uint16_t  expected;
+    uint32_t  n;
+    uint32_t  i;
+
+    for (n = 0; n < iterations; n++)
+    {
+        for (i = 0; i < sizeof(buffer); i++)
+        {
+            buffer[i] = (uint8_t)rand();
+        }
+        p_data = &buffer[random_get(MAX_ALIGNMENT)];
+        length = random_length_get();
+        seed   = (uint16_t)rand();
+
+        expected = ref_compute(p_data, length, NULL);
+        for (i = 0; i < ARRAY_SIZE(m_engines); i++)
+        {
+            check(m_engines[i].compute(p_data, length, NULL) == expected, m_engines[i].p_name, n);
+        }
+
+        expected = ref_compute(p_data, length, &seed);
+        for (i = 0; i < ARRAY_SIZE(m_engines); i++)
+        {
+            check(m_engines[i].compute(p_data, length, &seed) == expected, m_engines[i].p_name, n);
+        }
+    }
+}
+
+
+/**@brief Random data split into random blocks and chained through every engine, compared with
+ *        the CRC of the whole data.
+ */
+static void chain_fuzz(uint32_t iterations)
+{
+    static uint8_t buffer[MAX_ALIGNMENT + MAX_DATA_SIZE];
+
+    uint32_t block_end[MAX_BLOCKS];
+    uint32_t block_count;
+    uint8_t * p_data;
+    uint32_t  length;
+    uint32_t  start;
+    uint16_t  expected;
+    uint16_t  chained;
+    uint16_t  streamed;
+    uint32_t  n;
+    uint32_t  i;
+    uint32_t  j;
+
+    for (n = 0; n < iterations; n++)
+    {
+        for (i = 0; i < sizeof(buffer); i++)
+        {
+            buffer[i] = (uint8_t)rand();
+        }
+        p_data = &buffer[random_get(MAX_ALIGNMENT)];
+        length = random_length_get();
+
+        // Random block boundaries in ascending order, the last block ending at the data end.
+        block_count = 1 + random_get(MAX_BLOCKS);
+        for (j = 0; j < block_count - 1; j++)
+        {
+            block_end[j] = random_get(length + 1);
+        }
+        block_end[block_count - 1] = length;
+        for (j = 1; j < block_count; j++)
+        {
+            for (i = j; (i > 0) && (block_end[i - 1] > block_end[i]); i--)
+            {
+                uint32_t swap    = block_end[i];
+                block_end[i]     = block_end[i - 1];
+                block_end[i - 1] = swap;
+            }
+        }
+
+        expected = ref_compute(p_data, length, NULL);
+
+        for (i = 0; i < ARRAY_SIZE(m_engines); i++)
+        {
+            const engine_t * p_engine = &m_engines[i];
+
+            start    = 0;
+            chained  = p_engine->compute(p_data, block_end[0], NULL);
+            streamed = p_engine->update(p_engine->init(), p_data, block_end[0]);
+            for (j = 1; j < block_count; j++)
+            {
+                start    = block_end[j - 1];
+                chained  = p_engine->compute(&p_data[start], block_end[j] - start, &chained);
+                streamed = p_engine->update(streamed, &p_data[start], block_end[j] - start);
+            }
+            streamed = p_engine->final(streamed);
+
+            check(chained == expected, p_engine->p_name, n);
+            check(streamed == expected, p_engine->p_name, n);
+        }
+    }
+}
+
+
+/**@brief Benchmark of every engine on blocks of the given length. */
+static void bench(uint32_t block_length)
+{
+    static uint8_t data[BENCH_SIZE];
+
+    volatile uint16_t sink;
+    uint32_t          blocks = BENCH_SIZE / block_length;
+    uint16_t          crc;
+    uint64_t          start;
+    uint64_t          ns[ARRAY_SIZE(m_engines)];
+    uint32_t          i;
+    uint32_t          j;
+
+    for (i = 0; i < sizeof(data); i++)
+    {
+        data[i] = (uint8_t)rand();
+    }
+
+    for (i = 0; i < ARRAY_SIZE(m_engines); i++)
+    {
+        // Chained through p_crc, so that the calls cannot overlap.
+        crc   = m_engines[i].init();
+        start = host_ns_get();
+        for (j = 0; j < blocks; j++)
+        {
+            crc = m_engines[i].compute(&data[j * block_length], block_length, &crc);
+        }
+        ns[i] = host_ns_get() - start;
+        sink  = crc;
+    }
+    (void)sink;
+
+    printf("%4u byte blocks:", (unsigned)block_length);
+    for (i = 0; i < ARRAY_SIZE(m_engines); i++)
+    {
+        printf(" %6.2f", (double)ns[i] / (blocks * block_length));
+    }
+    printf(" ns/byte (");
+    for (i = 0; i < ARRAY_SIZE(m_engines); i++)
+    {
+        printf("%s%s", m_engines[i].p_name, (i + 1 < ARRAY_SIZE(m_engines)) ? ", " : ")\n");
+    }
+}
+
+
+int main(int argc, char * argv[])
+{
+    uint32_t iterations = 20000;
+    unsigned seed       = 1;
+    int      opt;
+
+    while ((opt = getopt(argc, argv, "n:s:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'n':
+                iterations = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+
+            case 's':
+                seed = (unsigned)strtoul(optarg, NULL, 0);
+                break;
+
+            default:
+                fprintf(stderr, "usage: %s [-n iterations] [-s seed]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    srand(seed);
+
+    printf("CRC-16 engines, %u iterations, seed %u\n", (unsigned)iterations, seed);
+
+    check_value_test();
+    compute_fuzz(iterations);
+    chain_fuzz(iterations);
+
+    bench(4);
+    bench(20);
+    bench(256);
+    bench(1024);
+
+    printf("%s\n", (m_errors == 0) ? "PASS" : "FAIL");
+
+    return (m_errors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
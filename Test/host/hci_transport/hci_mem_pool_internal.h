@@ -0,0 +1,32 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/** @file
+ *
+ * @brief Memory pool configuration of the host test.
+ *
+ * @details Packets have to fit the receive buffer of the SLIP link simulator. The number of TX
+ *          buffers, which is the TX window of the HCI Transport, is set by the Makefile.
+ */
+
+#ifndef MEM_POOL_INTERNAL_H__
+#define MEM_POOL_INTERNAL_H__
+
+#define TX_BUF_SIZE       256u         /**< TX buffer size in bytes. */
+#define RX_BUF_SIZE       TX_BUF_SIZE  /**< RX buffer size in bytes. */
+
+#ifndef TX_BUF_QUEUE_SIZE
+#define TX_BUF_QUEUE_SIZE 1u           /**< Number of TX buffers, i.e. of application packets which can be in flight (1, 2 or 4). */
+#endif
+#define RX_BUF_QUEUE_SIZE 4u           /**< RX buffer element size. */
+
+#endif // MEM_POOL_INTERNAL_H__
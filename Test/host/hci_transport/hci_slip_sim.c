@@ -0,0 +1,201 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include <string.h>
+#include "hci_slip_sim.h"
+#include "slip_sim.h"
+#include "app_error.h"
+#include "nrf_error.h"
+#include "nordic_common.h"
+
+#define PKT_HDR_SIZE    4u                      /**< Size of the HCI packet header, the rest is passed to the simulator as payload. */
+
+/**@brief SLIP layer of one side. */
+typedef struct
+{
+    hci_slip_event_handler_t handler;           /**< Event handler of the upper layer. */
+    bool                     is_open;           /**< The layer is open. */
+    bool                     is_tx_busy;        /**< A packet is being transmitted. */
+    const uint8_t *          p_tx_buffer;       /**< Packet being transmitted. */
+    uint32_t                 tx_length;         /**< Length of the packet being transmitted. */
+    uint8_t *                p_rx_buffer;       /**< Registered RX buffer, NULL when none. */
+    uint32_t                 rx_length;         /**< Size of the registered RX buffer. */
+} slip_t;
+
+static slip_t                m_slips[SLIP_SIM_SIDES];
+static hci_slip_sim_filter_t m_filter;          /**< Filter of arriving packets. */
+
+
+/**@brief Function for handling an event of the simulator for one side. */
+static void sim_evt_handle(uint32_t side, ser_phy_hci_slip_evt_t * p_event)
+{
+    slip_t *       p_slip = &m_slips[side];
+    hci_slip_evt_t event;
+
+    switch (p_event->evt_type)
+    {
+        case SER_PHY_HCI_SLIP_EVT_PKT_SENT:
+        case SER_PHY_HCI_SLIP_EVT_ACK_SENT:
+            p_slip->is_tx_busy = false;
+            if (p_slip->handler != NULL)
+            {
+                event.evt_type      = HCI_SLIP_TX_DONE;
+                event.packet        = p_slip->p_tx_buffer;
+                event.packet_length = p_slip->tx_length;
+                p_slip->handler(event);
+            }
+            break;
+
+        case SER_PHY_HCI_SLIP_EVT_PKT_RECEIVED:
+        {
+            uint8_t * const p_packet = p_event->evt_params.received_pkt.p_buffer;
+            const uint32_t  length   = p_event->evt_params.received_pkt.num_of_bytes;
+            const bool      receive  = (m_filter == NULL) || m_filter(side, p_packet, length);
+
+            if (receive && (p_slip->handler != NULL))
+            {
+                if ((p_slip->p_rx_buffer == NULL) || (length > p_slip->rx_length))
+                {
+                    event.evt_type      = HCI_SLIP_RX_OVERFLOW;
+                    event.packet        = p_slip->p_rx_buffer;
+                    event.packet_length = p_slip->rx_length;
+                }
+                else
+                {
+                    memcpy(p_slip->p_rx_buffer, p_packet, length);
+                    event.evt_type      = HCI_SLIP_RX_RDY;
+                    event.packet        = p_slip->p_rx_buffer;
+                    event.packet_length = length;
+
+                    // No new packet is received until a new RX buffer is registered.
+                    p_slip->p_rx_buffer = NULL;
+                    p_slip->rx_length   = 0;
+                }
+                APP_ERROR_CHECK(slip_sim_rx_buf_free(side, p_packet));
+                p_slip->handler(event);
+            }
+            else
+            {
+                APP_ERROR_CHECK(slip_sim_rx_buf_free(side, p_packet));
+            }
+            break;
+        }
+
+        default:
+            if (p_slip->handler != NULL)
+            {
+                event.evt_type      = HCI_SLIP_ERROR;
+                event.packet        = NULL;
+                event.packet_length = 0;
+                p_slip->handler(event);
+            }
+            break;
+    }
+}
+
+
+static void side_0_evt_handler(ser_phy_hci_slip_evt_t * p_event)
+{
+    sim_evt_handle(0, p_event);
+}
+
+
+static void side_1_evt_handler(ser_phy_hci_slip_evt_t * p_event)
+{
+    sim_evt_handle(1, p_event);
+}
+
+
+void hci_slip_sim_filter_set(hci_slip_sim_filter_t filter)
+{
+    m_filter = filter;
+}
+
+
+uint32_t hci_slip_sim_evt_handler_register(uint32_t side, hci_slip_event_handler_t event_handler)
+{
+    m_slips[side].handler = event_handler;
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t hci_slip_sim_open(uint32_t side)
+{
+    slip_t * p_slip = &m_slips[side];
+
+    if (p_slip->is_open)
+    {
+        return NRF_SUCCESS;
+    }
+
+    p_slip->is_open     = true;
+    p_slip->is_tx_busy  = false;
+    p_slip->p_rx_buffer = NULL;
+    p_slip->rx_length   = 0;
+
+    return slip_sim_open(side, (side == 0) ? side_0_evt_handler : side_1_evt_handler);
+}
+
+
+uint32_t hci_slip_sim_close(uint32_t side)
+{
+    m_slips[side].is_open = false;
+    slip_sim_close(side);
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t hci_slip_sim_write(uint32_t side, const uint8_t * p_buffer, uint32_t length)
+{
+    slip_t *                 p_slip = &m_slips[side];
+    ser_phy_hci_pkt_params_t header;
+    ser_phy_hci_pkt_params_t payload;
+
+    if (p_buffer == NULL)
+    {
+        return NRF_ERROR_INVALID_ADDR;
+    }
+    if (!p_slip->is_open)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+    if (p_slip->is_tx_busy)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    header.p_buffer      = (uint8_t *)p_buffer;
+    header.num_of_bytes  = (uint16_t)MIN(length, PKT_HDR_SIZE);
+    payload.p_buffer     = (uint8_t *)&p_buffer[header.num_of_bytes];
+    payload.num_of_bytes = (uint16_t)(length - header.num_of_bytes);
+
+    APP_ERROR_CHECK(slip_sim_tx_pkt_send(side,
+                                         &header,
+                                         (payload.num_of_bytes != 0) ? &payload : NULL,
+                                         NULL));
+    p_slip->is_tx_busy  = true;
+    p_slip->p_tx_buffer = p_buffer;
+    p_slip->tx_length   = length;
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t hci_slip_sim_rx_buffer_register(uint32_t side, uint8_t * p_buffer, uint32_t length)
+{
+    m_slips[side].p_rx_buffer = p_buffer;
+    m_slips[side].rx_length   = length;
+
+    return NRF_SUCCESS;
+}
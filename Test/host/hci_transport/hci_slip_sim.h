@@ -0,0 +1,62 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/** @file
+ *
+ * @brief The SLIP layer of hci_slip.h on the SLIP link simulator (slip_sim.h).
+ *
+ * @details Every side has the API of hci_slip.h, with the index of the side as first parameter.
+ *          As in hci_slip.c, one packet is transmitted at a time, and the RX buffer is released
+ *          when a packet has been received into it, until the upper layer registers a buffer again.
+ *          A packet which does not fit the registered buffer is dropped with one
+ *          HCI_SLIP_RX_OVERFLOW event.
+ *
+ *          A filter sees every packet which arrives at a side and can drop it, so that a test can
+ *          lose chosen packets.
+ */
+
+#ifndef HCI_SLIP_SIM_H__
+#define HCI_SLIP_SIM_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hci_slip.h"
+
+/**@brief Filter of arriving packets.
+ *
+ * @param[in] side      Receiving side.
+ * @param[in] p_packet  Packet data, header first.
+ * @param[in] length    Length of the packet in bytes.
+ *
+ * @return true to receive the packet, false to drop it.
+ */
+typedef bool (*hci_slip_sim_filter_t)(uint32_t side, const uint8_t * p_packet, uint32_t length);
+
+/**@brief Function for setting the filter of arriving packets, NULL to receive every packet. */
+void hci_slip_sim_filter_set(hci_slip_sim_filter_t filter);
+
+/**@brief Simulation of hci_slip_evt_handler_register for one side. */
+uint32_t hci_slip_sim_evt_handler_register(uint32_t side, hci_slip_event_handler_t event_handler);
+
+/**@brief Simulation of hci_slip_open for one side. */
+uint32_t hci_slip_sim_open(uint32_t side);
+
+/**@brief Simulation of hci_slip_close for one side. */
+uint32_t hci_slip_sim_close(uint32_t side);
+
+/**@brief Simulation of hci_slip_write for one side. */
+uint32_t hci_slip_sim_write(uint32_t side, const uint8_t * p_buffer, uint32_t length);
+
+/**@brief Simulation of hci_slip_rx_buffer_register for one side. */
+uint32_t hci_slip_sim_rx_buffer_register(uint32_t side, uint8_t * p_buffer, uint32_t length);
+
+#endif // HCI_SLIP_SIM_H__
@@ -0,0 +1,21 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/** @file
+ *
+ * @brief HCI Transport of side 1 (b) of the link.
+ */
+
+#define HCI_TRANSPORT_SIDE          1
+#define HCI_TRANSPORT_SIDE_SUFFIX   b
+
+#include "hci_transport_instance.h"
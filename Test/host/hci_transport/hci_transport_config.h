@@ -0,0 +1,26 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/** @file
+ *
+ * @brief HCI Transport configuration of the host test, as the serial DFU bootloader sets it.
+ *
+ * @details The SLIP layer is simulated, so no UART pins are needed.
+ */
+
+#ifndef HCI_TRANSPORT_CONFIG_H__
+#define HCI_TRANSPORT_CONFIG_H__
+
+#define MAX_PACKET_SIZE_IN_BITS      8000u                              /**< Maximum size of a single application packet in bits. */
+#define USED_BAUD_RATE               38400u                             /**< The used uart baudrate. */
+
+#endif // HCI_TRANSPORT_CONFIG_H__
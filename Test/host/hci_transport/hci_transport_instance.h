@@ -0,0 +1,74 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/** @file
+ *
+ * @brief One instance of hci_transport.c and its memory pool on the SLIP link simulator.
+ *
+ * @details Included by a source file which defines HCI_TRANSPORT_SIDE (index of the side in the
+ *          simulator) and HCI_TRANSPORT_SIDE_SUFFIX (appended to the global names of the instance).
+ */
+
+#include "hci_transport_sides.h"
+#include "hci_mem_pool.h"
+#include "hci_slip_sim.h"
+
+#define SIDE_NAME(NAME)             SIDE_NAME_(NAME, HCI_TRANSPORT_SIDE_SUFFIX)
+#define SIDE_NAME_(NAME, SUFFIX)    SIDE_NAME__(NAME, SUFFIX)
+#define SIDE_NAME__(NAME, SUFFIX)   NAME##_##SUFFIX
+
+// Global names of hci_transport.c.
+#define hci_transport_evt_handler_reg   SIDE_NAME(hci_transport_evt_handler_reg)
+#define hci_transport_tx_done_register  SIDE_NAME(hci_transport_tx_done_register)
+#define hci_transport_open              SIDE_NAME(hci_transport_open)
+#define hci_transport_close             SIDE_NAME(hci_transport_close)
+#define hci_transport_tx_alloc          SIDE_NAME(hci_transport_tx_alloc)
+#define hci_transport_tx_free           SIDE_NAME(hci_transport_tx_free)
+#define hci_transport_pkt_write         SIDE_NAME(hci_transport_pkt_write)
+#define hci_transport_rx_pkt_extract    SIDE_NAME(hci_transport_rx_pkt_extract)
+#define hci_transport_rx_pkt_consume    SIDE_NAME(hci_transport_rx_pkt_consume)
+#define hci_transport_timeout_handle    SIDE_NAME(hci_transport_timeout_handle)
+#define slip_event_handle               SIDE_NAME(slip_event_handle)
+
+// Global names of hci_mem_pool.c.
+#define hci_mem_pool_open               SIDE_NAME(hci_mem_pool_open)
+#define hci_mem_pool_close              SIDE_NAME(hci_mem_pool_close)
+#define hci_mem_pool_tx_alloc           SIDE_NAME(hci_mem_pool_tx_alloc)
+#define hci_mem_pool_tx_free            SIDE_NAME(hci_mem_pool_tx_free)
+#define hci_mem_pool_rx_produce         SIDE_NAME(hci_mem_pool_rx_produce)
+#define hci_mem_pool_rx_consume         SIDE_NAME(hci_mem_pool_rx_consume)
+#define hci_mem_pool_rx_data_size_set   SIDE_NAME(hci_mem_pool_rx_data_size_set)
+#define hci_mem_pool_rx_extract         SIDE_NAME(hci_mem_pool_rx_extract)
+
+// SLIP layer of this side.
+#define hci_slip_evt_handler_register(HANDLER)  hci_slip_sim_evt_handler_register(HCI_TRANSPORT_SIDE, (HANDLER))
+#define hci_slip_open()                         hci_slip_sim_open(HCI_TRANSPORT_SIDE)
+#define hci_slip_close()                        hci_slip_sim_close(HCI_TRANSPORT_SIDE)
+#define hci_slip_write(BUFFER, LENGTH)          hci_slip_sim_write(HCI_TRANSPORT_SIDE, (BUFFER), (LENGTH))
+#define hci_slip_rx_buffer_register(BUFFER, LENGTH) \
+    hci_slip_sim_rx_buffer_register(HCI_TRANSPORT_SIDE, (BUFFER), (LENGTH))
+
+#include "hci_mem_pool.c"
+#include "hci_transport.c"
+
+const hci_transport_api_t SIDE_NAME(hci_transport) =
+{
+    .evt_handler_reg  = hci_transport_evt_handler_reg,
+    .tx_done_register = hci_transport_tx_done_register,
+    .open             = hci_transport_open,
+    .close            = hci_transport_close,
+    .tx_alloc         = hci_transport_tx_alloc,
+    .tx_free          = hci_transport_tx_free,
+    .pkt_write        = hci_transport_pkt_write,
+    .rx_pkt_extract   = hci_transport_rx_pkt_extract,
+    .rx_pkt_consume   = hci_transport_rx_pkt_consume,
+};
@@ -0,0 +1,45 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/** @file
+ *
+ * @brief The two instances of the HCI Transport connected by the SLIP link simulator.
+ *
+ * @details hci_transport.c and hci_mem_pool.c keep their state in static variables, so they are
+ *          built once for every side (hci_transport_a.c and hci_transport_b.c), with the global
+ *          functions renamed. The test calls them through these tables.
+ */
+
+#ifndef HCI_TRANSPORT_SIDES_H__
+#define HCI_TRANSPORT_SIDES_H__
+
+#include <stdint.h>
+#include "hal_transport.h"
+
+/**@brief HCI Transport API of one instance. */
+typedef struct
+{
+    uint32_t (*evt_handler_reg)(hci_transport_event_handler_t event_handler);
+    uint32_t (*tx_done_register)(hci_transport_tx_done_handler_t event_handler);
+    uint32_t (*open)(void);
+    uint32_t (*close)(void);
+    uint32_t (*tx_alloc)(uint8_t ** pp_memory);
+    uint32_t (*tx_free)(void);
+    uint32_t (*pkt_write)(const uint8_t * p_buffer, uint16_t length);
+    uint32_t (*rx_pkt_extract)(uint8_t ** pp_buffer, uint16_t * p_length);
+    uint32_t (*rx_pkt_consume)(uint8_t * p_buffer);
+} hci_transport_api_t;
+
+extern const hci_transport_api_t hci_transport_a;   /**< Side 0 of the link. */
+extern const hci_transport_api_t hci_transport_b;   /**< Side 1 of the link. */
+
+#endif // HCI_TRANSPORT_SIDES_H__
@@ -0,0 +1,692 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/** @file
+ *
+ * @brief Loopback test of the HCI Transport TX window and retransmission timer with packet loss.
+ *
+ * @details Loopback: two instances of hci_transport.c send packets of random length to each other
+ *          over the SLIP link simulator, which loses and corrupts packets on purpose. Every packet
+ *          must be received once, in order and unchanged, and every packet written must be
+ *          reported as sent. The receiver can be made to consume its packets late, so that its
+ *          memory pool runs out of RX buffers. With -u only side 0 sends, as in a DFU, where the
+ *          device only acknowledges.
+ *
+ *          Scenarios (-t), side 0 sends and side 1 loses chosen packets:
+ *          - dupack:  the first transmission of packet 1 is lost. The packets after it are received
+ *                     out of sequence, and the first duplicate acknowledgement makes the sender
+ *                     rewind at once, long before the retransmission timeout. It rewinds only once
+ *                     for all the duplicate acknowledgements. Needs a window of 2 or more.
+ *          - backoff: after a few packets without loss, which bring the timeout below its initial
+ *                     value, every packet is lost. The timeout doubles on every retransmission up
+ *                     to four times the initial value. After MAX_RETRY_COUNT retransmissions every
+ *                     packet of the window is reported as failed at once, and the following
+ *                     packets are received, as the sequence numbers of the failed ones are reused.
+ *
+ *          Usage: hci_transport_test [-n packets] [-l max length] [-d drop permille]
+ *                                    [-c corrupt permille] [-r rx consume delay us] [-s seed] [-u]
+ *                 hci_transport_test -t dupack|backoff
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "hci_transport_sides.h"
+#include "hci_transport_config.h"
+#include "hci_mem_pool_internal.h"
+#include "hci_slip_sim.h"
+#include "slip_sim.h"
+#include "app_timer.h"
+#include "app_error.h"
+#include "app_util.h"
+#include "nrf_error.h"
+#include "nordic_common.h"
+
+#define PRESCALER       0                       /**< RTC1 prescaler, as APP_TIMER_PRESCALER in hci_transport.c. */
+#define BAUDRATE        USED_BAUD_RATE          /**< UART baud rate. */
+#define BITS_PER_BYTE   10                      /**< Start, 8 data and stop bits. */
+#define MAX_TIMERS      SLIP_SIM_SIDES          /**< One retransmission timer per side. */
+#define OP_QUEUE_SIZE   4                       /**< Size of the timer operation queues. */
+#define PKT_HDR_SIZE    4u                      /**< Size of the packet header, as in hci_transport.c. */
+#define PKT_CRC_SIZE    2u                      /**< Size of the packet CRC, as in hci_transport.c. */
+#define MAX_LENGTH      (TX_BUF_SIZE - PKT_HDR_SIZE - PKT_CRC_SIZE) /**< Maximum payload length. */
+#define MIN_LENGTH      4u                      /**< Minimum payload length, the packet number. */
+#define WINDOW          TX_BUF_QUEUE_SIZE       /**< TX window of the HCI Transport. */
+#define MAX_RETRY_COUNT 5u                      /**< Retransmissions before failure, as in hci_transport.c. */
+#define RTO_INITIAL     APP_TIMER_TICKS(3u * ROUNDED_DIV(MAX_PACKET_SIZE_IN_BITS * 1000u, USED_BAUD_RATE), \
+                                        PRESCALER) /**< Initial retransmission timeout in ticks, as in hci_transport.c. */
+#define RTO_MAX         (4u * RTO_INITIAL)      /**< Upper bound of the retransmission timeout in ticks, as in hci_transport.c. */
+#define RTO_TOLERANCE   4u                      /**< Tolerance of a measured timeout in ticks. */
+#define RTC_FREQ        32768ull                /**< RTC1 ticks per second (prescaler 0). */
+#define NS_PER_S        1000000000ull           /**< Nanoseconds per second. */
+#define STALL_LIMIT_NS  60000000000ull          /**< Time without progress after which the test fails. */
+#define SETTLE_NS       5000000000ull           /**< Time run after the last packet, duplicates would come in it. */
+#define SCENARIO_LENGTH 16u                     /**< Payload length of the packets of the scenarios. */
+#define LOG_PKTS        32u                     /**< Number of packets whose transmissions are logged. */
+#define LOG_TXS         (MAX_RETRY_COUNT + 2u)  /**< Number of logged transmissions of a packet. */
+
+/**@brief One side of the test. */
+typedef struct
+{
+    hci_transport_api_t const * p_api;          /**< HCI Transport of the side. */
+    uint32_t                    tx_total;       /**< Packets to write. */
+    uint32_t                    tx_cnt;         /**< Packets written. */
+    uint32_t                    tx_done_cnt;    /**< Packets reported as sent. */
+    uint32_t                    tx_failed_cnt;  /**< Packets reported as failed. */
+    uint64_t                    tx_failed_ns[2]; /**< Times of the first and the last failure. */
+    uint32_t                    rx_cnt;         /**< Packets received. */
+    uint32_t                    rx_next;        /**< Lowest number of the next packet received. */
+    uint64_t                    rx_bytes;       /**< Payload bytes received. */
+    uint64_t                    rx_done_ns;     /**< Time when the last packet was received. */
+    uint8_t *                   rx_held[RX_BUF_QUEUE_SIZE]; /**< Packets not consumed yet, oldest first. */
+    uint32_t                    rx_held_cnt;    /**< Number of packets not consumed yet. */
+} side_t;
+
+static uint32_t m_timer_buf[CEIL_DIV(APP_TIMER_BUF_SIZE(MAX_TIMERS, OP_QUEUE_SIZE + 1),
+                                     sizeof(uint32_t))];    /**< Buffer of the timer module. */
+static side_t   m_sides[SLIP_SIM_SIDES];
+static uint32_t m_max_length  = MAX_LENGTH;
+static uint64_t m_rx_delay_ns = 0;                          /**< Delay of consuming a received packet. */
+static uint64_t m_start_ns;                                 /**< Time when the first packets were written. */
+static uint64_t m_progress_ns;                              /**< Time of the last packet sent or received. */
+static uint32_t m_errors;                                   /**< Number of failed checks. */
+
+static bool     m_drop_all;                                 /**< Side 1 loses every packet of side 0. */
+static uint32_t m_drop_once = UINT32_MAX;                   /**< Side 1 loses the first transmission of this packet. */
+static uint64_t m_tx_log[LOG_PKTS][LOG_TXS];                /**< Transmission start times of the packets of side 0. */
+static uint32_t m_tx_log_cnt[LOG_PKTS];                     /**< Number of transmissions of the packets of side 0. */
+
+
+void app_error_handler(uint32_t error_code, uint32_t line_num, const uint8_t * p_file_name)
+{
+    printf("error 0x%x at %s:%u\n", (unsigned)error_code, (char const *)p_file_name, (unsigned)line_num);
+    exit(EXIT_FAILURE);
+}
+
+
+/**@brief Function for checking a condition and reporting it when false. */
+static void check(bool condition, char const * p_description)
+{
+    if (!condition)
+    {
+        printf("  %s\n", p_description);
+        m_errors++;
+    }
+}
+
+
+/**@brief Function for getting the payload length of a packet. */
+static uint16_t pkt_length_get(uint32_t side, uint32_t pkt_number)
+{
+    uint32_t hash = (pkt_number + 1) * 2654435761u + side;
+
+    if (m_max_length == MIN_LENGTH)
+    {
+        return MIN_LENGTH;
+    }
+    return (uint16_t)(MIN_LENGTH + ((hash >> 8) % (m_max_length - MIN_LENGTH + 1)));
+}
+
+
+/**@brief Function for getting a payload byte of a packet, after the packet number. */
+static uint8_t pkt_byte_get(uint32_t side, uint32_t pkt_number, uint32_t index)
+{
+    return (uint8_t)((pkt_number * 31) + (index * 7) + (side * 101));
+}
+
+
+/**@brief Function for writing the next packets of a side, as long as the TX window has room. */
+static void tx_next(uint32_t side)
+{
+    side_t *  p_side = &m_sides[side];
+    uint8_t * p_buffer;
+    uint16_t  length;
+    uint32_t  i;
+
+    while ((p_side->tx_cnt != p_side->tx_total) && (p_side->p_api->tx_alloc(&p_buffer) == NRF_SUCCESS))
+    {
+        length = pkt_length_get(side, p_side->tx_cnt);
+        UNUSED_VARIABLE(uint32_encode(p_side->tx_cnt, p_buffer));
+        for (i = MIN_LENGTH; i < length; i++)
+        {
+            p_buffer[i] = pkt_byte_get(side, p_side->tx_cnt, i);
+        }
+
+        APP_ERROR_CHECK(p_side->p_api->pkt_write(p_buffer, length));
+        p_side->tx_cnt++;
+    }
+}
+
+
+/**@brief Function for checking a received packet. */
+static void rx_check(uint32_t side, uint8_t const * p_buffer, uint16_t length)
+{
+    side_t *       p_side     = &m_sides[side];
+    const uint32_t peer       = (side + 1) % SLIP_SIM_SIDES;
+    const uint32_t pkt_number = (length >= MIN_LENGTH) ? uint32_decode(p_buffer) : UINT32_MAX;
+    bool           ok;
+    uint32_t       i;
+
+    // Packets reported as failed may be missing, every other packet comes once and in order.
+    ok = (pkt_number >= p_side->rx_next) &&
+         (pkt_number < m_sides[peer].tx_cnt) &&
+         (length == pkt_length_get(peer, pkt_number));
+
+    for (i = MIN_LENGTH; ok && (i < length); i++)
+    {
+        ok = (p_buffer[i] == pkt_byte_get(peer, pkt_number, i));
+    }
+
+    if (!ok)
+    {
+        printf("side %u: packet %u received out of order or with wrong length or data\n",
+               (unsigned)side, (unsigned)pkt_number);
+        m_errors++;
+    }
+    else
+    {
+        p_side->rx_next = pkt_number + 1;
+    }
+
+    p_side->rx_cnt++;
+    p_side->rx_bytes  += length;
+    p_side->rx_done_ns = slip_sim_time_get();
+}
+
+
+/**@brief Function for consuming the oldest received packet of a side, called after the delay. */
+static void rx_consume(void * p_context)
+{
+    side_t * p_side = p_context;
+    uint32_t i;
+
+    APP_ERROR_CHECK(p_side->p_api->rx_pkt_consume(p_side->rx_held[0]));
+
+    p_side->rx_held_cnt--;
+    for (i = 0; i < p_side->rx_held_cnt; i++)
+    {
+        p_side->rx_held[i] = p_side->rx_held[i + 1];
+    }
+
+    if (p_side->rx_held_cnt != 0)
+    {
+        APP_ERROR_CHECK(slip_sim_call(m_rx_delay_ns, rx_consume, p_side));
+    }
+}
+
+
+static void evt_handle(uint32_t side, hci_transport_evt_t event)
+{
+    side_t * p_side = &m_sides[side];
+    uint8_t * p_buffer;
+    uint16_t  length;
+
+    if (event.evt_type != HCI_TRANSPORT_RX_RDY)
+    {
+        printf("side %u: unexpected event %u\n", (unsigned)side, (unsigned)event.evt_type);
+        m_errors++;
+        return;
+    }
+
+    APP_ERROR_CHECK(p_side->p_api->rx_pkt_extract(&p_buffer, &length));
+    rx_check(side, p_buffer, length);
+    m_progress_ns = slip_sim_time_get();
+
+    if (m_rx_delay_ns == 0)
+    {
+        APP_ERROR_CHECK(p_side->p_api->rx_pkt_consume(p_buffer));
+        return;
+    }
+
+    APP_ERROR_CHECK_BOOL(p_side->rx_held_cnt < RX_BUF_QUEUE_SIZE);
+    p_side->rx_held[p_side->rx_held_cnt++] = p_buffer;
+    if (p_side->rx_held_cnt == 1)
+    {
+        APP_ERROR_CHECK(slip_sim_call(m_rx_delay_ns, rx_consume, p_side));
+    }
+}
+
+
+static void tx_done_handle(uint32_t side, hci_transport_tx_done_result_t result)
+{
+    side_t * p_side = &m_sides[side];
+
+    if (result == HCI_TRANSPORT_TX_DONE_SUCCESS)
+    {
+        p_side->tx_done_cnt++;
+    }
+    else
+    {
+        if (p_side->tx_failed_cnt == 0)
+        {
+            p_side->tx_failed_ns[0] = slip_sim_time_get();
+        }
+        p_side->tx_failed_ns[1] = slip_sim_time_get();
+        p_side->tx_failed_cnt++;
+    }
+
+    // Packets are reported in the order they were written, which is the order of the buffers.
+    APP_ERROR_CHECK(p_side->p_api->tx_free());
+    m_progress_ns = slip_sim_time_get();
+    tx_next(side);
+}
+
+
+static void side_a_evt_handler(hci_transport_evt_t event)
+{
+    evt_handle(0, event);
+}
+
+
+static void side_b_evt_handler(hci_transport_evt_t event)
+{
+    evt_handle(1, event);
+}
+
+
+static void side_a_tx_done_handler(hci_transport_tx_done_result_t result)
+{
+    tx_done_handle(0, result);
+}
+
+
+static void side_b_tx_done_handler(hci_transport_tx_done_result_t result)
+{
+    tx_done_handle(1, result);
+}
+
+
+/**@brief Function for getting the transmission time of a packet on the simulated line.
+ *
+ * @details As slip_sim.c counts it: the packet, its escaped bytes and two delimiters.
+ */
+static uint64_t wire_ns_get(const uint8_t * p_packet, uint32_t length)
+{
+    uint32_t wire_bytes = 2 + length;
+    uint32_t i;
+
+    for (i = 0; i < length; i++)
+    {
+        if ((p_packet[i] == 0xC0) || (p_packet[i] == 0xDB))
+        {
+            wire_bytes++;
+        }
+    }
+
+    return ((uint64_t)wire_bytes * BITS_PER_BYTE * NS_PER_S) / BAUDRATE;
+}
+
+
+/**@brief Filter of the scenarios: logs and loses packets of side 0. */
+static bool scenario_filter(uint32_t side, const uint8_t * p_packet, uint32_t length)
+{
+    uint32_t pkt_number;
+
+    if ((side != 1) || (length < PKT_HDR_SIZE + MIN_LENGTH + PKT_CRC_SIZE))
+    {
+        // Acknowledgements are never lost.
+        return true;
+    }
+
+    pkt_number = uint32_decode(&p_packet[PKT_HDR_SIZE]);
+    if ((pkt_number < LOG_PKTS) && (m_tx_log_cnt[pkt_number] < LOG_TXS))
+    {
+        m_tx_log[pkt_number][m_tx_log_cnt[pkt_number]] = slip_sim_time_get() -
+                                                         wire_ns_get(p_packet, length);
+    }
+    if (pkt_number < LOG_PKTS)
+    {
+        m_tx_log_cnt[pkt_number]++;
+    }
+
+    if (m_drop_all)
+    {
+        return false;
+    }
+    if (pkt_number == m_drop_once)
+    {
+        m_drop_once = UINT32_MAX;
+        return false;
+    }
+
+    return true;
+}
+
+
+/**@brief Function for checking whether all packets written have been reported and received. */
+static bool all_done(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < SLIP_SIM_SIDES; i++)
+    {
+        const uint32_t peer = (i + 1) % SLIP_SIM_SIDES;
+
+        if ((m_sides[i].tx_done_cnt + m_sides[i].tx_failed_cnt != m_sides[i].tx_total) ||
+            (m_sides[peer].rx_cnt != m_sides[i].tx_done_cnt))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+/**@brief Function for running the simulation until all packets are done, then letting it settle.
+ *
+ * @return false if the transport stalled.
+ */
+static bool run(void)
+{
+    uint64_t end_ns;
+    bool     is_stalled = false;
+
+    m_progress_ns = slip_sim_time_get();
+    while (!all_done())
+    {
+        if (!slip_sim_process(m_progress_ns + STALL_LIMIT_NS))
+        {
+            printf("  no progress for %llu s\n", STALL_LIMIT_NS / NS_PER_S);
+            m_errors++;
+            is_stalled = true;
+            break;
+        }
+    }
+
+    // Packets received twice would come after the last one.
+    end_ns = slip_sim_time_get() + SETTLE_NS;
+    while (slip_sim_process(end_ns))
+    {
+        // Retransmissions and acknowledgements in flight.
+    }
+
+    return !is_stalled;
+}
+
+
+/**@brief Function for checking that a measured time matches a timeout in ticks. */
+static bool is_timeout(uint64_t time_ns, uint32_t ticks)
+{
+    const uint64_t min_ns = ((uint64_t)(ticks - RTO_TOLERANCE) * NS_PER_S) / RTC_FREQ;
+    const uint64_t max_ns = ((uint64_t)(ticks + RTO_TOLERANCE) * NS_PER_S) / RTC_FREQ;
+
+    return (time_ns >= min_ns) && (time_ns <= max_ns);
+}
+
+
+/**@brief Function for converting a time in nanoseconds to ticks, rounded to the nearest tick. */
+static uint32_t ns_to_ticks(uint64_t time_ns)
+{
+    return (uint32_t)(((time_ns * RTC_FREQ) + (NS_PER_S / 2)) / NS_PER_S);
+}
+
+
+/**@brief Scenario: a lost packet is retransmitted upon the first duplicate acknowledgement. */
+static void dupack_test(void)
+{
+    const uint32_t packets = 16;
+    uint32_t       retransmissions = 0;
+    uint32_t       i;
+
+    printf("dupack, window %u\n", (unsigned)WINDOW);
+    if (WINDOW < 2)
+    {
+        printf("  no packet follows a lost one with a window of 1, skipped\n");
+        return;
+    }
+
+    m_drop_once         = 1;
+    m_sides[0].tx_total = packets;
+    tx_next(0);
+    UNUSED_VARIABLE(run());
+
+    check(m_sides[1].rx_cnt == packets, "not every packet received");
+    check(m_sides[0].tx_failed_cnt == 0, "packet reported as failed");
+    check(m_tx_log_cnt[1] == 2, "lost packet not transmitted exactly twice");
+    check((m_tx_log[1][1] - m_tx_log[1][0]) < ((RTO_INITIAL * NS_PER_S) / RTC_FREQ) / 4,
+          "lost packet retransmitted upon the timeout, not upon the duplicate acknowledgement");
+
+    for (i = 0; i < packets; i++)
+    {
+        retransmissions += m_tx_log_cnt[i] - 1;
+    }
+    printf("  retransmitted after %u us, %u packets transmitted again\n",
+           (unsigned)((m_tx_log[1][1] - m_tx_log[1][0]) / 1000), (unsigned)retransmissions);
+
+    // One rewind sends the window again once, however many duplicate acknowledgements arrive.
+    check(retransmissions <= WINDOW, "window rewound more than once");
+}
+
+
+/**@brief Scenario: the timeout backs off up to its cap, then the whole window fails. */
+static void backoff_test(void)
+{
+    const uint32_t warmup = 8;
+    const uint32_t after  = 4;
+    uint32_t       interval[MAX_RETRY_COUNT + 1];
+    bool           is_capped = false;
+    uint32_t       i;
+
+    printf("backoff, window %u, initial timeout %u ticks, cap %u ticks\n",
+           (unsigned)WINDOW, (unsigned)RTO_INITIAL, (unsigned)RTO_MAX);
+
+    // Round trip time samples bring the timeout down.
+    m_sides[0].tx_total = warmup;
+    tx_next(0);
+    UNUSED_VARIABLE(run());
+
+    // Every transmission of the next window is lost.
+    m_drop_all          = true;
+    m_sides[0].tx_total = warmup + WINDOW;
+    tx_next(0);
+    UNUSED_VARIABLE(run());
+
+    check(m_sides[0].tx_failed_cnt == WINDOW, "not every packet of the window reported as failed");
+    check(m_sides[0].tx_failed_ns[0] == m_sides[0].tx_failed_ns[1],
+          "packets of the window reported as failed at different times");
+    for (i = warmup; i < warmup + WINDOW; i++)
+    {
+        check(m_tx_log_cnt[i] == MAX_RETRY_COUNT + 1, "lost packet not transmitted MAX_RETRY_COUNT + 1 times");
+    }
+
+    if (m_tx_log_cnt[warmup] == MAX_RETRY_COUNT + 1)
+    {
+        printf("  timeouts:");
+        for (i = 0; i <= MAX_RETRY_COUNT; i++)
+        {
+            const uint64_t end_ns = (i < MAX_RETRY_COUNT) ? m_tx_log[warmup][i + 1] :
+                                                            m_sides[0].tx_failed_ns[0];
+
+            interval[i] = ns_to_ticks(end_ns - m_tx_log[warmup][i]);
+            printf(" %u", (unsigned)interval[i]);
+
+            if (i != 0)
+            {
+                const uint32_t expected = MIN(2u * interval[i - 1], RTO_MAX);
+
+                check(is_timeout(end_ns - m_tx_log[warmup][i], expected),
+                      "timeout not doubled up to the cap");
+                is_capped |= (2u * interval[i - 1] > RTO_MAX);
+            }
+        }
+        printf(" ticks\n");
+
+        check(interval[0] < RTO_INITIAL, "timeout not adapted to the round trip time");
+        check(is_capped, "cap of the timeout not reached");
+    }
+
+    // The sequence numbers of the failed packets are used again, the peer still expects them.
+    m_drop_all          = false;
+    m_sides[0].tx_total = warmup + WINDOW + after;
+    tx_next(0);
+    UNUSED_VARIABLE(run());
+
+    check(m_sides[1].rx_cnt == warmup + after, "packets after the failure not received");
+    check(m_sides[0].tx_failed_cnt == WINDOW, "packets after the failure reported as failed");
+}
+
+
+int main(int argc, char * argv[])
+{
+    slip_sim_config_t config =
+    {
+        .baudrate         = BAUDRATE,
+        .bits_per_byte    = BITS_PER_BYTE,
+        .drop_permille    = 0,
+        .corrupt_permille = 0,
+        .seed             = 1
+    };
+    char const * p_scenario = NULL;
+    uint32_t     packets    = 2000;
+    bool         one_way    = false;
+    uint32_t     i;
+    int          opt;
+
+    while ((opt = getopt(argc, argv, "n:l:d:c:r:s:ut:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'n':
+                packets = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+
+            case 'l':
+                m_max_length = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+
+            case 'd':
+                config.drop_permille = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+
+            case 'c':
+                config.corrupt_permille = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+
+            case 'r':
+                m_rx_delay_ns = strtoull(optarg, NULL, 0) * 1000;
+                break;
+
+            case 's':
+                config.seed = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+
+            case 'u':
+                one_way = true;
+                break;
+
+            case 't':
+                p_scenario = optarg;
+                break;
+
+            default:
+                fprintf(stderr, "usage: %s [-n packets] [-l max length] [-d drop permille] "
+                        "[-c corrupt permille] [-r rx consume delay us] [-s seed] [-u]\n"
+                        "       %s -t dupack|backoff\n", argv[0], argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if ((m_max_length < MIN_LENGTH) || (m_max_length > MAX_LENGTH))
+    {
+        fprintf(stderr, "max length must be %u - %u\n", (unsigned)MIN_LENGTH, (unsigned)MAX_LENGTH);
+        return EXIT_FAILURE;
+    }
+
+    APP_ERROR_CHECK(app_timer_init(PRESCALER, MAX_TIMERS, OP_QUEUE_SIZE + 1, m_timer_buf, NULL));
+    slip_sim_init(&config);
+
+    m_sides[0].p_api = &hci_transport_a;
+    m_sides[1].p_api = &hci_transport_b;
+    APP_ERROR_CHECK(hci_transport_a.open());
+    APP_ERROR_CHECK(hci_transport_b.open());
+    APP_ERROR_CHECK(hci_transport_a.evt_handler_reg(side_a_evt_handler));
+    APP_ERROR_CHECK(hci_transport_b.evt_handler_reg(side_b_evt_handler));
+    APP_ERROR_CHECK(hci_transport_a.tx_done_register(side_a_tx_done_handler));
+    APP_ERROR_CHECK(hci_transport_b.tx_done_register(side_b_tx_done_handler));
+
+    if (p_scenario != NULL)
+    {
+        m_max_length = SCENARIO_LENGTH;
+        hci_slip_sim_filter_set(scenario_filter);
+
+        if (strcmp(p_scenario, "dupack") == 0)
+        {
+            dupack_test();
+        }
+        else if (strcmp(p_scenario, "backoff") == 0)
+        {
+            backoff_test();
+        }
+        else
+        {
+            fprintf(stderr, "unknown scenario %s\n", p_scenario);
+            return EXIT_FAILURE;
+        }
+    }
+    else
+    {
+        m_sides[0].tx_total = packets;
+        m_sides[1].tx_total = one_way ? 0 : packets;
+
+        m_start_ns = slip_sim_time_get();
+        for (i = 0; i < SLIP_SIM_SIDES; i++)
+        {
+            tx_next(i);
+        }
+        UNUSED_VARIABLE(run());
+
+        printf("window %u, %u packets of %u - %u bytes %s, drop %.1f%%, corrupt %.1f%%, "
+               "rx consume delay %u us\n",
+               (unsigned)WINDOW, (unsigned)packets, (unsigned)MIN_LENGTH, (unsigned)m_max_length,
+               one_way ? "one way" : "each way",
+               config.drop_permille / 10.0, config.corrupt_permille / 10.0,
+               (unsigned)(m_rx_delay_ns / 1000));
+
+        for (i = 0; i < SLIP_SIM_SIDES; i++)
+        {
+            const uint32_t   peer = (i + 1) % SLIP_SIM_SIDES;
+            slip_sim_stats_t stats;
+            double           kbps;
+            double           raw_kbps = (double)BAUDRATE / BITS_PER_BYTE / 1000;
+
+            if (m_sides[i].tx_total == 0)
+            {
+                continue;
+            }
+            if ((m_sides[peer].rx_cnt != m_sides[i].tx_total) || (m_sides[i].tx_failed_cnt != 0))
+            {
+                printf("  side %u: %u of %u packets received, %u reported as failed\n",
+                       (unsigned)peer, (unsigned)m_sides[peer].rx_cnt,
+                       (unsigned)m_sides[i].tx_total, (unsigned)m_sides[i].tx_failed_cnt);
+                m_errors++;
+                continue;
+            }
+
+            slip_sim_stats_get(i, &stats);
+            kbps = (m_sides[peer].rx_bytes * 1e6) / (m_sides[peer].rx_done_ns - m_start_ns);
+            printf("  %u -> %u: %5.2f kB/s (%4.1f%% of the UART), %5.1f%% retransmitted, "
+                   "%u lost, %u corrupted\n",
+                   (unsigned)i, (unsigned)peer, kbps, (100.0 * kbps) / raw_kbps,
+                   (100.0 * (stats.pkts - packets)) / packets,
+                   (unsigned)stats.dropped, (unsigned)stats.corrupted);
+        }
+    }
+
+    APP_ERROR_CHECK(hci_transport_a.close());
+    APP_ERROR_CHECK(hci_transport_b.close());
+
+    printf("%s\n", (m_errors == 0) ? "PASS" : "FAIL");
+
+    return (m_errors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,43 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/** @file
+ *
+ * @defgroup host_cpu Cortex-M0 core on the host
+ * @{
+ * @ingroup host_test
+ *
+ * @brief Replacements of the Cortex-M0 core registers and instructions for host builds.
+ *
+ * @details Included before the module under test (-include). SCB is redirected to memory, so that
+ *          current_int_priority_get() reports thread mode. Enabling and disabling interrupts does
+ *          nothing, as interrupts are not simulated, and __DMB() is a full memory barrier of the
+ *          host. The SoftDevice critical region calls report that the SoftDevice is not enabled.
+ */
+
+#ifndef HOST_CPU_H__
+#define HOST_CPU_H__
+
+#include "nrf51.h"
+
+extern SCB_Type host_cpu_scb;     /**< System Control Block, VECTACTIVE is 0 (thread mode). */
+
+#undef  SCB
+#define SCB               (&host_cpu_scb)
+
+#define __disable_irq()   ((void)0)
+#define __enable_irq()    ((void)0)
+#define __DMB()           __sync_synchronize()
+
+#endif // HOST_CPU_H__
+
+/** @} */
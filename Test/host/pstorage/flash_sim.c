@@ -0,0 +1,310 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include "flash_sim.h"
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "nrf_error.h"
+#include "nrf_soc.h"
+
+#define MAX_WRITE_WORDS 256                         /**< Max size of a single write, as for sd_flash_write. */
+
+/**@brief Flash operation types. */
+typedef enum
+{
+    FLASH_OP_NONE,
+    FLASH_OP_WRITE,
+    FLASH_OP_ERASE
+} flash_op_t;
+
+static flash_sim_config_t      m_config;            /**< Simulator configuration. */
+static flash_sim_evt_handler_t m_evt_handler;       /**< Handler of system events. */
+static uint8_t *               mp_flash = NULL;     /**< Flash content. */
+static uint32_t                m_flash_size;        /**< Size of flash in bytes. */
+static int                     m_fd     = -1;       /**< Mapped file, -1 if flash is kept in RAM. */
+static uint32_t *              mp_wear  = NULL;     /**< Number of erases of every page. */
+static uint64_t                m_time_us;           /**< Virtual time. */
+static flash_sim_stats_t       m_stats;             /**< Statistics. */
+
+/**@brief Operation in progress. */
+static struct
+{
+    flash_op_t       op;                            /**< Operation type, FLASH_OP_NONE if idle. */
+    bool             fail;                          /**< Operation is going to fail (radio busy). */
+    uint64_t         end_time_us;                   /**< Time at which the result is reported. */
+    uint32_t         addr;                          /**< Flash address to write or erase. */
+    uint32_t         words;                         /**< Number of words to write. */
+    uint32_t const * p_src;                         /**< Data to write. */
+} m_op;
+
+
+/**@brief Function for drawing whether the next operation fails because the radio is busy. */
+static bool radio_busy_draw(void)
+{
+    return (m_config.busy_permille != 0) &&
+           ((uint32_t)(rand() % 1000) < m_config.busy_permille);
+}
+
+
+/**@brief Function for starting an operation.
+ *
+ * @details Source data is read when the operation ends, the same as for the SoftDevice, which
+ *          requires the source buffer to stay unchanged until the operation result is reported.
+ */
+static void op_start(flash_op_t op, uint32_t addr, uint32_t const * p_src, uint32_t words)
+{
+    m_op.op    = op;
+    m_op.addr  = addr;
+    m_op.p_src = p_src;
+    m_op.words = words;
+    m_op.fail  = radio_busy_draw();
+
+    if (m_op.fail)
+    {
+        m_op.end_time_us = m_time_us + m_config.busy_time_us;
+    }
+    else if (op == FLASH_OP_ERASE)
+    {
+        m_op.end_time_us = m_time_us + m_config.erase_time_us;
+    }
+    else
+    {
+        m_op.end_time_us = m_time_us + ((uint64_t)words * m_config.word_write_time_us);
+    }
+}
+
+
+uint32_t flash_sim_init(flash_sim_config_t const * p_config, flash_sim_evt_handler_t evt_handler)
+{
+    bool erase = true;
+
+    if ((p_config == NULL) || (evt_handler == NULL) || (p_config->page_count == 0) ||
+        (p_config->page_size == 0) || ((p_config->page_size % sizeof(uint32_t)) != 0))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    flash_sim_uninit();
+
+    m_config      = *p_config;
+    m_evt_handler = evt_handler;
+    m_flash_size  = m_config.page_size * m_config.page_count;
+    m_time_us     = 0;
+    m_op.op       = FLASH_OP_NONE;
+    memset(&m_stats, 0, sizeof(m_stats));
+
+    mp_wear = calloc(m_config.page_count, sizeof(uint32_t));
+    if (mp_wear == NULL)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    if (m_config.p_file_name != NULL)
+    {
+        struct stat file_stat;
+
+        m_fd = open(m_config.p_file_name, O_RDWR | O_CREAT, 0644);
+        if ((m_fd < 0) || (fstat(m_fd, &file_stat) != 0))
+        {
+            flash_sim_uninit();
+            return NRF_ERROR_NO_MEM;
+        }
+
+        // Keep the content of a file which already holds a flash image of the same size.
+        erase = (file_stat.st_size != (off_t)m_flash_size);
+
+        if (ftruncate(m_fd, m_flash_size) != 0)
+        {
+            flash_sim_uninit();
+            return NRF_ERROR_NO_MEM;
+        }
+
+        mp_flash = mmap(NULL, m_flash_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+        if (mp_flash == MAP_FAILED)
+        {
+            mp_flash = NULL;
+            flash_sim_uninit();
+            return NRF_ERROR_NO_MEM;
+        }
+    }
+    else
+    {
+        mp_flash = malloc(m_flash_size);
+        if (mp_flash == NULL)
+        {
+            flash_sim_uninit();
+            return NRF_ERROR_NO_MEM;
+        }
+    }
+
+    if (erase)
+    {
+        memset(mp_flash, 0xFF, m_flash_size);
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+void flash_sim_uninit(void)
+{
+    if (m_fd >= 0)
+    {
+        if (mp_flash != NULL)
+        {
+            (void)msync(mp_flash, m_flash_size, MS_SYNC);
+            (void)munmap(mp_flash, m_flash_size);
+        }
+        (void)close(m_fd);
+        m_fd = -1;
+    }
+    else
+    {
+        free(mp_flash);
+    }
+
+    mp_flash = NULL;
+    free(mp_wear);
+    mp_wear = NULL;
+}
+
+
+uint32_t flash_sim_write(uint32_t * const p_dst, uint32_t const * const p_src, uint32_t size)
+{
+    const uint32_t addr = (uint32_t)(uintptr_t)p_dst;
+
+    if (m_op.op != FLASH_OP_NONE)
+    {
+        m_stats.busy++;
+        return NRF_ERROR_BUSY;
+    }
+
+    if ((size == 0) || (size > MAX_WRITE_WORDS))
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
+    if (((addr % sizeof(uint32_t)) != 0) || (((uintptr_t)p_src % sizeof(uint32_t)) != 0) ||
+        (addr >= m_flash_size) || ((m_flash_size - addr) < (size * sizeof(uint32_t))))
+    {
+        return NRF_ERROR_INVALID_ADDR;
+    }
+
+    op_start(FLASH_OP_WRITE, addr, p_src, size);
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t flash_sim_page_erase(uint32_t page_number)
+{
+    if (m_op.op != FLASH_OP_NONE)
+    {
+        m_stats.busy++;
+        return NRF_ERROR_BUSY;
+    }
+
+    if (page_number >= m_config.page_count)
+    {
+        return NRF_ERROR_INVALID_ADDR;
+    }
+
+    op_start(FLASH_OP_ERASE, page_number * m_config.page_size, NULL, 0);
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t * flash_sim_ptr(uint32_t addr)
+{
+    return (uint32_t *)(mp_flash + addr);
+}
+
+
+bool flash_sim_process(void)
+{
+    uint32_t sys_evt = NRF_EVT_FLASH_OPERATION_SUCCESS;
+    uint32_t i;
+
+    if (m_op.op == FLASH_OP_NONE)
+    {
+        return false;
+    }
+
+    m_time_us = m_op.end_time_us;
+
+    if (m_op.fail)
+    {
+        m_stats.errors++;
+        sys_evt = NRF_EVT_FLASH_OPERATION_ERROR;
+    }
+    else if (m_op.op == FLASH_OP_ERASE)
+    {
+        const uint32_t page_number = m_op.addr / m_config.page_size;
+
+        memset(mp_flash + m_op.addr, 0xFF, m_config.page_size);
+        mp_wear[page_number]++;
+        m_stats.erases++;
+    }
+    else
+    {
+        uint32_t * p_dst = flash_sim_ptr(m_op.addr);
+
+        // Programming can only clear bits.
+        for (i = 0; i < m_op.words; i++)
+        {
+            p_dst[i] &= m_op.p_src[i];
+        }
+        m_stats.writes++;
+        m_stats.words_written += m_op.words;
+    }
+
+    // The handler may start the next operation.
+    m_op.op = FLASH_OP_NONE;
+    m_evt_handler(sys_evt);
+
+    return true;
+}
+
+
+uint64_t flash_sim_time_get(void)
+{
+    return m_time_us;
+}
+
+
+uint32_t flash_sim_wear_get(uint32_t page_number)
+{
+    return (page_number < m_config.page_count) ? mp_wear[page_number] : 0;
+}
+
+
+void flash_sim_stats_get(flash_sim_stats_t * p_stats)
+{
+    uint32_t i;
+
+    m_stats.max_wear = 0;
+    for (i = 0; i < m_config.page_count; i++)
+    {
+        if (mp_wear[i] > m_stats.max_wear)
+        {
+            m_stats.max_wear = mp_wear[i];
+        }
+    }
+
+    *p_stats = m_stats;
+    memset(&m_stats, 0, sizeof(m_stats));
+}
@@ -0,0 +1,127 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/** @file
+ *
+ * @defgroup flash_sim Flash simulator
+ * @{
+ * @ingroup host_test
+ *
+ * @brief Host simulation of the SoftDevice flash API.
+ *
+ * @details Flash content is kept in RAM or in a memory mapped file. Write and page erase
+ *          operations behave like sd_flash_write and sd_flash_page_erase: they are started
+ *          asynchronously, only one can be in progress at a time and the result is reported by
+ *          a system event (NRF_EVT_FLASH_OPERATION_SUCCESS or NRF_EVT_FLASH_OPERATION_ERROR).
+ *          The simulator keeps virtual time. An operation completes after the configured page
+ *          erase or word write time, and a configurable share of operations fails as if the
+ *          SoftDevice could not get flash access because of radio activity. A write can only
+ *          change bits from 1 to 0, as in NOR flash. Erases are counted per page.
+ */
+
+#ifndef FLASH_SIM_H__
+#define FLASH_SIM_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**@brief Handler of system events generated by the simulator. */
+typedef void (*flash_sim_evt_handler_t)(uint32_t sys_evt);
+
+/**@brief Simulator configuration. */
+typedef struct
+{
+    uint32_t     page_size;          /**< Size of a flash page in bytes. */
+    uint32_t     page_count;         /**< Number of flash pages, starting at address 0. */
+    uint32_t     erase_time_us;      /**< Duration of a page erase. */
+    uint32_t     word_write_time_us; /**< Duration of writing one word. */
+    uint32_t     busy_permille;      /**< Share of operations (in 1/1000) failing because the radio is busy. */
+    uint32_t     busy_time_us;       /**< Time after which a failed operation is reported. */
+    char const * p_file_name;        /**< File mapped as flash content, NULL to keep it in RAM. */
+} flash_sim_config_t;
+
+/**@brief Simulator statistics. */
+typedef struct
+{
+    uint32_t writes;        /**< Number of successful write operations. */
+    uint32_t words_written; /**< Number of written words. */
+    uint32_t erases;        /**< Number of successful page erases. */
+    uint32_t errors;        /**< Number of operations failed on purpose (radio busy). */
+    uint32_t busy;          /**< Number of operations rejected with NRF_ERROR_BUSY. */
+    uint32_t max_wear;      /**< Highest number of erases of a single page. */
+} flash_sim_stats_t;
+
+/**@brief Function for initializing the simulator.
+ *
+ * @details A new flash (or a new file) is erased. Content of an existing file of the right size is
+ *          kept.
+ *
+ * @param[in] p_config     Simulator configuration.
+ * @param[in] evt_handler  Handler of system events.
+ *
+ * @retval NRF_SUCCESS             Simulator initialized.
+ * @retval NRF_ERROR_INVALID_PARAM Invalid configuration.
+ * @retval NRF_ERROR_NO_MEM        Flash content could not be allocated or mapped.
+ */
+uint32_t flash_sim_init(flash_sim_config_t const * p_config, flash_sim_evt_handler_t evt_handler);
+
+/**@brief Function for releasing the flash content. A mapped file is synchronized. */
+void flash_sim_uninit(void);
+
+/**@brief Simulation of sd_flash_write.
+ *
+ * @param[in] p_dst  Flash address to write to (an address, not a host pointer).
+ * @param[in] p_src  Host pointer to the data.
+ * @param[in] size   Number of words to write.
+ *
+ * @retval NRF_SUCCESS              Operation started.
+ * @retval NRF_ERROR_BUSY           Another operation is in progress.
+ * @retval NRF_ERROR_INVALID_ADDR   Address outside of flash or unaligned.
+ * @retval NRF_ERROR_INVALID_LENGTH Size is 0 or more than 256 words.
+ */
+uint32_t flash_sim_write(uint32_t * const p_dst, uint32_t const * const p_src, uint32_t size);
+
+/**@brief Simulation of sd_flash_page_erase.
+ *
+ * @param[in] page_number  Page to erase.
+ *
+ * @retval NRF_SUCCESS            Operation started.
+ * @retval NRF_ERROR_BUSY         Another operation is in progress.
+ * @retval NRF_ERROR_INVALID_ADDR Page outside of flash.
+ */
+uint32_t flash_sim_page_erase(uint32_t page_number);
+
+/**@brief Function for converting a flash address to a host pointer to the flash content. */
+uint32_t * flash_sim_ptr(uint32_t addr);
+
+/**@brief Function for completing the operation in progress.
+ *
+ * @details Virtual time is advanced to the end of the operation, the flash content is modified and
+ *          the result is passed to the event handler, which may start the next operation.
+ *
+ * @retval true   An operation was completed.
+ * @retval false  No operation was in progress.
+ */
+bool flash_sim_process(void);
+
+/**@brief Function for getting virtual time in microseconds. */
+uint64_t flash_sim_time_get(void);
+
+/**@brief Function for getting the number of erases of a page. */
+uint32_t flash_sim_wear_get(uint32_t page_number);
+
+/**@brief Function for getting and resetting simulator statistics (wear counts are kept). */
+void flash_sim_stats_get(flash_sim_stats_t * p_stats);
+
+#endif // FLASH_SIM_H__
+
+/** @} */
@@ -0,0 +1,469 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/** @file
+ *
+ * @brief Persistent storage throughput and latency on top of the flash simulator.
+ *
+ * @details Runs store, update and clear workloads, keeping the command queue of the module full.
+ *          Latency of a command is measured in simulated time from the call to the module until
+ *          its successful completion is notified, so it includes time spent in the queue and any
+ *          retry after a flash operation failed because the radio was busy. Flash content is
+ *          compared with a shadow image after every workload; the program fails on any mismatch.
+ *
+ *          Usage: pstorage_bench [-n ops] [-s seed] [-b busy_permille] [-f flash_file]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "pstorage.h"
+#include "flash_sim.h"
+#include "nrf_error.h"
+
+#define BLOCK_SIZE         64                                      /**< Size of a block of the benchmark module. */
+#define BLOCK_COUNT        48                                      /**< Number of blocks of the benchmark module (3 flash pages). */
+#define MODULE_SIZE        (BLOCK_SIZE * BLOCK_COUNT)              /**< Size of the benchmark module. */
+#define DATA_SLOT_COUNT    (PSTORAGE_CMD_QUEUE_SIZE + 1)           /**< Number of source buffers, one more than commands in the queue. */
+#define LATENCY_FIFO_SIZE  (PSTORAGE_CMD_QUEUE_SIZE + 1)           /**< Size of the FIFO of start times of queued commands. */
+
+#define ERASE_TIME_US      22000                                   /**< Page erase time (nRF51 maximum is 22.3 ms). */
+#define WORD_WRITE_TIME_US 46                                      /**< Word write time (nRF51 maximum is 46.3 us). */
+#define BUSY_TIME_US       7500                                    /**< Time after which a flash operation fails when the radio is busy. */
+
+/**@brief Result of a workload. */
+typedef struct
+{
+    uint32_t submitted;       /**< Number of queued commands. */
+    uint32_t ops;             /**< Number of completed commands. */
+    uint64_t time_us;         /**< Simulated duration. */
+    uint64_t latency_sum_us;  /**< Sum of command latencies. */
+    uint64_t latency_max_us;  /**< Highest command latency. */
+    uint64_t host_ns;         /**< Host time spent in the module and the simulator. */
+} workload_result_t;
+
+static pstorage_handle_t  m_base_handle;                            /**< Handle of the benchmark module. */
+static uint8_t            m_shadow[MODULE_SIZE];                    /**< Expected flash content of the module. */
+static uint32_t           m_data[DATA_SLOT_COUNT][BLOCK_SIZE / 4];  /**< Source buffers of queued commands. */
+static uint32_t           m_data_slot;                              /**< Next source buffer to use. */
+static uint64_t           m_start_fifo[LATENCY_FIFO_SIZE];          /**< Start times of queued commands. */
+static uint32_t           m_fifo_rp;                                /**< Read index of m_start_fifo. */
+static uint32_t           m_fifo_count;                             /**< Number of entries in m_start_fifo. */
+static uint32_t           m_errors;                                 /**< Number of unexpected notifications. */
+static workload_result_t  m_result;                                 /**< Result of the running workload. */
+
+
+/**@brief Function for getting host time in nanoseconds. */
+static uint64_t host_ns_get(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ull) + (uint64_t)ts.tv_nsec;
+}
+
+
+/**@brief Persistent storage notification handler.
+ *
+ * @details Commands complete in the order in which they were queued, so the start time of a
+ *          completed command is at the head of the FIFO.
+ */
+static void pstorage_cb(pstorage_handle_t * p_handle,
+                        uint8_t             op_code,
+                        uint32_t            result,
+                        uint8_t           * p_data,
+                        uint32_t            data_len)
+{
+    uint64_t latency_us;
+
+    if (op_code == PSTORAGE_LOAD_OP_CODE)
+    {
+        // Loads are notified synchronously, only when the content is verified.
+        return;
+    }
+
+    if (result == NRF_ERROR_TIMEOUT)
+    {
+        // The flash operation is retried by the module.
+        return;
+    }
+
+    if ((result != NRF_SUCCESS) || (m_fifo_count == 0))
+    {
+        printf("unexpected notification: op_code %u, result 0x%x\n", op_code, (unsigned)result);
+        m_errors++;
+        return;
+    }
+
+    latency_us = flash_sim_time_get() - m_start_fifo[m_fifo_rp];
+    m_fifo_rp  = (m_fifo_rp + 1) % LATENCY_FIFO_SIZE;
+    m_fifo_count--;
+
+    m_result.ops++;
+    m_result.latency_sum_us += latency_us;
+    if (latency_us > m_result.latency_max_us)
+    {
+        m_result.latency_max_us = latency_us;
+    }
+}
+
+
+/**@brief System event handler of the flash simulator. */
+static void sys_evt_handler(uint32_t sys_evt)
+{
+    pstorage_sys_event_handler(sys_evt);
+}
+
+
+/**@brief Function for waiting until all queued commands are completed. */
+static void flush(void)
+{
+    while (flash_sim_process())
+    {
+        // Complete flash operations until the module stops requesting them.
+    }
+}
+
+
+/**@brief Function for queueing a command, running flash operations while the queue is full.
+ *
+ * @return Result of the last call to the module.
+ */
+static uint32_t submit(uint32_t (*cmd)(void * p_context), void * p_context)
+{
+    uint32_t err_code;
+
+    for (;;)
+    {
+        m_start_fifo[(m_fifo_rp + m_fifo_count) % LATENCY_FIFO_SIZE] = flash_sim_time_get();
+        m_fifo_count++;
+
+        err_code = cmd(p_context);
+        if (err_code != NRF_ERROR_NO_MEM)
+        {
+            break;
+        }
+
+        m_fifo_count--;
+        if (!flash_sim_process())
+        {
+            // Queue full without any flash operation in progress.
+            break;
+        }
+    }
+
+    if (err_code == NRF_SUCCESS)
+    {
+        m_result.submitted++;
+    }
+    else
+    {
+        m_fifo_count--;
+        printf("command failed: 0x%x\n", (unsigned)err_code);
+        m_errors++;
+    }
+
+    return err_code;
+}
+
+
+/**@brief Parameters of a store, update or clear command. */
+typedef struct
+{
+    pstorage_handle_t handle;
+    uint8_t *         p_data;
+    pstorage_size_t   size;
+    pstorage_size_t   offset;
+} cmd_param_t;
+
+
+static uint32_t store_cmd(void * p_context)
+{
+    cmd_param_t * p_param = p_context;
+    return pstorage_store(&p_param->handle, p_param->p_data, p_param->size, p_param->offset);
+}
+
+
+static uint32_t update_cmd(void * p_context)
+{
+    cmd_param_t * p_param = p_context;
+    return pstorage_update(&p_param->handle, p_param->p_data, p_param->size, p_param->offset);
+}
+
+
+static uint32_t clear_cmd(void * p_context)
+{
+    cmd_param_t * p_param = p_context;
+    return pstorage_clear(&p_param->handle, p_param->size);
+}
+
+
+/**@brief Function for preparing the parameters of a command on one block. */
+static void cmd_param_init(cmd_param_t * p_param,
+                           uint32_t      block,
+                           uint32_t      offset,
+                           uint32_t      size)
+{
+    uint8_t * p_data = (uint8_t *)m_data[m_data_slot];
+    uint32_t  i;
+
+    m_data_slot = (m_data_slot + 1) % DATA_SLOT_COUNT;
+
+    for (i = 0; i < size; i++)
+    {
+        p_data[i] = (uint8_t)rand();
+    }
+
+    (void)pstorage_block_identifier_get(&m_base_handle, block, &p_param->handle);
+    p_param->p_data = p_data;
+    p_param->size   = size;
+    p_param->offset = offset;
+}
+
+
+/**@brief Function for clearing the whole module. */
+static void module_clear(void)
+{
+    cmd_param_t param;
+
+    param.handle = m_base_handle;
+    param.size   = MODULE_SIZE;
+    (void)submit(clear_cmd, &param);
+    flush();
+    memset(m_shadow, 0xFF, sizeof(m_shadow));
+}
+
+
+/**@brief Function for comparing flash content with the shadow image. */
+static bool verify(char const * p_name)
+{
+    uint8_t  block[BLOCK_SIZE];
+    uint32_t i;
+    bool     ok = true;
+
+    for (i = 0; i < BLOCK_COUNT; i++)
+    {
+        pstorage_handle_t handle;
+
+        (void)pstorage_block_identifier_get(&m_base_handle, i, &handle);
+        if ((pstorage_load(block, &handle, BLOCK_SIZE, 0) != NRF_SUCCESS) ||
+            (memcmp(block, &m_shadow[i * BLOCK_SIZE], BLOCK_SIZE) != 0))
+        {
+            printf("%s: content of block %u differs\n", p_name, (unsigned)i);
+            ok = false;
+        }
+    }
+
+    return ok;
+}
+
+
+/**@brief Stores of half a block. The module is cleared when it is full, this is part of the
+ *        workload.
+ */
+static void store_run(uint32_t ops)
+{
+    const uint32_t size   = BLOCK_SIZE / 2;
+    uint32_t       offset = 0;
+    uint32_t       i;
+
+    for (i = 0; i < ops; i++)
+    {
+        cmd_param_t param;
+
+        if (offset == MODULE_SIZE)
+        {
+            flush();
+            module_clear();
+            offset = 0;
+        }
+
+        cmd_param_init(&param, offset / BLOCK_SIZE, offset % BLOCK_SIZE, size);
+        if (submit(store_cmd, &param) == NRF_SUCCESS)
+        {
+            memcpy(&m_shadow[offset], param.p_data, size);
+        }
+        offset += size;
+    }
+}
+
+
+/**@brief Updates of a random word aligned part of a random block. */
+static void update_run(uint32_t ops)
+{
+    uint32_t i;
+
+    for (i = 0; i < ops; i++)
+    {
+        cmd_param_t    param;
+        const uint32_t block  = (uint32_t)rand() % BLOCK_COUNT;
+        const uint32_t offset = ((uint32_t)rand() % (BLOCK_SIZE / 4)) * 4;
+        const uint32_t size   = (((uint32_t)rand() % ((BLOCK_SIZE - offset) / 4)) + 1) * 4;
+
+        cmd_param_init(&param, block, offset, size);
+        if (submit(update_cmd, &param) == NRF_SUCCESS)
+        {
+            memcpy(&m_shadow[(block * BLOCK_SIZE) + offset], param.p_data, size);
+        }
+    }
+}
+
+
+/**@brief Clears of a random block. */
+static void clear_run(uint32_t ops)
+{
+    uint32_t i;
+
+    for (i = 0; i < ops; i++)
+    {
+        cmd_param_t    param;
+        const uint32_t block = (uint32_t)rand() % BLOCK_COUNT;
+
+        (void)pstorage_block_identifier_get(&m_base_handle, block, &param.handle);
+        param.size = BLOCK_SIZE;
+        if (submit(clear_cmd, &param) == NRF_SUCCESS)
+        {
+            memset(&m_shadow[block * BLOCK_SIZE], 0xFF, BLOCK_SIZE);
+        }
+    }
+}
+
+
+/**@brief Function for running a workload and printing its result. */
+static bool workload_run(char const * p_name, void (*run)(uint32_t ops), uint32_t ops)
+{
+    flash_sim_stats_t stats;
+    uint64_t          start_us;
+    uint64_t          start_ns;
+
+    flush();
+    flash_sim_stats_get(&stats);
+    memset(&m_result, 0, sizeof(m_result));
+
+    start_us = flash_sim_time_get();
+    start_ns = host_ns_get();
+    run(ops);
+    flush();
+    m_result.host_ns = host_ns_get() - start_ns;
+    m_result.time_us = flash_sim_time_get() - start_us;
+
+    flash_sim_stats_get(&stats);
+
+    printf("%-7s %6u ops %9.1f ops/s  latency avg %8.1f us max %8llu us  "
+           "%6.0f ns/op  erases %5u  words %7u  flash errors %4u  max wear %u\n",
+           p_name,
+           (unsigned)m_result.ops,
+           (m_result.time_us != 0) ? (m_result.ops * 1e6) / m_result.time_us : 0.0,
+           (m_result.ops != 0) ? (double)m_result.latency_sum_us / m_result.ops : 0.0,
+           (unsigned long long)m_result.latency_max_us,
+           (m_result.ops != 0) ? (double)m_result.host_ns / m_result.ops : 0.0,
+           (unsigned)stats.erases,
+           (unsigned)stats.words_written,
+           (unsigned)stats.errors,
+           (unsigned)stats.max_wear);
+
+    return (m_result.ops == m_result.submitted) && verify(p_name);
+}
+
+
+int main(int argc, char * argv[])
+{
+    pstorage_module_param_t param;
+    flash_sim_config_t      config;
+    uint32_t                ops  = 1000;
+    unsigned                seed = 1;
+    uint32_t                err_code;
+    bool                    ok;
+    int                     opt;
+
+    memset(&config, 0, sizeof(config));
+    config.page_size          = PSTORAGE_FLASH_PAGE_SIZE;
+    config.page_count         = PSTORAGE_FLASH_PAGE_END;
+    config.erase_time_us      = ERASE_TIME_US;
+    config.word_write_time_us = WORD_WRITE_TIME_US;
+    config.busy_time_us       = BUSY_TIME_US;
+
+    while ((opt = getopt(argc, argv, "n:s:b:f:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'n':
+                ops = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+
+            case 's':
+                seed = (unsigned)strtoul(optarg, NULL, 0);
+                break;
+
+            case 'b':
+                config.busy_permille = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+
+            case 'f':
+                config.p_file_name = optarg;
+                break;
+
+            default:
+                fprintf(stderr, "usage: %s [-n ops] [-s seed] [-b busy_permille] [-f flash_file]\n",
+                        argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    srand(seed);
+
+    if (flash_sim_init(&config, sys_evt_handler) != NRF_SUCCESS)
+    {
+        fprintf(stderr, "flash simulator initialization failed\n");
+        return EXIT_FAILURE;
+    }
+
+    param.cb          = pstorage_cb;
+    param.block_size  = BLOCK_SIZE;
+    param.block_count = BLOCK_COUNT;
+
+    // Initialization fails if erasing the swap page fails, retry it then.
+    do
+    {
+        err_code = pstorage_init();
+        flush();
+        if (err_code == NRF_SUCCESS)
+        {
+            err_code = pstorage_register(&param, &m_base_handle);
+        }
+    }
+    while (err_code == NRF_ERROR_INVALID_STATE);
+
+    if (err_code != NRF_SUCCESS)
+    {
+        fprintf(stderr, "pstorage initialization failed: 0x%x\n", (unsigned)err_code);
+        return EXIT_FAILURE;
+    }
+
+    printf("pstorage: %u ops per workload, busy %u/1000, write combine %u bytes, seed %u\n",
+           (unsigned)ops, (unsigned)config.busy_permille, PSTORAGE_WRITE_COMBINE_SIZE, seed);
+
+    module_clear();
+
+    ok = workload_run("store", store_run, ops);
+    ok = workload_run("update", update_run, ops) && ok;
+    ok = workload_run("clear", clear_run, ops) && ok;
+    ok = (m_errors == 0) && ok;
+
+    flash_sim_uninit();
+
+    printf("%s\n", ok ? "PASS" : "FAIL");
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
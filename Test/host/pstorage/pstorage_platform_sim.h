@@ -0,0 +1,65 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+ /** @cond To make doxygen skip this file */
+
+/** @file
+ *  Persistent storage platform definitions for host builds on top of the flash simulator.
+ *  Included before pstorage.c (-include), it replaces Include/app_common/pstorage_platform.h.
+ */
+#ifndef PSTORAGE_PL_H__
+#define PSTORAGE_PL_H__
+
+#include <stdint.h>
+#include "flash_sim.h"
+
+#define PSTORAGE_FLASH_PAGE_SIZE    1024                                                        /**< Size of one flash page, as on nRF51. */
+#define PSTORAGE_FLASH_EMPTY_MASK   0xFFFFFFFF                                                  /**< Bit mask that defines an empty address in flash. */
+#define PSTORAGE_FLASH_PAGE_END     256                                                         /**< Number of simulated flash pages. */
+
+#define PSTORAGE_MAX_APPLICATIONS   4                                                           /**< Maximum number of applications that can be registered with the module. */
+#define PSTORAGE_MIN_BLOCK_SIZE     0x0010                                                      /**< Minimum size of block that can be registered with the module. */
+
+#define PSTORAGE_DATA_START_ADDR    ((PSTORAGE_FLASH_PAGE_END - PSTORAGE_MAX_APPLICATIONS - 1) \
+                                    * PSTORAGE_FLASH_PAGE_SIZE)                                 /**< Start address for persistent data. */
+#define PSTORAGE_DATA_END_ADDR      ((PSTORAGE_FLASH_PAGE_END - 1) * PSTORAGE_FLASH_PAGE_SIZE)  /**< End address for persistent data. */
+#define PSTORAGE_SWAP_ADDR          PSTORAGE_DATA_END_ADDR                                      /**< Top-most page is used as swap area for clear and update. */
+
+#define PSTORAGE_MAX_BLOCK_SIZE     PSTORAGE_FLASH_PAGE_SIZE                                    /**< Maximum size of block that can be registered with the module. */
+#define PSTORAGE_CMD_QUEUE_SIZE     10                                                          /**< Maximum number of flash access commands that can be maintained by the module. */
+#ifndef PSTORAGE_WRITE_COMBINE_SIZE
+#define PSTORAGE_WRITE_COMBINE_SIZE 128                                                         /**< Size of the write combine buffer, 0 to disable. Can be overridden from the command line. */
+#endif
+
+/* Flash backend. */
+#define PSTORAGE_FLASH_WRITE(P_DST, P_SRC, WORDS)  flash_sim_write((P_DST), (P_SRC), (WORDS))
+#define PSTORAGE_FLASH_PAGE_ERASE(PAGE_NUM)        flash_sim_page_erase(PAGE_NUM)
+#define PSTORAGE_FLASH_PTR(ADDR)                   flash_sim_ptr((uint32_t)(ADDR))
+
+
+/** Abstracts persistently memory block identifier. */
+typedef uint32_t pstorage_block_t;
+
+typedef struct
+{
+    uint32_t            module_id;      /**< Module ID.*/
+    pstorage_block_t    block_id;       /**< Block ID.*/
+} pstorage_handle_t;
+
+typedef uint16_t pstorage_size_t;      /** Size of length and offset fields. */
+
+/**@brief Handles Flash Access Result Events. */
+void pstorage_sys_event_handler (uint32_t sys_evt);
+
+#endif // PSTORAGE_PL_H__
+
+/** @endcond */
@@ -0,0 +1,34 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/** @file
+ *
+ * @brief Host build settings of the HCI PHY test, included before every module (-include).
+ *
+ * @details app_timer runs on the RTC1 simulator. The mailbox header of app_mailbox.c holds a
+ *          pointer, so APP_MAILBOX_DEF() reserves one more word for it on a 64 bit host.
+ */
+
+#ifndef SER_PHY_HCI_HOST_H__
+#define SER_PHY_HCI_HOST_H__
+
+#include "rtc_sim.h"
+#include "host_cpu.h"
+#include "app_mailbox.h"
+
+#undef  APP_MAILBOX_DEF
+#define APP_MAILBOX_DEF(name, queue_sz, type)                  \
+uint32_t os_mailQ_q_##name[4+((sizeof(type)+3)/4)*(queue_sz)]; \
+const app_mailbox_def_t os_mailQ_def_##name =                  \
+{ (queue_sz), sizeof(type), (os_mailQ_q_##name) }
+
+#endif // SER_PHY_HCI_HOST_H__
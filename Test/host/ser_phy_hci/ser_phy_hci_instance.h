@@ -0,0 +1,59 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/** @file
+ *
+ * @brief One instance of ser_phy_hci.c on the SLIP link simulator.
+ *
+ * @details Included by a source file which defines SER_PHY_SIDE (index of the side in the
+ *          simulator) and SER_PHY_SIDE_SUFFIX (appended to the global names of the instance).
+ */
+
+#include "ser_phy_hci.h"
+#include "ser_phy_sides.h"
+#include "slip_sim.h"
+
+#define SIDE_NAME(NAME)             SIDE_NAME_(NAME, SER_PHY_SIDE_SUFFIX)
+#define SIDE_NAME_(NAME, SUFFIX)    SIDE_NAME__(NAME, SUFFIX)
+#define SIDE_NAME__(NAME, SUFFIX)   NAME##_##SUFFIX
+
+// Global names of ser_phy_hci.c.
+#define ser_phy_open                SIDE_NAME(ser_phy_open)
+#define ser_phy_tx_pkt_send         SIDE_NAME(ser_phy_tx_pkt_send)
+#define ser_phy_rx_buf_set          SIDE_NAME(ser_phy_rx_buf_set)
+#define ser_phy_close               SIDE_NAME(ser_phy_close)
+#define ser_phy_interrupts_enable   SIDE_NAME(ser_phy_interrupts_enable)
+#define ser_phy_interrupts_disable  SIDE_NAME(ser_phy_interrupts_disable)
+#define os_mailQ_q_tx_evt_queue     SIDE_NAME(os_mailQ_q_tx_evt_queue)
+#define os_mailQ_def_tx_evt_queue   SIDE_NAME(os_mailQ_def_tx_evt_queue)
+#define os_mailQ_q_rx_evt_queue     SIDE_NAME(os_mailQ_q_rx_evt_queue)
+#define os_mailQ_def_rx_evt_queue   SIDE_NAME(os_mailQ_def_rx_evt_queue)
+
+// SLIP layer of this side.
+#define ser_phy_hci_slip_open(HANDLER)          slip_sim_open(SER_PHY_SIDE, (HANDLER))
+#define ser_phy_hci_slip_tx_pkt_send(H, P, C)   slip_sim_tx_pkt_send(SER_PHY_SIDE, (H), (P), (C))
+#define ser_phy_hci_slip_rx_buf_free(BUFFER)    slip_sim_rx_buf_free(SER_PHY_SIDE, (BUFFER))
+#define ser_phy_hci_slip_close()                slip_sim_close(SER_PHY_SIDE)
+#define ser_phy_hci_slip_interrupts_enable()    slip_sim_interrupts_enable(SER_PHY_SIDE, true)
+#define ser_phy_hci_slip_interrupts_disable()   slip_sim_interrupts_enable(SER_PHY_SIDE, false)
+
+#include "ser_phy_hci.c"
+
+const ser_phy_api_t SIDE_NAME(ser_phy) =
+{
+    .open               = ser_phy_open,
+    .tx_pkt_send        = ser_phy_tx_pkt_send,
+    .rx_buf_set         = ser_phy_rx_buf_set,
+    .close              = ser_phy_close,
+    .interrupts_enable  = ser_phy_interrupts_enable,
+    .interrupts_disable = ser_phy_interrupts_disable,
+};
@@ -0,0 +1,374 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/** @file
+ *
+ * @brief Loopback test of the HCI PHY TX window with packet loss and corruption.
+ *
+ * @details Test: two instances of ser_phy_hci.c send packets of random length to each other at the
+ *          same time, over the SLIP link simulator which loses and corrupts packets on purpose.
+ *          Every packet must be received once, in order and unchanged, and every packet passed to
+ *          ser_phy_tx_pkt_send() must be reported as sent. The receiver can be made to grant its
+ *          buffers late, as a busy upper layer does. With -u only side 0 sends, so that the
+ *          acknowledgements of side 1 do not wait for its own packets.
+ *
+ *          Benchmark: payload throughput in each direction, compared with the raw rate of the
+ *          UART, and the share of packets transmitted again.
+ *
+ *          Usage: ser_phy_hci_test [-n packets] [-l max length] [-d drop permille]
+ *                                  [-c corrupt permille] [-r rx buffer delay us] [-s seed] [-u]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "ser_phy_sides.h"
+#include "slip_sim.h"
+#include "app_timer.h"
+#include "app_error.h"
+#include "app_util.h"
+#include "nrf_error.h"
+#include "ser_config.h"
+
+#define PRESCALER       0                       /**< RTC1 prescaler, as APP_TIMER_PRESCALER in ser_phy_hci.c. */
+#define BAUDRATE        1000000                 /**< UART baud rate (SER_PHY_UART_BAUDRATE). */
+#define BITS_PER_BYTE   11                      /**< Start, 8 data, parity and stop bits. */
+#define MAX_TIMERS      SLIP_SIM_SIDES          /**< One retransmission timer per side. */
+#define OP_QUEUE_SIZE   4                       /**< Size of the timer operation queues. */
+#define STALL_LIMIT_NS  10000000000ull          /**< Time without progress after which the test fails. */
+#define SETTLE_NS       1000000000ull           /**< Time run after the last packet, duplicates would come in it. */
+
+/**@brief One side of the test. */
+typedef struct
+{
+    ser_phy_api_t const * p_api;                            /**< HCI PHY of the side. */
+    uint32_t              tx_total;                         /**< Packets to send. */
+    uint32_t              tx_cnt;                           /**< Packets passed to ser_phy_tx_pkt_send(). */
+    uint32_t              tx_sent_cnt;                      /**< Packets reported as sent. */
+    uint32_t              rx_cnt;                           /**< Packets received. */
+    uint64_t              rx_bytes;                         /**< Payload bytes received. */
+    uint64_t              rx_done_ns;                       /**< Time when the last packet was received. */
+    uint8_t               tx_buf[SER_HAL_TRANSPORT_MAX_PKT_SIZE]; /**< Packet being sent. */
+    uint8_t               rx_buf[SER_HAL_TRANSPORT_MAX_PKT_SIZE]; /**< Buffer granted for reception. */
+} side_t;
+
+static uint32_t m_timer_buf[CEIL_DIV(APP_TIMER_BUF_SIZE(MAX_TIMERS, OP_QUEUE_SIZE + 1),
+                                     sizeof(uint32_t))];    /**< Buffer of the timer module. */
+static side_t   m_sides[SLIP_SIM_SIDES];
+static uint32_t m_packets     = 10000;                      /**< Packets to send in each direction. */
+static bool     m_one_way     = false;                      /**< Only side 0 sends. */
+static uint32_t m_max_length  = SER_HAL_TRANSPORT_MAX_PKT_SIZE;
+static uint64_t m_rx_delay_ns = 0;                          /**< Delay of granting an RX buffer. */
+static uint64_t m_start_ns;                                 /**< Time when the first packets were sent. */
+static uint64_t m_progress_ns;                              /**< Time of the last packet sent or received. */
+static uint32_t m_errors;                                   /**< Number of failed checks. */
+
+
+void app_error_handler(uint32_t error_code, uint32_t line_num, const uint8_t * p_file_name)
+{
+    printf("error 0x%x at %s:%u\n", (unsigned)error_code, (char const *)p_file_name, (unsigned)line_num);
+    exit(EXIT_FAILURE);
+}
+
+
+/**@brief Function for getting the length of a packet. */
+static uint16_t pkt_length_get(uint32_t side, uint32_t pkt_number)
+{
+    uint32_t hash = (pkt_number + 1) * 2654435761u + side;
+
+    return (uint16_t)(1 + ((hash >> 8) % m_max_length));
+}
+
+
+/**@brief Function for getting a payload byte of a packet. */
+static uint8_t pkt_byte_get(uint32_t side, uint32_t pkt_number, uint32_t index)
+{
+    return (uint8_t)((pkt_number * 31) + (index * 7) + (side * 101));
+}
+
+
+/**@brief Function for passing the next packet of a side to its HCI PHY. */
+static void tx_next(uint32_t side)
+{
+    side_t * p_side = &m_sides[side];
+    uint16_t length;
+    uint32_t i;
+
+    if (p_side->tx_cnt == p_side->tx_total)
+    {
+        return;
+    }
+
+    // With a window of one packet, the buffer is in use until the packet is reported as sent.
+    length = pkt_length_get(side, p_side->tx_cnt);
+    for (i = 0; i < length; i++)
+    {
+        p_side->tx_buf[i] = pkt_byte_get(side, p_side->tx_cnt, i);
+    }
+
+    APP_ERROR_CHECK(p_side->p_api->tx_pkt_send(p_side->tx_buf, length));
+    p_side->tx_cnt++;
+}
+
+
+/**@brief Function for checking a received packet. */
+static void rx_check(uint32_t side, uint8_t const * p_buffer, uint16_t length)
+{
+    side_t *       p_side = &m_sides[side];
+    const uint32_t peer   = (side + 1) % SLIP_SIM_SIDES;
+    bool           ok;
+    uint32_t       i;
+
+    ok = (p_side->rx_cnt < m_sides[peer].tx_total) &&
+         (p_buffer == p_side->rx_buf) &&
+         (length == pkt_length_get(peer, p_side->rx_cnt));
+
+    for (i = 0; ok && (i < length); i++)
+    {
+        ok = (p_buffer[i] == pkt_byte_get(peer, p_side->rx_cnt, i));
+    }
+
+    if (!ok)
+    {
+        printf("side %u: packet %u received with wrong length or data\n",
+               (unsigned)side, (unsigned)p_side->rx_cnt);
+        m_errors++;
+    }
+
+    p_side->rx_cnt++;
+    p_side->rx_bytes  += length;
+    p_side->rx_done_ns = slip_sim_time_get();
+}
+
+
+/**@brief Function for granting the RX buffer of a side, called after the RX buffer delay. */
+static void rx_buf_grant(void * p_context)
+{
+    side_t * p_side = p_context;
+
+    APP_ERROR_CHECK(p_side->p_api->rx_buf_set(p_side->rx_buf));
+}
+
+
+static void evt_handle(uint32_t side, ser_phy_evt_t event)
+{
+    side_t * p_side = &m_sides[side];
+
+    switch (event.evt_type)
+    {
+        case SER_PHY_EVT_TX_PKT_SENT:
+            p_side->tx_sent_cnt++;
+            m_progress_ns = slip_sim_time_get();
+            tx_next(side);
+            break;
+
+        case SER_PHY_EVT_RX_BUF_REQUEST:
+            if (m_rx_delay_ns == 0)
+            {
+                rx_buf_grant(p_side);
+            }
+            else
+            {
+                APP_ERROR_CHECK(slip_sim_call(m_rx_delay_ns, rx_buf_grant, p_side));
+            }
+            break;
+
+        case SER_PHY_EVT_RX_PKT_RECEIVED:
+            rx_check(side,
+                     event.evt_params.rx_pkt_received.p_buffer,
+                     event.evt_params.rx_pkt_received.num_of_bytes);
+            m_progress_ns = slip_sim_time_get();
+            break;
+
+        case SER_PHY_EVT_HW_ERROR:
+            // Too much loss for this test: a packet was sent MAX_RETRY_COUNT times in vain.
+            printf("side %u: retransmissions exhausted\n", (unsigned)side);
+            m_errors++;
+            break;
+
+        default:
+            printf("side %u: unexpected event %u\n", (unsigned)side, (unsigned)event.evt_type);
+            m_errors++;
+            break;
+    }
+}
+
+
+static void side_a_evt_handler(ser_phy_evt_t event)
+{
+    evt_handle(0, event);
+}
+
+
+static void side_b_evt_handler(ser_phy_evt_t event)
+{
+    evt_handle(1, event);
+}
+
+
+/**@brief Function for checking whether all packets have been sent and received. */
+static bool all_done(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < SLIP_SIM_SIDES; i++)
+    {
+        const uint32_t peer = (i + 1) % SLIP_SIM_SIDES;
+
+        if ((m_sides[i].tx_sent_cnt != m_sides[i].tx_total) ||
+            (m_sides[i].rx_cnt != m_sides[peer].tx_total))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+int main(int argc, char * argv[])
+{
+    slip_sim_config_t config =
+    {
+        .baudrate         = BAUDRATE,
+        .bits_per_byte    = BITS_PER_BYTE,
+        .drop_permille    = 0,
+        .corrupt_permille = 0,
+        .seed             = 1
+    };
+    uint64_t end_ns;
+    uint32_t i;
+    int      opt;
+
+    while ((opt = getopt(argc, argv, "n:l:d:c:r:s:u")) != -1)
+    {
+        switch (opt)
+        {
+            case 'n':
+                m_packets = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+
+            case 'l':
+                m_max_length = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+
+            case 'd':
+                config.drop_permille = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+
+            case 'c':
+                config.corrupt_permille = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+
+            case 'r':
+                m_rx_delay_ns = strtoull(optarg, NULL, 0) * 1000;
+                break;
+
+            case 's':
+                config.seed = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+
+            case 'u':
+                m_one_way = true;
+                break;
+
+            default:
+                fprintf(stderr, "usage: %s [-n packets] [-l max length] [-d drop permille] "
+                        "[-c corrupt permille] [-r rx buffer delay us] [-s seed] [-u]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if ((m_max_length == 0) || (m_max_length > SER_HAL_TRANSPORT_MAX_PKT_SIZE))
+    {
+        fprintf(stderr, "max length must be 1 - %u\n", (unsigned)SER_HAL_TRANSPORT_MAX_PKT_SIZE);
+        return EXIT_FAILURE;
+    }
+
+    APP_ERROR_CHECK(app_timer_init(PRESCALER, MAX_TIMERS, OP_QUEUE_SIZE + 1, m_timer_buf, NULL));
+    slip_sim_init(&config);
+
+    m_sides[0].p_api    = &ser_phy_a;
+    m_sides[0].tx_total = m_packets;
+    m_sides[1].p_api    = &ser_phy_b;
+    m_sides[1].tx_total = m_one_way ? 0 : m_packets;
+    APP_ERROR_CHECK(ser_phy_a.open(side_a_evt_handler));
+    APP_ERROR_CHECK(ser_phy_b.open(side_b_evt_handler));
+
+    for (i = 0; i < SLIP_SIM_SIDES; i++)
+    {
+        tx_next(i);
+    }
+
+    m_start_ns    = slip_sim_time_get();
+    m_progress_ns = m_start_ns;
+    while (!all_done())
+    {
+        if (!slip_sim_process(m_progress_ns + STALL_LIMIT_NS))
+        {
+            printf("no progress for %llu s\n", STALL_LIMIT_NS / 1000000000ull);
+            m_errors++;
+            break;
+        }
+    }
+
+    // Packets received twice would come after the last one.
+    end_ns = slip_sim_time_get() + SETTLE_NS;
+    while (slip_sim_process(end_ns))
+    {
+        // Retransmissions and acknowledgements in flight.
+    }
+
+    printf("window %u, %u packets of 1 - %u bytes %s, drop %.1f%%, corrupt %.1f%%, "
+           "rx buffer delay %u us\n",
+           (unsigned)SER_PHY_HCI_TX_WINDOW_SIZE, (unsigned)m_packets, (unsigned)m_max_length,
+           m_one_way ? "one way" : "each way",
+           config.drop_permille / 10.0, config.corrupt_permille / 10.0,
+           (unsigned)(m_rx_delay_ns / 1000));
+
+    for (i = 0; i < SLIP_SIM_SIDES; i++)
+    {
+        const uint32_t   peer = (i + 1) % SLIP_SIM_SIDES;
+        slip_sim_stats_t stats;
+        double           kbps;
+        double           raw_kbps = (double)BAUDRATE / BITS_PER_BYTE / 1000;
+
+        if (m_sides[i].tx_total == 0)
+        {
+            continue;
+        }
+        if (m_sides[peer].rx_cnt != m_sides[i].tx_total)
+        {
+            printf("  side %u: %u of %u packets received\n",
+                   (unsigned)peer, (unsigned)m_sides[peer].rx_cnt, (unsigned)m_sides[i].tx_total);
+            m_errors++;
+            continue;
+        }
+
+        slip_sim_stats_get(i, &stats);
+        kbps = (m_sides[peer].rx_bytes * 1e6) / (m_sides[peer].rx_done_ns - m_start_ns);
+        printf("  %u -> %u: %6.1f kB/s (%4.1f%% of the UART), %5.1f%% retransmitted, "
+               "%u lost, %u corrupted, %u no buffer, %u flow stops\n",
+               (unsigned)i, (unsigned)peer, kbps, (100.0 * kbps) / raw_kbps,
+               (100.0 * (stats.pkts - m_packets)) / m_packets,
+               (unsigned)stats.dropped, (unsigned)stats.corrupted,
+               (unsigned)stats.overflows, (unsigned)stats.stalls);
+    }
+
+    ser_phy_a.close();
+    ser_phy_b.close();
+
+    printf("%s\n", (m_errors == 0) ? "PASS" : "FAIL");
+
+    return (m_errors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
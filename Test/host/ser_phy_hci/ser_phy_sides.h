@@ -0,0 +1,42 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/** @file
+ *
+ * @brief The two instances of the HCI PHY connected by the SLIP link simulator.
+ *
+ * @details ser_phy_hci.c keeps its state in static variables, so it is built once for every side
+ *          (ser_phy_hci_a.c and ser_phy_hci_b.c), with the ser_phy API functions renamed. The test
+ *          calls them through these tables.
+ */
+
+#ifndef SER_PHY_SIDES_H__
+#define SER_PHY_SIDES_H__
+
+#include <stdint.h>
+#include "ser_phy.h"
+
+/**@brief ser_phy API of one instance. */
+typedef struct
+{
+    uint32_t (*open)(ser_phy_events_handler_t events_handler);
+    uint32_t (*tx_pkt_send)(const uint8_t * p_buffer, uint16_t num_of_bytes);
+    uint32_t (*rx_buf_set)(uint8_t * p_buffer);
+    void     (*close)(void);
+    void     (*interrupts_enable)(void);
+    void     (*interrupts_disable)(void);
+} ser_phy_api_t;
+
+extern const ser_phy_api_t ser_phy_a;   /**< Side 0 of the link. */
+extern const ser_phy_api_t ser_phy_b;   /**< Side 1 of the link. */
+
+#endif // SER_PHY_SIDES_H__
@@ -0,0 +1,458 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "slip_sim.h"
+#include "rtc_sim.h"
+#include "nrf_error.h"
+#include "ser_config.h"
+
+#define HDR_SIZE        4                                               /**< Size of the small receive buffer of ser_phy_hci_slip.c. */
+#define PKT_SIZE        (SER_HAL_TRANSPORT_MAX_PKT_SIZE + HDR_SIZE + 2) /**< Size of the big receive buffer of ser_phy_hci_slip.c. */
+#define SLIP_END        0xC0                                            /**< SLIP frame delimiter. */
+#define SLIP_ESC        0xDB                                            /**< SLIP escape byte. */
+#define RTC_FREQ        32768ull                                        /**< RTC1 ticks per second (prescaler 0). */
+#define NS_PER_S        1000000000ull                                   /**< Nanoseconds per second. */
+#define CALLS_MAX       4                                               /**< Maximum number of scheduled calls. */
+
+/**@brief A packet on the line. */
+typedef struct
+{
+    uint8_t  data[PKT_SIZE];    /**< Header, payload and CRC. */
+    uint16_t length;            /**< Length in bytes. */
+    bool     is_ack;            /**< Packet without payload. */
+} line_pkt_t;
+
+/**@brief One side of the link. */
+typedef struct
+{
+    ser_phy_hci_slip_event_handler_t handler;       /**< Event handler of the upper layer, NULL when closed. */
+    line_pkt_t                       tx_pkt;        /**< Packet being transmitted. */
+    line_pkt_t                       tx_pending;    /**< Packet to be transmitted next. */
+    bool                             tx_active;     /**< tx_pkt is being transmitted. */
+    bool                             tx_stalled;    /**< The receiver has stopped the transmission (flow control). */
+    bool                             tx_pending_set; /**< tx_pending holds a packet. */
+    uint64_t                         tx_end_ns;     /**< End of the transmission of tx_pkt. */
+    uint8_t                          rx_small[HDR_SIZE]; /**< Small receive buffer. */
+    uint8_t                          rx_big[PKT_SIZE];   /**< Big receive buffer. */
+    bool                             rx_small_held; /**< Small buffer holds a packet for the upper layer. */
+    bool                             rx_big_held;   /**< Big buffer holds a packet for the upper layer. */
+    slip_sim_stats_t                 stats;         /**< Statistics of the transmitted packets. */
+} side_t;
+
+/**@brief A scheduled call. */
+typedef struct
+{
+    void     (*function)(void * p_context);    /**< Function to call, NULL if the entry is free. */
+    void *   p_context;                         /**< Parameter of the function. */
+    uint64_t time_ns;                           /**< Time of the call. */
+} call_t;
+
+static slip_sim_config_t m_config;              /**< Simulator configuration. */
+static side_t            m_sides[SLIP_SIM_SIDES];
+static call_t            m_calls[CALLS_MAX];
+static uint64_t          m_time_ns;             /**< Time since initialization. */
+static unsigned          m_seed;                /**< State of the random decisions. */
+
+
+/**@brief Function for drawing true with the given probability in 1/1000. */
+static bool permille_draw(uint32_t permille)
+{
+    return ((uint32_t)rand_r(&m_seed) % 1000) < permille;
+}
+
+
+/**@brief Function for converting time in nanoseconds to RTC ticks, rounded down. */
+static uint64_t ns_to_ticks(uint64_t time_ns)
+{
+    return (time_ns * RTC_FREQ) / NS_PER_S;
+}
+
+
+/**@brief Function for catching up with RTC1, which is ahead while an app_timer interrupt is
+ *        handled. */
+static void time_sync(void)
+{
+    const uint64_t rtc_ns = (rtc_sim_time_get() * NS_PER_S) / RTC_FREQ;
+
+    if (rtc_ns > m_time_ns)
+    {
+        m_time_ns = rtc_ns;
+    }
+}
+
+
+/**@brief Function for starting the transmission of the packet in tx_pkt. */
+static void tx_start(side_t * p_side)
+{
+    uint32_t wire_bytes = 2 + p_side->tx_pkt.length; // Two SLIP_END delimiters.
+    uint32_t i;
+
+    time_sync();
+
+    for (i = 0; i < p_side->tx_pkt.length; i++)
+    {
+        if ((p_side->tx_pkt.data[i] == SLIP_END) || (p_side->tx_pkt.data[i] == SLIP_ESC))
+        {
+            wire_bytes++;
+        }
+    }
+
+    p_side->tx_active  = true;
+    p_side->tx_stalled = false;
+    p_side->tx_end_ns  = m_time_ns +
+                         (((uint64_t)wire_bytes * m_config.bits_per_byte * NS_PER_S) / m_config.baudrate);
+
+    p_side->stats.wire_bytes += wire_bytes;
+    if (p_side->tx_pkt.is_ack)
+    {
+        p_side->stats.acks++;
+    }
+    else
+    {
+        p_side->stats.pkts++;
+    }
+}
+
+
+/**@brief Function for choosing the receive buffer of a packet, as ser_phy_hci_slip.c does.
+ *
+ * @param[in]  p_rx      Receiving side.
+ * @param[in]  length    Length of the packet.
+ * @param[out] pp_buffer Buffer for the packet, NULL if the packet is lost.
+ *
+ * @retval true   The packet can be received (or is lost).
+ * @retval false  No buffer is free, the receiver stops the sender.
+ */
+static bool rx_buffer_get(side_t * p_rx, uint32_t length, uint8_t ** pp_buffer)
+{
+    *pp_buffer = NULL;
+
+    if (!p_rx->rx_small_held)
+    {
+        if (length <= HDR_SIZE)
+        {
+            p_rx->rx_small_held = true;
+            *pp_buffer          = p_rx->rx_small;
+        }
+        else if (!p_rx->rx_big_held)
+        {
+            p_rx->rx_big_held = true;
+            *pp_buffer        = p_rx->rx_big;
+        }
+        return true;
+    }
+
+    if (!p_rx->rx_big_held)
+    {
+        p_rx->rx_big_held = true;
+        *pp_buffer        = p_rx->rx_big;
+        return true;
+    }
+
+    return false;
+}
+
+
+/**@brief Function for ending the transmission of a side and delivering the packet to its peer. */
+static void tx_end(uint32_t side)
+{
+    side_t *               p_tx = &m_sides[side];
+    side_t *               p_rx = &m_sides[(side + 1) % SLIP_SIM_SIDES];
+    line_pkt_t             pkt;
+    ser_phy_hci_slip_evt_t event;
+    uint8_t *              p_buffer = NULL;
+    bool                   lost     = permille_draw(m_config.drop_permille);
+
+    if (!lost && (p_rx->handler != NULL))
+    {
+        if (!rx_buffer_get(p_rx, p_tx->tx_pkt.length, &p_buffer))
+        {
+            // Resumed when the receiver frees a buffer.
+            p_tx->tx_stalled = true;
+            p_tx->stats.stalls++;
+            return;
+        }
+        if (p_buffer == NULL)
+        {
+            p_tx->stats.overflows++;
+        }
+    }
+    else if (lost)
+    {
+        p_tx->stats.dropped++;
+    }
+
+    pkt              = p_tx->tx_pkt;
+    p_tx->tx_active  = false;
+    p_tx->tx_stalled = false;
+    if (p_tx->tx_pending_set)
+    {
+        p_tx->tx_pkt         = p_tx->tx_pending;
+        p_tx->tx_pending_set = false;
+        tx_start(p_tx);
+    }
+
+    // The last byte has left the sender before it is received.
+    if (p_tx->handler != NULL)
+    {
+        event.evt_type = pkt.is_ack ? SER_PHY_HCI_SLIP_EVT_ACK_SENT : SER_PHY_HCI_SLIP_EVT_PKT_SENT;
+        p_tx->handler(&event);
+    }
+
+    if (p_buffer != NULL)
+    {
+        if (permille_draw(m_config.corrupt_permille))
+        {
+            const uint32_t bit = (uint32_t)rand_r(&m_seed) % (pkt.length * 8u);
+
+            pkt.data[bit / 8] ^= (uint8_t)(1u << (bit % 8));
+            p_tx->stats.corrupted++;
+        }
+
+        memcpy(p_buffer, pkt.data, pkt.length);
+        event.evt_type                               = SER_PHY_HCI_SLIP_EVT_PKT_RECEIVED;
+        event.evt_params.received_pkt.p_buffer     = p_buffer;
+        event.evt_params.received_pkt.num_of_bytes = pkt.length;
+        p_rx->handler(&event);
+    }
+}
+
+
+void slip_sim_init(slip_sim_config_t const * p_config)
+{
+    m_config  = *p_config;
+    m_seed    = p_config->seed;
+    m_time_ns = 0;
+    memset(m_sides, 0, sizeof(m_sides));
+    memset(m_calls, 0, sizeof(m_calls));
+
+    // Start where RTC1 is, as it cannot be reset.
+    m_time_ns = (rtc_sim_time_get() * NS_PER_S + RTC_FREQ - 1) / RTC_FREQ;
+}
+
+
+uint32_t slip_sim_open(uint32_t side, ser_phy_hci_slip_event_handler_t events_handler)
+{
+    side_t * p_side = &m_sides[side];
+
+    if (events_handler == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    p_side->handler        = events_handler;
+    p_side->tx_active      = false;
+    p_side->tx_stalled     = false;
+    p_side->tx_pending_set = false;
+    p_side->rx_small_held  = false;
+    p_side->rx_big_held    = false;
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t slip_sim_tx_pkt_send(uint32_t                         side,
+                              const ser_phy_hci_pkt_params_t * p_header,
+                              const ser_phy_hci_pkt_params_t * p_payload,
+                              const ser_phy_hci_pkt_params_t * p_crc)
+{
+    side_t *     p_side = &m_sides[side];
+    line_pkt_t * p_pkt;
+
+    if (p_header == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    if (!p_side->tx_active)
+    {
+        p_pkt = &p_side->tx_pkt;
+    }
+    else if (!p_side->tx_pending_set)
+    {
+        p_pkt = &p_side->tx_pending;
+    }
+    else
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    memcpy(p_pkt->data, p_header->p_buffer, p_header->num_of_bytes);
+    p_pkt->length = p_header->num_of_bytes;
+    p_pkt->is_ack = (p_payload == NULL);
+
+    if (p_payload != NULL)
+    {
+        memcpy(&p_pkt->data[p_pkt->length], p_payload->p_buffer, p_payload->num_of_bytes);
+        p_pkt->length += p_payload->num_of_bytes;
+    }
+    if (p_crc != NULL)
+    {
+        memcpy(&p_pkt->data[p_pkt->length], p_crc->p_buffer, p_crc->num_of_bytes);
+        p_pkt->length += p_crc->num_of_bytes;
+    }
+
+    if (p_side->tx_active)
+    {
+        p_side->tx_pending_set = true;
+    }
+    else
+    {
+        tx_start(p_side);
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t slip_sim_rx_buf_free(uint32_t side, uint8_t * p_buffer)
+{
+    side_t * p_side = &m_sides[side];
+    side_t * p_peer = &m_sides[(side + 1) % SLIP_SIM_SIDES];
+
+    if (p_buffer == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+    else if ((p_buffer == p_side->rx_small) && p_side->rx_small_held)
+    {
+        p_side->rx_small_held = false;
+    }
+    else if ((p_buffer == p_side->rx_big) && p_side->rx_big_held)
+    {
+        p_side->rx_big_held = false;
+    }
+    else
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    // A stopped sender continues now, in the next slip_sim_process().
+    if (p_peer->tx_stalled)
+    {
+        time_sync();
+        p_peer->tx_stalled = false;
+        p_peer->tx_end_ns  = m_time_ns;
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+void slip_sim_close(uint32_t side)
+{
+    m_sides[side].handler = NULL;
+}
+
+
+void slip_sim_interrupts_enable(uint32_t side, bool enable)
+{
+    (void)side;
+    (void)enable;
+}
+
+
+uint32_t slip_sim_call(uint64_t delay_ns, void (*function)(void * p_context), void * p_context)
+{
+    uint32_t i;
+
+    time_sync();
+
+    for (i = 0; i < CALLS_MAX; i++)
+    {
+        if (m_calls[i].function == NULL)
+        {
+            m_calls[i].function  = function;
+            m_calls[i].p_context = p_context;
+            m_calls[i].time_ns   = m_time_ns + delay_ns;
+            return NRF_SUCCESS;
+        }
+    }
+
+    return NRF_ERROR_NO_MEM;
+}
+
+
+bool slip_sim_process(uint64_t end_ns)
+{
+    uint64_t next_ns   = end_ns;
+    int32_t  next_side = -1;
+    int32_t  next_call = -1;
+    uint64_t end_ticks;
+    uint32_t i;
+
+    for (i = 0; i < SLIP_SIM_SIDES; i++)
+    {
+        if (m_sides[i].tx_active && !m_sides[i].tx_stalled && (m_sides[i].tx_end_ns <= next_ns))
+        {
+            next_ns   = m_sides[i].tx_end_ns;
+            next_side = (int32_t)i;
+        }
+    }
+    for (i = 0; i < CALLS_MAX; i++)
+    {
+        if ((m_calls[i].function != NULL) && (m_calls[i].time_ns < next_ns))
+        {
+            next_ns   = m_calls[i].time_ns;
+            next_call = (int32_t)i;
+            next_side = -1;
+        }
+    }
+
+    // app_timer interrupts up to the next event come first.
+    end_ticks = ns_to_ticks(next_ns);
+    if (end_ticks > rtc_sim_time_get())
+    {
+        if (rtc_sim_run(end_ticks))
+        {
+            time_sync();
+            return true;
+        }
+    }
+
+    if (next_ns > m_time_ns)
+    {
+        m_time_ns = next_ns;
+    }
+
+    if (next_call >= 0)
+    {
+        call_t call = m_calls[next_call];
+
+        m_calls[next_call].function = NULL;
+        call.function(call.p_context);
+        return true;
+    }
+    if (next_side >= 0)
+    {
+        tx_end((uint32_t)next_side);
+        return true;
+    }
+
+    return false;
+}
+
+
+uint64_t slip_sim_time_get(void)
+{
+    time_sync();
+
+    return m_time_ns;
+}
+
+
+void slip_sim_stats_get(uint32_t side, slip_sim_stats_t * p_stats)
+{
+    *p_stats = m_sides[side].stats;
+}
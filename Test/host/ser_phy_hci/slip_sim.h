@@ -0,0 +1,123 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/** @file
+ *
+ * @defgroup slip_sim SLIP link simulator
+ * @{
+ * @ingroup host_test
+ *
+ * @brief Host simulation of the HCI SLIP layer of two devices connected by a UART.
+ *
+ * @details Every side has the API of ser_phy_hci_slip.h, with the index of the side as first
+ *          parameter. A packet is transmitted in the time of its SLIP encoded bytes at the
+ *          configured baud rate, both directions at the same time. One more packet can be passed
+ *          while a packet is being transmitted, as in ser_phy_hci_slip.c.
+ *
+ *          Reception is modelled on ser_phy_hci_slip.c as well: a packet starts in the small
+ *          (header size) buffer and moves to the big buffer when it does not fit. It is lost when
+ *          the small buffer is full and the big one is held by the upper layer. When both are held,
+ *          the UART flow control stops the sender until a buffer is freed.
+ *
+ *          A configurable share of packets is lost on the line or has a bit flipped.
+ *
+ *          Time is kept in nanoseconds. RTC1 of the RTC1 simulator (rtc_sim.h) runs with it, so that
+ *          app_timer timeouts come between the packets.
+ */
+
+#ifndef SLIP_SIM_H__
+#define SLIP_SIM_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ser_phy_hci.h"
+
+#define SLIP_SIM_SIDES 2                                        /**< Number of devices on the link. */
+
+/**@brief Simulator configuration. */
+typedef struct
+{
+    uint32_t baudrate;          /**< UART baud rate in bits per second. */
+    uint32_t bits_per_byte;     /**< UART bits per byte, including start, parity and stop bits. */
+    uint32_t drop_permille;     /**< Share of packets (in 1/1000) lost on the line. */
+    uint32_t corrupt_permille;  /**< Share of packets (in 1/1000) received with one bit flipped. */
+    uint32_t seed;              /**< Seed of the loss and corruption decisions. */
+} slip_sim_config_t;
+
+/**@brief Statistics of one direction of the link, by transmitting side. */
+typedef struct
+{
+    uint32_t pkts;              /**< Number of packets with payload transmitted. */
+    uint32_t acks;              /**< Number of packets without payload (acknowledgements) transmitted. */
+    uint64_t wire_bytes;        /**< Number of SLIP encoded bytes transmitted. */
+    uint32_t dropped;           /**< Number of packets lost on the line on purpose. */
+    uint32_t corrupted;         /**< Number of packets corrupted on purpose. */
+    uint32_t overflows;         /**< Number of packets lost because the receiver had no buffer. */
+    uint32_t stalls;            /**< Number of times the receiver stopped the sender (flow control). */
+} slip_sim_stats_t;
+
+/**@brief Function for (re)initializing the simulator. Both sides are closed. */
+void slip_sim_init(slip_sim_config_t const * p_config);
+
+/**@brief Simulation of ser_phy_hci_slip_open for one side. */
+uint32_t slip_sim_open(uint32_t side, ser_phy_hci_slip_event_handler_t events_handler);
+
+/**@brief Simulation of ser_phy_hci_slip_tx_pkt_send for one side.
+ *
+ * @retval NRF_SUCCESS     Transmission started or scheduled.
+ * @retval NRF_ERROR_NULL  No header.
+ * @retval NRF_ERROR_BUSY  A packet is being transmitted and another one is already scheduled
+ *                         (ser_phy_hci_slip.c would overwrite the scheduled one).
+ */
+uint32_t slip_sim_tx_pkt_send(uint32_t                         side,
+                              const ser_phy_hci_pkt_params_t * p_header,
+                              const ser_phy_hci_pkt_params_t * p_payload,
+                              const ser_phy_hci_pkt_params_t * p_crc);
+
+/**@brief Simulation of ser_phy_hci_slip_rx_buf_free for one side. */
+uint32_t slip_sim_rx_buf_free(uint32_t side, uint8_t * p_buffer);
+
+/**@brief Simulation of ser_phy_hci_slip_close for one side. */
+void slip_sim_close(uint32_t side);
+
+/**@brief Simulation of ser_phy_hci_slip_interrupts_enable and _disable. Interrupts are not
+ *        simulated, events are always reported at once. */
+void slip_sim_interrupts_enable(uint32_t side, bool enable);
+
+/**@brief Function for calling a function after a delay, as if from an interrupt.
+ *
+ * @retval NRF_SUCCESS       Call scheduled.
+ * @retval NRF_ERROR_NO_MEM  Too many calls scheduled.
+ */
+uint32_t slip_sim_call(uint64_t delay_ns, void (*function)(void * p_context), void * p_context);
+
+/**@brief Function for running the simulation until the next event, not past a given time.
+ *
+ * @details The next end of a packet transmission, scheduled call or app_timer interrupt is
+ *          handled.
+ *
+ * @param[in] end_ns  Time (in nanoseconds since initialization) not to run past.
+ *
+ * @retval true   An event was handled.
+ * @retval false  End time reached.
+ */
+bool slip_sim_process(uint64_t end_ns);
+
+/**@brief Function for getting the time in nanoseconds since initialization. */
+uint64_t slip_sim_time_get(void);
+
+/**@brief Function for getting the statistics of the packets transmitted by one side. */
+void slip_sim_stats_get(uint32_t side, slip_sim_stats_t * p_stats);
+
+#endif // SLIP_SIM_H__
+
+/** @} */
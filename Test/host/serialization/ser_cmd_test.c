@@ -0,0 +1,2380 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/** @file
+ *
+ * @brief Test and benchmark of the s110 command serializers.
+ *
+ * @details Test: for every command, random requests are encoded by the application side
+ *          (*_req_enc()) and passed to the connectivity middleware (conn_mw_handler()), which
+ *          decodes them, calls the SoftDevice and encodes the response. The SoftDevice functions
+ *          are stubs which encode their arguments again with the application encoder, that
+ *          encoding must be identical to the request. They return random output values and
+ *          result codes, which must come out of the application response decoder (*_rsp_dec())
+ *          unchanged. Requests rejected by the application encoder as invalid are counted, but
+ *          every command must have some requests passing. The connectivity side may only reject
+ *          requests exceeding its limits (e.g. advertising data longer than 31 bytes).
+ *
+ *          Every command of the connectivity middleware is tested, except:
+ *          - power_system_off: the SoftDevice does not return and no response is encoded.
+ *
+ *          Benchmark: nanoseconds per command of the whole exchange (request encoding and
+ *          decoding, response encoding and decoding, the SoftDevice stub doing nothing), and
+ *          request and response bytes per command, for one random command of every kind.
+ *
+ *          Usage: ser_cmd_test [-n iterations] [-s seed]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "ble.h"
+#include "ble_gap.h"
+#include "ble_gatts.h"
+#include "ble_gattc.h"
+#include "ble_l2cap.h"
+#include "nrf_soc.h"
+#include "nrf_error.h"
+#include "ble_serialization.h"
+#include "ble_app.h"
+#include "ble_gap_app.h"
+#include "ble_gatts_app.h"
+#include "ble_gattc_app.h"
+#include "ble_l2cap_app.h"
+#include "nrf_soc_app.h"
+#include "conn_mw.h"
+
+#define PKT_BUFFER_SIZE   1024                              /**< Size of a request or response buffer. */
+#define MAX_VALUE_LEN     40                                /**< Max length of random values in commands. */
+#define ARRAY_SIZE(a)     (sizeof(a) / sizeof((a)[0]))      /**< Number of elements of an array. */
+
+/**@brief Encodes a request with the application encoder. The command is dropped when the encoder
+ *        rejects it. */
+#define REQ_ENC(call)                                       \
+    do                                                      \
+    {                                                       \
+        m_req_len = sizeof(m_req);                          \
+        if ((call) != NRF_SUCCESS)                          \
+        {                                                   \
+            m_rejected++;                                   \
+            return;                                         \
+        }                                                   \
+    } while (0)
+
+/**@brief Encodes the arguments of a SoftDevice call again with the application encoder (not in
+ *        the benchmark). */
+#define SD_REQ_ENC(call)                                    \
+    do                                                      \
+    {                                                       \
+        m_sd_called = true;                                 \
+        if (!m_bench)                                       \
+        {                                                   \
+            m_req_again_len = sizeof(m_req_again);          \
+            if ((call) != NRF_SUCCESS)                      \
+            {                                               \
+                m_req_again_len = 0;                        \
+            }                                               \
+        }                                                   \
+    } while (0)
+
+/**@brief Response decoder of commands without output values. */
+typedef uint32_t (*rsp_dec_t)(uint8_t const * const p_buf,
+                              uint32_t              packet_len,
+                              uint32_t * const      p_result_code);
+
+/**@brief Command to test. */
+typedef struct
+{
+    const char * p_name;                                    /**< Name of the command. */
+    void      (* run)(bool randomize);                      /**< Function for running the command, with new random arguments or with the previous ones. */
+} cmd_desc_t;
+
+static uint8_t      m_req[PKT_BUFFER_SIZE];                 /**< Request encoded by the application side. */
+static uint32_t     m_req_len;                              /**< Length of the request. */
+static uint8_t      m_req_again[PKT_BUFFER_SIZE];           /**< Request encoded again by the SoftDevice stub. */
+static uint32_t     m_req_again_len;                        /**< Length of the request encoded again. */
+static uint8_t      m_rsp[PKT_BUFFER_SIZE];                 /**< Response encoded by the connectivity side. */
+static uint32_t     m_rsp_len;                              /**< Length of the response. */
+static bool         m_sd_called;                            /**< A SoftDevice stub has been called. */
+static uint32_t     m_sd_result;                            /**< Result code returned by the SoftDevice stub. */
+static uint8_t      m_sd_out[PKT_BUFFER_SIZE];              /**< Output values of the SoftDevice stub. */
+static uint32_t     m_sd_out_len;                           /**< Length of the output values. */
+static bool         m_bench;                                /**< Benchmark running: no NULL arguments, no checks in the stubs. */
+static bool         m_oversize;                             /**< The request exceeds a limit of the connectivity side, which may reject it. */
+static const char * mp_name;                                /**< Name of the command being tested. */
+static uint32_t     m_iteration;                            /**< Iteration of the command being tested. */
+static uint32_t     m_passed;                               /**< Number of commands passed through both sides. */
+static uint32_t     m_rejected;                             /**< Number of commands rejected as invalid. */
+static uint32_t     m_errors;                               /**< Number of failed checks. */
+
+
+/**@brief Function for getting host time in nanoseconds. */
+static uint64_t host_ns_get(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ull) + (uint64_t)ts.tv_nsec;
+}
+
+
+/**@brief Function for reporting a failed check. */
+static bool check(bool ok, char const * p_what)
+{
+    if (!ok && (m_errors++ < 10))
+    {
+        printf("%s, iteration %u: %s\n", mp_name, (unsigned)m_iteration, p_what);
+    }
+    return ok;
+}
+
+
+/**@brief Function for getting a random number from 0 to limit - 1. */
+static uint32_t random_get(uint32_t limit)
+{
+    return (limit != 0) ? ((uint32_t)rand() % limit) : 0;
+}
+
+
+/**@brief Function for filling a span with random bytes. */
+static void random_fill(void * p_data, uint32_t length)
+{
+    uint32_t i;
+
+    for (i = 0; i < length; i++)
+    {
+        ((uint8_t *)p_data)[i] = (uint8_t)rand();
+    }
+}
+
+
+/**@brief Function for deciding whether to pass a NULL pointer, for one pointer in five (never in
+ *        the benchmark). */
+static bool random_null(void)
+{
+    return !m_bench && (random_get(5) == 0);
+}
+
+
+/**@brief Macro for passing a pointer, or NULL for one pointer in five. */
+#define OR_NULL(p) (random_null() ? NULL : (p))
+
+
+/**@brief Function for setting an output value of a SoftDevice stub. */
+static void sd_out(void * p_out, uint32_t length)
+{
+    if (!m_bench)
+    {
+        random_fill(p_out, length);
+    }
+    memcpy(m_sd_out, p_out, length);
+    m_sd_out_len = length;
+}
+
+
+/**@brief Function for setting a variable length output value of a SoftDevice stub, no longer
+ *        than the buffer size in *p_len. Only the length is returned when p_data is NULL. */
+static void sd_out_var(uint8_t * p_data, uint16_t * p_len)
+{
+    if (!m_bench)
+    {
+        *p_len = (uint16_t)random_get(*p_len + 1);
+    }
+    if (p_data != NULL)
+    {
+        sd_out(p_data, *p_len);
+    }
+    else
+    {
+        // The application side decodes no value, only the length is checked.
+        memset(m_sd_out, 0, *p_len);
+        m_sd_out_len = *p_len;
+    }
+}
+
+
+/**@brief Function for returning NRF_ERROR_NULL from a SoftDevice stub. */
+static uint32_t sd_null(void)
+{
+    m_sd_result = NRF_ERROR_NULL;
+    return m_sd_result;
+}
+
+
+/**@brief Function for passing the request to the connectivity side.
+ *
+ * @retval true   The SoftDevice was called with the arguments of the request and a response was
+ *                encoded.
+ * @retval false  The request was rejected, or the SoftDevice was called with other arguments.
+ *                Only requests exceeding a limit of the connectivity side may be rejected.
+ */
+static bool conn_call(void)
+{
+    uint32_t err_code;
+
+    m_sd_called     = false;
+    m_sd_result     = (!m_bench && (random_get(4) == 0)) ? NRF_ERROR_INVALID_PARAM : NRF_SUCCESS;
+    m_sd_out_len    = 0;
+    m_req_again_len = 0;
+    m_rsp_len       = sizeof(m_rsp);
+
+    err_code = conn_mw_handler(m_req, m_req_len, m_rsp, &m_rsp_len);
+    if ((err_code != NRF_SUCCESS) || !m_sd_called)
+    {
+        m_rejected++;
+        (void)check(m_bench || m_oversize, "request rejected by the connectivity side");
+        return false;
+    }
+
+    return m_bench ||
+           check((m_req_again_len == m_req_len) && (memcmp(m_req_again, m_req, m_req_len) == 0),
+                 "SoftDevice called with other arguments than requested");
+}
+
+
+/**@brief Function for checking a decoded response.
+ *
+ * @param[in] err_code     Result of the response decoder.
+ * @param[in] result_code  Decoded result code.
+ * @param[in] values_ok    The decoded output values are the SoftDevice output values.
+ */
+static void rsp_check(uint32_t err_code, uint32_t result_code, bool values_ok)
+{
+    if (check(err_code == NRF_SUCCESS, "response decoding failed") &&
+        check(result_code == m_sd_result, "wrong result code") &&
+        check(values_ok, "wrong output values"))
+    {
+        m_passed++;
+    }
+}
+
+
+/**@brief Function for decoding and checking a response without output values. */
+static void rsp_dec(rsp_dec_t decoder)
+{
+    uint32_t result_code = 0;
+    uint32_t err_code    = decoder(m_rsp, m_rsp_len, &result_code);
+
+    rsp_check(err_code, result_code, true);
+}
+
+
+/**@brief Function for checking decoded output values against the SoftDevice output values.
+ *        They are not checked when the SoftDevice call failed or did not set them. */
+static bool out_check(void const * p_value, uint32_t length)
+{
+    return (m_sd_result != NRF_SUCCESS) ||
+           (m_sd_out_len == 0) ||
+           ((length == m_sd_out_len) && (memcmp(p_value, m_sd_out, length) == 0));
+}
+
+
+/* SoftDevice stubs. */
+
+uint32_t sd_ble_gap_adv_data_set(uint8_t const * p_data, uint8_t dlen,
+                                 uint8_t const * p_sr_data, uint8_t srdlen)
+{
+    SD_REQ_ENC(ble_gap_adv_data_set_req_enc(p_data, dlen, p_sr_data, srdlen,
+                                            m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gap_adv_start(ble_gap_adv_params_t const * p_adv_params)
+{
+    SD_REQ_ENC(ble_gap_adv_start_req_enc(p_adv_params, m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gap_adv_stop(void)
+{
+    SD_REQ_ENC(ble_gap_adv_stop_req_enc(m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gap_address_set(uint8_t addr_cycle_mode, ble_gap_addr_t const * p_addr)
+{
+    SD_REQ_ENC(ble_gap_address_set_req_enc(addr_cycle_mode, p_addr, m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gap_address_get(ble_gap_addr_t * p_addr)
+{
+    SD_REQ_ENC(ble_gap_address_get_req_enc(p_addr, m_req_again, &m_req_again_len));
+    if (p_addr == NULL)
+    {
+        return sd_null();
+    }
+    sd_out(p_addr, sizeof(*p_addr));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gap_conn_param_update(uint16_t conn_handle, ble_gap_conn_params_t const * p_conn_params)
+{
+    SD_REQ_ENC(ble_gap_conn_param_update_req_enc(conn_handle, p_conn_params,
+                                                 m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gap_disconnect(uint16_t conn_handle, uint8_t hci_status_code)
+{
+    SD_REQ_ENC(ble_gap_disconnect_req_enc(conn_handle, hci_status_code,
+                                          m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gap_tx_power_set(int8_t tx_power)
+{
+    SD_REQ_ENC(ble_gap_tx_power_set_req_enc(tx_power, m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gap_appearance_set(uint16_t appearance)
+{
+    SD_REQ_ENC(ble_gap_appearance_set_req_enc(appearance, m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gap_appearance_get(uint16_t * p_appearance)
+{
+    SD_REQ_ENC(ble_gap_appearance_get_req_enc(p_appearance, m_req_again, &m_req_again_len));
+    if (p_appearance == NULL)
+    {
+        return sd_null();
+    }
+    sd_out(p_appearance, sizeof(*p_appearance));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gap_ppcp_set(ble_gap_conn_params_t const * p_conn_params)
+{
+    SD_REQ_ENC(ble_gap_ppcp_set_req_enc(p_conn_params, m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gap_ppcp_get(ble_gap_conn_params_t * p_conn_params)
+{
+    SD_REQ_ENC(ble_gap_ppcp_get_req_enc(p_conn_params, m_req_again, &m_req_again_len));
+    if (p_conn_params == NULL)
+    {
+        return sd_null();
+    }
+    sd_out(p_conn_params, sizeof(*p_conn_params));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gap_device_name_set(ble_gap_conn_sec_mode_t const * p_write_perm,
+                                    uint8_t const * p_dev_name, uint16_t len)
+{
+    SD_REQ_ENC(ble_gap_device_name_set_req_enc(p_write_perm, p_dev_name, len,
+                                               m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gap_device_name_get(uint8_t * p_dev_name, uint16_t * p_len)
+{
+    SD_REQ_ENC(ble_gap_device_name_get_req_enc(p_dev_name, p_len, m_req_again, &m_req_again_len));
+    if (p_len == NULL)
+    {
+        return sd_null();
+    }
+    sd_out_var(p_dev_name, p_len);
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gap_authenticate(uint16_t conn_handle, ble_gap_sec_params_t const * p_sec_params)
+{
+    SD_REQ_ENC(ble_gap_authenticate_req_enc(conn_handle, p_sec_params,
+                                            m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gap_sec_params_reply(uint16_t conn_handle, uint8_t sec_status,
+                                     ble_gap_sec_params_t const * p_sec_params)
+{
+    SD_REQ_ENC(ble_gap_sec_params_reply_req_enc(conn_handle, sec_status, p_sec_params,
+                                                m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gap_auth_key_reply(uint16_t conn_handle, uint8_t key_type, uint8_t const * key)
+{
+    SD_REQ_ENC(ble_gap_auth_key_reply_req_enc(conn_handle, key_type, key,
+                                              m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gap_sec_info_reply(uint16_t conn_handle, ble_gap_enc_info_t const * p_enc_info,
+                                   ble_gap_sign_info_t const * p_sign_info)
+{
+    SD_REQ_ENC(ble_gap_sec_info_reply_req_enc(conn_handle, p_enc_info, p_sign_info,
+                                              m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gap_conn_sec_get(uint16_t conn_handle, ble_gap_conn_sec_t * p_conn_sec)
+{
+    SD_REQ_ENC(ble_gap_conn_sec_get_req_enc(conn_handle, p_conn_sec, m_req_again, &m_req_again_len));
+    if (p_conn_sec == NULL)
+    {
+        return sd_null();
+    }
+    sd_out(p_conn_sec, sizeof(*p_conn_sec));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gap_rssi_start(uint16_t conn_handle)
+{
+    SD_REQ_ENC(ble_gap_rssi_start_req_enc(conn_handle, m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gap_rssi_stop(uint16_t conn_handle)
+{
+    SD_REQ_ENC(ble_gap_rssi_stop_req_enc(conn_handle, m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gattc_primary_services_discover(uint16_t conn_handle, uint16_t start_handle,
+                                                ble_uuid_t const * p_srvc_uuid)
+{
+    SD_REQ_ENC(ble_gattc_primary_services_discover_req_enc(conn_handle, start_handle, p_srvc_uuid,
+                                                           m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gattc_relationships_discover(uint16_t conn_handle,
+                                             ble_gattc_handle_range_t const * p_handle_range)
+{
+    SD_REQ_ENC(ble_gattc_relationships_discover_req_enc(conn_handle, p_handle_range,
+                                                        m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gattc_characteristics_discover(uint16_t conn_handle,
+                                               ble_gattc_handle_range_t const * p_handle_range)
+{
+    SD_REQ_ENC(ble_gattc_characteristics_discover_req_enc(conn_handle, p_handle_range,
+                                                          m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gattc_descriptors_discover(uint16_t conn_handle,
+                                           ble_gattc_handle_range_t const * p_handle_range)
+{
+    SD_REQ_ENC(ble_gattc_descriptors_discover_req_enc(conn_handle, p_handle_range,
+                                                      m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gattc_char_value_by_uuid_read(uint16_t conn_handle, ble_uuid_t const * p_uuid,
+                                              ble_gattc_handle_range_t const * p_handle_range)
+{
+    SD_REQ_ENC(ble_gattc_char_value_by_uuid_read_req_enc(conn_handle, p_uuid, p_handle_range,
+                                                         m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gattc_read(uint16_t conn_handle, uint16_t handle, uint16_t offset)
+{
+    SD_REQ_ENC(ble_gattc_read_req_enc(conn_handle, handle, offset, m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gattc_char_values_read(uint16_t conn_handle, uint16_t const * p_handles,
+                                       uint16_t handle_count)
+{
+    SD_REQ_ENC(ble_gattc_char_values_read_req_enc(conn_handle, p_handles, handle_count,
+                                                  m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gattc_write(uint16_t conn_handle, ble_gattc_write_params_t const * p_write_params)
+{
+    SD_REQ_ENC(ble_gattc_write_req_enc(conn_handle, p_write_params, m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gattc_hv_confirm(uint16_t conn_handle, uint16_t handle)
+{
+    SD_REQ_ENC(ble_gattc_hv_confirm_req_enc(conn_handle, handle, m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gatts_service_add(uint8_t type, ble_uuid_t const * p_uuid, uint16_t * p_handle)
+{
+    SD_REQ_ENC(ble_gatts_service_add_req_enc(type, p_uuid, p_handle, m_req_again, &m_req_again_len));
+    if (p_handle == NULL)
+    {
+        return sd_null();
+    }
+    sd_out(p_handle, sizeof(*p_handle));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gatts_include_add(uint16_t service_handle, uint16_t inc_srvc_handle,
+                                  uint16_t * p_include_handle)
+{
+    SD_REQ_ENC(ble_gatts_include_add_req_enc(service_handle, inc_srvc_handle, p_include_handle,
+                                             m_req_again, &m_req_again_len));
+    if (p_include_handle == NULL)
+    {
+        return sd_null();
+    }
+    sd_out(p_include_handle, sizeof(*p_include_handle));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gatts_characteristic_add(uint16_t service_handle,
+                                         ble_gatts_char_md_t const * p_char_md,
+                                         ble_gatts_attr_t const * p_attr_char_value,
+                                         ble_gatts_char_handles_t * p_handles)
+{
+    SD_REQ_ENC(ble_gatts_characteristic_add_req_enc(service_handle, p_char_md, p_attr_char_value,
+                                                    p_handles, m_req_again, &m_req_again_len));
+    if (p_handles == NULL)
+    {
+        return sd_null();
+    }
+    sd_out(p_handles, sizeof(*p_handles));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gatts_descriptor_add(uint16_t char_handle, ble_gatts_attr_t const * p_attr,
+                                     uint16_t * p_handle)
+{
+    SD_REQ_ENC(ble_gatts_descriptor_add_req_enc(char_handle, p_attr, p_handle,
+                                                m_req_again, &m_req_again_len));
+    if (p_handle == NULL)
+    {
+        return sd_null();
+    }
+    sd_out(p_handle, sizeof(*p_handle));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gatts_value_set(uint16_t handle, uint16_t offset, uint16_t * const p_len,
+                                uint8_t const * const p_value)
+{
+    SD_REQ_ENC(ble_gatts_value_set_req_enc(handle, offset, p_len, p_value,
+                                           m_req_again, &m_req_again_len));
+    if (p_len != NULL)
+    {
+        sd_out(p_len, sizeof(*p_len));
+    }
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gatts_value_get(uint16_t handle, uint16_t offset, uint16_t * const p_len,
+                                uint8_t * const p_data)
+{
+    SD_REQ_ENC(ble_gatts_value_get_req_enc(handle, offset, p_len, p_data,
+                                           m_req_again, &m_req_again_len));
+    if (p_len == NULL)
+    {
+        return sd_null();
+    }
+    sd_out_var(p_data, p_len);
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gatts_hvx(uint16_t conn_handle, ble_gatts_hvx_params_t const * const p_hvx_params)
+{
+    SD_REQ_ENC(ble_gatts_hvx_req_enc(conn_handle, p_hvx_params, m_req_again, &m_req_again_len));
+    if ((p_hvx_params != NULL) && (p_hvx_params->p_len != NULL))
+    {
+        sd_out(p_hvx_params->p_len, sizeof(*p_hvx_params->p_len));
+    }
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gatts_service_changed(uint16_t conn_handle, uint16_t start_handle,
+                                      uint16_t end_handle)
+{
+    SD_REQ_ENC(ble_gatts_service_changed_req_enc(conn_handle, start_handle, end_handle,
+                                                 m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gatts_rw_authorize_reply(uint16_t conn_handle,
+                                         ble_gatts_rw_authorize_reply_params_t const * const p_rw_authorize_reply_params)
+{
+    SD_REQ_ENC(ble_gatts_rw_authorize_reply_req_enc(conn_handle, p_rw_authorize_reply_params,
+                                                    m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gatts_sys_attr_set(uint16_t conn_handle, uint8_t const * const p_sys_attr_data,
+                                   uint16_t len)
+{
+    SD_REQ_ENC(ble_gatts_sys_attr_set_req_enc(conn_handle, p_sys_attr_data, len,
+                                              m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_gatts_sys_attr_get(uint16_t conn_handle, uint8_t * const p_sys_attr_data,
+                                   uint16_t * const p_len)
+{
+    SD_REQ_ENC(ble_gatts_sys_attr_get_req_enc(conn_handle, p_sys_attr_data, p_len,
+                                              m_req_again, &m_req_again_len));
+    if (p_len == NULL)
+    {
+        return sd_null();
+    }
+    sd_out_var(p_sys_attr_data, p_len);
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_l2cap_cid_register(uint16_t cid)
+{
+    SD_REQ_ENC(ble_l2cap_cid_register_req_enc(cid, m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_l2cap_cid_unregister(uint16_t cid)
+{
+    SD_REQ_ENC(ble_l2cap_cid_unregister_req_enc(cid, m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_l2cap_tx(uint16_t conn_handle, ble_l2cap_header_t const * const p_header,
+                         uint8_t const * const p_data)
+{
+    SD_REQ_ENC(ble_l2cap_tx_req_enc(conn_handle, p_header, p_data, m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_enable(ble_enable_params_t * p_ble_enable_params)
+{
+    SD_REQ_ENC(ble_enable_req_enc(p_ble_enable_params, m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_tx_buffer_count_get(uint8_t * p_count)
+{
+    SD_REQ_ENC(ble_tx_buffer_count_get_req_enc(p_count, m_req_again, &m_req_again_len));
+    if (p_count == NULL)
+    {
+        return sd_null();
+    }
+    sd_out(p_count, sizeof(*p_count));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_uuid_vs_add(ble_uuid128_t const * const p_vs_uuid, uint8_t * const p_uuid_type)
+{
+    SD_REQ_ENC(ble_uuid_vs_add_req_enc(p_vs_uuid, p_uuid_type, m_req_again, &m_req_again_len));
+    if (p_uuid_type == NULL)
+    {
+        return sd_null();
+    }
+    sd_out(p_uuid_type, sizeof(*p_uuid_type));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_uuid_decode(uint8_t uuid_le_len, uint8_t const * const p_uuid_le,
+                            ble_uuid_t * const p_uuid)
+{
+    SD_REQ_ENC(ble_uuid_decode_req_enc(uuid_le_len, p_uuid_le, p_uuid,
+                                       m_req_again, &m_req_again_len));
+    if (p_uuid == NULL)
+    {
+        return sd_null();
+    }
+    sd_out(p_uuid, sizeof(*p_uuid));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_uuid_encode(ble_uuid_t const * const p_uuid, uint8_t * const p_uuid_le_len,
+                            uint8_t * const p_uuid_le)
+{
+    SD_REQ_ENC(ble_uuid_encode_req_enc(p_uuid, p_uuid_le_len, p_uuid_le,
+                                       m_req_again, &m_req_again_len));
+    if (p_uuid_le_len == NULL)
+    {
+        return sd_null();
+    }
+    *p_uuid_le_len = (m_bench || (rand() & 1)) ? 16 : 2;
+    if (p_uuid_le != NULL)
+    {
+        sd_out(p_uuid_le, *p_uuid_le_len);
+    }
+    else
+    {
+        m_sd_out_len = *p_uuid_le_len;
+    }
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_version_get(ble_version_t * p_version)
+{
+    SD_REQ_ENC(ble_version_get_req_enc(p_version, m_req_again, &m_req_again_len));
+    if (p_version == NULL)
+    {
+        return sd_null();
+    }
+    sd_out(p_version, sizeof(*p_version));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_opt_set(uint32_t opt_id, ble_opt_t const * p_opt)
+{
+    SD_REQ_ENC(ble_opt_set_req_enc(opt_id, p_opt, m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_ble_opt_get(uint32_t opt_id, ble_opt_t * p_opt)
+{
+    static ble_gap_irk_t irk;
+    static uint8_t       passkey[BLE_GAP_PASSKEY_LEN];
+    static uint16_t      actual_latency;
+
+    SD_REQ_ENC(ble_opt_get_req_enc(opt_id, p_opt, m_req_again, &m_req_again_len));
+    if (p_opt == NULL)
+    {
+        return sd_null();
+    }
+    if (!m_bench)
+    {
+        random_fill(&irk, sizeof(irk));
+        random_fill(passkey, sizeof(passkey));
+        actual_latency = (uint16_t)rand();
+    }
+    sd_out(p_opt, sizeof(*p_opt));
+    // The request carries no option storage, the stub returns its own.
+    switch (opt_id)
+    {
+        case BLE_GAP_OPT_PASSKEY:
+            p_opt->gap.passkey.p_passkey = OR_NULL(passkey);
+            break;
+
+        case BLE_GAP_OPT_PRIVACY:
+            p_opt->gap.privacy.p_irk = OR_NULL(&irk);
+            break;
+
+        default:
+            p_opt->gap.local_conn_latency.p_actual_latency = OR_NULL(&actual_latency);
+            break;
+    }
+    memcpy(m_sd_out, p_opt, sizeof(*p_opt));
+    return m_sd_result;
+}
+
+
+uint32_t sd_power_system_off(void)
+{
+    SD_REQ_ENC(power_system_off_req_enc(m_req_again, &m_req_again_len));
+    return m_sd_result;
+}
+
+
+uint32_t sd_temp_get(int32_t * p_temp)
+{
+    SD_REQ_ENC(temp_get_req_enc(p_temp, m_req_again, &m_req_again_len));
+    if (p_temp == NULL)
+    {
+        return sd_null();
+    }
+    sd_out(p_temp, sizeof(*p_temp));
+    return m_sd_result;
+}
+
+
+/* Commands. */
+
+static void cmd_gap_adv_data_set(bool randomize)
+{
+    static uint8_t         data[BLE_GAP_ADV_MAX_SIZE + 1];
+    static uint8_t         sr_data[BLE_GAP_ADV_MAX_SIZE + 1];
+    static uint8_t const * p_data;
+    static uint8_t const * p_sr_data;
+    static uint8_t         dlen;
+    static uint8_t         srdlen;
+
+    if (randomize)
+    {
+        dlen       = (uint8_t)random_get(BLE_GAP_ADV_MAX_SIZE + 2);
+        srdlen     = (uint8_t)random_get(BLE_GAP_ADV_MAX_SIZE + 2);
+        m_oversize = (dlen > BLE_GAP_ADV_MAX_SIZE) || (srdlen > BLE_GAP_ADV_MAX_SIZE);
+        random_fill(data, sizeof(data));
+        random_fill(sr_data, sizeof(sr_data));
+        p_data    = OR_NULL(data);
+        p_sr_data = OR_NULL(sr_data);
+    }
+    REQ_ENC(ble_gap_adv_data_set_req_enc(p_data, dlen, p_sr_data, srdlen, m_req, &m_req_len));
+    if (conn_call())
+    {
+        rsp_dec(ble_gap_adv_data_set_rsp_dec);
+    }
+}
+
+
+static void cmd_gap_adv_start(bool randomize)
+{
+    static ble_gap_adv_params_t params;
+    static ble_gap_whitelist_t  whitelist;
+    static ble_gap_addr_t       peer_addr;
+    static ble_gap_addr_t       addrs[BLE_GAP_WHITELIST_ADDR_MAX_COUNT];
+    static ble_gap_addr_t     * p_addrs[BLE_GAP_WHITELIST_ADDR_MAX_COUNT];
+    static ble_gap_irk_t        irks[BLE_GAP_WHITELIST_IRK_MAX_COUNT];
+    static ble_gap_irk_t      * p_irks[BLE_GAP_WHITELIST_IRK_MAX_COUNT];
+
+    uint32_t i;
+
+    if (randomize)
+    {
+        random_fill(&params, sizeof(params));
+        random_fill(&peer_addr, sizeof(peer_addr));
+        random_fill(addrs, sizeof(addrs));
+        random_fill(irks, sizeof(irks));
+        for (i = 0; i < BLE_GAP_WHITELIST_ADDR_MAX_COUNT; i++)
+        {
+            p_addrs[i] = &addrs[i];
+        }
+        for (i = 0; i < BLE_GAP_WHITELIST_IRK_MAX_COUNT; i++)
+        {
+            p_irks[i] = &irks[i];
+        }
+        whitelist.addr_count = (uint8_t)random_get(BLE_GAP_WHITELIST_ADDR_MAX_COUNT + 1);
+        whitelist.irk_count  = (uint8_t)random_get(BLE_GAP_WHITELIST_IRK_MAX_COUNT + 1);
+        whitelist.pp_addrs   = p_addrs;
+        whitelist.pp_irks    = p_irks;
+        params.p_peer_addr   = OR_NULL(&peer_addr);
+        params.p_whitelist   = OR_NULL(&whitelist);
+    }
+    REQ_ENC(ble_gap_adv_start_req_enc(&params, m_req, &m_req_len));
+    if (conn_call())
+    {
+        rsp_dec(ble_gap_adv_start_rsp_dec);
+    }
+}
+
+
+static void cmd_gap_adv_stop(bool randomize)
+{
+    REQ_ENC(ble_gap_adv_stop_req_enc(m_req, &m_req_len));
+    if (conn_call())
+    {
+        rsp_dec(ble_gap_adv_stop_rsp_dec);
+    }
+}
+
+
+static void cmd_gap_address_set(bool randomize)
+{
+    static ble_gap_addr_t addr;
+    static uint8_t        addr_cycle_mode;
+
+    if (randomize)
+    {
+        random_fill(&addr, sizeof(addr));
+        addr_cycle_mode = (uint8_t)rand();
+    }
+    REQ_ENC(ble_gap_address_set_req_enc(addr_cycle_mode, &addr, m_req, &m_req_len));
+    if (conn_call())
+    {
+        rsp_dec(ble_gap_address_set_rsp_dec);
+    }
+}
+
+
+static void cmd_gap_address_get(bool randomize)
+{
+    static ble_gap_addr_t addr;
+
+    ble_gap_addr_t decoded;
+    uint32_t       result_code = 0;
+    uint32_t       err_code;
+
+    REQ_ENC(ble_gap_address_get_req_enc(&addr, m_req, &m_req_len));
+    if (conn_call())
+    {
+        err_code = ble_gap_address_get_rsp_dec(m_rsp, m_rsp_len, &decoded, &result_code);
+        rsp_check(err_code, result_code, out_check(&decoded, sizeof(decoded)));
+    }
+}
+
+
+static void cmd_gap_conn_param_update(bool randomize)
+{
+    static ble_gap_conn_params_t         conn_params;
+    static ble_gap_conn_params_t const * p_conn_params;
+    static uint16_t                      conn_handle;
+
+    if (randomize)
+    {
+        random_fill(&conn_params, sizeof(conn_params));
+        conn_handle   = (uint16_t)rand();
+        p_conn_params = OR_NULL(&conn_params);
+    }
+    REQ_ENC(ble_gap_conn_param_update_req_enc(conn_handle, p_conn_params, m_req, &m_req_len));
+    if (conn_call())
+    {
+        rsp_dec(ble_gap_conn_param_update_rsp_dec);
+    }
+}
+
+
+static void cmd_gap_ppcp_set(bool randomize)
+{
+    static ble_gap_conn_params_t conn_params;
+
+    if (randomize)
+    {
+        random_fill(&conn_params, sizeof(conn_params));
+    }
+    REQ_ENC(ble_gap_ppcp_set_req_enc(&conn_params, m_req, &m_req_len));
+    if (conn_call())
+    {
+        rsp_dec(ble_gap_ppcp_set_rsp_dec);
+    }
+}
+
+
+static void cmd_gap_ppcp_get(bool randomize)
+{
+    static ble_gap_conn_params_t conn_params;
+
+    ble_gap_conn_params_t decoded;
+    uint32_t              result_code = 0;
+    uint32_t              err_code;
+
+    REQ_ENC(ble_gap_ppcp_get_req_enc(&conn_params, m_req, &m_req_len));
+    if (conn_call())
+    {
+        err_code = ble_gap_ppcp_get_rsp_dec(m_rsp, m_rsp_len, &decoded, &result_code);
+        rsp_check(err_code, result_code, out_check(&decoded, sizeof(decoded)));
+    }
+}
+
+
+static void cmd_gap_disconnect(bool randomize)
+{
+    static uint16_t conn_handle;
+    static uint8_t  hci_status_code;
+
+    if (randomize)
+    {
+        conn_handle     = (uint16_t)rand();
+        hci_status_code = (uint8_t)rand();
+    }
+    REQ_ENC(ble_gap_disconnect_req_enc(conn_handle, hci_status_code, m_req, &m_req_len));
+    if (conn_call())
+    {
+        rsp_dec(ble_gap_disconnect_rsp_dec);
+    }
+}
+
+
+static void cmd_gap_tx_power_set(bool randomize)
+{
+    static int8_t tx_power;
+
+    if (randomize)
+    {
+        tx_power = (int8_t)rand();
+    }
+    REQ_ENC(ble_gap_tx_power_set_req_enc(tx_power, m_req, &m_req_len));
+    if (conn_call())
+    {
+        rsp_dec(ble_gap_tx_power_set_rsp_dec);
+    }
+}
+
+
+static void cmd_gap_appearance_set(bool randomize)
+{
+    static uint16_t appearance;
+
+    if (randomize)
+    {
+        appearance = (uint16_t)rand();
+    }
+    REQ_ENC(ble_gap_appearance_set_req_enc(appearance, m_req, &m_req_len));
+    if (conn_call())
+    {
+        rsp_dec(ble_gap_appearance_set_rsp_dec);
+    }
+}
+
+
+static void cmd_gap_appearance_get(bool randomize)
+{
+    static uint16_t appearance;
+
+    uint16_t decoded     = 0;
+    uint32_t result_code = 0;
+    uint32_t err_code;
+
+    REQ_ENC(ble_gap_appearance_get_req_enc(&appearance, m_req, &m_req_len));
+    if (conn_call())
+    {
+        err_code = ble_gap_appearance_get_rsp_dec(m_rsp, m_rsp_len, &decoded, &result_code);
+        rsp_check(err_code, result_code, out_check(&decoded, sizeof(decoded)));
+    }
+}
+
+
+static void cmd_gap_rssi_start(bool randomize)
+{
+    static uint16_t conn_handle;
+
+    if (randomize)
+    {
+        conn_handle = (uint16_t)rand();
+    }
+    REQ_ENC(ble_gap_rssi_start_req_enc(conn_handle, m_req, &m_req_len));
+    if (conn_call())
+    {
+        rsp_dec(ble_gap_rssi_start_rsp_dec);
+    }
+}
+
+
+static void cmd_gap_rssi_stop(bool randomize)
+{
+    static uint16_t conn_handle;
+
+    if (randomize)
+    {
+        conn_handle = (uint16_t)rand();
+    }
+    REQ_ENC(ble_gap_rssi_stop_req_enc(conn_handle, m_req, &m_req_len));
+    if (conn_call())
+    {
+        rsp_dec(ble_gap_rssi_stop_rsp_dec);
+    }
+}
+
+
+static void cmd_gap_device_name_set(bool randomize)
+{
+    static ble_gap_conn_sec_mode_t         write_perm;
+    static ble_gap_conn_sec_mode_t const * p_write_perm;
+    static uint8_t                         dev_name[BLE_GAP_DEVNAME_MAX_LEN];
+    static uint8_t const                 * p_dev_name;
+    static uint16_t                        len;
+
+    if (randomize)
+    {
+        random_fill(&write_perm, sizeof(write_perm));
+        random_fill(dev_name, sizeof(dev_name));
+        len          = (uint16_t)random_get(BLE_GAP_DEVNAME_MAX_LEN + 1);
+        p_write_perm = OR_NULL(&write_perm);
+        p_dev_name   = OR_NULL(dev_name);
+    }
+    REQ_ENC(ble_gap_device_name_set_req_enc(p_write_perm, p_dev_name, len, m_req, &m_req_len));
+    if (conn_call())
+    {
+        rsp_dec(ble_gap_device_name_set_rsp_dec);
+    }
+}
+
+
+static void cmd_gap_device_name_get(bool randomize)
+{
+    static uint8_t    dev_name[BLE_GAP_DEVNAME_MAX_LEN];
+    static uint8_t  * p_dev_name;
+    static uint16_t   len;
+    static uint16_t * p_len;
+
+    uint8_t  decoded[BLE_GAP_DEVNAME_MAX_LEN] = {0};
+    uint16_t decoded_len                      = sizeof(decoded);
+    uint32_t result_code                      = 0;
+    uint32_t err_code;
+
+    if (randomize)
+    {
+        len        = (uint16_t)random_get(BLE_GAP_DEVNAME_MAX_LEN + 1);
+        p_dev_name = OR_NULL(dev_name);
+        p_len      = OR_NULL(&len);
+    }
+    REQ_ENC(ble_gap_device_name_get_req_enc(p_dev_name, p_len, m_req, &m_req_len));
+    if (conn_call())
+    {
+        err_code = ble_gap_device_name_get_rsp_dec(m_rsp, m_rsp_len, decoded, &decoded_len,
+                                                   &result_code);
+        rsp_check(err_code, result_code, out_check(decoded, decoded_len));
+    }
+}
+
+
+static void cmd_gap_authenticate(bool randomize)
+{
+    static ble_gap_sec_params_t         sec_params;
+    static ble_gap_sec_params_t const * p_sec_params;
+    static uint16_t                     conn_handle;
+
+    if (randomize)
+    {
+        random_fill(&sec_params, sizeof(sec_params));
+        conn_handle  = (uint16_t)rand();
+        p_sec_params = OR_NULL(&sec_params);
+    }
+    REQ_ENC(ble_gap_authenticate_req_enc(conn_handle, p_sec_params, m_req, &m_req_len));
+    if (conn_call())
+    {
+        rsp_dec(ble_gap_authenticate_rsp_dec);
+    }
+}
+
+
+static void cmd_gap_sec_params_reply(bool randomize)
+{
+    static ble_gap_sec_params_t         sec_params;
+    static ble_gap_sec_params_t const * p_sec_params;
+    static uint16_t                     conn_handle;
+    static uint8_t                      sec_status;
+
+    if (randomize)
+    {
+        random_fill(&sec_params, sizeof(sec_params));
+        conn_handle  = (uint16_t)rand();
+        sec_status   = (uint8_t)rand();
+        p_sec_params = OR_NULL(&sec_params);
+    }
+    REQ_ENC(ble_gap_sec_params_reply_req_enc(conn_handle, sec_status, p_sec_params,
+                                             m_req, &m_req_len));
+    if (conn_call())
+    {
+        rsp_dec(ble_gap_sec_params_reply_rsp_dec);
+    }
+}
+
+
+static void cmd_gap_auth_key_reply(bool randomize)
+{
+    static uint8_t         key[16];
+    static uint8_t const * p_key;
+    static uint16_t        conn_handle;
+    static uint8_t         key_type;
+
+    if (randomize)
+    {
+        random_fill(key, sizeof(key));
+        conn_handle = (uint16_t)rand();
+        key_type    = (uint8_t)random_get(BLE_GAP_AUTH_KEY_TYPE_OOB + 1);
+        p_key       = (key_type != BLE_GAP_AUTH_KEY_TYPE_NONE) ? key : NULL;
+    }
+    REQ_ENC(ble_gap_auth_key_reply_req_enc(conn_handle, key_type, p_key, m_req, &m_req_len));
+    if (conn_call())
+    {
+        rsp_dec(ble_gap_auth_key_reply_rsp_dec);
+    }
+}
+
+
+static void cmd_gap_sec_info_reply(bool randomize)
+{
+    static ble_gap_enc_info_t          enc_info;
+    static ble_gap_enc_info_t const  * p_enc_info;
+    static ble_gap_sign_info_t         sign_info;
+    static ble_gap_sign_info_t const * p_sign_info;
+    static uint16_t                    conn_handle;
+
+    if (randomize)
+    {
+        random_fill(&enc_info, sizeof(enc_info));
+        random_fill(&sign_info, sizeof(sign_info));
+        conn_handle = (uint16_t)rand();
+        p_enc_info  = OR_NULL(&enc_info);
+        p_sign_info = OR_NULL(&sign_info);
+    }
+    REQ_ENC(ble_gap_sec_info_reply_req_enc(conn_handle, p_enc_info, p_sign_info,
+                                           m_req, &m_req_len));
+    if (conn_call())
+    {
+        rsp_dec(ble_gap_sec_info_reply_rsp_dec);
+    }
+}
+
+
+static void cmd_gap_conn_sec_get(bool randomize)
+{
+    static ble_gap_conn_sec_t conn_sec;
+    static uint16_t           conn_handle;
+
+    ble_gap_conn_sec_t         decoded;
+    ble_gap_conn_sec_t       * p_decoded = &decoded;
+    ble_gap_conn_sec_t const * p_out     = (ble_gap_conn_sec_t const *)m_sd_out;
+    uint32_t                   result_code = 0;
+    uint32_t                   err_code;
+
+    if (randomize)
+    {
+        conn_handle = (uint16_t)rand();
+    }
+    REQ_ENC(ble_gap_conn_sec_get_req_enc(conn_handle, &conn_sec, m_req, &m_req_len));
+    if (conn_call())
+    {
+        // Only the bit fields are compared, the padding bits are not encoded.
+        err_code = ble_gap_conn_sec_get_rsp_dec(m_rsp, m_rsp_len, &p_decoded, &result_code);
+        rsp_check(err_code, result_code,
+                  (m_sd_result != NRF_SUCCESS) ||
+                  ((decoded.encr_key_size == p_out->encr_key_size) &&
+                   (decoded.sec_mode.sm == p_out->sec_mode.sm) &&
+                   (decoded.sec_mode.lv == p_out->sec_mode.lv)));
+    }
+}
+
+
+static void cmd_gattc_primary_services_discover(bool randomize)
+{
+    static ble_uuid_t         uuid;
+    static ble_uuid_t const * p_uuid;
+    static uint16_t           conn_handle;
+    static uint16_t           start_handle;
+
+    if (randomize)
+    {
+        random_fill(&uuid, sizeof(uuid));
+        conn_handle  = (uint16_t)rand();
+        start_handle = (uint16_t)rand();
+        p_uuid       = OR_NULL(&uuid);
+    }
+    REQ_ENC(ble_gattc_primary_services_discover_req_enc(conn_handle, start_handle, p_uuid,
+                                                        m_req, &m_req_len));
+    if (conn_call())
+    {
+        rsp_dec(ble_gattc_primary_services_discover_rsp_dec);
+    }
+}
+
+
+static void cmd_gattc_relationships_discover(bool randomize)
+{
+    static ble_gattc_handle_range_t         range;
+    static ble_gattc_handle_range_t const * p_range;
+    static uint16_t                         conn_handle;
+
+    if (randomize)
+    {
+        random_fill(&range, sizeof(range));
+        conn_handle = (uint16_t)rand();
+        p_range     = OR_NULL(&range);
+    }
+    REQ_ENC(ble_gattc_relationships_discover_req_enc(conn_handle, p_range, m_req, &m_req_len));
+    if (conn_call())
+    {
+        rsp_dec(ble_gattc_relationships_discover_rsp_dec);
+    }
+}
+
+
+static void cmd_gattc_characteristics_discover(bool randomize)
+{
+    static ble_gattc_handle_range_t         range;
+    static ble_gattc_handle_range_t const * p_range;
+    static uint16_t                         conn_handle;
+
+    if (randomize)
+    {
+        random_fill(&range, sizeof(range));
+        conn_handle = (uint16_t)rand();
+        p_range     = OR_NULL(&range);
+    }
+    REQ_ENC(ble_gattc_characteristics_discover_req_enc(conn_handle, p_range, m_req, &m_req_len));
+    if (conn_call())
+    {
+        rsp_dec(ble_gattc_characteristics_discover_rsp_dec);
+    }
+}
+
+
+static void cmd_gattc_descriptors_discover(bool randomize)
+{
+    static ble_gattc_handle_range_t         range;
+    static ble_gattc_handle_range_t const * p_range;
+    static uint16_t                         conn_handle;
+
+    if (randomize)
+    {
+        random_fill(&range, sizeof(range));
+        conn_handle = (uint16_t)rand();
+        p_range     = OR_NULL(&range);
+    }
+    REQ_ENC(ble_gattc_descriptors_discover_req_enc(conn_handle, p_range, m_req, &m_req_len));
+    if (conn_call())
+    {
+        rsp_dec(ble_gattc_descriptors_discover_rsp_dec);
+    }
+}
+
+
+static void cmd_gattc_char_value_by_uuid_read(bool randomize)
+{
+    static ble_uuid_t                       uuid;
+    static ble_uuid_t const               * p_uuid;
+    static ble_gattc_handle_range_t         range;
+    static ble_gattc_handle_range_t const * p_range;
+    static uint16_t                         conn_handle;
+
+    if (randomize)
+    {
+        random_fill(&uuid, sizeof(uuid));
+        random_fill(&range, sizeof(range));
+        conn_handle = (uint16_t)rand();
+        p_uuid      = OR_NULL(&uuid);
+        p_range     = OR_NULL(&range);
+    }
+    REQ_ENC(ble_gattc_char_value_by_uuid_read_req_enc(conn_handle, p_uuid, p_range,
+                                                      m_req, &m_req_len));
+    if (conn_call())
+    {
+        rsp_dec(ble_gattc_char_value_by_uuid_read_rsp_dec);
+    }
+}
+
+
+static void cmd_gattc_read(bool randomize)
+{
+    static uint16_t conn_handle;
+    static uint16_t handle;
+    static uint16_t offset;
+
+    if (randomize)
+    {
+        conn_handle = (uint16_t)rand();
+        handle      = (uint16_t)rand();
+        offset      = (uint16_t)rand();
+    }
+    REQ_ENC(ble_gattc_read_req_enc(conn_handle, handle, offset, m_req, &m_req_len));
+    if (conn_call())
+    {
+        rsp_dec(ble_gattc_read_rsp_dec);
+    }
+}
+
+
+static void cmd_gattc_char_values_read(bool randomize)
+{
+    static uint16_t         handles[16];
+    static uint16_t const * p_handles;
+    static uint16_t         handle_count;
+    static uint16_t         conn_handle;
+
+    if (randomize)
+    {
+        random_fill(handles, sizeof(handles));
+        conn_handle  = (uint16_t)rand();
+        handle_count = (uint16_t)random_get(ARRAY_SIZE(handles) + 1);
+        p_handles    = OR_NULL(handles);
+        m_oversize   = (handle_count > BLE_GATTC_HANDLE_COUNT_LEN_MAX);
+    }
+    REQ_ENC(ble_gattc_char_values_read_req_enc(conn_handle, p_handles, handle_count,
+                                               m_req, &m_req_len));
+    if (conn_call())
+    {
+        rsp_dec(ble_gattc_char_values_read_rsp_dec);
+    }
+}
+
+
+static void cmd_gattc_write(bool randomize)
+{
+    static ble_gattc_write_params_t         write_params;
+    static ble_gattc_write_params_t const * p_write_params;
+    static uint8_t                          value[GATT_MTU_SIZE_DEFAULT];
+    static uint16_t                         conn_handle;
+
+    if (randomize)
+    {
+        random_fill(&write_params, sizeof(write_params));
+        random_fill(value, sizeof(value));
+        conn_handle          = (uint16_t)rand();
+        write_params.len     = (uint16_t)random_get(sizeof(value));
+        write_params.p_value = OR_NULL(value);
+        p_write_params       = OR_NULL(&write_params);
+    }
+    REQ_ENC(ble_gattc_write_req_enc(conn_handle, p_write_params, m_req, &m_req_len));
+    if (conn_call())
+    {
+        rsp_dec(ble_gattc_write_rsp_dec);
+    }
+}
+
+
+static void cmd_gattc_hv_confirm(bool randomize)
+{
+    static uint16_t conn_handle;
+    static uint16_t handle;
+
+    if (randomize)
+    {
+        conn_handle = (uint16_t)rand();
+        handle      = (uint16_t)rand();
+    }
+    REQ_ENC(ble_gattc_hv_confirm_req_enc(conn_handle, handle, m_req, &m_req_len));
+    if (conn_call())
+    {
+        rsp_dec(ble_gattc_hv_confirm_rsp_dec);
+    }
+}
+
+
+static void cmd_gatts_service_add(bool randomize)
+{
+    static ble_uuid_t         uuid;
+    static ble_uuid_t const * p_uuid;
+    static uint16_t           handle;
+    static uint16_t         * p_handle;
+    static uint8_t            type;
+
+    uint16_t decoded     = 0;
+    uint32_t result_code = 0;
+    uint32_t err_code;
+
+    if (randomize)
+    {
+        random_fill(&uuid, sizeof(uuid));
+        type     = (uint8_t)random_get(BLE_GATTS_SRVC_TYPE_SECONDARY + 1);
+        p_uuid   = OR_NULL(&uuid);
+        p_handle = OR_NULL(&handle);
+    }
+    REQ_ENC(ble_gatts_service_add_req_enc(type, p_uuid, p_handle, m_req, &m_req_len));
+    if (conn_call())
+    {
+        err_code = ble_gatts_service_add_rsp_dec(m_rsp, m_rsp_len, &decoded, &result_code);
+        rsp_check(err_code, result_code, out_check(&decoded, sizeof(decoded)));
+    }
+}
+
+
+static void cmd_gatts_include_add(bool randomize)
+{
+    static uint16_t   service_handle;
+    static uint16_t   inc_srvc_handle;
+    static uint16_t   handle;
+    static uint16_t * p_handle;
+
+    uint16_t decoded     = 0;
+    uint32_t result_code = 0;
+    uint32_t err_code;
+
+    if (randomize)
+    {
+        service_handle  = (uint16_t)rand();
+        inc_srvc_handle = (uint16_t)rand();
+        p_handle        = OR_NULL(&handle);
+    }
+    REQ_ENC(ble_gatts_include_add_req_enc(service_handle, inc_srvc_handle, p_handle,
+                                          m_req, &m_req_len));
+    if (conn_call())
+    {
+        err_code = ble_gatts_include_add_rsp_dec(m_rsp, m_rsp_len, &decoded, &result_code);
+        rsp_check(err_code, result_code, out_check(&decoded, sizeof(decoded)));
+    }
+}
+
+
+/**@brief Function for making random attribute metadata. The serializers only support values
+ *        held by the stack, so other value locations are used for one in five only (never in the
+ *        benchmark). */
+static void attr_md_random(ble_gatts_attr_md_t * p_attr_md)
+{
+    random_fill(p_attr_md, sizeof(*p_attr_md));
+    if (m_bench || (random_get(5) != 0))
+    {
+        p_attr_md->vloc = BLE_GATTS_VLOC_STACK;
+    }
+}
+
+
+/**@brief Function for making a random attribute, value and metadata included. */
+static void attr_random(ble_gatts_attr_t    * p_attr,
+                        ble_uuid_t          * p_uuid,
+                        ble_gatts_attr_md_t * p_attr_md,
+                        uint8_t             * p_value,
+                        uint16_t              value_size)
+{
+    random_fill(p_attr, sizeof(*p_attr));
+    random_fill(p_uuid, sizeof(*p_uuid));
+    attr_md_random(p_attr_md);
+    random_fill(p_value, value_size);
+    p_attr->p_uuid    = OR_NULL(p_uuid);
+    p_attr->p_attr_md = OR_NULL(p_attr_md);
+    p_attr->init_len  = (uint16_t)random_get(value_size + 1);
+    p_attr->p_value   = OR_NULL(p_value);
+}
+
+
+static void cmd_gatts_descriptor_add(bool randomize)
+{
+    static ble_gatts_attr_t         attr;
+    static ble_gatts_attr_t const * p_attr;
+    static ble_uuid_t               uuid;
+    static ble_gatts_attr_md_t      attr_md;
+    static uint8_t                  value[MAX_VALUE_LEN];
+    static uint16_t                 char_handle;
+    static uint16_t                 handle;
+    static uint16_t               * p_handle;
+
+    uint16_t decoded     = 0;
+    uint32_t result_code = 0;
+    uint32_t err_code;
+
+    if (randomize)
+    {
+        attr_random(&attr, &uuid, &attr_md, value, sizeof(value));
+        char_handle = (uint16_t)rand();
+        p_attr      = OR_NULL(&attr);
+        p_handle    = OR_NULL(&handle);
+    }
+    REQ_ENC(ble_gatts_descriptor_add_req_enc(char_handle, p_attr, p_handle, m_req, &m_req_len));
+    if (conn_call())
+    {
+        err_code = ble_gatts_descriptor_add_rsp_dec(m_rsp, m_rsp_len, &decoded, &result_code);
+        rsp_check(err_code, result_code, out_check(&decoded, sizeof(decoded)));
+    }
+}
+
+
+static void cmd_gatts_characteristic_add(bool randomize)
+{
+    static ble_gatts_char_md_t         char_md;
+    static ble_gatts_char_md_t const * p_char_md;
+    static ble_gatts_char_pf_t         char_pf;
+    static ble_gatts_attr_md_t         user_desc_md;
+    static ble_gatts_attr_md_t         cccd_md;
+    static ble_gatts_attr_md_t         sccd_md;
+    static uint8_t                     user_desc[MAX_VALUE_LEN];
+    static ble_gatts_attr_t            attr;
+    static ble_gatts_attr_t const    * p_attr;
+    static ble_uuid_t                  uuid;
+    static ble_gatts_attr_md_t         attr_md;
+    static uint8_t                     value[MAX_VALUE_LEN];
+    static ble_gatts_char_handles_t    handles;
+    static ble_gatts_char_handles_t  * p_handles;
+    static uint16_t                    service_handle;
+
+    ble_gatts_char_handles_t decoded;
+    uint16_t               * p_decoded   = &decoded.value_handle;
+    uint32_t                 result_code = 0;
+    uint32_t                 err_code;
+
+    if (randomize)
+    {
+        random_fill(&char_md, sizeof(char_md));
+        random_fill(&char_pf, sizeof(char_pf));
+        attr_md_random(&user_desc_md);
+        attr_md_random(&cccd_md);
+        attr_md_random(&sccd_md);
+        random_fill(user_desc, sizeof(user_desc));
+        char_md.char_user_desc_size = (uint16_t)random_get(sizeof(user_desc) + 1);
+        char_md.p_char_user_desc    = OR_NULL(user_desc);
+        char_md.p_char_pf           = OR_NULL(&char_pf);
+        char_md.p_user_desc_md      = OR_NULL(&user_desc_md);
+        char_md.p_cccd_md           = OR_NULL(&cccd_md);
+        char_md.p_sccd_md           = OR_NULL(&sccd_md);
+        attr_random(&attr, &uuid, &attr_md, value, sizeof(value));
+        service_handle = (uint16_t)rand();
+        p_char_md      = OR_NULL(&char_md);
+        p_attr         = OR_NULL(&attr);
+        p_handles      = OR_NULL(&handles);
+    }
+    REQ_ENC(ble_gatts_characteristic_add_req_enc(service_handle, p_char_md, p_attr, p_handles,
+                                                 m_req, &m_req_len));
+    if (conn_call())
+    {
+        memset(&decoded, 0, sizeof(decoded));
+        err_code = ble_gatts_characteristic_add_rsp_dec(m_rsp, m_rsp_len, &p_decoded,
+                                                        &result_code);
+        rsp_check(err_code, result_code, out_check(&decoded, sizeof(decoded)));
+    }
+}
+
+
+static void cmd_gatts_value_set(bool randomize)
+{
+    static uint8_t         value[MAX_VALUE_LEN];
+    static uint8_t const * p_value;
+    static uint16_t        len;
+    static uint16_t      * p_len;
+    static uint16_t        handle;
+    static uint16_t        offset;
+
+    uint16_t decoded     = 0;
+    uint32_t result_code = 0;
+    uint32_t err_code;
+
+    if (randomize)
+    {
+        random_fill(value, sizeof(value));
+        handle  = (uint16_t)rand();
+        offset  = (uint16_t)rand();
+        len     = (uint16_t)random_get(sizeof(value) + 1);
+        p_len   = OR_NULL(&len);
+        p_value = OR_NULL(value);
+    }
+    REQ_ENC(ble_gatts_value_set_req_enc(handle, offset, p_len, p_value, m_req, &m_req_len));
+    if (conn_call())
+    {
+        err_code = ble_gatts_value_set_rsp_dec(m_rsp, m_rsp_len, &decoded, &result_code);
+        rsp_check(err_code, result_code, out_check(&decoded, sizeof(decoded)));
+    }
+}
+
+
+static void cmd_gatts_value_get(bool randomize)
+{
+    static uint8_t         value[MAX_VALUE_LEN];
+    static uint8_t const * p_value;
+    static uint16_t        len;
+    static uint16_t      * p_len;
+    static uint16_t        handle;
+    static uint16_t        offset;
+
+    uint8_t    decoded[MAX_VALUE_LEN] = {0};
+    uint8_t  * p_decoded;
+    uint16_t   decoded_len;
+    uint16_t * p_decoded_len          = &decoded_len;
+    uint32_t   result_code            = 0;
+    uint32_t   err_code;
+
+    if (randomize)
+    {
+        handle  = (uint16_t)rand();
+        offset  = (uint16_t)rand();
+        len     = (uint16_t)random_get(sizeof(value) + 1);
+        p_len   = OR_NULL(&len);
+        p_value = OR_NULL(value);
+    }
+    REQ_ENC(ble_gatts_value_get_req_enc(handle, offset, p_len, p_value, m_req, &m_req_len));
+    if (conn_call())
+    {
+        // The decoder takes the buffer size from the length, which it always needs.
+        p_decoded   = (p_value != NULL) ? decoded : NULL;
+        decoded_len = len;
+        err_code    = ble_gatts_value_get_rsp_dec(m_rsp, m_rsp_len, &p_decoded, &p_decoded_len,
+                                                  &result_code);
+        rsp_check(err_code, result_code,
+                  (p_decoded_len != NULL) && out_check(decoded, decoded_len));
+    }
+}
+
+
+static void cmd_gatts_hvx(bool randomize)
+{
+    static ble_gatts_hvx_params_t         hvx_params;
+    static ble_gatts_hvx_params_t const * p_hvx_params;
+    static uint8_t                        data[MAX_VALUE_LEN];
+    static uint16_t                       len;
+    static uint16_t                       conn_handle;
+
+    uint16_t   decoded     = 0;
+    uint16_t * p_decoded   = &decoded;
+    uint32_t   result_code = 0;
+    uint32_t   err_code;
+
+    if (randomize)
+    {
+        random_fill(&hvx_params, sizeof(hvx_params));
+        random_fill(data, sizeof(data));
+        conn_handle       = (uint16_t)rand();
+        len               = (uint16_t)random_get(sizeof(data) + 1);
+        hvx_params.p_len  = OR_NULL(&len);
+        hvx_params.p_data = (hvx_params.p_len != NULL) ? OR_NULL(data) : NULL;
+        p_hvx_params      = OR_NULL(&hvx_params);
+    }
+    REQ_ENC(ble_gatts_hvx_req_enc(conn_handle, p_hvx_params, m_req, &m_req_len));
+    if (conn_call())
+    {
+        err_code = ble_gatts_hvx_rsp_dec(m_rsp, m_rsp_len, &result_code, &p_decoded);
+        rsp_check(err_code, result_code, out_check(&decoded, sizeof(decoded)));
+    }
+}
+
+
+static void cmd_gatts_service_changed(bool randomize)
+{
+    static uint16_t conn_handle;
+    static uint16_t start_handle;
+    static uint16_t end_handle;
+
+    if (randomize)
+    {
+        conn_handle  = (uint16_t)rand();
+        start_handle = (uint16_t)rand();
+        end_handle   = (uint16_t)rand();
+    }
+    REQ_ENC(ble_gatts_service_changed_req_enc(conn_handle, start_handle, end_handle,
+                                              m_req, &m_req_len));
+    if (conn_call())
+    {
+        rsp_dec(ble_gatts_service_changed_rsp_dec);
+    }
+}
+
+
+static void cmd_gatts_rw_authorize_reply(bool randomize)
+{
+    static ble_gatts_rw_authorize_reply_params_t         reply_params;
+    static ble_gatts_rw_authorize_reply_params_t const * p_reply_params;
+    static uint8_t                                       data[MAX_VALUE_LEN];
+    static uint16_t                                      conn_handle;
+
+    if (randomize)
+    {
+        random_fill(&reply_params, sizeof(reply_params));
+        random_fill(data, sizeof(data));
+        conn_handle = (uint16_t)rand();
+        // The read and write replies share the length and data fields.
+        reply_params.type               = BLE_GATTS_AUTHORIZE_TYPE_READ + random_get(2);
+        reply_params.params.read.len    = (uint16_t)random_get(sizeof(data) + 1);
+        reply_params.params.read.p_data = OR_NULL(data);
+        p_reply_params                  = OR_NULL(&reply_params);
+    }
+    REQ_ENC(ble_gatts_rw_authorize_reply_req_enc(conn_handle, p_reply_params, m_req, &m_req_len));
+    if (conn_call())
+    {
+        rsp_dec(ble_gatts_rw_authorize_reply_rsp_dec);
+    }
+}
+
+
+static void cmd_gatts_sys_attr_set(bool randomize)
+{
+    static uint8_t         sys_attr_data[64];
+    static uint8_t const * p_sys_attr_data;
+    static uint16_t        len;
+    static uint16_t        conn_handle;
+
+    if (randomize)
+    {
+        random_fill(sys_attr_data, sizeof(sys_attr_data));
+        conn_handle     = (uint16_t)rand();
+        len             = (uint16_t)random_get(sizeof(sys_attr_data));
+        p_sys_attr_data = OR_NULL(sys_attr_data);
+    }
+    REQ_ENC(ble_gatts_sys_attr_set_req_enc(conn_handle, p_sys_attr_data, len, m_req, &m_req_len));
+    if (conn_call())
+    {
+        rsp_dec(ble_gatts_sys_attr_set_rsp_dec);
+    }
+}
+
+
+static void cmd_gatts_sys_attr_get(bool randomize)
+{
+    static uint8_t         sys_attr_data[64];
+    static uint8_t const * p_sys_attr_data;
+    static uint16_t        len;
+    static uint16_t      * p_len;
+    static uint16_t        conn_handle;
+
+    uint8_t  decoded[sizeof(sys_attr_data)] = {0};
+    uint16_t decoded_len                    = 0;
+    uint32_t result_code                    = 0;
+    uint32_t err_code;
+
+    if (randomize)
+    {
+        conn_handle     = (uint16_t)rand();
+        len             = (uint16_t)random_get(sizeof(sys_attr_data) + 1);
+        p_len           = OR_NULL(&len);
+        p_sys_attr_data = OR_NULL(sys_attr_data);
+    }
+    REQ_ENC(ble_gatts_sys_attr_get_req_enc(conn_handle, p_sys_attr_data, p_len,
+                                           m_req, &m_req_len));
+    if (conn_call())
+    {
+        decoded_len = len;
+        err_code    = ble_gatts_sys_attr_get_rsp_dec(m_rsp, m_rsp_len,
+                                                     (p_sys_attr_data != NULL) ? decoded : NULL,
+                                                     &decoded_len, &result_code);
+        rsp_check(err_code, result_code, out_check(decoded, decoded_len));
+    }
+}
+
+
+static void cmd_l2cap_cid_register(bool randomize)
+{
+    static uint16_t cid;
+
+    if (randomize)
+    {
+        cid = (uint16_t)rand();
+    }
+    REQ_ENC(ble_l2cap_cid_register_req_enc(cid, m_req, &m_req_len));
+    if (conn_call())
+    {
+        rsp_dec(ble_l2cap_cid_register_rsp_dec);
+    }
+}
+
+
+static void cmd_l2cap_cid_unregister(bool randomize)
+{
+    static uint16_t cid;
+
+    if (randomize)
+    {
+        cid = (uint16_t)rand();
+    }
+    REQ_ENC(ble_l2cap_cid_unregister_req_enc(cid, m_req, &m_req_len));
+    if (conn_call())
+    {
+        rsp_dec(ble_l2cap_cid_unregister_rsp_dec);
+    }
+}
+
+
+static void cmd_l2cap_tx(bool randomize)
+{
+    static ble_l2cap_header_t         header;
+    static ble_l2cap_header_t const * p_header;
+    static uint8_t                    data[GATT_MTU_SIZE_DEFAULT + 1];
+    static uint8_t const            * p_data;
+    static uint16_t                   conn_handle;
+
+    if (randomize)
+    {
+        random_fill(&header, sizeof(header));
+        random_fill(data, sizeof(data));
+        conn_handle = (uint16_t)rand();
+        header.len  = (uint16_t)random_get(sizeof(data));
+        p_header    = OR_NULL(&header);
+        p_data      = OR_NULL(data);
+    }
+    REQ_ENC(ble_l2cap_tx_req_enc(conn_handle, p_header, p_data, m_req, &m_req_len));
+    if (conn_call())
+    {
+        rsp_dec(ble_l2cap_tx_rsp_dec);
+    }
+}
+
+
+static void cmd_ble_enable(bool randomize)
+{
+    static ble_enable_params_t   enable_params;
+    static ble_enable_params_t * p_enable_params;
+
+    if (randomize)
+    {
+        random_fill(&enable_params, sizeof(enable_params));
+        p_enable_params = OR_NULL(&enable_params);
+    }
+    REQ_ENC(ble_enable_req_enc(p_enable_params, m_req, &m_req_len));
+    if (conn_call())
+    {
+        rsp_dec(ble_enable_rsp_dec);
+    }
+}
+
+
+static void cmd_ble_tx_buffer_count_get(bool randomize)
+{
+    static uint8_t   count;
+    static uint8_t * p_count;
+
+    uint8_t   decoded     = 0;
+    uint8_t * p_decoded   = &decoded;
+    uint32_t  result_code = 0;
+    uint32_t  err_code;
+
+    if (randomize)
+    {
+        p_count = OR_NULL(&count);
+    }
+    REQ_ENC(ble_tx_buffer_count_get_req_enc(p_count, m_req, &m_req_len));
+    if (conn_call())
+    {
+        err_code = ble_tx_buffer_count_get_rsp_dec(m_rsp, m_rsp_len, &p_decoded, &result_code);
+        rsp_check(err_code, result_code, out_check(&decoded, sizeof(decoded)));
+    }
+}
+
+
+static void cmd_ble_uuid_vs_add(bool randomize)
+{
+    static ble_uuid128_t         vs_uuid;
+    static ble_uuid128_t const * p_vs_uuid;
+    static uint8_t               uuid_type;
+    static uint8_t             * p_uuid_type;
+
+    uint8_t   decoded     = 0;
+    uint8_t * p_decoded   = &decoded;
+    uint32_t  result_code = 0;
+    uint32_t  err_code;
+
+    if (randomize)
+    {
+        random_fill(&vs_uuid, sizeof(vs_uuid));
+        p_vs_uuid   = OR_NULL(&vs_uuid);
+        p_uuid_type = OR_NULL(&uuid_type);
+    }
+    REQ_ENC(ble_uuid_vs_add_req_enc(p_vs_uuid, p_uuid_type, m_req, &m_req_len));
+    if (conn_call())
+    {
+        err_code = ble_uuid_vs_add_rsp_dec(m_rsp, m_rsp_len, &p_decoded, &result_code);
+        rsp_check(err_code, result_code, out_check(&decoded, sizeof(decoded)));
+    }
+}
+
+
+static void cmd_ble_uuid_decode(bool randomize)
+{
+    static uint8_t         uuid_le[16];
+    static uint8_t const * p_uuid_le;
+    static uint8_t         uuid_le_len;
+    static ble_uuid_t      uuid;
+    static ble_uuid_t    * p_uuid;
+
+    ble_uuid_t         decoded;
+    ble_uuid_t       * p_decoded   = &decoded;
+    ble_uuid_t const * p_out       = (ble_uuid_t const *)m_sd_out;
+    uint32_t           result_code = 0;
+    uint32_t           err_code;
+
+    if (randomize)
+    {
+        random_fill(uuid_le, sizeof(uuid_le));
+        uuid_le_len = (rand() & 1) ? 16 : 2;
+        p_uuid_le   = OR_NULL(uuid_le);
+        p_uuid      = OR_NULL(&uuid);
+    }
+    REQ_ENC(ble_uuid_decode_req_enc(uuid_le_len, p_uuid_le, p_uuid, m_req, &m_req_len));
+    if (conn_call())
+    {
+        err_code = ble_uuid_decode_rsp_dec(m_rsp, m_rsp_len, &p_decoded, &result_code);
+        rsp_check(err_code, result_code,
+                  (m_sd_result != NRF_SUCCESS) ||
+                  ((decoded.uuid == p_out->uuid) && (decoded.type == p_out->type)));
+    }
+}
+
+
+static void cmd_ble_uuid_encode(bool randomize)
+{
+    static ble_uuid_t         uuid;
+    static ble_uuid_t const * p_uuid;
+    static uint8_t            uuid_le_len;
+    static uint8_t          * p_uuid_le_len;
+    static uint8_t            uuid_le[16];
+    static uint8_t          * p_uuid_le;
+
+    uint8_t  decoded_len = sizeof(uuid_le);
+    uint8_t  decoded[sizeof(uuid_le)];
+    uint32_t result_code = 0;
+    uint32_t err_code;
+
+    if (randomize)
+    {
+        random_fill(&uuid, sizeof(uuid));
+        p_uuid        = OR_NULL(&uuid);
+        p_uuid_le_len = OR_NULL(&uuid_le_len);
+        p_uuid_le     = OR_NULL(uuid_le);
+    }
+    REQ_ENC(ble_uuid_encode_req_enc(p_uuid, p_uuid_le_len, p_uuid_le, m_req, &m_req_len));
+    if (conn_call())
+    {
+        err_code = ble_uuid_encode_rsp_dec(m_rsp, m_rsp_len,
+                                           (p_uuid_le_len != NULL) ? &decoded_len : NULL,
+                                           (p_uuid_le != NULL) ? decoded : NULL,
+                                           &result_code);
+        if (p_uuid_le == NULL)
+        {
+            // Only the length is returned.
+            memcpy(decoded, m_sd_out, decoded_len);
+        }
+        rsp_check(err_code, result_code, out_check(decoded, decoded_len));
+    }
+}
+
+
+static void cmd_ble_version_get(bool randomize)
+{
+    static ble_version_t   version;
+    static ble_version_t * p_version;
+
+    ble_version_t         decoded     = {0};
+    ble_version_t const * p_out       = (ble_version_t const *)m_sd_out;
+    uint32_t              result_code = 0;
+    uint32_t              err_code;
+
+    if (randomize)
+    {
+        p_version = OR_NULL(&version);
+    }
+    REQ_ENC(ble_version_get_req_enc(p_version, m_req, &m_req_len));
+    if (conn_call())
+    {
+        err_code = ble_version_get_rsp_dec(m_rsp, m_rsp_len, &decoded, &result_code);
+        rsp_check(err_code, result_code,
+                  (m_sd_result != NRF_SUCCESS) ||
+                  ((decoded.version_number == p_out->version_number) &&
+                   (decoded.company_id == p_out->company_id) &&
+                   (decoded.subversion_number == p_out->subversion_number)));
+    }
+}
+
+
+static void cmd_ble_opt_set(bool randomize)
+{
+    static const uint32_t opt_ids[] =
+    {
+        BLE_GAP_OPT_LOCAL_CONN_LATENCY, BLE_GAP_OPT_PASSKEY, BLE_GAP_OPT_PRIVACY
+    };
+
+    static ble_opt_t     opt;
+    static ble_gap_irk_t irk;
+    static uint8_t       passkey[BLE_GAP_PASSKEY_LEN];
+    static uint16_t      actual_latency;
+    static uint32_t      opt_id;
+
+    if (randomize)
+    {
+        random_fill(&opt, sizeof(opt));
+        random_fill(&irk, sizeof(irk));
+        random_fill(passkey, sizeof(passkey));
+        opt_id = opt_ids[random_get(ARRAY_SIZE(opt_ids))];
+        switch (opt_id)
+        {
+            case BLE_GAP_OPT_LOCAL_CONN_LATENCY:
+                opt.gap.local_conn_latency.p_actual_latency = OR_NULL(&actual_latency);
+                break;
+
+            case BLE_GAP_OPT_PASSKEY:
+                opt.gap.passkey.p_passkey = OR_NULL(passkey);
+                break;
+
+            default:
+                opt.gap.privacy.p_irk = OR_NULL(&irk);
+                break;
+        }
+    }
+    REQ_ENC(ble_opt_set_req_enc(opt_id, &opt, m_req, &m_req_len));
+    if (conn_call())
+    {
+        rsp_dec(ble_opt_set_rsp_dec);
+    }
+}
+
+
+/**@brief Function for checking a decoded option against the option returned by the SoftDevice. */
+static bool opt_check(uint32_t opt_id, ble_opt_t const * p_decoded)
+{
+    ble_opt_t const * p_out = (ble_opt_t const *)m_sd_out;
+
+    switch (opt_id)
+    {
+        case BLE_GAP_OPT_LOCAL_CONN_LATENCY:
+            return (p_decoded->gap.local_conn_latency.conn_handle ==
+                    p_out->gap.local_conn_latency.conn_handle) &&
+                   (p_decoded->gap.local_conn_latency.requested_latency ==
+                    p_out->gap.local_conn_latency.requested_latency) &&
+                   ((p_out->gap.local_conn_latency.p_actual_latency == NULL) ?
+                    (p_decoded->gap.local_conn_latency.p_actual_latency == NULL) :
+                    ((p_decoded->gap.local_conn_latency.p_actual_latency != NULL) &&
+                     (*p_decoded->gap.local_conn_latency.p_actual_latency ==
+                      *p_out->gap.local_conn_latency.p_actual_latency)));
+
+        case BLE_GAP_OPT_PASSKEY:
+            return (p_out->gap.passkey.p_passkey == NULL) ?
+                   (p_decoded->gap.passkey.p_passkey == NULL) :
+                   ((p_decoded->gap.passkey.p_passkey != NULL) &&
+                    (memcmp(p_decoded->gap.passkey.p_passkey, p_out->gap.passkey.p_passkey,
+                            BLE_GAP_PASSKEY_LEN) == 0));
+
+        default:
+            return (p_decoded->gap.privacy.interval_s == p_out->gap.privacy.interval_s) &&
+                   ((p_out->gap.privacy.p_irk == NULL) ?
+                    (p_decoded->gap.privacy.p_irk == NULL) :
+                    ((p_decoded->gap.privacy.p_irk != NULL) &&
+                     (memcmp(p_decoded->gap.privacy.p_irk, p_out->gap.privacy.p_irk,
+                             sizeof(ble_gap_irk_t)) == 0)));
+    }
+}
+
+
+static void cmd_ble_opt_get(bool randomize)
+{
+    static const uint32_t opt_ids[] =
+    {
+        BLE_GAP_OPT_LOCAL_CONN_LATENCY, BLE_GAP_OPT_PASSKEY, BLE_GAP_OPT_PRIVACY
+    };
+
+    static ble_opt_t   opt;
+    static ble_opt_t * p_opt;
+    static uint32_t    opt_id;
+
+    ble_opt_t     decoded;
+    ble_gap_irk_t irk;
+    uint8_t       passkey[BLE_GAP_PASSKEY_LEN];
+    uint16_t      actual_latency;
+    uint32_t      decoded_id  = 0;
+    uint32_t      result_code = 0;
+    uint32_t      err_code;
+
+    if (randomize)
+    {
+        opt_id = opt_ids[random_get(ARRAY_SIZE(opt_ids))];
+        p_opt  = OR_NULL(&opt);
+    }
+    REQ_ENC(ble_opt_get_req_enc(opt_id, p_opt, m_req, &m_req_len));
+    if (conn_call())
+    {
+        // The decoder fills the storage the option points to.
+        memset(&decoded, 0, sizeof(decoded));
+        if (opt_id == BLE_GAP_OPT_LOCAL_CONN_LATENCY)
+        {
+            decoded.gap.local_conn_latency.p_actual_latency = &actual_latency;
+        }
+        else if (opt_id == BLE_GAP_OPT_PASSKEY)
+        {
+            decoded.gap.passkey.p_passkey = passkey;
+        }
+        else if (opt_id == BLE_GAP_OPT_PRIVACY)
+        {
+            decoded.gap.privacy.p_irk = &irk;
+        }
+        err_code = ble_opt_get_rsp_dec(m_rsp, m_rsp_len, &decoded_id, &decoded, &result_code);
+        rsp_check(err_code, result_code,
+                  (m_sd_result != NRF_SUCCESS) ||
+                  ((decoded_id == opt_id) && opt_check(opt_id, &decoded)));
+    }
+}
+
+
+static void cmd_temp_get(bool randomize)
+{
+    static int32_t   temp;
+    static int32_t * p_temp;
+
+    int32_t  decoded     = 0;
+    uint32_t result_code = 0;
+    uint32_t err_code;
+
+    if (randomize)
+    {
+        p_temp = OR_NULL(&temp);
+    }
+    REQ_ENC(temp_get_req_enc(p_temp, m_req, &m_req_len));
+    if (conn_call())
+    {
+        err_code = temp_get_rsp_dec(m_rsp, m_rsp_len, &result_code, &decoded);
+        rsp_check(err_code, result_code, out_check(&decoded, sizeof(decoded)));
+    }
+}
+
+
+static const cmd_desc_t m_commands[] =
+{
+    {"gap_adv_data_set",                cmd_gap_adv_data_set},
+    {"gap_adv_start",                   cmd_gap_adv_start},
+    {"gap_adv_stop",                    cmd_gap_adv_stop},
+    {"gap_address_set",                 cmd_gap_address_set},
+    {"gap_address_get",                 cmd_gap_address_get},
+    {"gap_conn_param_update",           cmd_gap_conn_param_update},
+    {"gap_ppcp_set",                    cmd_gap_ppcp_set},
+    {"gap_ppcp_get",                    cmd_gap_ppcp_get},
+    {"gap_disconnect",                  cmd_gap_disconnect},
+    {"gap_tx_power_set",                cmd_gap_tx_power_set},
+    {"gap_appearance_set",              cmd_gap_appearance_set},
+    {"gap_appearance_get",              cmd_gap_appearance_get},
+    {"gap_rssi_start",                  cmd_gap_rssi_start},
+    {"gap_rssi_stop",                   cmd_gap_rssi_stop},
+    {"gap_device_name_set",             cmd_gap_device_name_set},
+    {"gap_device_name_get",             cmd_gap_device_name_get},
+    {"gap_authenticate",                cmd_gap_authenticate},
+    {"gap_sec_params_reply",            cmd_gap_sec_params_reply},
+    {"gap_auth_key_reply",              cmd_gap_auth_key_reply},
+    {"gap_sec_info_reply",              cmd_gap_sec_info_reply},
+    {"gap_conn_sec_get",                cmd_gap_conn_sec_get},
+    {"gattc_primary_services_discover", cmd_gattc_primary_services_discover},
+    {"gattc_relationships_discover",    cmd_gattc_relationships_discover},
+    {"gattc_characteristics_discover",  cmd_gattc_characteristics_discover},
+    {"gattc_descriptors_discover",      cmd_gattc_descriptors_discover},
+    {"gattc_char_value_by_uuid_read",   cmd_gattc_char_value_by_uuid_read},
+    {"gattc_read",                      cmd_gattc_read},
+    {"gattc_char_values_read",          cmd_gattc_char_values_read},
+    {"gattc_write",                     cmd_gattc_write},
+    {"gattc_hv_confirm",                cmd_gattc_hv_confirm},
+    {"gatts_service_add",               cmd_gatts_service_add},
+    {"gatts_include_add",               cmd_gatts_include_add},
+    {"gatts_descriptor_add",            cmd_gatts_descriptor_add},
+    {"gatts_characteristic_add",        cmd_gatts_characteristic_add},
+    {"gatts_value_set",                 cmd_gatts_value_set},
+    {"gatts_value_get",                 cmd_gatts_value_get},
+    {"gatts_hvx",                       cmd_gatts_hvx},
+    {"gatts_service_changed",           cmd_gatts_service_changed},
+    {"gatts_rw_authorize_reply",        cmd_gatts_rw_authorize_reply},
+    {"gatts_sys_attr_set",              cmd_gatts_sys_attr_set},
+    {"gatts_sys_attr_get",              cmd_gatts_sys_attr_get},
+    {"l2cap_cid_register",              cmd_l2cap_cid_register},
+    {"l2cap_cid_unregister",            cmd_l2cap_cid_unregister},
+    {"l2cap_tx",                        cmd_l2cap_tx},
+    {"ble_enable",                      cmd_ble_enable},
+    {"ble_tx_buffer_count_get",         cmd_ble_tx_buffer_count_get},
+    {"ble_uuid_vs_add",                 cmd_ble_uuid_vs_add},
+    {"ble_uuid_decode",                 cmd_ble_uuid_decode},
+    {"ble_uuid_encode",                 cmd_ble_uuid_encode},
+    {"ble_version_get",                 cmd_ble_version_get},
+    {"ble_opt_set",                     cmd_ble_opt_set},
+    {"ble_opt_get",                     cmd_ble_opt_get},
+    {"temp_get",                        cmd_temp_get},
+};
+
+
+/**@brief Function for passing random commands of one kind through both sides. */
+static void cmd_test(const cmd_desc_t * p_desc, uint32_t iterations)
+{
+    uint32_t passed = m_passed;
+
+    mp_name = p_desc->p_name;
+    for (m_iteration = 0; m_iteration < iterations; m_iteration++)
+    {
+        m_oversize = false;
+        p_desc->run(true);
+    }
+    m_iteration = iterations;
+    (void)check(m_passed != passed, "no command passed");
+}
+
+
+/**@brief Function for measuring the time of a whole exchange of one command, with random
+ *        arguments which are passed. */
+static void bench(const cmd_desc_t * p_desc, uint32_t rounds)
+{
+    uint32_t passed = m_passed;
+    uint32_t tries;
+    uint64_t start;
+    uint64_t ns;
+    uint32_t round;
+
+    mp_name     = p_desc->p_name;
+    m_iteration = 0;
+    m_bench     = true;
+
+    for (tries = 0; (tries < 100) && (m_passed == passed); tries++)
+    {
+        p_desc->run(true);
+    }
+    if (check(m_passed != passed, "no command passed"))
+    {
+        for (round = 0; round < rounds / 10; round++)
+        {
+            p_desc->run(false);
+        }
+
+        start = host_ns_get();
+        for (round = 0; round < rounds; round++)
+        {
+            p_desc->run(false);
+        }
+        ns = host_ns_get() - start;
+
+        printf("%-32s %7.1f ns/op %4u + %3u bytes/msg (request + response)\n",
+               p_desc->p_name, (double)ns / rounds, (unsigned)m_req_len, (unsigned)m_rsp_len);
+    }
+
+    m_bench = false;
+}
+
+
+int main(int argc, char * argv[])
+{
+    uint32_t iterations = 5000;
+    unsigned seed       = 1;
+    int      opt;
+    uint32_t i;
+
+    while ((opt = getopt(argc, argv, "n:s:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'n':
+                iterations = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+
+            case 's':
+                seed = (unsigned)strtoul(optarg, NULL, 0);
+                break;
+
+            default:
+                fprintf(stderr, "usage: %s [-n iterations] [-s seed]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    srand(seed);
+
+    printf("s110 command serializers, %u iterations, seed %u\n", (unsigned)iterations, seed);
+
+    for (i = 0; i < ARRAY_SIZE(m_commands); i++)
+    {
+        cmd_test(&m_commands[i], iterations);
+    }
+    printf("%u commands passed, %u rejected as invalid\n", (unsigned)m_passed, (unsigned)m_rejected);
+
+    for (i = 0; i < ARRAY_SIZE(m_commands); i++)
+    {
+        bench(&m_commands[i], iterations * 10);
+    }
+
+    printf("%s\n", (m_errors == 0) ? "PASS" : "FAIL");
+
+    return (m_errors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
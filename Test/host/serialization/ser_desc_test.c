@@ -0,0 +1,241 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/** @file
+ *
+ * @brief Check of the fixed length prefix of every structure descriptor (field_desc_serialization.c).
+ *
+ * @details The s110 structure serializers are included by this file, so that their static
+ *          descriptors can be reached. For every descriptor, and every descriptor embedded in it,
+ *          fixed_count and fixed_len given in SER_STRUCT_DESC() must be those found by walking the
+ *          fields: integers, and embedded structures whose fields all have fixed length, are fixed
+ *          length fields, and the prefix ends at the first other field.
+ *
+ *          The program is built with DEBUG_NRF. A descriptor whose fixed_count covers a
+ *          conditional structure must be rejected by the check, and must trigger the assert of the
+ *          fixed length field walkers when it is encoded and decoded.
+ *
+ *          Usage: ser_desc_test
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "ble_struct_serialization.c"
+#include "ble_gap_struct_serialization.c"
+#include "ble_gattc_struct_serialization.c"
+#include "ble_gatts_struct_serialization.c"
+
+#define ARRAY_SIZE(a)   (sizeof(a) / sizeof((a)[0]))        /**< Number of elements of an array. */
+
+/**@brief Descriptor under test. */
+typedef struct
+{
+    const char *              p_name;                       /**< Name of the descriptor. */
+    ser_struct_desc_t const * p_desc;                       /**< Descriptor. */
+} desc_entry_t;
+
+/**@brief Structure with a conditional field covered by fixed_count. */
+typedef struct
+{
+    uint16_t   value;
+    uint16_t * p_cond;
+} bad_struct_t;
+
+/**@brief All structure descriptors of the s110 serializers. Descriptors added to the serializers
+ *        must be added here.
+ */
+static const desc_entry_t m_descs[] =
+{
+    {"ser_uint16_desc",                         &ser_uint16_desc},
+    {"ble_uuid_t_desc",                         &ble_uuid_t_desc},
+    {"m_ble_gap_conn_params_t_desc",            &m_ble_gap_conn_params_t_desc},
+    {"m_ble_gap_opt_local_conn_latency_t_desc", &m_ble_gap_opt_local_conn_latency_t_desc},
+    {"m_ble_gattc_handle_range_t_desc",         &m_ble_gattc_handle_range_t_desc},
+    {"ble_gattc_evt_hvx_desc",                  &ble_gattc_evt_hvx_desc},
+    {"m_ble_gatts_char_pf_t_desc",              &m_ble_gatts_char_pf_t_desc},
+    {"m_ble_gatts_attr_context_t_desc",         &m_ble_gatts_attr_context_t_desc},
+    {"m_ble_gatts_evt_write_t_desc",            &m_ble_gatts_evt_write_t_desc},
+};
+
+static ser_field_desc_t const m_bad_fields[] =
+{
+    SER_FIELD_UINT16(bad_struct_t, value),
+    SER_FIELD_COND_STRUCT(bad_struct_t, p_cond, ser_uint16_desc)
+};
+
+static ser_struct_desc_t const m_bad_desc =
+    SER_STRUCT_DESC(m_bad_fields, sizeof (bad_struct_t), 2, 2 + 1);
+
+static uint32_t m_errors;                                   /**< Number of failed checks. */
+static uint32_t m_asserts;                                  /**< Number of asserts triggered. */
+
+
+void assert_nrf_callback(uint16_t line_num, const uint8_t * p_file_name)
+{
+    m_asserts++;
+}
+
+
+static uint32_t fixed_run_len(ser_struct_desc_t const * p_desc, uint32_t * p_end);
+
+
+/**@brief Function for getting the encoded length of a field.
+ *
+ * @return Encoded length of the field, 0 if the field has variable length.
+ */
+static uint32_t fixed_field_len(ser_field_desc_t const * p_field)
+{
+    uint32_t len;
+    uint32_t end;
+
+    switch (p_field->type)
+    {
+        case SER_FIELD_TYPE_UINT8:
+            return 1;
+
+        case SER_FIELD_TYPE_UINT16:
+            return 2;
+
+        case SER_FIELD_TYPE_UINT32:
+            return 4;
+
+        case SER_FIELD_TYPE_STRUCT:
+            len = fixed_run_len(p_field->p_desc, &end);
+            return (end == p_field->p_desc->field_count) ? len : 0;
+
+        default:
+            return 0;
+    }
+}
+
+
+/**@brief Function for getting the encoded length of the fixed length fields at the start of a
+ *        structure.
+ *
+ * @param[out] p_end  Index of the first variable length field.
+ */
+static uint32_t fixed_run_len(ser_struct_desc_t const * p_desc, uint32_t * p_end)
+{
+    uint32_t len = 0;
+    uint32_t field_len;
+    uint32_t i;
+
+    for (i = 0; i < p_desc->field_count; i++)
+    {
+        field_len = fixed_field_len(&p_desc->p_fields[i]);
+
+        if (field_len == 0)
+        {
+            break;
+        }
+        len += field_len;
+    }
+
+    *p_end = i;
+    return len;
+}
+
+
+/**@brief Function for checking the fixed length prefix of a descriptor and of every descriptor
+ *        embedded in it.
+ *
+ * @param[in] p_desc   Descriptor.
+ * @param[in] p_name   Name of the descriptor, for reports.
+ * @param[in] report   True to report a wrong prefix.
+ *
+ * @return True if the prefix of the descriptor and of all embedded descriptors is right.
+ */
+static bool desc_check(ser_struct_desc_t const * p_desc, const char * p_name, bool report)
+{
+    uint32_t end;
+    uint32_t len = fixed_run_len(p_desc, &end);
+    bool     ok  = (p_desc->fixed_count == end) && (p_desc->fixed_len == len);
+    uint32_t i;
+
+    if (!ok && report)
+    {
+        printf("%s: fixed_count %u, fixed_len %u, expected %u, %u\n",
+               p_name,
+               (unsigned)p_desc->fixed_count, (unsigned)p_desc->fixed_len,
+               (unsigned)end, (unsigned)len);
+    }
+
+    for (i = 0; i < p_desc->field_count; i++)
+    {
+        ser_field_desc_t const * p_field = &p_desc->p_fields[i];
+
+        if ((p_field->type == SER_FIELD_TYPE_STRUCT) || (p_field->type == SER_FIELD_TYPE_COND_STRUCT))
+        {
+            ok &= desc_check(p_field->p_desc, p_name, report);
+        }
+    }
+
+    return ok;
+}
+
+
+/**@brief A descriptor with a wrong prefix must be rejected by the check, and trigger the assert
+ *        of the fixed length field walkers.
+ */
+static void bad_desc_test(void)
+{
+    uint16_t     cond   = 0x1234;
+    bad_struct_t bad    = {0x5678, &cond};
+    uint8_t      buf[16];
+    uint32_t     index  = 0;
+
+    if (desc_check(&m_bad_desc, "m_bad_desc", false))
+    {
+        printf("m_bad_desc: wrong prefix not found\n");
+        m_errors++;
+    }
+
+    m_asserts = 0;
+    (void)ser_struct_enc(&m_bad_desc, &bad, buf, sizeof(buf), &index);
+    if (m_asserts != 1)
+    {
+        printf("m_bad_desc: %u asserts on encoding, expected 1\n", (unsigned)m_asserts);
+        m_errors++;
+    }
+
+    m_asserts = 0;
+    index     = 0;
+    (void)ser_struct_dec(&m_bad_desc, buf, sizeof(buf), &index, NULL, &bad);
+    if (m_asserts != 1)
+    {
+        printf("m_bad_desc: %u asserts on decoding, expected 1\n", (unsigned)m_asserts);
+        m_errors++;
+    }
+}
+
+
+int main(void)
+{
+    uint32_t i;
+
+    printf("structure descriptors, %u\n", (unsigned)ARRAY_SIZE(m_descs));
+
+    for (i = 0; i < ARRAY_SIZE(m_descs); i++)
+    {
+        if (!desc_check(m_descs[i].p_desc, m_descs[i].p_name, true))
+        {
+            m_errors++;
+        }
+    }
+
+    bad_desc_test();
+
+    printf("%s\n", (m_errors == 0) ? "PASS" : "FAIL");
+
+    return (m_errors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,358 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/** @file
+ *
+ * @brief Test and benchmark of the s110 event serializers.
+ *
+ * @details Test: for every event, random events are encoded by the connectivity side
+ *          (ble_event_enc()), decoded by the application side (ble_event_dec()) and encoded
+ *          again. Both encodings must be identical. The length of the event reported by
+ *          ble_event_dec() without an event buffer must be the decoded length, with or without
+ *          the event header.
+ *
+ *          Benchmark: nanoseconds per event of encoding and decoding, and encoded bytes per
+ *          event, for every event.
+ *
+ *          Usage: ser_evt_test [-n iterations] [-s seed]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "ble.h"
+#include "ble_app.h"
+#include "ble_conn.h"
+#include "nrf_error.h"
+
+#define EVT_BUFFER_SIZE   1024                              /**< Size of an event buffer, for events with variable length tails. */
+#define EVT_RANDOM_SIZE   (sizeof(ble_evt_t) + 3 * sizeof(ble_gattc_handle_value_t)) /**< Size of the random part of an event, with the tail of a read by UUID response. */
+#define PKT_BUFFER_SIZE   1024                              /**< Size of an encoded event buffer. */
+#define MAX_VALUE_LEN     40                                /**< Max length of random values in events. */
+#define MAX_COUNT         5                                 /**< Max number of random services, characteristics or descriptors in events. */
+#define BENCH_BATCH       64                                /**< Number of different events encoded and decoded in every benchmark round. */
+#define ARRAY_SIZE(a)     (sizeof(a) / sizeof((a)[0]))      /**< Number of elements of an array. */
+
+/**@brief Event buffer, aligned as required for SoftDevice events. */
+typedef union
+{
+    ble_evt_t evt;                                          /**< Event. */
+    uint8_t   raw[EVT_BUFFER_SIZE];                         /**< Space for the variable length tail of the event. */
+    uint32_t  align;                                        /**< Alignment of the buffer. */
+} evt_buffer_t;
+
+/**@brief Event to test. */
+typedef struct
+{
+    uint16_t     evt_id;                                    /**< Event ID. */
+    const char * p_name;                                    /**< Name of the event. */
+} evt_desc_t;
+
+static const evt_desc_t m_events[] =
+{
+    {BLE_EVT_TX_COMPLETE,                     "tx_complete"},
+    {BLE_GAP_EVT_CONNECTED,                   "gap_connected"},
+    {BLE_GAP_EVT_DISCONNECTED,                "gap_disconnected"},
+    {BLE_GAP_EVT_CONN_PARAM_UPDATE,           "gap_conn_param_update"},
+    {BLE_GAP_EVT_SEC_PARAMS_REQUEST,          "gap_sec_params_request"},
+    {BLE_GAP_EVT_SEC_INFO_REQUEST,            "gap_sec_info_request"},
+    {BLE_GAP_EVT_PASSKEY_DISPLAY,             "gap_passkey_display"},
+    {BLE_GAP_EVT_AUTH_KEY_REQUEST,            "gap_auth_key_request"},
+    {BLE_GAP_EVT_AUTH_STATUS,                 "gap_auth_status"},
+    {BLE_GAP_EVT_CONN_SEC_UPDATE,             "gap_conn_sec_update"},
+    {BLE_GAP_EVT_TIMEOUT,                     "gap_timeout"},
+    {BLE_GAP_EVT_RSSI_CHANGED,                "gap_rssi_changed"},
+    {BLE_GATTC_EVT_PRIM_SRVC_DISC_RSP,        "gattc_prim_srvc_disc_rsp"},
+    {BLE_GATTC_EVT_REL_DISC_RSP,              "gattc_rel_disc_rsp"},
+    {BLE_GATTC_EVT_CHAR_DISC_RSP,             "gattc_char_disc_rsp"},
+    {BLE_GATTC_EVT_DESC_DISC_RSP,             "gattc_desc_disc_rsp"},
+    {BLE_GATTC_EVT_CHAR_VAL_BY_UUID_READ_RSP, "gattc_char_val_by_uuid_read_rsp"},
+    {BLE_GATTC_EVT_READ_RSP,                  "gattc_read_rsp"},
+    {BLE_GATTC_EVT_CHAR_VALS_READ_RSP,        "gattc_char_vals_read_rsp"},
+    {BLE_GATTC_EVT_WRITE_RSP,                 "gattc_write_rsp"},
+    {BLE_GATTC_EVT_HVX,                       "gattc_hvx"},
+    {BLE_GATTC_EVT_TIMEOUT,                   "gattc_timeout"},
+    {BLE_GATTS_EVT_WRITE,                     "gatts_write"},
+    {BLE_GATTS_EVT_RW_AUTHORIZE_REQUEST,      "gatts_rw_authorize_request"},
+    {BLE_GATTS_EVT_SYS_ATTR_MISSING,          "gatts_sys_attr_missing"},
+    {BLE_GATTS_EVT_HVC,                       "gatts_hvc"},
+    {BLE_GATTS_EVT_SC_CONFIRM,                "gatts_sc_confirm"},
+    {BLE_GATTS_EVT_TIMEOUT,                   "gatts_timeout"},
+    {BLE_L2CAP_EVT_RX,                        "l2cap_rx"},
+};
+
+static uint8_t  m_values[4 * MAX_VALUE_LEN];                /**< Values of the handle-value pairs of read by UUID responses. */
+static uint32_t m_errors;                                   /**< Number of failed checks. */
+
+
+/**@brief Function for getting host time in nanoseconds. */
+static uint64_t host_ns_get(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ull) + (uint64_t)ts.tv_nsec;
+}
+
+
+/**@brief Function for reporting a failed check. */
+static bool check(bool ok, const evt_desc_t * p_desc, char const * p_what, uint32_t iteration)
+{
+    if (!ok && (m_errors++ < 10))
+    {
+        printf("%s, iteration %u: %s\n", p_desc->p_name, (unsigned)iteration, p_what);
+    }
+    return ok;
+}
+
+
+/**@brief Function for filling a span with random bytes. */
+static void random_fill(void * p_data, uint32_t length)
+{
+    uint32_t i;
+
+    for (i = 0; i < length; i++)
+    {
+        ((uint8_t *)p_data)[i] = (uint8_t)rand();
+    }
+}
+
+
+/**@brief Function for making a random event, with counts and lengths in range. */
+static void event_random(evt_buffer_t * p_buffer, uint16_t evt_id)
+{
+    ble_gattc_evt_t * p_gattc = &p_buffer->evt.evt.gattc_evt;
+    ble_gatts_evt_t * p_gatts = &p_buffer->evt.evt.gatts_evt;
+    uint32_t          i;
+
+    random_fill(p_buffer, EVT_RANDOM_SIZE);
+    p_buffer->evt.header.evt_id = evt_id;
+
+    switch (evt_id)
+    {
+        case BLE_GATTC_EVT_PRIM_SRVC_DISC_RSP:
+            p_gattc->params.prim_srvc_disc_rsp.count = rand() % MAX_COUNT;
+            break;
+
+        case BLE_GATTC_EVT_REL_DISC_RSP:
+            p_gattc->params.rel_disc_rsp.count = rand() % MAX_COUNT;
+            break;
+
+        case BLE_GATTC_EVT_CHAR_DISC_RSP:
+            p_gattc->params.char_disc_rsp.count = rand() % MAX_COUNT;
+            break;
+
+        case BLE_GATTC_EVT_DESC_DISC_RSP:
+            p_gattc->params.desc_disc_rsp.count = rand() % MAX_COUNT;
+            break;
+
+        case BLE_GATTC_EVT_CHAR_VAL_BY_UUID_READ_RSP:
+            p_gattc->params.char_val_by_uuid_read_rsp.count     = rand() % 4;
+            p_gattc->params.char_val_by_uuid_read_rsp.value_len = rand() % MAX_VALUE_LEN;
+            for (i = 0; i < 4; i++)
+            {
+                p_gattc->params.char_val_by_uuid_read_rsp.handle_value[i].p_value =
+                    &m_values[i * MAX_VALUE_LEN];
+            }
+            break;
+
+        case BLE_GATTC_EVT_READ_RSP:
+            p_gattc->params.read_rsp.len = rand() % MAX_VALUE_LEN;
+            break;
+
+        case BLE_GATTC_EVT_CHAR_VALS_READ_RSP:
+            p_gattc->params.char_vals_read_rsp.len = rand() % MAX_VALUE_LEN;
+            break;
+
+        case BLE_GATTC_EVT_WRITE_RSP:
+            p_gattc->params.write_rsp.len = rand() % MAX_VALUE_LEN;
+            break;
+
+        case BLE_GATTC_EVT_HVX:
+            p_gattc->params.hvx.len = rand() % MAX_VALUE_LEN;
+            break;
+
+        case BLE_GATTS_EVT_WRITE:
+            p_gatts->params.write.len = rand() % MAX_VALUE_LEN;
+            break;
+
+        case BLE_GATTS_EVT_RW_AUTHORIZE_REQUEST:
+            p_gatts->params.authorize_request.type = BLE_GATTS_AUTHORIZE_TYPE_READ + (rand() % 2);
+            p_gatts->params.authorize_request.request.write.len = rand() % MAX_VALUE_LEN;
+            break;
+
+        case BLE_L2CAP_EVT_RX:
+            p_buffer->evt.evt.l2cap_evt.params.rx.header.len = rand() % MAX_VALUE_LEN;
+            break;
+
+        default:
+            break;
+    }
+}
+
+
+/**@brief Function for passing random events of one kind through both serializers. */
+static void evt_test(const evt_desc_t * p_desc, uint32_t iterations)
+{
+    static evt_buffer_t event;
+    static evt_buffer_t decoded;
+    static uint8_t      packet[PKT_BUFFER_SIZE];
+    static uint8_t      packet_again[PKT_BUFFER_SIZE];
+
+    uint32_t packet_len;
+    uint32_t packet_again_len;
+    uint32_t measured_len;
+    uint32_t decoded_len;
+    uint32_t i;
+
+    for (i = 0; i < iterations; i++)
+    {
+        event_random(&event, p_desc->evt_id);
+
+        packet_len = sizeof(packet);
+        if (!check(ble_event_enc(&event.evt, sizeof(event), packet, &packet_len) == NRF_SUCCESS,
+                   p_desc, "encoding failed", i))
+        {
+            continue;
+        }
+
+        measured_len = 0;
+        (void)check(ble_event_dec(packet, packet_len, NULL, &measured_len) == NRF_SUCCESS,
+                    p_desc, "measuring failed", i);
+
+        memset(&decoded, 0, sizeof(decoded));
+        decoded_len = sizeof(decoded);
+        if (!check(ble_event_dec(packet, packet_len, &decoded.evt, &decoded_len) == NRF_SUCCESS,
+                   p_desc, "decoding failed", i))
+        {
+            continue;
+        }
+        (void)check(decoded.evt.header.evt_id == p_desc->evt_id, p_desc, "wrong event ID", i);
+        (void)check((measured_len == decoded_len) ||
+                    (measured_len + sizeof(ble_evt_hdr_t) == decoded_len),
+                    p_desc, "measured length is not the decoded length", i);
+
+        packet_again_len = sizeof(packet_again);
+        if (!check(ble_event_enc(&decoded.evt, sizeof(decoded), packet_again, &packet_again_len)
+                   == NRF_SUCCESS, p_desc, "encoding of the decoded event failed", i))
+        {
+            continue;
+        }
+        (void)check((packet_again_len == packet_len) &&
+                    (memcmp(packet_again, packet, packet_len) == 0),
+                    p_desc, "decoded event is encoded differently", i);
+    }
+}
+
+
+/**@brief Function for measuring the encoding and decoding time of events of one kind. */
+static void bench(const evt_desc_t * p_desc, uint32_t rounds)
+{
+    static evt_buffer_t events[BENCH_BATCH];
+    static evt_buffer_t decoded;
+    static uint8_t      packets[BENCH_BATCH][PKT_BUFFER_SIZE];
+    static uint32_t     packet_lens[BENCH_BATCH];
+
+    uint64_t bytes = 0;
+    uint64_t start;
+    uint64_t ns[2];
+    uint32_t decoded_len;
+    uint32_t round;
+    uint32_t i;
+
+    for (i = 0; i < BENCH_BATCH; i++)
+    {
+        event_random(&events[i], p_desc->evt_id);
+    }
+
+    start = host_ns_get();
+    for (round = 0; round < rounds; round++)
+    {
+        for (i = 0; i < BENCH_BATCH; i++)
+        {
+            packet_lens[i] = PKT_BUFFER_SIZE;
+            (void)ble_event_enc(&events[i].evt, sizeof(events[i]), packets[i], &packet_lens[i]);
+        }
+    }
+    ns[0] = host_ns_get() - start;
+
+    start = host_ns_get();
+    for (round = 0; round < rounds; round++)
+    {
+        for (i = 0; i < BENCH_BATCH; i++)
+        {
+            decoded_len = sizeof(decoded);
+            (void)ble_event_dec(packets[i], packet_lens[i], &decoded.evt, &decoded_len);
+        }
+    }
+    ns[1] = host_ns_get() - start;
+
+    for (i = 0; i < BENCH_BATCH; i++)
+    {
+        bytes += packet_lens[i];
+    }
+
+    printf("%-32s %7.1f ns/op encode %7.1f ns/op decode %6.1f bytes/msg\n",
+           p_desc->p_name,
+           (double)ns[0] / ((uint64_t)rounds * BENCH_BATCH),
+           (double)ns[1] / ((uint64_t)rounds * BENCH_BATCH),
+           (double)bytes / BENCH_BATCH);
+}
+
+
+int main(int argc, char * argv[])
+{
+    uint32_t iterations = 20000;
+    unsigned seed       = 1;
+    int      opt;
+    uint32_t i;
+
+    while ((opt = getopt(argc, argv, "n:s:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'n':
+                iterations = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+
+            case 's':
+                seed = (unsigned)strtoul(optarg, NULL, 0);
+                break;
+
+            default:
+                fprintf(stderr, "usage: %s [-n iterations] [-s seed]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    srand(seed);
+    random_fill(m_values, sizeof(m_values));
+
+    printf("s110 event serializers, %u iterations, seed %u\n", (unsigned)iterations, seed);
+
+    for (i = 0; i < ARRAY_SIZE(m_events); i++)
+    {
+        evt_test(&m_events[i], iterations);
+    }
+
+    for (i = 0; i < ARRAY_SIZE(m_events); i++)
+    {
+        bench(&m_events[i], iterations / 10);
+    }
+
+    printf("%s\n", (m_errors == 0) ? "PASS" : "FAIL");
+
+    return (m_errors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,748 @@
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/** @file
+ *
+ * @brief Test and benchmark of the SLIP codec (slip.c).
+ *
+ * @details Test: fixed vectors are encoded and decoded byte for byte. The codec is then fuzzed
+ *          against a reference codec processing one byte at a time, as the SLIP layers did before
+ *          they used slip.c:
+ *          - slip_special_byte_find() on random spans at every alignment.
+ *          - slip_encode() on random data with random shares of END and ESC bytes, into output
+ *            buffers of random size. The output must be identical to the reference and no byte
+ *            past the output buffer may be written.
+ *          - slip_decode() on random byte streams made mostly of END, ESC and special codes, in
+ *            spans of random length, into buffers of random size which are randomly grown or
+ *            dropped when full. Every result, consumed count and decoded byte must be identical to
+ *            the reference and no byte past the buffer may be written.
+ *          - Random frames are encoded, framed and decoded again, and must come out unchanged.
+ *
+ *          Benchmark: nanoseconds per byte of encoding and decoding with slip.c and with the
+ *          reference codec, for data without special bytes, random data and data with many
+ *          special bytes.
+ *
+ *          Usage: slip_test [-n iterations] [-s seed]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "slip.h"
+#include "nordic_common.h"
+
+#define MAX_FRAME_SIZE  300                                 /**< Max size of a fuzzed frame in bytes. */
+#define GUARD_SIZE      16                                  /**< Number of bytes checked past output and decode buffers. */
+#define GUARD_BYTE      0x5A                                /**< Value of the guard bytes. */
+#define OUTPUT_SIZE     (3 * MAX_FRAME_SIZE + GUARD_SIZE)   /**< Size of an encoder output buffer, for a frame of special bytes and the largest output chunk. */
+#define STREAM_SIZE     1024                                /**< Size of a fuzzed decoder input stream in bytes. */
+#define BENCH_SIZE      (1024 * 1024)                       /**< Size of the benchmark data in bytes. */
+#define ARRAY_SIZE(a)   (sizeof(a) / sizeof((a)[0]))        /**< Number of elements of an array. */
+
+/**@brief Fixed test vector. */
+typedef struct
+{
+    const char * p_name;                                    /**< Name of the vector. */
+    uint8_t      data[8];                                   /**< Frame content. */
+    uint32_t     data_length;                               /**< Length of the frame content. */
+    uint8_t      encoded[16];                               /**< Expected SLIP encoding of the content, without END bytes. */
+    uint32_t     encoded_length;                            /**< Length of the expected encoding. */
+} vector_t;
+
+/**@brief Fixed decoder vector, a received byte stream and the frames decoded from it. */
+typedef struct
+{
+    const char * p_name;                                    /**< Name of the vector. */
+    uint8_t      stream[16];                                /**< Received bytes. */
+    uint32_t     stream_length;                             /**< Number of received bytes. */
+    uint8_t      frames[16];                                /**< Contents of the decoded frames, one after another. */
+    uint32_t     frames_length;                             /**< Total length of the decoded frames. */
+    uint32_t     frame_count;                               /**< Number of decoded frames. */
+} stream_vector_t;
+
+/**@brief Reference decoder, processing one byte at a time. */
+typedef struct
+{
+    uint8_t * p_buffer;
+    uint32_t  buffer_size;
+    uint32_t  length;
+    bool      escape;
+    bool      synchronized;
+} ref_decoder_t;
+
+static const vector_t m_vectors[] =
+{
+    {"empty",          {0},                          0, {0},                                    0},
+    {"plain",          {0x01, 0x02, 0x03},           3, {0x01, 0x02, 0x03},                     3},
+    {"END",            {0xC0},                       1, {0xDB, 0xDC},                           2},
+    {"ESC",            {0xDB},                       1, {0xDB, 0xDD},                           2},
+    {"codes",          {0xDC, 0xDD},                 2, {0xDC, 0xDD},                           2},
+    {"ESC END",        {0xDB, 0xC0},                 2, {0xDB, 0xDD, 0xDB, 0xDC},               4},
+    {"mixed",          {0x00, 0xC0, 0xFF, 0xDB, 0xDC, 0xC0, 0xC0, 0x7F},
+                       8, {0x00, 0xDB, 0xDC, 0xFF, 0xDB, 0xDD, 0xDC, 0xDB, 0xDC, 0xDB, 0xDC, 0x7F}, 12},
+    {"all special",    {0xC0, 0xDB, 0xC0, 0xDB, 0xC0, 0xDB, 0xC0, 0xDB},
+                       8, {0xDB, 0xDC, 0xDB, 0xDD, 0xDB, 0xDC, 0xDB, 0xDD,
+                           0xDB, 0xDC, 0xDB, 0xDD, 0xDB, 0xDC, 0xDB, 0xDD},                     16},
+};
+
+static const stream_vector_t m_stream_vectors[] =
+{
+    {"unsynchronized", {0x01, 0xDB, 0xDC, 0xC0, 0x02, 0xC0},         6, {0x02},             1, 1},
+    {"empty frames",   {0xC0, 0xC0, 0xC0, 0x03, 0xC0},               5, {0x03},             1, 1},
+    {"back to back",   {0xC0, 0x04, 0xC0, 0x05, 0xC0, 0xC0, 0x06, 0xC0},
+                       8, {0x04, 0x06},                                                     2, 2},
+    {"escapes",        {0xC0, 0xDB, 0xDC, 0xDB, 0xDD, 0xC0},         6, {0xC0, 0xDB},       2, 1},
+    {"bad escape",     {0xC0, 0xDB, 0x41, 0xDB, 0xDB, 0xC0},         6, {0x41, 0xDB},       2, 1},
+    {"ESC at end",     {0xC0, 0x07, 0xDB, 0xC0, 0xC0, 0x08, 0xC0},   7, {0x07, 0x08},       2, 2},
+    {"lone ESC",       {0xC0, 0xDB, 0xC0, 0xC0, 0x09, 0xC0},         6, {0x09},             1, 1},
+};
+
+static uint32_t m_errors;                                   /**< Number of failed checks. */
+
+
+/**@brief Function for getting host time in nanoseconds. */
+static uint64_t host_ns_get(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ull) + (uint64_t)ts.tv_nsec;
+}
+
+
+/**@brief Function for reporting a failed check. */
+static bool check(bool ok, char const * p_what, uint32_t iteration)
+{
+    if (!ok && (m_errors++ < 10))
+    {
+        printf("iteration %u: %s\n", (unsigned)iteration, p_what);
+    }
+    return ok;
+}
+
+
+/**@brief Function for getting a random number from 0 to limit - 1. */
+static uint32_t random_get(uint32_t limit)
+{
+    return (limit != 0) ? ((uint32_t)rand() % limit) : 0;
+}
+
+
+/**@brief Function for filling a span with random bytes, of which about one in every special_1_in
+ *        is a SLIP END or ESC byte (none if 0).
+ */
+static void random_fill(uint8_t * p_data, uint32_t length, uint32_t special_1_in)
+{
+    uint32_t i;
+
+    for (i = 0; i < length; i++)
+    {
+        if ((special_1_in != 0) && (random_get(special_1_in) == 0))
+        {
+            p_data[i] = (rand() & 1) ? SLIP_END : SLIP_ESC;
+        }
+        else
+        {
+            do
+            {
+                p_data[i] = (uint8_t)rand();
+            } while ((p_data[i] == SLIP_END) || (p_data[i] == SLIP_ESC));
+        }
+    }
+}
+
+
+/**@brief Function for checking that the guard bytes following a buffer are unchanged. */
+static bool guard_check(const uint8_t * p_guard)
+{
+    uint32_t i;
+
+    for (i = 0; i < GUARD_SIZE; i++)
+    {
+        if (p_guard[i] != GUARD_BYTE)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/**@brief Reference encoder, one byte at a time.
+ *
+ * @return Length of the encoding.
+ */
+static uint32_t ref_encode(const uint8_t * p_data, uint32_t length, uint8_t * p_output)
+{
+    uint32_t count = 0;
+    uint32_t i;
+
+    for (i = 0; i < length; i++)
+    {
+        switch (p_data[i])
+        {
+            case SLIP_END:
+                p_output[count++] = SLIP_ESC;
+                p_output[count++] = SLIP_ESC_END;
+                break;
+
+            case SLIP_ESC:
+                p_output[count++] = SLIP_ESC;
+                p_output[count++] = SLIP_ESC_ESC;
+                break;
+
+            default:
+                p_output[count++] = p_data[i];
+                break;
+        }
+    }
+    return count;
+}
+
+
+/**@brief Reference decoder, processing one received byte.
+ *
+ * @return SLIP_DECODE_CONTINUE if the byte was consumed and did not end a frame,
+ *         SLIP_DECODE_FRAME_END if it ended a frame, SLIP_DECODE_BUFFER_FULL if it was not consumed.
+ */
+static slip_decode_result_t ref_decode_byte(ref_decoder_t * p_decoder, uint8_t byte)
+{
+    if (!p_decoder->synchronized)
+    {
+        if (byte == SLIP_END)
+        {
+            p_decoder->length       = 0;
+            p_decoder->escape       = false;
+            p_decoder->synchronized = true;
+        }
+        return SLIP_DECODE_CONTINUE;
+    }
+
+    if (byte == SLIP_END)
+    {
+        p_decoder->escape = false;
+        if (p_decoder->length != 0)
+        {
+            p_decoder->synchronized = false;
+            return SLIP_DECODE_FRAME_END;
+        }
+        return SLIP_DECODE_CONTINUE;
+    }
+
+    if (!p_decoder->escape && (byte == SLIP_ESC))
+    {
+        p_decoder->escape = true;
+        return SLIP_DECODE_CONTINUE;
+    }
+
+    if (p_decoder->length == p_decoder->buffer_size)
+    {
+        return SLIP_DECODE_BUFFER_FULL;
+    }
+
+    if (p_decoder->escape)
+    {
+        if (byte == SLIP_ESC_END)
+        {
+            byte = SLIP_END;
+        }
+        else if (byte == SLIP_ESC_ESC)
+        {
+            byte = SLIP_ESC;
+        }
+        p_decoder->escape = false;
+    }
+    p_decoder->p_buffer[p_decoder->length++] = byte;
+
+    return SLIP_DECODE_CONTINUE;
+}
+
+
+/**@brief Reference decoder, processing a span of received bytes like slip_decode(). */
+static slip_decode_result_t ref_decode(ref_decoder_t * p_decoder,
+                                       const uint8_t * p_data,
+                                       uint32_t      * p_length)
+{
+    slip_decode_result_t result = SLIP_DECODE_CONTINUE;
+    uint32_t             index;
+
+    for (index = 0; index < *p_length; index++)
+    {
+        result = ref_decode_byte(p_decoder, p_data[index]);
+
+        if (result == SLIP_DECODE_FRAME_END)
+        {
+            index++;
+            break;
+        }
+        if (result == SLIP_DECODE_BUFFER_FULL)
+        {
+            break;
+        }
+    }
+
+    *p_length = index;
+    return result;
+}
+
+
+/**@brief Function for encoding a span with slip_encode() into output buffers of random size.
+ *
+ * @return Length of the encoding, or UINT32_MAX if a byte past an output buffer was written.
+ */
+static uint32_t chunked_encode(const uint8_t * p_data, uint32_t length, uint8_t * p_output,
+                               uint32_t max_chunk)
+{
+    slip_encoder_t encoder;
+    uint32_t       count = 0;
+    uint32_t       chunk;
+    uint32_t       written;
+
+    slip_encoder_init(&encoder, p_data, length);
+
+    while (!slip_encoder_is_done(&encoder))
+    {
+        chunk = 1 + random_get(max_chunk);
+        memset(&p_output[count + chunk], GUARD_BYTE, GUARD_SIZE);
+
+        written = slip_encode(&encoder, &p_output[count], chunk);
+        if ((written > chunk) || (written == 0) || !guard_check(&p_output[count + chunk]))
+        {
+            return UINT32_MAX;
+        }
+        count += written;
+    }
+
+    // An encoder which is done does not output anything more.
+    if (slip_encode(&encoder, &p_output[count], 4) != 0)
+    {
+        return UINT32_MAX;
+    }
+
+    return count;
+}
+
+
+/**@brief Function for decoding a stream in one go with slip_decode().
+ *
+ * @return Number of frames decoded into p_frames.
+ */
+static uint32_t stream_decode(const uint8_t * p_stream, uint32_t length, uint8_t * p_frames,
+                              uint32_t * p_frames_length)
+{
+    slip_decoder_t       decoder;
+    slip_decode_result_t result;
+    uint8_t              buffer[MAX_FRAME_SIZE];
+    uint32_t             consumed;
+    uint32_t             frames = 0;
+
+    *p_frames_length = 0;
+    slip_decoder_init(&decoder, buffer, sizeof(buffer));
+
+    while (length != 0)
+    {
+        consumed = length;
+        result   = slip_decode(&decoder, p_stream, &consumed);
+        p_stream += consumed;
+        length   -= consumed;
+
+        if (result == SLIP_DECODE_FRAME_END)
+        {
+            memcpy(&p_frames[*p_frames_length], buffer, decoder.length);
+            *p_frames_length += decoder.length;
+            frames++;
+            slip_decoder_init(&decoder, buffer, sizeof(buffer));
+        }
+        else if (result == SLIP_DECODE_BUFFER_FULL)
+        {
+            slip_decoder_init(&decoder, buffer, sizeof(buffer));
+        }
+    }
+
+    return frames;
+}
+
+
+/**@brief Fixed vectors, encoded and decoded byte for byte. */
+static void vector_test(void)
+{
+    uint8_t  output[OUTPUT_SIZE];
+    uint8_t  stream[2 * MAX_FRAME_SIZE];
+    uint8_t  frames[MAX_FRAME_SIZE];
+    uint32_t frames_length;
+    uint32_t length;
+    uint32_t frame_count;
+    uint32_t i;
+
+    for (i = 0; i < ARRAY_SIZE(m_vectors); i++)
+    {
+        const vector_t * p_vector = &m_vectors[i];
+
+        // Output buffers of one byte up to the whole encoding.
+        length = chunked_encode(p_vector->data, p_vector->data_length, output, 1);
+        if (!check((length == p_vector->encoded_length) &&
+                   (memcmp(output, p_vector->encoded, length) == 0), p_vector->p_name, i))
+        {
+            continue;
+        }
+        length = chunked_encode(p_vector->data, p_vector->data_length, output, MAX_FRAME_SIZE);
+        check((length == p_vector->encoded_length) &&
+              (memcmp(output, p_vector->encoded, length) == 0), p_vector->p_name, i);
+
+        if (p_vector->data_length == 0)
+        {
+            continue;
+        }
+
+        stream[0] = SLIP_END;
+        memcpy(&stream[1], p_vector->encoded, p_vector->encoded_length);
+        stream[1 + p_vector->encoded_length] = SLIP_END;
+
+        frame_count = stream_decode(stream, p_vector->encoded_length + 2, frames, &frames_length);
+        check((frame_count == 1) && (frames_length == p_vector->data_length) &&
+              (memcmp(frames, p_vector->data, frames_length) == 0), p_vector->p_name, i);
+    }
+
+    for (i = 0; i < ARRAY_SIZE(m_stream_vectors); i++)
+    {
+        const stream_vector_t * p_vector = &m_stream_vectors[i];
+
+        frame_count = stream_decode(p_vector->stream, p_vector->stream_length, frames,
+                                    &frames_length);
+        check((frame_count == p_vector->frame_count) &&
+              (frames_length == p_vector->frames_length) &&
+              (memcmp(frames, p_vector->frames, frames_length) == 0), p_vector->p_name, i);
+    }
+}
+
+
+/**@brief slip_special_byte_find() at every alignment, against a byte by byte search. */
+static void find_fuzz(uint32_t iterations)
+{
+    uint8_t  data[MAX_FRAME_SIZE];
+    uint32_t offset;
+    uint32_t length;
+    uint32_t expected;
+    uint32_t n;
+
+    for (n = 0; n < iterations; n++)
+    {
+        offset = random_get(8);
+        length = random_get(sizeof(data) - offset + 1);
+        random_fill(data, sizeof(data), 1 + random_get(64));
+
+        for (expected = 0; expected < length; expected++)
+        {
+            if ((data[offset + expected] == SLIP_END) || (data[offset + expected] == SLIP_ESC))
+            {
+                break;
+            }
+        }
+
+        check(slip_special_byte_find(&data[offset], length) == expected, "special byte find", n);
+    }
+}
+
+
+/**@brief slip_encode() into output buffers of random size, against the reference encoder. */
+static void encode_fuzz(uint32_t iterations)
+{
+    static const uint32_t special_1_in[] = {0, 1, 2, 16, 256};
+
+    uint8_t  data[MAX_FRAME_SIZE + 8];
+    uint8_t  output[OUTPUT_SIZE];
+    uint8_t  expected[2 * MAX_FRAME_SIZE];
+    uint32_t offset;
+    uint32_t length;
+    uint32_t expected_length;
+    uint32_t n;
+
+    for (n = 0; n < iterations; n++)
+    {
+        offset = random_get(8);
+        length = random_get(MAX_FRAME_SIZE + 1);
+        random_fill(&data[offset], length,
+                    special_1_in[random_get(ARRAY_SIZE(special_1_in))]);
+
+        expected_length = ref_encode(&data[offset], length, expected);
+        length          = chunked_encode(&data[offset], length, output, 1 + random_get(40));
+
+        if (check(length != UINT32_MAX, "encode past the output buffer", n))
+        {
+            check((length == expected_length) && (memcmp(output, expected, length) == 0),
+                  "encoding differs from the reference", n);
+        }
+    }
+}
+
+
+/**@brief slip_decode() on random streams in spans of random length, into buffers of random size,
+ *        against the reference decoder.
+ */
+static void decode_fuzz(uint32_t iterations)
+{
+    static const uint8_t special[] = {SLIP_END, SLIP_ESC, SLIP_ESC_END, SLIP_ESC_ESC};
+
+    uint8_t              stream[STREAM_SIZE];
+    uint8_t              buffer[MAX_FRAME_SIZE + GUARD_SIZE];
+    uint8_t              ref_buffer[MAX_FRAME_SIZE];
+    slip_decoder_t       decoder;
+    ref_decoder_t        ref;
+    slip_decode_result_t result;
+    slip_decode_result_t ref_result;
+    uint32_t             index;
+    uint32_t             consumed;
+    uint32_t             ref_consumed;
+    uint32_t             size;
+    uint32_t             special_1_in;
+    uint32_t             i;
+    uint32_t             n;
+
+    for (n = 0; n < iterations; n++)
+    {
+        special_1_in = 1 + random_get(32);
+        for (i = 0; i < sizeof(stream); i++)
+        {
+            stream[i] = (random_get(special_1_in) == 0) ? special[random_get(sizeof(special))]
+                                                        : (uint8_t)rand();
+        }
+
+        size = random_get(65);
+        memset(buffer, GUARD_BYTE, sizeof(buffer));
+        slip_decoder_init(&decoder, (size != 0) ? buffer : NULL, size);
+        memset(&ref, 0, sizeof(ref));
+        ref.p_buffer    = ref_buffer;
+        ref.buffer_size = size;
+
+        for (index = 0; index < sizeof(stream); index += consumed)
+        {
+            consumed     = 1 + random_get(MIN(64u, sizeof(stream) - index));
+            ref_consumed = consumed;
+            result       = slip_decode(&decoder, &stream[index], &consumed);
+            ref_result   = ref_decode(&ref, &stream[index], &ref_consumed);
+
+            if (!check((result == ref_result) && (consumed == ref_consumed) &&
+                       (decoder.length == ref.length) && (decoder.escape == ref.escape) &&
+                       (decoder.synchronized == ref.synchronized) &&
+                       ((decoder.length == 0) ||
+                        (memcmp(decoder.p_buffer, ref.p_buffer, decoder.length) == 0)),
+                       "decoding differs from the reference", n) ||
+                !check(guard_check(&buffer[decoder.buffer_size]), "decode past the buffer", n))
+            {
+                break;
+            }
+
+            if ((result == SLIP_DECODE_BUFFER_FULL) && (decoder.buffer_size < MAX_FRAME_SIZE) &&
+                (rand() & 1))
+            {
+                // Grow the buffer, as the serialization PHY does, the decoded bytes are kept.
+                size = decoder.buffer_size + 1 + random_get(MAX_FRAME_SIZE - decoder.buffer_size);
+                memset(&buffer[decoder.length], GUARD_BYTE, sizeof(buffer) - decoder.length);
+                decoder.p_buffer    = buffer;
+                decoder.buffer_size = size;
+                ref.buffer_size     = size;
+            }
+            else if ((result == SLIP_DECODE_BUFFER_FULL) || (result == SLIP_DECODE_FRAME_END))
+            {
+                // Drop the frame or start the next one, in a buffer of another size.
+                size = random_get(65);
+                memset(buffer, GUARD_BYTE, sizeof(buffer));
+                slip_decoder_init(&decoder, (size != 0) ? buffer : NULL, size);
+                memset(&ref, 0, sizeof(ref));
+                ref.p_buffer    = ref_buffer;
+                ref.buffer_size = size;
+            }
+        }
+    }
+}
+
+
+/**@brief Random frames are encoded, framed and decoded in spans of random length. */
+static void round_trip_test(uint32_t iterations)
+{
+    static const uint32_t special_1_in[] = {0, 1, 4, 256};
+
+    uint8_t              frames[8][MAX_FRAME_SIZE];
+    uint32_t             lengths[8];
+    uint8_t              stream[8 * (2 * MAX_FRAME_SIZE + 2) + 64 + GUARD_SIZE];
+    uint8_t              buffer[MAX_FRAME_SIZE];
+    slip_decoder_t       decoder;
+    slip_decode_result_t result;
+    uint32_t             stream_length;
+    uint32_t             frame_count;
+    uint32_t             received;
+    uint32_t             index;
+    uint32_t             consumed;
+    uint32_t             length;
+    uint32_t             i;
+    uint32_t             n;
+
+    for (n = 0; n < iterations; n++)
+    {
+        frame_count   = 1 + random_get(ARRAY_SIZE(frames));
+        stream_length = 0;
+
+        for (i = 0; i < frame_count; i++)
+        {
+            lengths[i] = 1 + random_get(MAX_FRAME_SIZE);
+            random_fill(frames[i], lengths[i], special_1_in[random_get(ARRAY_SIZE(special_1_in))]);
+
+            stream[stream_length++] = SLIP_END;
+            length = chunked_encode(frames[i], lengths[i], &stream[stream_length],
+                                    1 + random_get(64));
+            if (!check(length != UINT32_MAX, "encode past the output buffer", n))
+            {
+                return;
+            }
+            stream_length += length;
+            stream[stream_length++] = SLIP_END;
+        }
+
+        received = 0;
+        slip_decoder_init(&decoder, buffer, sizeof(buffer));
+
+        for (index = 0; index < stream_length; index += consumed)
+        {
+            consumed = 1 + random_get(MIN(100u, stream_length - index));
+            result   = slip_decode(&decoder, &stream[index], &consumed);
+
+            if (result == SLIP_DECODE_FRAME_END)
+            {
+                check((received < frame_count) && (decoder.length == lengths[received]) &&
+                      (memcmp(buffer, frames[received], decoder.length) == 0),
+                      "round trip frame differs", n);
+                received++;
+                slip_decoder_init(&decoder, buffer, sizeof(buffer));
+            }
+            if (!check(result != SLIP_DECODE_BUFFER_FULL, "round trip buffer full", n))
+            {
+                break;
+            }
+        }
+
+        check(received == frame_count, "round trip frame lost", n);
+    }
+}
+
+
+/**@brief Nanoseconds per byte of slip.c and of the reference codec. */
+static void bench(const char * p_name, uint32_t special_1_in, bool random_bytes)
+{
+    static uint8_t data[BENCH_SIZE];
+    static uint8_t encoded[2 * BENCH_SIZE + 2];
+    static uint8_t decoded[BENCH_SIZE];
+
+    slip_encoder_t encoder;
+    slip_decoder_t decoder;
+    ref_decoder_t  ref;
+    uint32_t       encoded_length;
+    uint32_t       consumed;
+    uint64_t       start;
+    uint64_t       ns[4];
+    uint32_t       i;
+
+    // Touch the buffers, so that page faults are not measured.
+    memset(encoded, 0, sizeof(encoded));
+    memset(decoded, 0, sizeof(decoded));
+
+    if (random_bytes)
+    {
+        for (i = 0; i < sizeof(data); i++)
+        {
+            data[i] = (uint8_t)rand();
+        }
+    }
+    else
+    {
+        random_fill(data, sizeof(data), special_1_in);
+    }
+
+    start = host_ns_get();
+    slip_encoder_init(&encoder, data, sizeof(data));
+    encoded_length = slip_encode(&encoder, &encoded[1], 2 * BENCH_SIZE);
+    ns[0] = host_ns_get() - start;
+
+    start = host_ns_get();
+    (void)ref_encode(data, sizeof(data), &encoded[1]);
+    ns[1] = host_ns_get() - start;
+
+    encoded[0]                  = SLIP_END;
+    encoded[encoded_length + 1] = SLIP_END;
+
+    start = host_ns_get();
+    slip_decoder_init(&decoder, decoded, sizeof(decoded));
+    consumed = encoded_length + 2;
+    check(slip_decode(&decoder, encoded, &consumed) == SLIP_DECODE_FRAME_END, "bench decode", 0);
+    ns[2] = host_ns_get() - start;
+    check((decoder.length == sizeof(data)) && (memcmp(decoded, data, sizeof(data)) == 0),
+          "bench decode", 0);
+
+    start = host_ns_get();
+    memset(&ref, 0, sizeof(ref));
+    ref.p_buffer    = decoded;
+    ref.buffer_size = sizeof(decoded);
+    consumed = encoded_length + 2;
+    (void)ref_decode(&ref, encoded, &consumed);
+    ns[3] = host_ns_get() - start;
+
+    printf("%-20s %6.2f %6.2f ns/byte encode, %6.2f %6.2f ns/byte decode (slip.c, reference)\n",
+           p_name,
+           (double)ns[0] / sizeof(data), (double)ns[1] / sizeof(data),
+           (double)ns[2] / sizeof(data), (double)ns[3] / sizeof(data));
+}
+
+
+int main(int argc, char * argv[])
+{
+    uint32_t iterations = 20000;
+    unsigned seed       = 1;
+    int      opt;
+
+    while ((opt = getopt(argc, argv, "n:s:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'n':
+                iterations = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+
+            case 's':
+                seed = (unsigned)strtoul(optarg, NULL, 0);
+                break;
+
+            default:
+                fprintf(stderr, "usage: %s [-n iterations] [-s seed]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    srand(seed);
+
+    printf("SLIP codec, %u iterations, seed %u\n", (unsigned)iterations, seed);
+
+    vector_test();
+    find_fuzz(iterations);
+    encode_fuzz(iterations);
+    decode_fuzz(iterations / 10);
+    round_trip_test(iterations / 10);
+
+    bench("no special bytes", 0, false);
+    bench("random bytes", 0, true);
+    bench("1 in 16 special", 16, false);
+
+    printf("%s\n", (m_errors == 0) ? "PASS" : "FAIL");
+
+    return (m_errors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -36,6 +36,7 @@
 #include "ble_srv_common.h"
 #include "ble_advdata.h"
 #include "ble_conn_params.h"
+#include "ble_gatts_router.h"
 #include "boards.h"
 #include "app_scheduler.h"
 #include "softdevice_handler.h"
@@ -567,14 +568,17 @@ static void advertising_start(void)
 
 /**@brief Function for handling the Application's BLE Stack events.
  *
+ * @param[in]   p_context   Unused.
  * @param[in]   p_ble_evt   Bluetooth stack event.
  */
-static void on_ble_evt(ble_evt_t * p_ble_evt)
+static void on_ble_evt(void * p_context, ble_evt_t * p_ble_evt)
 {
     uint32_t                         err_code;
     static ble_gap_evt_auth_status_t m_auth_status;
     ble_gap_enc_info_t *             p_enc_info;
 
+    UNUSED_PARAMETER(p_context);
+
     switch (p_ble_evt->header.evt_id)
     {
         case BLE_GAP_EVT_CONNECTED:
@@ -650,19 +654,92 @@ static void on_ble_evt(ble_evt_t * p_ble_evt)
 }
 
 
-/**@brief Function for dispatching a BLE stack event to all modules with a BLE stack event handler.
+/**@brief Function for passing a BLE stack event to the Connection Parameters module. */
+static void conn_params_on_ble_evt(void * p_context, ble_evt_t * p_ble_evt)
+{
+    UNUSED_PARAMETER(p_context);
+    ble_conn_params_on_ble_evt(p_ble_evt);
+}
+
+
+/**@brief Function for passing a BLE stack event to the GATT Server event router. */
+static void gatts_router_on_ble_evt(void * p_context, ble_evt_t * p_ble_evt)
+{
+    UNUSED_PARAMETER(p_context);
+    ble_gatts_router_on_ble_evt(p_ble_evt);
+}
+
+
+/**@brief Function for passing a BLE stack event to the CIS service. */
+static void cis_on_ble_evt(void * p_context, ble_evt_t * p_ble_evt)
+{
+    ble_cis_on_ble_evt((ble_cis_t *)p_context, p_ble_evt);
+}
+
+
+/**@brief Function for registering a BLE stack event handler for a list of event ids.
  *
- * @details This function is called from the scheduler in the main loop after a BLE stack
- *          event has been received.
+ * @param[in]   handler     Handler to register.
+ * @param[in]   p_context   Context passed to the handler.
+ * @param[in]   p_evt_ids   Event ids the handler is interested in.
+ * @param[in]   evt_count   Number of event ids.
+ */
+static void ble_evt_handlers_register(ble_evt_registry_handler_t handler,
+                                      void *                     p_context,
+                                      const uint16_t *           p_evt_ids,
+                                      uint8_t                    evt_count)
+{
+    uint32_t err_code;
+    uint8_t  i;
+
+    for (i = 0; i < evt_count; i++)
+    {
+        err_code = softdevice_ble_evt_handler_register(p_evt_ids[i], handler, p_context);
+        APP_ERROR_CHECK(err_code);
+    }
+}
+
+
+/**@brief Function for registering all modules with a BLE stack event handler.
  *
- * @param[in]   p_ble_evt   Bluetooth stack event.
+ * @details Each module only gets the events it handles. Modules registered for the same event
+ *          are called in the order they are registered here.
  */
-static void ble_evt_dispatch(ble_evt_t * p_ble_evt)
+static void ble_evt_registry_init(void)
 {
-    debug(0,"BLE event dispatch \n\r");
-    on_ble_evt(p_ble_evt);
-    ble_conn_params_on_ble_evt(p_ble_evt);
-    ble_cis_on_ble_evt(&m_cis, p_ble_evt);
+    static const uint16_t app_evt_ids[]          = {BLE_GAP_EVT_CONNECTED,
+                                                    BLE_GAP_EVT_DISCONNECTED,
+                                                    BLE_GAP_EVT_SEC_PARAMS_REQUEST,
+                                                    BLE_GATTS_EVT_SYS_ATTR_MISSING,
+                                                    BLE_GAP_EVT_AUTH_STATUS,
+                                                    BLE_GAP_EVT_SEC_INFO_REQUEST,
+                                                    BLE_GAP_EVT_TIMEOUT};
+    static const uint16_t conn_params_evt_ids[]  = {BLE_GAP_EVT_CONNECTED,
+                                                    BLE_GAP_EVT_DISCONNECTED,
+                                                    BLE_GATTS_EVT_WRITE,
+                                                    BLE_GAP_EVT_CONN_PARAM_UPDATE};
+    static const uint16_t gatts_router_evt_ids[] = {BLE_GATTS_EVT_WRITE,
+                                                    BLE_GATTS_EVT_RW_AUTHORIZE_REQUEST,
+                                                    BLE_GATTS_EVT_HVC};
+    static const uint16_t cis_evt_ids[]          = {BLE_GAP_EVT_CONNECTED,
+                                                    BLE_GAP_EVT_DISCONNECTED};
+
+    ble_evt_handlers_register(on_ble_evt,
+                              NULL,
+                              app_evt_ids,
+                              sizeof(app_evt_ids) / sizeof(app_evt_ids[0]));
+    ble_evt_handlers_register(conn_params_on_ble_evt,
+                              NULL,
+                              conn_params_evt_ids,
+                              sizeof(conn_params_evt_ids) / sizeof(conn_params_evt_ids[0]));
+    ble_evt_handlers_register(gatts_router_on_ble_evt,
+                              NULL,
+                              gatts_router_evt_ids,
+                              sizeof(gatts_router_evt_ids) / sizeof(gatts_router_evt_ids[0]));
+    ble_evt_handlers_register(cis_on_ble_evt,
+                              &m_cis,
+                              cis_evt_ids,
+                              sizeof(cis_evt_ids) / sizeof(cis_evt_ids[0]));
 }
 
 /**@brief Function for dispatching a system event to interested modules.
@@ -697,10 +774,9 @@ static void ble_stack_init(void)
     APP_ERROR_CHECK(err_code);
 
     // Register with the SoftDevice handler module for BLE events.
-    err_code = softdevice_ble_evt_handler_set(ble_evt_dispatch);
-    APP_ERROR_CHECK(err_code);
+    ble_evt_registry_init();
     
-    // Register with the SoftDevice handler module for BLE events.
+    // Register with the SoftDevice handler module for system events.
     err_code = softdevice_sys_evt_handler_set(sys_evt_dispatch);
     APP_ERROR_CHECK(err_code);
     debug(0,"Initializing stack... \n\r");